@@ -0,0 +1,105 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef CACHED_SPECTRUM_PROPAGATION_LOSS_H
+#define CACHED_SPECTRUM_PROPAGATION_LOSS_H
+
+#include "ns3/spectrum-propagation-loss-model.h"
+#include "ns3/propagation-cache.h"
+
+namespace ns3 {
+
+/**
+ * \ingroup spectrum
+ *
+ * \brief Memoize the gain of another model for each pair of nodes and
+ * SpectrumModel.
+ *
+ * The gain of each band is computed once by the Model attribute, which
+ * may be a chain of models, and applied to the PSD of the following
+ * transmissions until either node moves further than the
+ * PositionThreshold attribute.  The cache holds at most MaxSize pairs,
+ * evicting the least recently used ones.
+ *
+ * This is only correct for models which scale each band independently
+ * of the transmitted PSD, and are deterministic for a given pair of
+ * positions, such as FriisSpectrumPropagationLossModel.  Models varying
+ * in time, such as the TraceFadingLossModel of LTE, should be chained
+ * after this model rather than cached.  Pairs are directional, a->b
+ * and b->a being cached separately.
+ */
+class CachedSpectrumPropagationLossModel : public SpectrumPropagationLossModel
+{
+public:
+  CachedSpectrumPropagationLossModel ();
+  ~CachedSpectrumPropagationLossModel ();
+
+  /**
+   * \brief Get the type ID.
+   * \return the object TypeId
+   */
+  static TypeId GetTypeId ();
+
+  virtual Ptr<SpectrumValue> DoCalcRxPowerSpectralDensity (Ptr<const SpectrumValue> txPsd,
+                                                           Ptr<const MobilityModel> a,
+                                                           Ptr<const MobilityModel> b) const;
+
+  /**
+   * \param model the model whose gain is cached
+   */
+  void SetModel (Ptr<SpectrumPropagationLossModel> model);
+  /**
+   * \return the model whose gain is cached
+   */
+  Ptr<SpectrumPropagationLossModel> GetModel () const;
+  /**
+   * \return the number of gains found in the cache
+   */
+  uint64_t GetCacheHits () const;
+  /**
+   * \return the number of gains computed by the model
+   */
+  uint64_t GetCacheMisses () const;
+
+protected:
+  virtual void DoDispose ();
+
+private:
+  /**
+   * \param maxSize the largest number of pairs of nodes in the cache
+   */
+  void SetMaxSize (uint32_t maxSize);
+  /**
+   * \return the largest number of pairs of nodes in the cache
+   */
+  uint32_t GetMaxSize () const;
+  /**
+   * \param threshold the distance the nodes may move before their gain is computed again [m]
+   */
+  void SetPositionThreshold (double threshold);
+  /**
+   * \return the distance the nodes may move before their gain is computed again [m]
+   */
+  double GetPositionThreshold () const;
+
+  Ptr<SpectrumPropagationLossModel> m_model; //!< the model whose gain is cached
+  mutable PropagationCache<SpectrumValue> m_cache; //!< the linear gain of each band, for each pair of nodes
+};
+
+
+} // namespace ns3
+
+#endif /* CACHED_SPECTRUM_PROPAGATION_LOSS_H */
@@ -0,0 +1,153 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2017
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef DARY_HEAP_SCHEDULER_H
+#define DARY_HEAP_SCHEDULER_H
+
+#include "scheduler.h"
+#include <stdint.h>
+#include <vector>
+
+/**
+ * \file
+ * \ingroup scheduler
+ * ns3::DaryHeapScheduler declaration.
+ */
+
+namespace ns3 {
+
+/**
+ * \ingroup scheduler
+ * \brief a 4-ary heap event scheduler with indexed removal
+ *
+ * The events are stored by value in a single contiguous array managed
+ * as an implicit 4-ary heap. Compared to the binary HeapScheduler,
+ * the tree is half as deep and the four children of a node share a
+ * cache line or two, so that RemoveNext touches much less memory.
+ * Neither Insert nor RemoveNext allocate memory once the array has
+ * grown to the peak event population: the storage is never shrunk
+ * and therefore acts as a pool of event slots.
+ *
+ * To make Remove cheap, the scheduler also maintains an index from
+ * event uid to heap position. The index is an open-addressing hash
+ * table with linear probing stored in a second contiguous array.
+ * Event uids are allocated sequentially by the simulator, and the
+ * live ones form runs of consecutive values: they are scattered over
+ * the table with Fibonacci hashing, because the identity hash would
+ * make them collide in long probe sequences. Remove is thus O(log n)
+ * instead of the O(n) linear scan done by HeapScheduler.
+ */
+class DaryHeapScheduler : public Scheduler
+{
+public:
+  /**
+   *  Register this type.
+   *  \return The object TypeId.
+   */
+  static TypeId GetTypeId (void);
+
+  /** Constructor. */
+  DaryHeapScheduler ();
+  /** Destructor. */
+  virtual ~DaryHeapScheduler ();
+
+  // Inherited
+  virtual void Insert (const Scheduler::Event &ev);
+  virtual bool IsEmpty (void) const;
+  virtual Scheduler::Event PeekNext (void) const;
+  virtual Scheduler::Event RemoveNext (void);
+  virtual void Remove (const Scheduler::Event &ev);
+
+private:
+  /** Number of children of each heap node. */
+  static const uint32_t ARITY = 4;
+  /** Marker for an unused slot of the uid index. */
+  static const uint32_t NO_POSITION = 0xffffffff;
+
+  /** Slot of the uid to heap position index. */
+  struct IndexEntry
+  {
+    uint32_t uid;       /**< Event uid. */
+    uint32_t position;  /**< Position of the event in the heap. */
+  };
+
+  /**
+   * Store an event at a given heap position and record it in the index.
+   *
+   * \param [in] position The heap position.
+   * \param [in] ev The event to store.
+   */
+  inline void Place (uint32_t position, const Scheduler::Event &ev);
+  /**
+   * Move the event at \p position towards the root until
+   * the heap property is restored.
+   *
+   * \param [in] position The starting heap position.
+   */
+  void SiftUp (uint32_t position);
+  /**
+   * Move the event at \p position towards the leaves until
+   * the heap property is restored.
+   *
+   * \param [in] position The starting heap position.
+   */
+  void SiftDown (uint32_t position);
+
+  /**
+   * Get the home slot of a uid in the index.
+   *
+   * \param [in] uid The event uid.
+   * \returns The first slot to probe.
+   */
+  inline uint32_t IndexHome (uint32_t uid) const;
+  /**
+   * Find the index slot holding a uid.
+   *
+   * \param [in] uid The event uid, which must be present in the index.
+   * \returns The slot holding \p uid.
+   */
+  inline uint32_t IndexFind (uint32_t uid) const;
+  /**
+   * Add a new uid to the index, growing the table if needed.
+   *
+   * \param [in] uid The event uid.
+   * \param [in] position The heap position of the event.
+   */
+  void IndexInsert (uint32_t uid, uint32_t position);
+  /**
+   * Remove a uid from the index.
+   *
+   * \param [in] uid The event uid, which must be present in the index.
+   */
+  void IndexErase (uint32_t uid);
+  /** Double the size of the index and rehash all entries. */
+  void IndexGrow (void);
+
+  /** The event list, managed as a 4-ary heap rooted at index 0. */
+  std::vector<Scheduler::Event> m_heap;
+  /** The uid to heap position index, sized to a power of two. */
+  std::vector<IndexEntry> m_index;
+  /** Mask applied to slot numbers to wrap around the index. */
+  uint32_t m_indexMask;
+  /** Shift applied to hashed uids to obtain their home slot in the index. */
+  uint32_t m_indexShift;
+};
+
+} // namespace ns3
+
+#endif /* DARY_HEAP_SCHEDULER_H */
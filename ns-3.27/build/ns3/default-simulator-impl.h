@@ -0,0 +1,224 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2005,2006 INRIA
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Mathieu Lacage <mathieu.lacage@sophia.inria.fr>
+ */
+
+#ifndef DEFAULT_SIMULATOR_IMPL_H
+#define DEFAULT_SIMULATOR_IMPL_H
+
+#include "simulator-impl.h"
+#include "scheduler.h"
+#include "event-impl.h"
+#include "system-thread.h"
+
+#include "ptr.h"
+
+#include <atomic>
+#include <list>
+
+/**
+ * \file
+ * \ingroup simulator
+ * ns3::DefaultSimulatorImpl declaration.
+ */
+
+namespace ns3 {
+
+/**
+ * \ingroup simulator
+ *
+ * The default single process simulator implementation.
+ */
+class DefaultSimulatorImpl : public SimulatorImpl
+{
+public:
+  /**
+   *  Register this type.
+   *  \return The object TypeId.
+   */
+  static TypeId GetTypeId (void);
+
+  /** Constructor. */
+  DefaultSimulatorImpl ();
+  /** Destructor. */
+  ~DefaultSimulatorImpl ();
+
+  // Inherited
+  virtual void Destroy ();
+  virtual bool IsFinished (void) const;
+  virtual void Stop (void);
+  virtual void Stop (const Time &delay);
+  virtual EventId Schedule (const Time &delay, EventImpl *event);
+  virtual void ScheduleWithContext (uint32_t context, const Time &delay, EventImpl *event);
+  virtual EventId ScheduleNow (EventImpl *event);
+  virtual EventId ScheduleDestroy (EventImpl *event);
+  virtual void Remove (const EventId &id);
+  virtual void Cancel (const EventId &id);
+  virtual bool IsExpired (const EventId &id) const;
+  virtual void Run (void);
+  virtual Time Now (void) const;
+  virtual Time GetDelayLeft (const EventId &id) const;
+  virtual Time GetMaximumSimulationTime (void) const;
+  virtual void SetScheduler (ObjectFactory schedulerFactory);
+  virtual uint32_t GetSystemId (void) const; 
+  virtual uint32_t GetContext (void) const;
+
+  /**
+   * Get the number of cancelled events still held in the event list.
+   *
+   * \returns The number of tombstones.
+   */
+  uint32_t GetTombstoneCount (void) const;
+  /**
+   * Get the fraction of the event list occupied by cancelled events.
+   *
+   * \returns The ratio of tombstones to pending events.
+   */
+  double GetTombstoneRatio (void) const;
+  /**
+   * Get the number of bulk compactions of the event list.
+   *
+   * \returns The number of compactions.
+   */
+  uint32_t GetCompactionCount (void) const;
+  /**
+   * Get the total number of tombstones discarded by compactions.
+   *
+   * \returns The number of compacted events.
+   */
+  uint64_t GetCompactedEventCount (void) const;
+
+private:
+  virtual void DoDispose (void);
+
+  /** Process the next event. */
+  void ProcessOneEvent (void);
+  /** Move events from a different context into the main event queue. */
+  void ProcessEventsWithContext (void);
+  /**
+   * Account for a newly cancelled event, compacting the event list
+   * if the tombstones exceed the configured threshold.
+   */
+  void NotifyCancelled (void);
+  /** Purge all the cancelled events from the event list. */
+  void CompactEvents (void);
+ 
+  /**
+   * Wrap an event with its execution context.
+   *
+   * The events scheduled from other threads are passed to the main
+   * thread through an intrusive multiple producer, single consumer
+   * queue of these nodes (D. Vyukov's algorithm): a producer
+   * enqueues with a single atomic exchange, and never waits on the
+   * consumer. The nodes are recycled through a free list shared by
+   * all the simulator instances.
+   */
+  struct EventWithContext {
+    /** The event context. */
+    uint32_t context;
+    /** Event timestamp. */
+    uint64_t timestamp;
+    /** The event implementation. */
+    EventImpl *event;
+    /** The next node in the queue or in the free list. */
+    std::atomic<EventWithContext *> next;
+  };
+  /**
+   * Get a node from the free list, or allocate a new one.
+   *
+   * \returns A node for an event with context.
+   */
+  static EventWithContext * AllocateEventWithContext (void);
+  /**
+   * Return a chain of nodes to the free list.
+   *
+   * \param [in] first The first node of the chain.
+   * \param [in] last The last node of the chain.
+   */
+  static void FreeEventsWithContext (EventWithContext *first, EventWithContext *last);
+  /**
+   * Enqueue a node, from any thread.
+   *
+   * \param [in] node The node.
+   */
+  void PushEventWithContext (EventWithContext *node);
+  /**
+   * Dequeue a node, from the main thread.
+   *
+   * \returns The oldest node, or 0 if the queue is empty or the
+   *          oldest node is not completely enqueued yet.
+   */
+  EventWithContext * PopEventWithContext (void);
+
+  /** The most recently enqueued node, where other threads enqueue. */
+  std::atomic<EventWithContext *> m_eventsWithContextHead;
+  /** The oldest node, where the main thread dequeues. */
+  EventWithContext *m_eventsWithContextTail;
+  /** Placeholder node, so that the queue never becomes empty. */
+  EventWithContext m_eventsWithContextStub;
+  /** Free nodes, shared by all the instances. */
+  static std::atomic<EventWithContext *> g_freeEventsWithContext;
+
+  /** Container type for the events to run at Simulator::Destroy() */
+  typedef std::list<EventId> DestroyEvents;
+  /** The container of events to run at Destroy. */
+  DestroyEvents m_destroyEvents;
+  /** Flag calling for the end of the simulation. */
+  bool m_stop;
+  /** The event priority queue. */
+  Ptr<Scheduler> m_events;
+  /** The factory of the event priority queue, to rebuild it when compacting. */
+  ObjectFactory m_schedulerFactory;
+
+  /** Next event unique id. */
+  uint32_t m_uid;
+  /** Unique id of the current event. */
+  uint32_t m_currentUid;
+  /** Timestamp of the current event. */
+  uint64_t m_currentTs;
+  /** Execution context of the current event. */
+  uint32_t m_currentContext;
+  /**
+   * Number of events that have been inserted but not yet scheduled,
+   *  not counting the Destroy events; this is used for validation
+   */
+  int m_unscheduledEvents;
+
+  /**
+   * Flag \c true if Remove only cancels the event and leaves it in the
+   * event list, relying on bulk compaction to purge it.
+   */
+  bool m_lazyRemove;
+  /** Tombstone ratio above which the event list is compacted. */
+  double m_maxTombstoneRatio;
+  /** Minimum number of tombstones before the event list is compacted. */
+  uint32_t m_minTombstones;
+  /** Number of cancelled events still in the event list. */
+  uint32_t m_tombstones;
+  /** Number of compactions performed. */
+  uint32_t m_compactions;
+  /** Number of tombstones purged by compactions. */
+  uint64_t m_compactedEvents;
+
+  /** Main execution thread. */
+  SystemThread::ThreadId m_main;
+};
+
+} // namespace ns3
+
+#endif /* DEFAULT_SIMULATOR_IMPL_H */
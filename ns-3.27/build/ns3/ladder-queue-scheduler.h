@@ -0,0 +1,172 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2017
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef LADDER_QUEUE_SCHEDULER_H
+#define LADDER_QUEUE_SCHEDULER_H
+
+#include "scheduler.h"
+#include <stdint.h>
+#include <vector>
+
+/**
+ * \file
+ * \ingroup scheduler
+ * ns3::LadderQueueScheduler declaration.
+ */
+
+namespace ns3 {
+
+/**
+ * \ingroup scheduler
+ * \brief a ladder queue event scheduler
+ *
+ * This is an implementation of the Ladder Queue described in
+ * "Ladder Queue: An O(1) Priority Queue Structure for Large-Scale
+ * Discrete Event Simulation", W. T. Tang, R. S. M. Goh and I. L.-J. Thng,
+ * ACM TOMACS, 15(3), 2005.
+ *
+ * The events are spread over three tiers:
+ *  - the top, an unsorted array which receives all the events
+ *    scheduled past the range covered by the ladder;
+ *  - the ladder, made of up to MAX_RUNGS rungs of buckets. Each rung
+ *    covers the time span of one bucket of the rung above it, and its
+ *    bucket width is derived from the number of events in that span;
+ *  - the bottom, a short sorted array from which the events are
+ *    dequeued.
+ *
+ * When the bottom is empty, the next non-empty bucket of the lowest
+ * rung is sorted into it, or is first spread over a new rung if it
+ * holds more than THRESHOLD events. When the ladder is empty, the top
+ * is spread over a new first rung, whose bucket width is the observed
+ * event time span divided by the number of events. The bucket width
+ * thus follows the event time distribution, unlike the resize policy
+ * of CalendarScheduler, and enqueue and dequeue are O(1) amortized
+ * for most distributions.
+ *
+ * Unlike the original design, buckets are unsorted arrays rather than
+ * linked lists. The rungs and their buckets are kept around when they
+ * are emptied, so that their storage is reused.
+ */
+class LadderQueueScheduler : public Scheduler
+{
+public:
+  /**
+   *  Register this type.
+   *  \return The object TypeId.
+   */
+  static TypeId GetTypeId (void);
+
+  /** Constructor. */
+  LadderQueueScheduler ();
+  /** Destructor. */
+  virtual ~LadderQueueScheduler ();
+
+  // Inherited
+  virtual void Insert (const Scheduler::Event &ev);
+  virtual bool IsEmpty (void) const;
+  virtual Scheduler::Event PeekNext (void) const;
+  virtual Scheduler::Event RemoveNext (void);
+  virtual void Remove (const Scheduler::Event &ev);
+
+private:
+  /** Maximum number of events sorted at once into the bottom. */
+  static const uint32_t THRESHOLD = 50;
+  /** Maximum number of rungs. */
+  static const uint32_t MAX_RUNGS = 8;
+
+  /** Bucket type: an unsorted array of events. */
+  typedef std::vector<Scheduler::Event> Bucket;
+
+  /** A rung of the ladder. */
+  struct Rung
+  {
+    uint64_t start;        /**< Timestamp of the start of the first bucket. */
+    uint64_t width;        /**< Bucket width. */
+    uint32_t current;      /**< Index of the first bucket not yet consumed. */
+    uint32_t nBuckets;     /**< Number of buckets in use. */
+    std::vector<Bucket> buckets; /**< The buckets. */
+  };
+
+  /**
+   * Get the timestamp of the start of the current bucket of a rung.
+   *
+   * \param [in] rung The rung.
+   * \returns The lower bound of the timestamps held by \p rung.
+   */
+  inline uint64_t CurrentStart (const Rung &rung) const;
+  /**
+   * Spread events over the buckets of a rung.
+   *
+   * \param [in,out] rung The rung, whose start, width and number of
+   *        buckets are already set.
+   * \param [in,out] events The events, which are moved into \p rung.
+   */
+  void Spread (Rung &rung, Bucket &events);
+  /**
+   * Set up a new lowest rung covering a time span.
+   *
+   * \param [in] start The start of the time span.
+   * \param [in] span The length of the time span.
+   * \param [in] count The number of events expected in the span.
+   * \returns The new rung.
+   */
+  Rung & AddRung (uint64_t start, uint64_t span, uint32_t count);
+  /** Move the content of the top into the ladder or the bottom. */
+  void TransferTop (void);
+  /**
+   * Spread the bottom over a new rung when it has grown too large.
+   * The bottom is then refilled from that rung.
+   */
+  void SpawnFromBottom (void);
+  /**
+   * Sort a bucket into the bottom.
+   *
+   * \param [in,out] events The events, which are moved into the bottom.
+   */
+  void SortIntoBottom (Bucket &events);
+  /** Refill the bottom if it is exhausted and the queue is not empty. */
+  void Refill (void);
+  /**
+   * Remove an event from an unsorted array.
+   *
+   * \param [in,out] events The array.
+   * \param [in] ev The event to remove.
+   */
+  void EraseUnsorted (Bucket &events, const Scheduler::Event &ev);
+
+  /** The unsorted events past the range of the ladder. */
+  Bucket m_top;
+  /** Lower bound of the timestamps held by the top. */
+  uint64_t m_topStart;
+  /** Minimum timestamp in the top. */
+  uint64_t m_topMin;
+  /** Maximum timestamp in the top. */
+  uint64_t m_topMax;
+  /** The rungs, the first m_nRungs of which are in use. */
+  std::vector<Rung> m_rungs;
+  /** Number of rungs in use. */
+  uint32_t m_nRungs;
+  /** The earliest events, sorted in increasing order. */
+  Bucket m_bottom;
+  /** Index of the next event to dequeue from the bottom. */
+  uint32_t m_bottomNext;
+};
+
+} // namespace ns3
+
+#endif /* LADDER_QUEUE_SCHEDULER_H */
@@ -0,0 +1,225 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2017
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef PARTITION_HELPER_H
+#define PARTITION_HELPER_H
+
+#include <stdint.h>
+#include <vector>
+
+#include "ns3/node-container.h"
+#include "ns3/nstime.h"
+#include "ns3/ptr.h"
+
+/**
+ * \file
+ * \ingroup mpi
+ * ns3::PartitionHelper declaration.
+ */
+
+namespace ns3 {
+
+class Node;
+
+/**
+ * \ingroup mpi
+ *
+ * \brief Assign the system ids of a topology for a parallel simulation.
+ *
+ * The nodes are split into a number of partitions of about the same
+ * size, so that the links between partitions have the largest
+ * possible minimum delay, which is the lookahead of the conservative
+ * parallel simulators, and are as few as possible.
+ *
+ * The links are read from the channels installed on the nodes: a
+ * channel with two devices and a "Delay" attribute, such as a
+ * PointToPointChannel, is a link which may be cut; the nodes sharing
+ * any other channel are kept in the same partition. Links may also be
+ * declared with AddLink before they are installed.
+ *
+ * The partition is computed in two steps:
+ *  - the links shorter than a delay threshold are contracted. The
+ *    threshold is the largest link delay for which no contracted
+ *    group of nodes exceeds the size of a partition;
+ *  - the contracted graph is partitioned with a multilevel
+ *    heuristic: it is coarsened by heavy edge matching, the coarsest
+ *    graph is split by greedy graph growing, and the partition is
+ *    refined by greedy boundary moves while it is projected back.
+ *
+ * With DistributedSimulatorImpl, the PointToPointHelper selects a
+ * remote channel when the two nodes of a link have different system
+ * ids, so the links must be declared with AddLink and the system ids
+ * assigned before the links are installed. MultithreadedSimulatorImpl
+ * reads the system ids when Run is called, so the system ids of a
+ * topology built by the layout helpers may be assigned afterwards.
+ */
+class PartitionHelper
+{
+public:
+  /** Constructor. */
+  PartitionHelper ();
+
+  /**
+   * Set the tolerated imbalance between partitions.
+   *
+   * \param [in] imbalance The largest partition may hold up to
+   *        (1 + \p imbalance) times the average number of nodes.
+   */
+  void SetImbalance (double imbalance);
+
+  /**
+   * Declare a link which is not installed yet.
+   *
+   * \param [in] a One end of the link.
+   * \param [in] b The other end of the link.
+   * \param [in] delay The propagation delay of the link.
+   */
+  void AddLink (Ptr<Node> a, Ptr<Node> b, Time delay);
+
+  /**
+   * Compute a partition of a topology.
+   *
+   * \param [in] nodes The nodes to partition. The links to nodes not
+   *        in the container are ignored.
+   * \param [in] nPartitions The number of partitions.
+   * \returns The partition of each node, in the container order.
+   */
+  std::vector<uint32_t> Partition (NodeContainer nodes, uint32_t nPartitions);
+
+  /**
+   * Compute a partition of a topology and set the "SystemId"
+   * attribute of the nodes accordingly.
+   *
+   * \param [in] nodes The nodes to partition.
+   * \param [in] nPartitions The number of partitions.
+   */
+  void Assign (NodeContainer nodes, uint32_t nPartitions);
+
+  /**
+   * Evaluate the current system ids of a topology, such as a manual
+   * assignment, with the same metrics as the last partition.
+   *
+   * \param [in] nodes The nodes.
+   */
+  void Evaluate (NodeContainer nodes);
+
+  /**
+   * \returns The number of links between partitions, for the last call
+   *          to Partition, Assign or Evaluate.
+   */
+  uint32_t GetCutLinks (void) const;
+
+  /**
+   * \returns The smallest delay of the links between partitions,
+   *          or Time::Max if there is none.
+   */
+  Time GetLookAhead (void) const;
+
+  /**
+   * \returns The number of nodes of the largest partition divided by
+   *          the average number of nodes of a partition.
+   */
+  double GetLoadImbalance (void) const;
+
+private:
+  /** A link, between node indexes. */
+  struct Link
+  {
+    uint32_t a;      /**< Index of one end. */
+    uint32_t b;      /**< Index of the other end. */
+    int64_t delay;   /**< Delay in time steps, or -1 if it cannot be cut. */
+  };
+
+  /** A graph in compressed adjacency form. */
+  struct Graph
+  {
+    std::vector<uint32_t> vertexWeight;  /**< Nodes held by each vertex. */
+    std::vector<uint32_t> start;         /**< First edge of each vertex, plus the end. */
+    std::vector<uint32_t> adjacent;      /**< Other end of each edge. */
+    std::vector<uint32_t> edgeWeight;    /**< Links held by each edge. */
+  };
+
+  /**
+   * Collect the links between the nodes of a container.
+   *
+   * \param [in] nodes The nodes.
+   * \returns The links, between indexes in \p nodes.
+   */
+  std::vector<Link> GetLinks (NodeContainer nodes) const;
+  /**
+   * Coarsen a graph by heavy edge matching.
+   *
+   * \param [in] graph The graph.
+   * \param [in] maxWeight The largest weight of a coarse vertex.
+   * \param [out] coarse The coarse graph.
+   * \param [out] map The coarse vertex of each vertex of \p graph.
+   */
+  static void Coarsen (const Graph &graph, uint32_t maxWeight,
+                       Graph &coarse, std::vector<uint32_t> &map);
+  /**
+   * Split a graph by greedy graph growing.
+   *
+   * \param [in] graph The graph.
+   * \param [in] nPartitions The number of partitions.
+   * \returns The partition of each vertex.
+   */
+  static std::vector<uint32_t> Grow (const Graph &graph, uint32_t nPartitions);
+  /**
+   * Improve a partition by greedy boundary moves, and restore its
+   * balance if needed.
+   *
+   * \param [in] graph The graph.
+   * \param [in] nPartitions The number of partitions.
+   * \param [in] maxWeight The largest weight of a partition.
+   * \param [in,out] part The partition of each vertex.
+   */
+  static void Refine (const Graph &graph, uint32_t nPartitions, uint32_t maxWeight,
+                      std::vector<uint32_t> &part);
+  /**
+   * Compute the metrics of a partition.
+   *
+   * \param [in] links The links.
+   * \param [in] nPartitions The number of partitions.
+   * \param [in] part The partition of each node.
+   */
+  void Measure (const std::vector<Link> &links, uint32_t nPartitions,
+                const std::vector<uint32_t> &part);
+
+  /** A link declared by AddLink. */
+  struct DeclaredLink
+  {
+    Ptr<Node> a;   /**< One end. */
+    Ptr<Node> b;   /**< The other end. */
+    Time delay;    /**< The delay. */
+  };
+
+  /** The declared links. */
+  std::vector<DeclaredLink> m_declared;
+  /** The tolerated imbalance. */
+  double m_imbalance;
+  /** The number of links between partitions. */
+  uint32_t m_cutLinks;
+  /** The smallest delay of the links between partitions. */
+  Time m_lookAhead;
+  /** The load imbalance. */
+  double m_loadImbalance;
+};
+
+} // namespace ns3
+
+#endif /* PARTITION_HELPER_H */
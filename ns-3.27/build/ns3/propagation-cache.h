@@ -0,0 +1,280 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2012 Telum (www.telum.ru)
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Kirill Andreev <andreev@telum.ru>
+ */
+#ifndef PROPAGATION_CACHE_H_
+#define PROPAGATION_CACHE_H_
+
+#include "ns3/mobility-model.h"
+#include "ns3/assert.h"
+#include <unordered_map>
+#include <list>
+#include <algorithm>
+
+namespace ns3
+{
+/**
+ * \ingroup propagation
+ * \brief Constructs a cache of objects, where each object is responsible for a single propagation path loss calculations.
+ * Propagation path is identified by a couple of MobilityModels and a spectrum model UID.
+ * By default, propagation path a-->b and b-->a is the same thing.
+ *
+ * The paths are hashed, so that a lookup does not depend on the
+ * number of paths in the cache.  By default, the cache is unbounded
+ * and its entries never expire, which suits the objects holding the
+ * state of a path, such as a JakesProcess.  A cache memoizing the
+ * loss of the paths can be bounded with SetMaxSize, evicting the least
+ * recently used paths first, and can drop the paths whose ends moved
+ * further than a threshold since they were added, with
+ * SetPositionThreshold.
+ */
+template<class T>
+class PropagationCache
+{
+public:
+  /**
+   * \param symmetric whether the paths a-->b and b-->a are the same
+   */
+  PropagationCache (bool symmetric = true)
+    : m_symmetric (symmetric),
+      m_maxSize (0),
+      m_positionThreshold (-1),
+      m_hits (0),
+      m_misses (0)
+  {};
+  ~PropagationCache () {};
+
+  /**
+   * Set the largest number of paths held by the cache.  The least
+   * recently used paths are evicted when more paths are added.
+   * \param maxSize the largest number of paths, or 0 for an unbounded cache
+   */
+  void SetMaxSize (uint32_t maxSize)
+  {
+    m_maxSize = maxSize;
+    Evict ();
+  };
+  /**
+   * \return the largest number of paths held by the cache, or 0 if unbounded
+   */
+  uint32_t GetMaxSize (void) const
+  {
+    return m_maxSize;
+  };
+  /**
+   * Set the distance that either end of a path may move before the
+   * data of the path expires.  With a threshold of 0, any change of
+   * position expires the data.
+   * \param threshold the distance [m], or a negative value to never expire the data
+   */
+  void SetPositionThreshold (double threshold)
+  {
+    m_positionThreshold = threshold;
+  };
+  /**
+   * \return the distance either end of a path may move before the data of the path expires [m]
+   */
+  double GetPositionThreshold (void) const
+  {
+    return m_positionThreshold;
+  };
+
+  /**
+   * Get the model associated with the path
+   * \param a 1st node mobility model
+   * \param b 2nd node mobility model
+   * \param modelUid model UID
+   * \return the model, or 0 if the path is not cached or its data expired
+   */
+  Ptr<T> GetPathData (Ptr<const MobilityModel> a, Ptr<const MobilityModel> b, uint32_t modelUid)
+  {
+    PropagationPathIdentifier key = PropagationPathIdentifier (a, b, modelUid, m_symmetric);
+    typename PathCache::iterator it = m_pathCache.find (key);
+    if (it == m_pathCache.end ())
+      {
+        m_misses++;
+        return 0;
+      }
+    typename PathList::iterator path = it->second;
+    if (m_positionThreshold >= 0
+        && (CalculateDistance (path->m_srcPosition, path->m_srcMobility->GetPosition ()) > m_positionThreshold
+            || CalculateDistance (path->m_dstPosition, path->m_dstMobility->GetPosition ()) > m_positionThreshold))
+      {
+        m_pathList.erase (path);
+        m_pathCache.erase (it);
+        m_misses++;
+        return 0;
+      }
+    m_hits++;
+    m_pathList.splice (m_pathList.begin (), m_pathList, path);
+    return path->m_data;
+  };
+
+  /**
+   * Add a model to the path
+   * \param data the model to associate to the path
+   * \param a 1st node mobility model
+   * \param b 2nd node mobility model
+   * \param modelUid model UID
+   */
+  void AddPathData (Ptr<T> data, Ptr<const MobilityModel> a, Ptr<const MobilityModel> b, uint32_t modelUid)
+  {
+    PropagationPathIdentifier key = PropagationPathIdentifier (a, b, modelUid, m_symmetric);
+    NS_ASSERT (m_pathCache.find (key) == m_pathCache.end ());
+    Path path (key);
+    path.m_srcMobility = a;
+    path.m_dstMobility = b;
+    path.m_srcPosition = a->GetPosition ();
+    path.m_dstPosition = b->GetPosition ();
+    path.m_data = data;
+    m_pathList.push_front (path);
+    m_pathCache.insert (std::make_pair (key, m_pathList.begin ()));
+    Evict ();
+  };
+
+  /**
+   * \return the number of paths in the cache
+   */
+  uint32_t GetSize (void) const
+  {
+    return m_pathCache.size ();
+  };
+  /**
+   * \return the number of lookups which found the data of a path
+   */
+  uint64_t GetHits (void) const
+  {
+    return m_hits;
+  };
+  /**
+   * \return the number of lookups which found no data, or expired data
+   */
+  uint64_t GetMisses (void) const
+  {
+    return m_misses;
+  };
+  /**
+   * Remove all the paths from the cache, and reset the statistics.
+   */
+  void Clear (void)
+  {
+    m_pathCache.clear ();
+    m_pathList.clear ();
+    m_hits = 0;
+    m_misses = 0;
+  };
+
+private:
+  /// Each path is identified by
+  struct PropagationPathIdentifier
+  {
+    /**
+     * Constructor
+     * @param a 1st node mobility model
+     * @param b 2nd node mobility model
+     * @param modelUid model UID
+     * @param symmetric whether the order of a and b is irrelevant
+     */
+    PropagationPathIdentifier (Ptr<const MobilityModel> a, Ptr<const MobilityModel> b, uint32_t modelUid, bool symmetric) :
+      m_srcMobility (PeekPointer (a)), m_dstMobility (PeekPointer (b)), m_spectrumModelUid (modelUid)
+    {
+      if (symmetric && m_dstMobility < m_srcMobility)
+        {
+          std::swap (m_srcMobility, m_dstMobility);
+        }
+    };
+    const MobilityModel *m_srcMobility; //!< 1st node mobility model
+    const MobilityModel *m_dstMobility; //!< 2nd node mobility model
+    uint32_t m_spectrumModelUid; //!< model UID
+
+    /**
+     * Equality operator.
+     *
+     * \param other Right value of the operator.
+     * \returns True if both identify the same path.
+     */
+    bool operator == (const PropagationPathIdentifier & other) const
+    {
+      return m_srcMobility == other.m_srcMobility
+             && m_dstMobility == other.m_dstMobility
+             && m_spectrumModelUid == other.m_spectrumModelUid;
+    }
+  };
+
+  /// Hash function of a PropagationPathIdentifier
+  struct PropagationPathHash
+  {
+    /**
+     * \param path the path
+     * \returns the hash of the path
+     */
+    size_t operator () (const PropagationPathIdentifier & path) const
+    {
+      size_t h = std::hash<const MobilityModel *> () (path.m_srcMobility);
+      h ^= std::hash<const MobilityModel *> () (path.m_dstMobility) + 0x9e3779b9 + (h << 6) + (h >> 2);
+      h ^= std::hash<uint32_t> () (path.m_spectrumModelUid) + 0x9e3779b9 + (h << 6) + (h >> 2);
+      return h;
+    }
+  };
+
+  /// The data of a path, and the positions of its ends when it was added
+  struct Path
+  {
+    /**
+     * Constructor
+     * @param key the identifier of the path
+     */
+    Path (const PropagationPathIdentifier &key) : m_key (key)
+    {};
+    PropagationPathIdentifier m_key; //!< identifier of the path
+    Ptr<const MobilityModel> m_srcMobility; //!< 1st node mobility model, kept alive by the cache
+    Ptr<const MobilityModel> m_dstMobility; //!< 2nd node mobility model, kept alive by the cache
+    Vector m_srcPosition; //!< position of the 1st node
+    Vector m_dstPosition; //!< position of the 2nd node
+    Ptr<T> m_data; //!< the data of the path
+  };
+
+  /// Typedef: paths from the most to the least recently used
+  typedef std::list<Path> PathList;
+  /// Typedef: PropagationPathIdentifier, position in the PathList
+  typedef std::unordered_map<PropagationPathIdentifier, typename PathList::iterator, PropagationPathHash> PathCache;
+
+  /**
+   * Evict the least recently used paths beyond the largest size
+   */
+  void Evict (void)
+  {
+    while (m_maxSize > 0 && m_pathList.size () > m_maxSize)
+      {
+        m_pathCache.erase (m_pathList.back ().m_key);
+        m_pathList.pop_back ();
+      }
+  };
+
+private:
+  bool m_symmetric; //!< whether a-->b and b-->a are the same path
+  uint32_t m_maxSize; //!< largest number of paths, or 0
+  double m_positionThreshold; //!< distance the nodes may move before a path expires [m], or negative
+  PathCache m_pathCache; //!< Path cache
+  PathList m_pathList; //!< paths from the most to the least recently used
+  uint64_t m_hits; //!< number of lookups which found the data of a path
+  uint64_t m_misses; //!< number of lookups which found no data
+};
+} // namespace ns3
+
+#endif // PROPAGATION_CACHE_H_
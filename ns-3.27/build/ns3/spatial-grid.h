@@ -0,0 +1,164 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+#ifndef SPATIAL_GRID_H
+#define SPATIAL_GRID_H
+
+#include "ns3/ptr.h"
+#include "ns3/vector.h"
+#include <stdint.h>
+#include <vector>
+#include <map>
+#include <unordered_map>
+
+namespace ns3 {
+
+class MobilityModel;
+
+/**
+ * \ingroup mobility
+ *
+ * \brief Index of MobilityModel instances on a uniform grid, to find
+ * the ones near a position without visiting all of them.
+ *
+ * Each MobilityModel is added with an identifier chosen by the
+ * caller, typically the index of the object it moves in a container
+ * of the caller.
+ *
+ * A ConstantPositionMobilityModel only moves when it is set a new
+ * position, which fires its CourseChange trace, so it is kept in the
+ * square cell holding its position and moved to another cell from
+ * that trace.  Any other model may move without notification, so it
+ * is checked at its current position on every query, as is an entry
+ * without a MobilityModel.
+ *
+ * The grid is two-dimensional: the cells extend along the z axis, but
+ * queries compare the distance in three dimensions.
+ */
+class SpatialGrid
+{
+public:
+  /**
+   * Create an empty grid.
+   *
+   * \param cellSize The side of the cells [m].  A query visits the
+   *        cells overlapping the square around its sphere, so the
+   *        distance of the queries is a good choice.
+   */
+  SpatialGrid (double cellSize);
+  ~SpatialGrid ();
+
+  /**
+   * \param cellSize The side of the cells [m].
+   *
+   * The grid must be empty.
+   */
+  void SetCellSize (double cellSize);
+  /**
+   * \return The side of the cells [m].
+   */
+  double GetCellSize (void) const;
+  /**
+   * \return The number of entries in the grid.
+   */
+  uint32_t GetN (void) const;
+
+  /**
+   * Add an entry to the grid.
+   *
+   * \param id The identifier reported by the queries for this entry.
+   * \param model The MobilityModel giving the position of the entry,
+   *        or null for an entry found by every query.
+   */
+  void Add (uint32_t id, Ptr<MobilityModel> model);
+  /**
+   * Remove all the entries.
+   */
+  void Clear (void);
+
+  /**
+   * Find the entries within a distance of a position.
+   *
+   * \param [in] position The center of the search.
+   * \param [in] distance The largest distance of an entry found [m].
+   * \param [out] ids The identifiers of the entries found, in
+   *        increasing order.  The vector is cleared first.
+   */
+  void Find (const Vector &position, double distance, std::vector<uint32_t> &ids) const;
+
+private:
+  /** An entry of the grid. */
+  struct Entry
+  {
+    uint32_t id;                //!< The identifier of the entry.
+    Ptr<MobilityModel> model;   //!< The mobility of the entry, if any.
+    Vector position;            //!< The position of a stationary entry.
+    uint64_t cell;              //!< The cell of a stationary entry.
+  };
+
+  /**
+   * \param x The x coordinate of the cell [cells].
+   * \param y The y coordinate of the cell [cells].
+   * \return The key of the cell in m_cells.
+   */
+  static uint64_t GetCellKey (int64_t x, int64_t y);
+  /**
+   * \param position A position.
+   * \return The key of the cell holding position.
+   */
+  uint64_t GetCellKey (const Vector &position) const;
+  /**
+   * Add the stationary entries of a cell within a distance of a
+   * position to a list.
+   *
+   * \param [in] entries The indices in m_entries of the entries of the cell.
+   * \param [in] position The center of the search.
+   * \param [in] distance The largest distance of an entry found [m].
+   * \param [out] ids The list to extend.
+   */
+  void FindInCell (const std::vector<uint32_t> &entries, const Vector &position,
+                   double distance, std::vector<uint32_t> &ids) const;
+  /**
+   * Move the entries of a stationary model which was given a new
+   * position to the cell of that position.
+   *
+   * \param model The model which fired its CourseChange trace.
+   */
+  void CourseChanged (Ptr<const MobilityModel> model);
+
+  /**
+   * Defined and unimplemented to avoid misuse: the grid is connected
+   * to the trace sources of its models.
+   */
+  SpatialGrid (const SpatialGrid &);
+  /**
+   * Defined and unimplemented to avoid misuse.
+   * \returns
+   */
+  SpatialGrid &operator = (const SpatialGrid &);
+
+  double m_cellSize;                   //!< The side of the cells.
+  std::vector<Entry> m_entries;        //!< All the entries.
+  /** The indices in m_entries of the stationary entries of each cell. */
+  std::unordered_map<uint64_t, std::vector<uint32_t> > m_cells;
+  /** The indices in m_entries of the entries which may move. */
+  std::vector<uint32_t> m_moving;
+  /** The indices in m_entries of the entries of each stationary model. */
+  std::multimap<const MobilityModel *, uint32_t> m_stationary;
+};
+
+} // namespace ns3
+
+#endif /* SPATIAL_GRID_H */
@@ -0,0 +1,170 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2007,2008,2009 INRIA, UDCAST
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Amine Ismail <amine.ismail@sophia.inria.fr>
+ *                      <amine.ismail@udcast.com>
+ *
+ */
+
+#ifndef UDP_CLIENT_H
+#define UDP_CLIENT_H
+
+#include "ns3/application.h"
+#include "ns3/event-id.h"
+#include "ns3/ptr.h"
+#include "ns3/ipv4-address.h"
+#include "ns3/traced-callback.h"
+#include <unordered_map>
+
+namespace ns3 {
+
+class Socket;
+class Packet;
+
+class FuzzyVar
+{
+public:
+	FuzzyVar(std::string nome, int32_t a, int32_t b);
+	void add_set(std::string name, int32_t a, int32_t b, int32_t c);
+	double activation(std::string set, double value);
+	std::vector<std::string> get_sets(void);
+	double get_limit_min(void) const;
+	double get_limit_max(void) const;
+
+protected:
+	std::string nome;
+	int32_t limits[2];
+	std::unordered_map<std::string, std::array<int32_t, 3>> sets;
+};
+
+class FuzzyVarIn: public FuzzyVar
+{
+public:
+	FuzzyVarIn(std::string nome, int32_t a, int32_t b);
+};
+
+class FuzzyVarOut: public FuzzyVar
+{
+public:
+	FuzzyVarOut(std::string nome, int32_t a, int32_t b);
+	void add_set(std::string name, int32_t a, int32_t b, int32_t c);
+	double activation(std::string set, double value);
+	void reset(std::string set);
+	void reset(void);
+	double get_u_max(std::string set);
+	void set_u_max(std::string set, double u);
+
+private:
+	std::unordered_map<std::string, double> u_max;
+	
+};
+
+class Fuzzy
+{
+public:
+	Fuzzy();
+	void set_vars(FuzzyVarIn *in1, FuzzyVarIn *in2, FuzzyVarOut *out);
+	void add_rule(std::string in1, std::string in2, std::string out);
+	double op_And(double x1, double x2);
+	double op_Agg(double x1, double x2);
+	double eval(double x1, double x2);
+
+private:
+	std::vector<std::array<std::string, 3>> rules;
+	FuzzyVarIn *in[2];
+	FuzzyVarOut *out;
+};
+
+/**
+ * \ingroup udpclientserver
+ *
+ * \brief A Udp client. Sends UDP packet carrying sequence number and time stamp
+ *  in their payloads
+ *
+ */
+class UdpClient : public Application
+{
+public:
+  /**
+   * \brief Get the type ID.
+   * \return the object TypeId
+   */
+  static TypeId GetTypeId (void);
+
+  UdpClient ();
+
+  virtual ~UdpClient ();
+
+  /**
+   * \brief set the remote address and port
+   * \param ip remote IP address
+   * \param port remote port
+   */
+  void SetRemote (Address ip, uint16_t port);
+  /**
+   * \brief set the remote address
+   * \param addr remote address
+   */
+  void SetRemote (Address addr);
+
+  typedef void (*DropCallback)(uint32_t, uint32_t);
+  typedef void (*DelayCallback)(double, double);
+
+protected:
+  virtual void DoDispose (void);
+
+private:
+
+  virtual void StartApplication (void);
+  virtual void StopApplication (void);
+
+  /**
+   * \brief Send a packet
+   */
+  void Send (void);
+
+  uint32_t m_count; //!< Maximum number of packets the application will send
+  Time m_interval; //!< Packet inter-send time
+  uint32_t m_size; //!< Size of the sent packet (including the SeqTsHeader)
+
+  uint32_t m_sent; //!< Counter for sent packets
+  Ptr<Socket> m_socket; //!< Socket
+  Address m_peerAddress; //!< Remote peer address
+  uint16_t m_peerPort; //!< Remote peer port
+  EventId m_sendEvent; //!< Event to send the next packet
+
+  void HandleRead (Ptr<Socket> socket);
+  void HandlePacket (Ptr<Packet> packet, Address &from);
+  void adjust_rate(uint32_t drops, double delay);
+  bool stopped;
+  bool enable_fuzzy;
+  bool enable_simple;
+
+  uint32_t drops_old;
+  uint32_t drops;
+  double delay_old;
+  double delay;
+  double delay_min;
+  double delay_tolerance;
+  TracedCallback<uint32_t, uint32_t> m_ReportDrops;
+  TracedCallback<double, double> m_ReportDelay;
+  Fuzzy fuzzy;
+};
+
+} // namespace ns3
+
+#endif /* UDP_CLIENT_H */
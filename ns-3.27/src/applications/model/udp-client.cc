@@ -34,6 +34,7 @@
 #include "seq-ts-header.h"
 #include <cstdlib>
 #include <cstdio>
+#include <array>
 
 namespace ns3 {
 
@@ -25,7 +25,10 @@
 #include "names.h"
 #include "pointer.h"
 #include "log.h"
+#include "trace-source-accessor.h"
 
+#include <algorithm>
+#include <map>
 #include <sstream>
 
 /**
@@ -150,6 +153,8 @@ MatchContainer::DisconnectWithoutContext (std::string name, const CallbackBase &
 /**
  * \ingroup config-impl
  * Helper to test if an array entry matches a config path specification.
+ *
+ * The specification is parsed once, when the matcher is constructed.
  */
 class ArrayMatcher
 {
@@ -167,7 +172,22 @@ public:
    * \returns \c true if the index matches the Config Path.
    */
   bool Matches (uint32_t i) const;
+  /**
+   * Get the matching indices, if there are not too many of them.
+   *
+   * \param [in] max The maximum number of indices wanted.
+   * \param [out] indices The matching indices, in increasing order.
+   * \returns \c true if at most \p max indices match, in which case
+   *          they have been stored in \p indices.
+   */
+  bool GetIndices (uint32_t max, std::vector<uint32_t> *indices) const;
 private:
+  /**
+   * Parse a Config path specification, or one of its alternatives.
+   *
+   * \param [in] element The Config path specification.
+   */
+  void Parse (std::string element);
   /**
    * Convert a string to an \c uint32_t.
    *
@@ -178,79 +198,120 @@ private:
   bool StringToUint32 (std::string str, uint32_t *value) const;
   /** The Config path element. */
   std::string m_element;
+  /** \c true if the element is, or has an alternative which is, "*". */
+  bool m_all;
+  /** The ranges of matching indices, both bounds included. */
+  std::vector<std::pair<uint32_t, uint32_t> > m_ranges;
 
 };  // class ArrayMatcher
 
 
 ArrayMatcher::ArrayMatcher (std::string element)
-  : m_element (element)
+  : m_element (element),
+    m_all (false)
 {
   NS_LOG_FUNCTION (this << element);
+  Parse (element);
 }
-bool
-ArrayMatcher::Matches (uint32_t i) const
+void
+ArrayMatcher::Parse (std::string element)
 {
-  NS_LOG_FUNCTION (this << i);
-  if (m_element == "*")
+  NS_LOG_FUNCTION (this << element);
+  if (element == "*")
     {
-      NS_LOG_DEBUG ("Array "<<i<<" matches *");
-      return true;
+      m_all = true;
+      return;
     }
   std::string::size_type tmp;
-  tmp = m_element.find ("|");
+  tmp = element.find ("|");
   if (tmp != std::string::npos)
     {
-      std::string left = m_element.substr (0, tmp-0);
-      std::string right = m_element.substr (tmp+1, m_element.size () - (tmp + 1));
-      ArrayMatcher matcher = ArrayMatcher (left);
-      if (matcher.Matches (i))
-        {
-          NS_LOG_DEBUG ("Array "<<i<<" matches "<<left);
-          return true;
-        }
-      matcher = ArrayMatcher (right);
-      if (matcher.Matches (i))
-        {
-          NS_LOG_DEBUG ("Array "<<i<<" matches "<<right);
-          return true;
-        }
-      NS_LOG_DEBUG ("Array "<<i<<" does not match "<<m_element);
-      return false;
+      std::string left = element.substr (0, tmp-0);
+      std::string right = element.substr (tmp+1, element.size () - (tmp + 1));
+      Parse (left);
+      Parse (right);
+      return;
     }
-  std::string::size_type leftBracket = m_element.find ("[");
-  std::string::size_type rightBracket = m_element.find ("]");
-  std::string::size_type dash = m_element.find ("-");
-  if (leftBracket == 0 && rightBracket == m_element.size () - 1 &&
+  std::string::size_type leftBracket = element.find ("[");
+  std::string::size_type rightBracket = element.find ("]");
+  std::string::size_type dash = element.find ("-");
+  if (leftBracket == 0 && rightBracket == element.size () - 1 &&
       dash > leftBracket && dash < rightBracket)
     {
-      std::string lowerBound = m_element.substr (leftBracket + 1, dash - (leftBracket + 1));
-      std::string upperBound = m_element.substr (dash + 1, rightBracket - (dash + 1));
+      std::string lowerBound = element.substr (leftBracket + 1, dash - (leftBracket + 1));
+      std::string upperBound = element.substr (dash + 1, rightBracket - (dash + 1));
       uint32_t min;
       uint32_t max;
       if (StringToUint32 (lowerBound, &min) && 
-          StringToUint32 (upperBound, &max) &&
-          i >= min && i <= max)
-        {
-          NS_LOG_DEBUG ("Array "<<i<<" matches "<<m_element);
-          return true;
-        }
-      else
+          StringToUint32 (upperBound, &max))
         {
-          NS_LOG_DEBUG ("Array "<<i<<" does not "<<m_element);
-          return false;
+          m_ranges.push_back (std::make_pair (min, max));
         }
+      return;
     }
   uint32_t value;
-  if (StringToUint32 (m_element, &value) &&
-      i == value)
+  if (StringToUint32 (element, &value))
+    {
+      m_ranges.push_back (std::make_pair (value, value));
+    }
+}
+bool
+ArrayMatcher::Matches (uint32_t i) const
+{
+  NS_LOG_FUNCTION (this << i);
+  if (m_all)
     {
       NS_LOG_DEBUG ("Array "<<i<<" matches "<<m_element);
       return true;
     }
+  for (std::vector<std::pair<uint32_t, uint32_t> >::const_iterator range = m_ranges.begin ();
+       range != m_ranges.end (); ++range)
+    {
+      if (i >= range->first && i <= range->second)
+        {
+          NS_LOG_DEBUG ("Array "<<i<<" matches "<<m_element);
+          return true;
+        }
+    }
   NS_LOG_DEBUG ("Array "<<i<<" does not match "<<m_element);
   return false;
 }
 
+bool
+ArrayMatcher::GetIndices (uint32_t max, std::vector<uint32_t> *indices) const
+{
+  NS_LOG_FUNCTION (this << max << indices);
+  if (m_all)
+    {
+      return false;
+    }
+  uint64_t n = 0;
+  for (std::vector<std::pair<uint32_t, uint32_t> >::const_iterator range = m_ranges.begin ();
+       range != m_ranges.end (); ++range)
+    {
+      if (range->first <= range->second)
+        {
+          n += static_cast<uint64_t> (range->second) - range->first + 1;
+        }
+    }
+  if (n > max)
+    {
+      return false;
+    }
+  indices->clear ();
+  for (std::vector<std::pair<uint32_t, uint32_t> >::const_iterator range = m_ranges.begin ();
+       range != m_ranges.end (); ++range)
+    {
+      for (uint64_t i = range->first; i <= range->second; i++)
+        {
+          indices->push_back (static_cast<uint32_t> (i));
+        }
+    }
+  std::sort (indices->begin (), indices->end ());
+  indices->erase (std::unique (indices->begin (), indices->end ()), indices->end ());
+  return true;
+}
+
 bool
 ArrayMatcher::StringToUint32 (std::string str, uint32_t *value) const
 {
@@ -261,6 +322,227 @@ ArrayMatcher::StringToUint32 (std::string str, uint32_t *value) const
   return !iss.bad () && !iss.fail ();
 }
 
+/**
+ * \ingroup config-impl
+ * An attribute through which a Config path can reach other objects.
+ */
+struct PathAttribute
+{
+  std::string name;                       //!< The attribute name.
+  Ptr<const AttributeAccessor> accessor;  //!< The attribute accessor.
+  bool hasGetter;                         //!< \c true if the attribute can be read.
+  bool isContainer;                       //!< \c true for an object container, \c false for a pointer.
+};
+
+/**
+ * \ingroup config-impl
+ * One segment of a Config path, parsed once.
+ */
+class PathSegment
+{
+public:
+  /**
+   * Construct from the text of the segment.
+   *
+   * \param [in] item The segment, without slashes.
+   */
+  PathSegment (std::string item);
+  /**
+   * Get the type named by a "$" segment.
+   *
+   * \returns The TypeId named by the segment.
+   */
+  TypeId GetTypeId (void) const;
+  /**
+   * Get the attributes of a type which match this segment.
+   *
+   * The answer is computed the first time each type is met,
+   * by searching the attributes of the type and of its parents.
+   *
+   * \param [in] tid The type of the object met on the path.
+   * \returns The matching pointer and object container attributes,
+   *          in declaration order, the type's own ones first.
+   */
+  const std::vector<PathAttribute> & GetAttributes (TypeId tid) const;
+
+  std::string m_item;      //!< The segment.
+  bool m_isObject;         //!< \c true for a "$" segment, which calls GetObject.
+  ArrayMatcher m_matcher;  //!< The segment parsed as an array index.
+
+private:
+  /** Container type of the attributes matching this segment, by type uid. */
+  typedef std::map<uint16_t, std::vector<PathAttribute> > AttributeMap;
+
+  mutable bool m_hasTid;             //!< \c true once m_tid has been found.
+  mutable TypeId m_tid;              //!< The type named by a "$" segment.
+  mutable AttributeMap m_attributes; //!< The attributes matching this segment.
+
+};  // class PathSegment
+
+PathSegment::PathSegment (std::string item)
+  : m_item (item),
+    m_isObject (item.find ("$") == 0),
+    m_matcher (item),
+    m_hasTid (false)
+{
+  NS_LOG_FUNCTION (this << item);
+  if (m_isObject)
+    {
+      // The type may be registered later, so it is looked up again,
+      // and reported if missing, when the segment is reached.
+      m_hasTid = TypeId::LookupByNameFailSafe (item.substr (1, item.size () - 1), &m_tid);
+    }
+}
+
+TypeId
+PathSegment::GetTypeId (void) const
+{
+  NS_LOG_FUNCTION (this);
+  NS_ASSERT (m_isObject);
+  if (!m_hasTid)
+    {
+      m_tid = TypeId::LookupByName (m_item.substr (1, m_item.size () - 1));
+      m_hasTid = true;
+    }
+  return m_tid;
+}
+
+const std::vector<PathAttribute> &
+PathSegment::GetAttributes (TypeId tid) const
+{
+  NS_LOG_FUNCTION (this << tid);
+  AttributeMap::const_iterator found = m_attributes.find (tid.GetUid ());
+  if (found != m_attributes.end ())
+    {
+      return found->second;
+    }
+  std::vector<PathAttribute> &attributes = m_attributes[tid.GetUid ()];
+  TypeId nextTid = tid;
+  do
+    {
+      tid = nextTid;
+      for (uint32_t i = 0; i < tid.GetAttributeN (); i++)
+        {
+          struct TypeId::AttributeInformation info;
+          info = tid.GetAttribute (i);
+          if (info.name != m_item && m_item != "*")
+            {
+              continue;
+            }
+          PathAttribute attribute;
+          attribute.name = info.name;
+          attribute.accessor = info.accessor;
+          attribute.hasGetter = (info.flags & TypeId::ATTR_GET) && info.accessor->HasGetter ();
+          // attempt to cast to a pointer checker.
+          if (dynamic_cast<const PointerChecker *> (PeekPointer (info.checker)) != 0)
+            {
+              attribute.isContainer = false;
+              attributes.push_back (attribute);
+            }
+          // attempt to cast to an object vector.
+          else if (dynamic_cast<const ObjectPtrContainerChecker *> (PeekPointer (info.checker)) != 0)
+            {
+              attribute.isContainer = true;
+              attributes.push_back (attribute);
+            }
+          // this could be anything else and we don't know what to do with it.
+          // So, we just ignore it.
+        }
+      nextTid = tid.GetParent ();
+    } while (nextTid != tid);
+  return attributes;
+}
+
+/**
+ * \ingroup config-impl
+ * A Config path split into its segments.
+ */
+class ParsedPath
+{
+public:
+  /**
+   * Construct from a Config path.
+   *
+   * \param [in] path The Config path.
+   */
+  ParsedPath (std::string path);
+  /**
+   * Get the Config path.
+   *
+   * \returns The Config path this object was constructed from.
+   */
+  std::string GetPath (void) const;
+  /**
+   * Get the number of segments.
+   *
+   * \returns The number of segments of the Config path.
+   */
+  uint32_t GetN (void) const;
+  /**
+   * Get one segment.
+   *
+   * \param [in] i The index of the segment, in [0,GetN()[.
+   * \returns The segment.
+   */
+  const PathSegment & Get (uint32_t i) const;
+
+private:
+  /** The Config path. */
+  std::string m_path;
+  /** The segments of the Config path. */
+  std::vector<PathSegment> m_segments;
+
+};  // class ParsedPath
+
+ParsedPath::ParsedPath (std::string path)
+  : m_path (path)
+{
+  NS_LOG_FUNCTION (this << path);
+
+  // ensure that we start and end with a '/'
+  std::string::size_type tmp = path.find ("/");
+  if (tmp != 0)
+    {
+      // no slash at start
+      path = "/" + path;
+    }
+  tmp = path.find_last_of ("/");
+  if (tmp != (path.size () - 1))
+    {
+      // no slash at end
+      path = path + "/";
+    }
+
+  std::string::size_type start = 0;
+  std::string::size_type next;
+  while ((next = path.find ("/", start + 1)) != std::string::npos)
+    {
+      m_segments.push_back (PathSegment (path.substr (start + 1, next - (start + 1))));
+      start = next;
+    }
+}
+
+std::string
+ParsedPath::GetPath (void) const
+{
+  NS_LOG_FUNCTION (this);
+  return m_path;
+}
+
+uint32_t
+ParsedPath::GetN (void) const
+{
+  NS_LOG_FUNCTION (this);
+  return m_segments.size ();
+}
+
+const PathSegment &
+ParsedPath::Get (uint32_t i) const
+{
+  NS_LOG_FUNCTION (this << i);
+  return m_segments[i];
+}
+
 /**
  * \ingroup config-impl
  * Abstract class to parse Config paths into object references.
@@ -271,9 +553,10 @@ public:
   /**
    * Construct from a base Config path.
    *
-   * \param [in] path The Config path.
+   * \param [in] path The parsed Config path, which must outlive
+   *                  this object.
    */
-  Resolver (std::string path);
+  Resolver (const ParsedPath &path);
   /** Destructor. */
   virtual ~Resolver ();
 
@@ -287,23 +570,32 @@ public:
   void Resolve (Ptr<Object> root);
   
 private:
-  /** Ensure the Config path starts and ends with a '/'. */
-  void Canonicalize (void);
   /**
    * Parse the next element in the Config path.
    *
-   * \param [in] path The remaining portion of the Config path.
+   * \param [in] segment The index of the next segment of the Config path.
    * \param [in] root The object corresponding to the current positon
    *                  in the Config path.
    */
-  void DoResolve (std::string path, Ptr<Object> root);
+  void DoResolve (uint32_t segment, Ptr<Object> root);
   /**
    * Parse an index on the Config path.
    *
-   * \param [in] path The remaining Config path.
-   * \param [in,out] vector The resulting list of matching objects.
+   * \param [in] segment The index of the segment holding the index.
+   * \param [in] root The object holding the container.
+   * \param [in] attribute The container attribute of \p root.
+   */
+  void DoArrayResolve (uint32_t segment, Ptr<Object> root,
+                       const PathAttribute &attribute);
+  /**
+   * Read an attribute leading to other objects.
+   *
+   * \param [in] object The object holding the attribute.
+   * \param [in] attribute The attribute.
+   * \param [out] value The attribute value.
    */
-  void DoArrayResolve (std::string path, const ObjectPtrContainerValue &vector);
+  void GetAttribute (Ptr<Object> object, const PathAttribute &attribute,
+                     AttributeValue &value) const;
   /**
    * Handle one object found on the path.
    *
@@ -327,46 +619,26 @@ private:
   /** Current list of path tokens. */
   std::vector<std::string> m_workStack;
   /** The Config path. */
-  std::string m_path;
+  const ParsedPath &m_path;
 
 };  // class Resolver
 
-Resolver::Resolver (std::string path)
+Resolver::Resolver (const ParsedPath &path)
   : m_path (path)
 {
-  NS_LOG_FUNCTION (this << path);
-  Canonicalize ();
+  NS_LOG_FUNCTION (this << path.GetPath ());
 }
 Resolver::~Resolver ()
 {
   NS_LOG_FUNCTION (this);
 }
-void
-Resolver::Canonicalize (void)
-{
-  NS_LOG_FUNCTION (this);
-
-  // ensure that we start and end with a '/'
-  std::string::size_type tmp = m_path.find ("/");
-  if (tmp != 0)
-    {
-      // no slash at start
-      m_path = "/" + m_path;
-    }
-  tmp = m_path.find_last_of ("/");
-  if (tmp != (m_path.size () - 1))
-    {
-      // no slash at end
-      m_path = m_path + "/";
-    }
-}
 
 void 
 Resolver::Resolve (Ptr<Object> root)
 {
   NS_LOG_FUNCTION (this << root);
 
-  DoResolve (m_path, root);
+  DoResolve (0, root);
 }
 
 std::string
@@ -392,13 +664,24 @@ Resolver::DoResolveOne (Ptr<Object> object)
 }
 
 void
-Resolver::DoResolve (std::string path, Ptr<Object> root)
+Resolver::GetAttribute (Ptr<Object> object, const PathAttribute &attribute,
+                        AttributeValue &value) const
 {
-  NS_LOG_FUNCTION (this << path << root);
-  NS_ASSERT ((path.find ("/")) == 0);
-  std::string::size_type next = path.find ("/", 1);
+  NS_LOG_FUNCTION (this << object << attribute.name << &value);
+  if (!attribute.hasGetter
+      || !attribute.accessor->Get (PeekPointer (object), value))
+    {
+      // let the object report the problem, or convert the value
+      object->GetAttribute (attribute.name, value);
+    }
+}
 
-  if (next == std::string::npos)
+void
+Resolver::DoResolve (uint32_t segment, Ptr<Object> root)
+{
+  NS_LOG_FUNCTION (this << segment << root);
+
+  if (segment == m_path.GetN ())
     {
       //
       // If root is zero, we're beginning to see if we can use the object name 
@@ -414,8 +697,8 @@ Resolver::DoResolve (std::string path, Ptr<Object> root)
         }
       return;
     }
-  std::string item = path.substr (1, next-1);
-  std::string pathLeft = path.substr (next, path.size ()-next);
+  const PathSegment &next = m_path.Get (segment);
+  const std::string &item = next.m_item;
 
   //
   // If root is zero, we're beginning to see if we can use the object name 
@@ -426,11 +709,10 @@ Resolver::DoResolve (std::string path, Ptr<Object> root)
   //
   if (root == 0)
     {
-      std::string::size_type offset = path.find ("/Names");
-      if (offset == 0)
+      if (item.compare (0, 5, "Names") == 0)
         {
           m_workStack.push_back (item);
-          DoResolve (pathLeft, root);
+          DoResolve (segment + 1, root);
           m_workStack.pop_back ();
           return;
         }
@@ -447,7 +729,7 @@ Resolver::DoResolve (std::string path, Ptr<Object> root)
     {
       NS_LOG_DEBUG ("Name system resolved item = " << item << " to " << namedObject);
       m_workStack.push_back (item);
-      DoResolve (pathLeft, namedObject);
+      DoResolve (segment + 1, namedObject);
       m_workStack.pop_back ();
       return;
     }
@@ -463,82 +745,58 @@ Resolver::DoResolve (std::string path, Ptr<Object> root)
     {
       return;
     }
-  std::string::size_type dollarPos = item.find ("$");
-  if (dollarPos == 0)
+  if (next.m_isObject)
     {
       // This is a call to GetObject
-      std::string tidString = item.substr (1, item.size () - 1);
-      NS_LOG_DEBUG ("GetObject="<<tidString<<" on path="<<GetResolvedPath ());
-      TypeId tid = TypeId::LookupByName (tidString);
-      Ptr<Object> object = root->GetObject<Object> (tid);
+      NS_LOG_DEBUG ("GetObject="<<item<<" on path="<<GetResolvedPath ());
+      Ptr<Object> object = root->GetObject<Object> (next.GetTypeId ());
       if (object == 0)
         {
-          NS_LOG_DEBUG ("GetObject ("<<tidString<<") failed on path="<<GetResolvedPath ());
+          NS_LOG_DEBUG ("GetObject ("<<item<<") failed on path="<<GetResolvedPath ());
           return;
         }
       m_workStack.push_back (item);
-      DoResolve (pathLeft, object);
+      DoResolve (segment + 1, object);
       m_workStack.pop_back ();
     }
   else 
     {
       // this is a normal attribute.
-      TypeId tid;
-      TypeId nextTid = root->GetInstanceTypeId ();
+      const std::vector<PathAttribute> &attributes =
+        next.GetAttributes (root->GetInstanceTypeId ());
       bool foundMatch = false;
-      
-      do
+
+      for (std::vector<PathAttribute>::const_iterator i = attributes.begin ();
+           i != attributes.end (); ++i)
         {
-          tid = nextTid;
-          
-          for (uint32_t i = 0; i < tid.GetAttributeN(); i++)
+          if (!i->isContainer)
             {
-              struct TypeId::AttributeInformation info;
-              info = tid.GetAttribute(i);
-              if (info.name != item && item != "*")
+              NS_LOG_DEBUG ("GetAttribute(ptr)="<<i->name<<" on path="<<GetResolvedPath ());
+              PointerValue ptr;
+              GetAttribute (root, *i, ptr);
+              Ptr<Object> object = ptr.Get<Object> ();
+              if (object == 0)
                 {
+                  NS_LOG_ERROR ("Requested object name=\""<<item<<
+                                "\" exists on path=\""<<GetResolvedPath ()<<"\""
+                                " but is null.");
                   continue;
                 }
-              // attempt to cast to a pointer checker.
-              const PointerChecker *ptr = dynamic_cast<const PointerChecker *> (PeekPointer (info.checker));
-              if (ptr != 0)
-                {
-                  NS_LOG_DEBUG ("GetAttribute(ptr)="<<info.name<<" on path="<<GetResolvedPath ());
-                  PointerValue ptr;
-                  root->GetAttribute (info.name, ptr);
-                  Ptr<Object> object = ptr.Get<Object> ();
-                  if (object == 0)
-                    {
-                      NS_LOG_ERROR ("Requested object name=\""<<item<<
-                                    "\" exists on path=\""<<GetResolvedPath ()<<"\""
-                                    " but is null.");
-                      continue;
-                    }
-                  foundMatch = true;
-                  m_workStack.push_back (info.name);
-                  DoResolve (pathLeft, object);
-                  m_workStack.pop_back ();
-                }
-              // attempt to cast to an object vector.
-              const ObjectPtrContainerChecker *vectorChecker = 
-                dynamic_cast<const ObjectPtrContainerChecker *> (PeekPointer (info.checker));
-              if (vectorChecker != 0)
-                {
-                  NS_LOG_DEBUG ("GetAttribute(vector)="<<info.name<<" on path="<<GetResolvedPath () << pathLeft);
-                  foundMatch = true;
-                  ObjectPtrContainerValue vector;
-                  root->GetAttribute (info.name, vector);
-                  m_workStack.push_back (info.name);
-                  DoArrayResolve (pathLeft, vector);
-                  m_workStack.pop_back ();
-                }
-              // this could be anything else and we don't know what to do with it.
-              // So, we just ignore it.
+              foundMatch = true;
+              m_workStack.push_back (i->name);
+              DoResolve (segment + 1, object);
+              m_workStack.pop_back ();
             }
+          else
+            {
+              NS_LOG_DEBUG ("GetAttribute(vector)="<<i->name<<" on path="<<GetResolvedPath ());
+              foundMatch = true;
+              m_workStack.push_back (i->name);
+              DoArrayResolve (segment + 1, root, *i);
+              m_workStack.pop_back ();
+            }
+        }
 
-          nextTid = tid.GetParent ();
-        } while (nextTid != tid);
-      
       if (!foundMatch)
         {
           NS_LOG_DEBUG ("Requested item="<<item<<" does not exist on path="<<GetResolvedPath ());
@@ -548,20 +806,61 @@ Resolver::DoResolve (std::string path, Ptr<Object> root)
 }
 
 void 
-Resolver::DoArrayResolve (std::string path, const ObjectPtrContainerValue &container)
+Resolver::DoArrayResolve (uint32_t segment, Ptr<Object> root,
+                          const PathAttribute &attribute)
 {
-  NS_LOG_FUNCTION(this << path << &container);
-  NS_ASSERT (path != "");
-  NS_ASSERT ((path.find ("/")) == 0);
-  std::string::size_type next = path.find ("/", 1);
-  if (next == std::string::npos)
+  NS_LOG_FUNCTION (this << segment << root << attribute.name);
+  if (segment == m_path.GetN ())
     {
       return;
     }
-  std::string item = path.substr (1, next-1);
-  std::string pathLeft = path.substr (next, path.size ()-next);
+  const PathSegment &next = m_path.Get (segment);
+  const ArrayMatcher &matcher = next.m_matcher;
+
+  //
+  // When a few indices are requested, as in "/NodeList/3", fetch only
+  // these items rather than a copy of the whole container.  This is
+  // valid only if the item at each requested position has that index,
+  // as is the case for containers indexed by position, and otherwise
+  // we fall back to a search of the whole container.
+  //
+  const ObjectPtrContainerAccessor *accessor =
+    dynamic_cast<const ObjectPtrContainerAccessor *> (PeekPointer (attribute.accessor));
+  uint32_t n;
+  std::vector<uint32_t> indices;
+  if (attribute.hasGetter && accessor != 0
+      && accessor->GetN (PeekPointer (root), &n)
+      && matcher.GetIndices (n, &indices)
+      && (indices.empty () || indices.back () < n))
+    {
+      std::vector<Ptr<Object> > items;
+      items.reserve (indices.size ());
+      for (std::vector<uint32_t>::const_iterator i = indices.begin (); i != indices.end (); ++i)
+        {
+          uint32_t index;
+          Ptr<Object> item = accessor->GetItem (PeekPointer (root), *i, &index);
+          if (index != *i)
+            {
+              break;
+            }
+          items.push_back (item);
+        }
+      if (items.size () == indices.size ())
+        {
+          for (uint32_t i = 0; i < items.size (); ++i)
+            {
+              std::ostringstream oss;
+              oss << indices[i];
+              m_workStack.push_back (oss.str ());
+              DoResolve (segment + 1, items[i]);
+              m_workStack.pop_back ();
+            }
+          return;
+        }
+    }
 
-  ArrayMatcher matcher = ArrayMatcher (item);
+  ObjectPtrContainerValue container;
+  GetAttribute (root, attribute, container);
   ObjectPtrContainerValue::Iterator it;
   for (it = container.Begin (); it != container.End (); ++it)
     {
@@ -570,7 +869,7 @@ Resolver::DoArrayResolve (std::string path, const ObjectPtrContainerValue &conta
           std::ostringstream oss;
           oss << (*it).first;
           m_workStack.push_back (oss.str ());
-          DoResolve (pathLeft, (*it).second);
+          DoResolve (segment + 1, (*it).second);
           m_workStack.pop_back ();
         }
     }
@@ -593,8 +892,16 @@ public:
   void DisconnectWithoutContext (std::string path, const CallbackBase &cb);
   /** \copydoc Config::Disconnect() */
   void Disconnect (std::string path, const CallbackBase &cb);
+  /** \copydoc Config::ConnectMany() */
+  void ConnectMany (const std::vector<std::pair<std::string, CallbackBase> > &connections);
   /** \copydoc Config::LookupMatches() */
   MatchContainer LookupMatches (std::string path);
+  /**
+   * \param [in] path The parsed path to perform a match against.
+   * \returns A container which contains all the objects which match
+   *          the input path.
+   */
+  MatchContainer LookupMatches (const ParsedPath &path);
 
   /** \copydoc Config::RegisterRootNamespaceObject() */
   void RegisterRootNamespaceObject (Ptr<Object> obj);
@@ -606,7 +913,6 @@ public:
   /** \copydoc Config::GetRootNamespaceObject() */
   Ptr<Object> GetRootNamespaceObject (uint32_t i) const;
 
-private:
   /**
    * Break a Config path into the leading path and the last leaf token.
    * \param [in] path The Config path.
@@ -616,6 +922,8 @@ private:
    */
   void ParsePath (std::string path, std::string *root, std::string *leaf) const;
 
+private:
+
   /** Container type to hold the root Config path tokens. */
   typedef std::vector<Ptr<Object> > Roots;
 
@@ -685,14 +993,42 @@ ConfigImpl::Disconnect (std::string path, const CallbackBase &cb)
   container.Disconnect (leaf, cb);
 }
 
+void
+ConfigImpl::ConnectMany (const std::vector<std::pair<std::string, CallbackBase> > &connections)
+{
+  NS_LOG_FUNCTION (this << &connections);
+
+  // Paths which differ only by their trace source share their matches.
+  std::map<std::string, MatchContainer> matches;
+  for (std::vector<std::pair<std::string, CallbackBase> >::const_iterator i = connections.begin ();
+       i != connections.end (); ++i)
+    {
+      std::string root, leaf;
+      ParsePath (i->first, &root, &leaf);
+      std::map<std::string, MatchContainer>::iterator match = matches.find (root);
+      if (match == matches.end ())
+        {
+          match = matches.insert (std::make_pair (root, LookupMatches (root))).first;
+        }
+      match->second.Connect (leaf, i->second);
+    }
+}
+
 MatchContainer 
 ConfigImpl::LookupMatches (std::string path)
 {
   NS_LOG_FUNCTION (this << path);
+  return LookupMatches (ParsedPath (path));
+}
+
+MatchContainer 
+ConfigImpl::LookupMatches (const ParsedPath &path)
+{
+  NS_LOG_FUNCTION (this << path.GetPath ());
   class LookupMatchesResolver : public Resolver 
   {
   public:
-    LookupMatchesResolver (std::string path)
+    LookupMatchesResolver (const ParsedPath &path)
       : Resolver (path)
     {}
     virtual void DoOne (Ptr<Object> object, std::string path)
@@ -715,7 +1051,7 @@ ConfigImpl::LookupMatches (std::string path)
   //
   resolver.Resolve (0);
 
-  return MatchContainer (resolver.m_objects, resolver.m_contexts, path);
+  return MatchContainer (resolver.m_objects, resolver.m_contexts, path.GetPath ());
 }
 
 void 
@@ -753,6 +1089,173 @@ ConfigImpl::GetRootNamespaceObject (uint32_t i) const
   return m_roots[i];
 }
 
+/**
+ * \ingroup config-impl
+ * The parsed path held by a CompiledPath, with the trace sources
+ * each type provides for its last segment.
+ */
+class CompiledPathImpl : public SimpleRefCount<CompiledPathImpl>
+{
+public:
+  /**
+   * Construct from a Config path.
+   *
+   * \param [in] path The Config path.
+   * \param [in] root The leading part of the \p path, up to the final slash.
+   * \param [in] leaf The trailing part of the \p path.
+   */
+  CompiledPathImpl (std::string path, std::string root, std::string leaf);
+  /**
+   * Get the trace source named by the last segment.
+   *
+   * \param [in] tid The type of an object matched by the path.
+   * \returns The trace source accessor, or zero if \p tid has no
+   *          such trace source.
+   */
+  Ptr<const TraceSourceAccessor> GetTraceSource (TypeId tid);
+
+  std::string m_path;  //!< The Config path.
+  ParsedPath m_root;   //!< The leading part of the Config path.
+  std::string m_leaf;  //!< The trailing part of the Config path.
+
+private:
+  /** Container type of the trace sources, by type uid. */
+  typedef std::map<uint16_t, Ptr<const TraceSourceAccessor> > TraceSourceMap;
+  /** The trace sources named by the last segment. */
+  TraceSourceMap m_traceSources;
+
+};  // class CompiledPathImpl
+
+CompiledPathImpl::CompiledPathImpl (std::string path, std::string root, std::string leaf)
+  : m_path (path),
+    m_root (root),
+    m_leaf (leaf)
+{
+  NS_LOG_FUNCTION (this << path << root << leaf);
+}
+
+Ptr<const TraceSourceAccessor>
+CompiledPathImpl::GetTraceSource (TypeId tid)
+{
+  NS_LOG_FUNCTION (this << tid);
+  TraceSourceMap::const_iterator found = m_traceSources.find (tid.GetUid ());
+  if (found != m_traceSources.end ())
+    {
+      return found->second;
+    }
+  Ptr<const TraceSourceAccessor> accessor = tid.LookupTraceSourceByName (m_leaf);
+  m_traceSources[tid.GetUid ()] = accessor;
+  return accessor;
+}
+
+CompiledPath::CompiledPath (std::string path)
+{
+  NS_LOG_FUNCTION (this << path);
+  std::string root, leaf;
+  ConfigImpl::Get ()->ParsePath (path, &root, &leaf);
+  m_impl = Create<CompiledPathImpl> (path, root, leaf);
+}
+CompiledPath::CompiledPath (const CompiledPath &o)
+  : m_impl (o.m_impl)
+{
+  NS_LOG_FUNCTION (this << &o);
+}
+CompiledPath &
+CompiledPath::operator = (const CompiledPath &o)
+{
+  NS_LOG_FUNCTION (this << &o);
+  m_impl = o.m_impl;
+  return *this;
+}
+CompiledPath::~CompiledPath ()
+{
+  NS_LOG_FUNCTION (this);
+}
+std::string
+CompiledPath::GetPath (void) const
+{
+  NS_LOG_FUNCTION (this);
+  return m_impl->m_path;
+}
+MatchContainer
+CompiledPath::LookupMatches (void) const
+{
+  NS_LOG_FUNCTION (this);
+  return ConfigImpl::Get ()->LookupMatches (m_impl->m_root);
+}
+void
+CompiledPath::Set (const AttributeValue &value) const
+{
+  NS_LOG_FUNCTION (this << &value);
+  LookupMatches ().Set (m_impl->m_leaf, value);
+}
+void
+CompiledPath::Connect (const CallbackBase &cb) const
+{
+  NS_LOG_FUNCTION (this << &cb);
+  MatchContainer container = LookupMatches ();
+  for (uint32_t i = 0; i < container.GetN (); ++i)
+    {
+      Ptr<Object> object = container.Get (i);
+      Ptr<const TraceSourceAccessor> accessor =
+        m_impl->GetTraceSource (object->GetInstanceTypeId ());
+      if (accessor != 0)
+        {
+          accessor->Connect (PeekPointer (object),
+                             container.GetMatchedPath (i) + m_impl->m_leaf, cb);
+        }
+    }
+}
+void
+CompiledPath::ConnectWithoutContext (const CallbackBase &cb) const
+{
+  NS_LOG_FUNCTION (this << &cb);
+  MatchContainer container = LookupMatches ();
+  for (uint32_t i = 0; i < container.GetN (); ++i)
+    {
+      Ptr<Object> object = container.Get (i);
+      Ptr<const TraceSourceAccessor> accessor =
+        m_impl->GetTraceSource (object->GetInstanceTypeId ());
+      if (accessor != 0)
+        {
+          accessor->ConnectWithoutContext (PeekPointer (object), cb);
+        }
+    }
+}
+void
+CompiledPath::Disconnect (const CallbackBase &cb) const
+{
+  NS_LOG_FUNCTION (this << &cb);
+  MatchContainer container = LookupMatches ();
+  for (uint32_t i = 0; i < container.GetN (); ++i)
+    {
+      Ptr<Object> object = container.Get (i);
+      Ptr<const TraceSourceAccessor> accessor =
+        m_impl->GetTraceSource (object->GetInstanceTypeId ());
+      if (accessor != 0)
+        {
+          accessor->Disconnect (PeekPointer (object),
+                                container.GetMatchedPath (i) + m_impl->m_leaf, cb);
+        }
+    }
+}
+void
+CompiledPath::DisconnectWithoutContext (const CallbackBase &cb) const
+{
+  NS_LOG_FUNCTION (this << &cb);
+  MatchContainer container = LookupMatches ();
+  for (uint32_t i = 0; i < container.GetN (); ++i)
+    {
+      Ptr<Object> object = container.Get (i);
+      Ptr<const TraceSourceAccessor> accessor =
+        m_impl->GetTraceSource (object->GetInstanceTypeId ());
+      if (accessor != 0)
+        {
+          accessor->DisconnectWithoutContext (PeekPointer (object), cb);
+        }
+    }
+}
+
 
 void Reset (void)
 {
@@ -851,6 +1354,12 @@ Disconnect (std::string path, const CallbackBase &cb)
   NS_LOG_FUNCTION (path << &cb);
   ConfigImpl::Get ()->Disconnect (path, cb);
 }
+void
+ConnectMany (const std::vector<std::pair<std::string, CallbackBase> > &connections)
+{
+  NS_LOG_FUNCTION (&connections);
+  ConfigImpl::Get ()->ConnectMany (connections);
+}
 MatchContainer LookupMatches (std::string path)
 {
   NS_LOG_FUNCTION (path);
@@ -22,6 +22,7 @@
 
 #include "ptr.h"
 #include <string>
+#include <utility>
 #include <vector>
 
 /**
@@ -140,6 +141,18 @@ void Connect (std::string path, const CallbackBase &cb);
  */
 void Disconnect (std::string path, const CallbackBase &cb);
 
+/**
+ * \ingroup config
+ * \param [in] connections Pairs of a path to match trace sources
+ *             and of the callback to connect to them.
+ *
+ * This function is equivalent to calling Config::Connect on each
+ * pair, except that the objects holding the trace sources are
+ * searched only once for all the paths which differ only by their
+ * trace source name.
+ */
+void ConnectMany (const std::vector<std::pair<std::string, CallbackBase> > &connections);
+
 /**
  * \ingroup config
  * \brief hold a set of objects which match a specific search string.
@@ -258,6 +271,84 @@ private:
  */
 MatchContainer LookupMatches (std::string path);
 
+class CompiledPathImpl;
+
+/**
+ * \ingroup config
+ * \brief A path parsed once, to be matched many times.
+ *
+ * Config::Set, Config::Connect and the other functions taking a
+ * path parse it on each call.  A CompiledPath splits the path and
+ * parses its array indices once, when constructed, and remembers
+ * which attributes and trace sources each TypeId met on the path
+ * provides, so that later matches only walk the objects.  This is
+ * useful when the same path is set or connected repeatedly, or when
+ * the objects it matches are created after it is compiled.
+ *
+ * The path is matched against the root namespace objects and the
+ * object names registered when each method is called.
+ */
+class CompiledPath
+{
+public:
+  /**
+   * \param [in] path A path to match attributes or trace sources.
+   */
+  CompiledPath (std::string path);
+  /**
+   * \param [in] o The path to copy.
+   */
+  CompiledPath (const CompiledPath &o);
+  /**
+   * \param [in] o The path to copy.
+   * \returns This path.
+   */
+  CompiledPath &operator = (const CompiledPath &o);
+  ~CompiledPath ();
+
+  /**
+   * \returns The path this object was constructed from.
+   */
+  std::string GetPath (void) const;
+  /**
+   * \returns A container with all the objects holding the attribute
+   *          or trace source named by the last segment of the path.
+   */
+  MatchContainer LookupMatches (void) const;
+
+  /**
+   * \param [in] value The value to set in all matching attributes.
+   * \sa ns3::Config::Set
+   */
+  void Set (const AttributeValue &value) const;
+  /**
+   * \param [in] cb The callback to connect to the matching trace sources.
+   * \sa ns3::Config::Connect
+   */
+  void Connect (const CallbackBase &cb) const;
+  /**
+   * \param [in] cb The callback to connect to the matching trace sources.
+   * \sa ns3::Config::ConnectWithoutContext
+   */
+  void ConnectWithoutContext (const CallbackBase &cb) const;
+  /**
+   * \param [in] cb The callback to disconnect from the matching
+   *            trace sources.
+   * \sa ns3::Config::Disconnect
+   */
+  void Disconnect (const CallbackBase &cb) const;
+  /**
+   * \param [in] cb The callback to disconnect from the matching
+   *            trace sources.
+   * \sa ns3::Config::DisconnectWithoutContext
+   */
+  void DisconnectWithoutContext (const CallbackBase &cb) const;
+
+private:
+  /** The parsed path and its caches. */
+  Ptr<CompiledPathImpl> m_impl;
+};
+
 /**
  * \ingroup config
  * \param [in] obj A new root object
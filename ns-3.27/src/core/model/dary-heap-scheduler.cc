@@ -0,0 +1,280 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2017
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "dary-heap-scheduler.h"
+#include "event-impl.h"
+#include "assert.h"
+#include "log.h"
+#include <algorithm>
+
+/**
+ * \file
+ * \ingroup scheduler
+ * Implementation of ns3::DaryHeapScheduler class.
+ */
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("DaryHeapScheduler");
+
+NS_OBJECT_ENSURE_REGISTERED (DaryHeapScheduler);
+
+TypeId
+DaryHeapScheduler::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::DaryHeapScheduler")
+    .SetParent<Scheduler> ()
+    .SetGroupName ("Core")
+    .AddConstructor<DaryHeapScheduler> ()
+  ;
+  return tid;
+}
+
+DaryHeapScheduler::DaryHeapScheduler ()
+{
+  NS_LOG_FUNCTION (this);
+  IndexEntry empty = { 0, NO_POSITION};
+  m_index.resize (64, empty);
+  m_indexMask = m_index.size () - 1;
+  m_indexShift = 32 - 6;
+}
+
+DaryHeapScheduler::~DaryHeapScheduler ()
+{
+  NS_LOG_FUNCTION (this);
+}
+
+uint32_t
+DaryHeapScheduler::IndexHome (uint32_t uid) const
+{
+  // Knuth's multiplicative hash, keeping the top bits of the product.
+  return (uid * 2654435769U) >> m_indexShift;
+}
+
+uint32_t
+DaryHeapScheduler::IndexFind (uint32_t uid) const
+{
+  uint32_t slot = IndexHome (uid);
+  while (m_index[slot].uid != uid || m_index[slot].position == NO_POSITION)
+    {
+      NS_ASSERT (m_index[slot].position != NO_POSITION);
+      slot = (slot + 1) & m_indexMask;
+    }
+  return slot;
+}
+
+void
+DaryHeapScheduler::IndexInsert (uint32_t uid, uint32_t position)
+{
+  NS_LOG_FUNCTION (this << uid << position);
+  // keep the load factor below one half so that probe sequences stay short.
+  if ((m_heap.size () + 1) * 2 > m_index.size ())
+    {
+      IndexGrow ();
+    }
+  uint32_t slot = IndexHome (uid);
+  while (m_index[slot].position != NO_POSITION)
+    {
+      slot = (slot + 1) & m_indexMask;
+    }
+  m_index[slot].uid = uid;
+  m_index[slot].position = position;
+}
+
+void
+DaryHeapScheduler::IndexErase (uint32_t uid)
+{
+  NS_LOG_FUNCTION (this << uid);
+  uint32_t hole = IndexFind (uid);
+  uint32_t slot = hole;
+  // backward-shift deletion: move up every following entry of the
+  // probe run which would otherwise become unreachable.
+  while (true)
+    {
+      slot = (slot + 1) & m_indexMask;
+      if (m_index[slot].position == NO_POSITION)
+        {
+          break;
+        }
+      uint32_t home = IndexHome (m_index[slot].uid);
+      bool reachable;
+      if (hole <= slot)
+        {
+          reachable = hole < home && home <= slot;
+        }
+      else
+        {
+          reachable = hole < home || home <= slot;
+        }
+      if (!reachable)
+        {
+          m_index[hole] = m_index[slot];
+          hole = slot;
+        }
+    }
+  m_index[hole].position = NO_POSITION;
+}
+
+void
+DaryHeapScheduler::IndexGrow (void)
+{
+  NS_LOG_FUNCTION (this);
+  IndexEntry empty = { 0, NO_POSITION};
+  std::vector<IndexEntry> old (m_index.size () * 2, empty);
+  old.swap (m_index);
+  m_indexMask = m_index.size () - 1;
+  m_indexShift--;
+  for (std::vector<IndexEntry>::const_iterator i = old.begin (); i != old.end (); ++i)
+    {
+      if (i->position == NO_POSITION)
+        {
+          continue;
+        }
+      uint32_t slot = IndexHome (i->uid);
+      while (m_index[slot].position != NO_POSITION)
+        {
+          slot = (slot + 1) & m_indexMask;
+        }
+      m_index[slot] = *i;
+    }
+}
+
+void
+DaryHeapScheduler::Place (uint32_t position, const Scheduler::Event &ev)
+{
+  m_heap[position] = ev;
+  m_index[IndexFind (ev.key.m_uid)].position = position;
+}
+
+void
+DaryHeapScheduler::SiftUp (uint32_t position)
+{
+  NS_LOG_FUNCTION (this << position);
+  Scheduler::Event ev = m_heap[position];
+  while (position > 0)
+    {
+      uint32_t parent = (position - 1) / ARITY;
+      if (!(ev.key < m_heap[parent].key))
+        {
+          break;
+        }
+      Place (position, m_heap[parent]);
+      position = parent;
+    }
+  Place (position, ev);
+}
+
+void
+DaryHeapScheduler::SiftDown (uint32_t position)
+{
+  NS_LOG_FUNCTION (this << position);
+  uint32_t size = m_heap.size ();
+  Scheduler::Event ev = m_heap[position];
+  while (true)
+    {
+      uint32_t first = position * ARITY + 1;
+      if (first >= size)
+        {
+          break;
+        }
+      uint32_t last = std::min (first + ARITY, size);
+      uint32_t smallest = first;
+      for (uint32_t child = first + 1; child < last; ++child)
+        {
+          if (m_heap[child].key < m_heap[smallest].key)
+            {
+              smallest = child;
+            }
+        }
+      if (!(m_heap[smallest].key < ev.key))
+        {
+          break;
+        }
+      Place (position, m_heap[smallest]);
+      position = smallest;
+    }
+  Place (position, ev);
+}
+
+void
+DaryHeapScheduler::Insert (const Event &ev)
+{
+  NS_LOG_FUNCTION (this << ev.impl << ev.key.m_ts << ev.key.m_uid);
+  IndexInsert (ev.key.m_uid, m_heap.size ());
+  m_heap.push_back (ev);
+  SiftUp (m_heap.size () - 1);
+}
+
+bool
+DaryHeapScheduler::IsEmpty (void) const
+{
+  NS_LOG_FUNCTION (this);
+  return m_heap.empty ();
+}
+
+Scheduler::Event
+DaryHeapScheduler::PeekNext (void) const
+{
+  NS_LOG_FUNCTION (this);
+  NS_ASSERT (!m_heap.empty ());
+  return m_heap.front ();
+}
+
+Scheduler::Event
+DaryHeapScheduler::RemoveNext (void)
+{
+  NS_LOG_FUNCTION (this);
+  NS_ASSERT (!m_heap.empty ());
+  Scheduler::Event next = m_heap.front ();
+  IndexErase (next.key.m_uid);
+  Scheduler::Event last = m_heap.back ();
+  m_heap.pop_back ();
+  if (!m_heap.empty ())
+    {
+      m_heap.front () = last;
+      SiftDown (0);
+    }
+  return next;
+}
+
+void
+DaryHeapScheduler::Remove (const Event &ev)
+{
+  NS_LOG_FUNCTION (this << ev.impl << ev.key.m_ts << ev.key.m_uid);
+  uint32_t position = m_index[IndexFind (ev.key.m_uid)].position;
+  NS_ASSERT (m_heap[position].impl == ev.impl);
+  IndexErase (ev.key.m_uid);
+  Scheduler::Event last = m_heap.back ();
+  m_heap.pop_back ();
+  if (position == m_heap.size ())
+    {
+      // the removed event was the last one of the array.
+      return;
+    }
+  m_heap[position] = last;
+  if (position > 0 && last.key < m_heap[(position - 1) / ARITY].key)
+    {
+      SiftUp (position);
+    }
+  else
+    {
+      SiftDown (position);
+    }
+}
+
+} // namespace ns3
@@ -25,10 +25,14 @@
 
 #include "ptr.h"
 #include "pointer.h"
+#include "boolean.h"
+#include "double.h"
+#include "uinteger.h"
 #include "assert.h"
 #include "log.h"
 
 #include <cmath>
+#include <vector>
 
 
 /**
@@ -46,6 +50,8 @@ NS_LOG_COMPONENT_DEFINE ("DefaultSimulatorImpl");
 
 NS_OBJECT_ENSURE_REGISTERED (DefaultSimulatorImpl);
 
+std::atomic<DefaultSimulatorImpl::EventWithContext *> DefaultSimulatorImpl::g_freeEventsWithContext (0);
+
 TypeId
 DefaultSimulatorImpl::GetTypeId (void)
 {
@@ -53,6 +59,25 @@ DefaultSimulatorImpl::GetTypeId (void)
     .SetParent<SimulatorImpl> ()
     .SetGroupName ("Core")
     .AddConstructor<DefaultSimulatorImpl> ()
+    .AddAttribute ("LazyRemove",
+                   "If true, Simulator::Remove only cancels the event, which "
+                   "then stays in the event list as a tombstone until it "
+                   "expires or the list is compacted.",
+                   BooleanValue (false),
+                   MakeBooleanAccessor (&DefaultSimulatorImpl::m_lazyRemove),
+                   MakeBooleanChecker ())
+    .AddAttribute ("MaxTombstoneRatio",
+                   "With LazyRemove, the fraction of cancelled events in the "
+                   "event list above which all of them are purged at once.",
+                   DoubleValue (0.5),
+                   MakeDoubleAccessor (&DefaultSimulatorImpl::m_maxTombstoneRatio),
+                   MakeDoubleChecker<double> (0.0, 1.0))
+    .AddAttribute ("MinTombstones",
+                   "With LazyRemove, the minimum number of cancelled events "
+                   "in the event list before it is compacted.",
+                   UintegerValue (1024),
+                   MakeUintegerAccessor (&DefaultSimulatorImpl::m_minTombstones),
+                   MakeUintegerChecker<uint32_t> (1))
   ;
   return tid;
 }
@@ -71,7 +96,12 @@ DefaultSimulatorImpl::DefaultSimulatorImpl ()
   m_currentTs = 0;
   m_currentContext = Simulator::NO_CONTEXT;
   m_unscheduledEvents = 0;
-  m_eventsWithContextEmpty = true;
+  m_tombstones = 0;
+  m_compactions = 0;
+  m_compactedEvents = 0;
+  m_eventsWithContextStub.next.store (0, std::memory_order_relaxed);
+  m_eventsWithContextHead.store (&m_eventsWithContextStub, std::memory_order_relaxed);
+  m_eventsWithContextTail = &m_eventsWithContextStub;
   m_main = SystemThread::Self();
 }
 
@@ -125,6 +155,7 @@ DefaultSimulatorImpl::SetScheduler (ObjectFactory schedulerFactory)
         }
     }
   m_events = scheduler;
+  m_schedulerFactory = schedulerFactory;
 }
 
 // System ID for non-distributed simulation is always zero
@@ -141,6 +172,11 @@ DefaultSimulatorImpl::ProcessOneEvent (void)
 
   NS_ASSERT (next.key.m_ts >= m_currentTs);
   m_unscheduledEvents--;
+  if (next.impl->IsCancelled ())
+    {
+      NS_ASSERT (m_tombstones > 0);
+      m_tombstones--;
+    }
 
   NS_LOG_LOGIC ("handle " << next.key.m_ts);
   m_currentTs = next.key.m_ts;
@@ -158,33 +194,115 @@ DefaultSimulatorImpl::IsFinished (void) const
   return m_events->IsEmpty () || m_stop;
 }
 
+DefaultSimulatorImpl::EventWithContext *
+DefaultSimulatorImpl::AllocateEventWithContext (void)
+{
+  // Each thread takes the whole free list at once, which is immune to
+  // the ABA problem of popping single nodes, and then draws from it.
+  static thread_local EventWithContext *cache = 0;
+  if (cache == 0)
+    {
+      cache = g_freeEventsWithContext.exchange (0, std::memory_order_acquire);
+      if (cache == 0)
+        {
+          return new EventWithContext;
+        }
+    }
+  EventWithContext *node = cache;
+  cache = node->next.load (std::memory_order_relaxed);
+  return node;
+}
+
+void
+DefaultSimulatorImpl::FreeEventsWithContext (EventWithContext *first, EventWithContext *last)
+{
+  EventWithContext *head = g_freeEventsWithContext.load (std::memory_order_relaxed);
+  do
+    {
+      last->next.store (head, std::memory_order_relaxed);
+    }
+  while (!g_freeEventsWithContext.compare_exchange_weak (head, first,
+                                                         std::memory_order_release,
+                                                         std::memory_order_relaxed));
+}
+
+void
+DefaultSimulatorImpl::PushEventWithContext (EventWithContext *node)
+{
+  node->next.store (0, std::memory_order_relaxed);
+  EventWithContext *prev = m_eventsWithContextHead.exchange (node, std::memory_order_acq_rel);
+  // until this store, the consumer sees the queue as ending at prev.
+  prev->next.store (node, std::memory_order_release);
+}
+
+DefaultSimulatorImpl::EventWithContext *
+DefaultSimulatorImpl::PopEventWithContext (void)
+{
+  EventWithContext *tail = m_eventsWithContextTail;
+  EventWithContext *next = tail->next.load (std::memory_order_acquire);
+  if (tail == &m_eventsWithContextStub)
+    {
+      if (next == 0)
+        {
+          return 0;
+        }
+      m_eventsWithContextTail = next;
+      tail = next;
+      next = next->next.load (std::memory_order_acquire);
+    }
+  if (next != 0)
+    {
+      m_eventsWithContextTail = next;
+      return tail;
+    }
+  if (tail != m_eventsWithContextHead.load (std::memory_order_acquire))
+    {
+      // a producer is between its exchange and its link.
+      return 0;
+    }
+  // tail is the last node: enqueue the stub behind it to release it.
+  PushEventWithContext (&m_eventsWithContextStub);
+  next = tail->next.load (std::memory_order_acquire);
+  if (next != 0)
+    {
+      m_eventsWithContextTail = next;
+      return tail;
+    }
+  return 0;
+}
+
 void
 DefaultSimulatorImpl::ProcessEventsWithContext (void)
 {
-  if (m_eventsWithContextEmpty)
+  if (m_eventsWithContextHead.load (std::memory_order_acquire) == m_eventsWithContextTail)
     {
       return;
     }
 
-  // swap queues
-  EventsWithContext eventsWithContext;
-  {
-    CriticalSection cs (m_eventsWithContextMutex);
-    m_eventsWithContext.swap(eventsWithContext);
-    m_eventsWithContextEmpty = true;
-  }
-  while (!eventsWithContext.empty ())
+  EventWithContext *first = 0;
+  EventWithContext *last = 0;
+  EventWithContext *event;
+  while ((event = PopEventWithContext ()) != 0)
     {
-       EventWithContext event = eventsWithContext.front ();
-       eventsWithContext.pop_front ();
-       Scheduler::Event ev;
-       ev.impl = event.event;
-       ev.key.m_ts = m_currentTs + event.timestamp;
-       ev.key.m_context = event.context;
-       ev.key.m_uid = m_uid;
-       m_uid++;
-       m_unscheduledEvents++;
-       m_events->Insert (ev);
+      Scheduler::Event ev;
+      ev.impl = event->event;
+      ev.key.m_ts = m_currentTs + event->timestamp;
+      ev.key.m_context = event->context;
+      ev.key.m_uid = m_uid;
+      m_uid++;
+      m_unscheduledEvents++;
+      m_events->Insert (ev);
+      // chain the consumed nodes to free them all at once.
+      event->next.store (first, std::memory_order_relaxed);
+      if (first == 0)
+        {
+          last = event;
+        }
+      first = event;
+    }
+  if (first != 0)
+    {
+      FreeEventsWithContext (first, last);
     }
 }
 
@@ -264,16 +382,12 @@ DefaultSimulatorImpl::ScheduleWithContext (uint32_t context, Time const &delay,
     }
   else
     {
-      EventWithContext ev;
-      ev.context = context;
+      EventWithContext *ev = AllocateEventWithContext ();
+      ev->context = context;
       // Current time added in ProcessEventsWithContext()
-      ev.timestamp = delay.GetTimeStep ();
-      ev.event = event;
-      {
-        CriticalSection cs (m_eventsWithContextMutex);
-        m_eventsWithContext.push_back(ev);
-        m_eventsWithContextEmpty = false;
-      }
+      ev->timestamp = delay.GetTimeStep ();
+      ev->event = event;
+      PushEventWithContext (ev);
     }
 }
 
@@ -344,6 +458,12 @@ DefaultSimulatorImpl::Remove (const EventId &id)
     {
       return;
     }
+  if (m_lazyRemove)
+    {
+      id.PeekEventImpl ()->Cancel ();
+      NotifyCancelled ();
+      return;
+    }
   Scheduler::Event event;
   event.impl = id.PeekEventImpl ();
   event.key.m_ts = id.GetTs ();
@@ -363,7 +483,77 @@ DefaultSimulatorImpl::Cancel (const EventId &id)
   if (!IsExpired (id))
     {
       id.PeekEventImpl ()->Cancel ();
+      NotifyCancelled ();
+    }
+}
+
+void
+DefaultSimulatorImpl::NotifyCancelled (void)
+{
+  m_tombstones++;
+  if (m_lazyRemove
+      && m_tombstones >= m_minTombstones
+      && m_tombstones > m_maxTombstoneRatio * m_unscheduledEvents)
+    {
+      CompactEvents ();
+    }
+}
+
+void
+DefaultSimulatorImpl::CompactEvents (void)
+{
+  NS_LOG_FUNCTION (this << m_tombstones << m_unscheduledEvents);
+  // Drain the event list in order, moving only the live events to a
+  // new event list: sorted insertion is the cheapest case for most
+  // schedulers and this works with any of them. The drained event list
+  // is not reused, since some schedulers, such as CalendarScheduler,
+  // expect the events inserted after a RemoveNext to be later.
+  Ptr<Scheduler> events = m_schedulerFactory.Create<Scheduler> ();
+  while (!m_events->IsEmpty ())
+    {
+      Scheduler::Event next = m_events->RemoveNext ();
+      if (next.impl->IsCancelled ())
+        {
+          next.impl->Unref ();
+          m_unscheduledEvents--;
+          m_compactedEvents++;
+        }
+      else
+        {
+          events->Insert (next);
+        }
+    }
+  m_events = events;
+  m_tombstones = 0;
+  m_compactions++;
+}
+
+uint32_t
+DefaultSimulatorImpl::GetTombstoneCount (void) const
+{
+  return m_tombstones;
+}
+
+double
+DefaultSimulatorImpl::GetTombstoneRatio (void) const
+{
+  if (m_unscheduledEvents == 0)
+    {
+      return 0.0;
     }
+  return static_cast<double> (m_tombstones) / m_unscheduledEvents;
+}
+
+uint32_t
+DefaultSimulatorImpl::GetCompactionCount (void) const
+{
+  return m_compactions;
+}
+
+uint64_t
+DefaultSimulatorImpl::GetCompactedEventCount (void) const
+{
+  return m_compactedEvents;
 }
 
 bool
@@ -25,10 +25,10 @@
 #include "scheduler.h"
 #include "event-impl.h"
 #include "system-thread.h"
-#include "system-mutex.h"
 
 #include "ptr.h"
 
+#include <atomic>
 #include <list>
 
 /**
@@ -78,6 +78,31 @@ public:
   virtual uint32_t GetSystemId (void) const; 
   virtual uint32_t GetContext (void) const;
 
+  /**
+   * Get the number of cancelled events still held in the event list.
+   *
+   * \returns The number of tombstones.
+   */
+  uint32_t GetTombstoneCount (void) const;
+  /**
+   * Get the fraction of the event list occupied by cancelled events.
+   *
+   * \returns The ratio of tombstones to pending events.
+   */
+  double GetTombstoneRatio (void) const;
+  /**
+   * Get the number of bulk compactions of the event list.
+   *
+   * \returns The number of compactions.
+   */
+  uint32_t GetCompactionCount (void) const;
+  /**
+   * Get the total number of tombstones discarded by compactions.
+   *
+   * \returns The number of compacted events.
+   */
+  uint64_t GetCompactedEventCount (void) const;
+
 private:
   virtual void DoDispose (void);
 
@@ -85,8 +110,24 @@ private:
   void ProcessOneEvent (void);
   /** Move events from a different context into the main event queue. */
   void ProcessEventsWithContext (void);
+  /**
+   * Account for a newly cancelled event, compacting the event list
+   * if the tombstones exceed the configured threshold.
+   */
+  void NotifyCancelled (void);
+  /** Purge all the cancelled events from the event list. */
+  void CompactEvents (void);
  
-  /** Wrap an event with its execution context. */
+  /**
+   * Wrap an event with its execution context.
+   *
+   * The events scheduled from other threads are passed to the main
+   * thread through an intrusive multiple producer, single consumer
+   * queue of these nodes (D. Vyukov's algorithm): a producer
+   * enqueues with a single atomic exchange, and never waits on the
+   * consumer. The nodes are recycled through a free list shared by
+   * all the simulator instances.
+   */
   struct EventWithContext {
     /** The event context. */
     uint32_t context;
@@ -94,18 +135,44 @@ private:
     uint64_t timestamp;
     /** The event implementation. */
     EventImpl *event;
+    /** The next node in the queue or in the free list. */
+    std::atomic<EventWithContext *> next;
   };
-  /** Container type for the events from a different context. */
-  typedef std::list<struct EventWithContext> EventsWithContext;
-  /** The container of events from a different context. */
-  EventsWithContext m_eventsWithContext;
   /**
-   * Flag \c true if all events with context have been moved to the
-   * primary event queue.
+   * Get a node from the free list, or allocate a new one.
+   *
+   * \returns A node for an event with context.
+   */
+  static EventWithContext * AllocateEventWithContext (void);
+  /**
+   * Return a chain of nodes to the free list.
+   *
+   * \param [in] first The first node of the chain.
+   * \param [in] last The last node of the chain.
    */
-  bool m_eventsWithContextEmpty;
-  /** Mutex to control access to the list of events with context. */
-  SystemMutex m_eventsWithContextMutex;
+  static void FreeEventsWithContext (EventWithContext *first, EventWithContext *last);
+  /**
+   * Enqueue a node, from any thread.
+   *
+   * \param [in] node The node.
+   */
+  void PushEventWithContext (EventWithContext *node);
+  /**
+   * Dequeue a node, from the main thread.
+   *
+   * \returns The oldest node, or 0 if the queue is empty or the
+   *          oldest node is not completely enqueued yet.
+   */
+  EventWithContext * PopEventWithContext (void);
+
+  /** The most recently enqueued node, where other threads enqueue. */
+  std::atomic<EventWithContext *> m_eventsWithContextHead;
+  /** The oldest node, where the main thread dequeues. */
+  EventWithContext *m_eventsWithContextTail;
+  /** Placeholder node, so that the queue never becomes empty. */
+  EventWithContext m_eventsWithContextStub;
+  /** Free nodes, shared by all the instances. */
+  static std::atomic<EventWithContext *> g_freeEventsWithContext;
 
   /** Container type for the events to run at Simulator::Destroy() */
   typedef std::list<EventId> DestroyEvents;
@@ -115,6 +182,8 @@ private:
   bool m_stop;
   /** The event priority queue. */
   Ptr<Scheduler> m_events;
+  /** The factory of the event priority queue, to rebuild it when compacting. */
+  ObjectFactory m_schedulerFactory;
 
   /** Next event unique id. */
   uint32_t m_uid;
@@ -130,6 +199,22 @@ private:
    */
   int m_unscheduledEvents;
 
+  /**
+   * Flag \c true if Remove only cancels the event and leaves it in the
+   * event list, relying on bulk compaction to purge it.
+   */
+  bool m_lazyRemove;
+  /** Tombstone ratio above which the event list is compacted. */
+  double m_maxTombstoneRatio;
+  /** Minimum number of tombstones before the event list is compacted. */
+  uint32_t m_minTombstones;
+  /** Number of cancelled events still in the event list. */
+  uint32_t m_tombstones;
+  /** Number of compactions performed. */
+  uint32_t m_compactions;
+  /** Number of tombstones purged by compactions. */
+  uint64_t m_compactedEvents;
+
   /** Main execution thread. */
   SystemThread::ThreadId m_main;
 };
@@ -0,0 +1,297 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2017
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ladder-queue-scheduler.h"
+#include "event-impl.h"
+#include "assert.h"
+#include "log.h"
+#include <algorithm>
+
+/**
+ * \file
+ * \ingroup scheduler
+ * Implementation of ns3::LadderQueueScheduler class.
+ */
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("LadderQueueScheduler");
+
+NS_OBJECT_ENSURE_REGISTERED (LadderQueueScheduler);
+
+TypeId
+LadderQueueScheduler::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::LadderQueueScheduler")
+    .SetParent<Scheduler> ()
+    .SetGroupName ("Core")
+    .AddConstructor<LadderQueueScheduler> ()
+  ;
+  return tid;
+}
+
+LadderQueueScheduler::LadderQueueScheduler ()
+  : m_topStart (0),
+    m_topMin (~0ULL),
+    m_topMax (0),
+    m_rungs (MAX_RUNGS),
+    m_nRungs (0),
+    m_bottomNext (0)
+{
+  NS_LOG_FUNCTION (this);
+}
+
+LadderQueueScheduler::~LadderQueueScheduler ()
+{
+  NS_LOG_FUNCTION (this);
+}
+
+uint64_t
+LadderQueueScheduler::CurrentStart (const Rung &rung) const
+{
+  return rung.start + rung.current * rung.width;
+}
+
+void
+LadderQueueScheduler::Spread (Rung &rung, Bucket &events)
+{
+  NS_LOG_FUNCTION (this << events.size ());
+  for (Bucket::const_iterator i = events.begin (); i != events.end (); ++i)
+    {
+      uint64_t bucket = (i->key.m_ts - rung.start) / rung.width;
+      NS_ASSERT (bucket < rung.nBuckets);
+      rung.buckets[bucket].push_back (*i);
+    }
+  events.clear ();
+}
+
+LadderQueueScheduler::Rung &
+LadderQueueScheduler::AddRung (uint64_t start, uint64_t span, uint32_t count)
+{
+  NS_LOG_FUNCTION (this << start << span << count);
+  NS_ASSERT (m_nRungs < MAX_RUNGS);
+  NS_ASSERT (span > 0 && count > 0);
+  Rung &rung = m_rungs[m_nRungs];
+  m_nRungs++;
+  // aim at one event per bucket
+  rung.width = std::max<uint64_t> (1, span / count);
+  rung.nBuckets = (span + rung.width - 1) / rung.width;
+  rung.start = start;
+  rung.current = 0;
+  if (rung.buckets.size () < rung.nBuckets)
+    {
+      rung.buckets.resize (rung.nBuckets);
+    }
+  return rung;
+}
+
+void
+LadderQueueScheduler::SortIntoBottom (Bucket &events)
+{
+  NS_LOG_FUNCTION (this << events.size ());
+  NS_ASSERT (m_bottom.empty ());
+  m_bottom.swap (events);
+  std::sort (m_bottom.begin (), m_bottom.end ());
+  m_bottomNext = 0;
+}
+
+void
+LadderQueueScheduler::TransferTop (void)
+{
+  NS_LOG_FUNCTION (this << m_top.size ());
+  NS_ASSERT (m_nRungs == 0 && !m_top.empty ());
+  if (m_top.size () <= THRESHOLD || m_topMin == m_topMax)
+    {
+      m_topStart = m_topMax + 1;
+      SortIntoBottom (m_top);
+    }
+  else
+    {
+      Rung &rung = AddRung (m_topMin, m_topMax - m_topMin + 1, m_top.size ());
+      m_topStart = rung.start + rung.nBuckets * rung.width;
+      Spread (rung, m_top);
+    }
+  m_topMin = ~0ULL;
+  m_topMax = 0;
+}
+
+void
+LadderQueueScheduler::SpawnFromBottom (void)
+{
+  NS_LOG_FUNCTION (this << m_bottom.size () - m_bottomNext);
+  m_bottom.erase (m_bottom.begin (), m_bottom.begin () + m_bottomNext);
+  m_bottomNext = 0;
+  uint64_t start = m_bottom.front ().key.m_ts;
+  uint64_t end = (m_nRungs > 0) ? CurrentStart (m_rungs[m_nRungs - 1]) : m_topStart;
+  NS_ASSERT (start < end);
+  Rung &rung = AddRung (start, end - start, m_bottom.size ());
+  Spread (rung, m_bottom);
+  Refill ();
+}
+
+void
+LadderQueueScheduler::Refill (void)
+{
+  if (m_bottomNext == m_bottom.size ())
+    {
+      m_bottom.clear ();
+      m_bottomNext = 0;
+    }
+  while (m_bottom.empty ())
+    {
+      // find the lowest rung with events left, dropping the exhausted ones.
+      while (m_nRungs > 0)
+        {
+          Rung &rung = m_rungs[m_nRungs - 1];
+          while (rung.current < rung.nBuckets && rung.buckets[rung.current].empty ())
+            {
+              rung.current++;
+            }
+          if (rung.current < rung.nBuckets)
+            {
+              break;
+            }
+          m_nRungs--;
+        }
+      if (m_nRungs == 0)
+        {
+          if (m_top.empty ())
+            {
+              return;
+            }
+          TransferTop ();
+          continue;
+        }
+      Rung &rung = m_rungs[m_nRungs - 1];
+      Bucket &bucket = rung.buckets[rung.current];
+      uint64_t bucketStart = CurrentStart (rung);
+      rung.current++;
+      if (bucket.size () > THRESHOLD && rung.width > 1 && m_nRungs < MAX_RUNGS)
+        {
+          Rung &child = AddRung (bucketStart, rung.width, bucket.size ());
+          Spread (child, bucket);
+        }
+      else
+        {
+          SortIntoBottom (bucket);
+        }
+    }
+}
+
+void
+LadderQueueScheduler::EraseUnsorted (Bucket &events, const Scheduler::Event &ev)
+{
+  for (Bucket::iterator i = events.begin (); i != events.end (); ++i)
+    {
+      if (i->key.m_uid == ev.key.m_uid)
+        {
+          NS_ASSERT (i->impl == ev.impl);
+          *i = events.back ();
+          events.pop_back ();
+          return;
+        }
+    }
+  NS_ASSERT (false);
+}
+
+void
+LadderQueueScheduler::Insert (const Event &ev)
+{
+  NS_LOG_FUNCTION (this << ev.impl << ev.key.m_ts << ev.key.m_uid);
+  uint64_t ts = ev.key.m_ts;
+  if (ts >= m_topStart)
+    {
+      m_top.push_back (ev);
+      m_topMin = std::min (m_topMin, ts);
+      m_topMax = std::max (m_topMax, ts);
+      Refill ();
+      return;
+    }
+  for (uint32_t i = 0; i < m_nRungs; i++)
+    {
+      Rung &rung = m_rungs[i];
+      if (ts >= CurrentStart (rung))
+        {
+          rung.buckets[(ts - rung.start) / rung.width].push_back (ev);
+          return;
+        }
+    }
+  // new events usually sort after most of the bottom, so that
+  // keeping it in increasing order makes this insertion cheap.
+  Bucket::iterator pos = std::upper_bound (m_bottom.begin () + m_bottomNext, m_bottom.end (), ev);
+  m_bottom.insert (pos, ev);
+  if (m_bottom.size () - m_bottomNext > 4 * THRESHOLD
+      && m_nRungs < MAX_RUNGS
+      && m_bottom[m_bottomNext].key.m_ts != m_bottom.back ().key.m_ts)
+    {
+      SpawnFromBottom ();
+    }
+}
+
+bool
+LadderQueueScheduler::IsEmpty (void) const
+{
+  NS_LOG_FUNCTION (this);
+  return m_bottomNext == m_bottom.size ();
+}
+
+Scheduler::Event
+LadderQueueScheduler::PeekNext (void) const
+{
+  NS_LOG_FUNCTION (this);
+  NS_ASSERT (m_bottomNext < m_bottom.size ());
+  return m_bottom[m_bottomNext];
+}
+
+Scheduler::Event
+LadderQueueScheduler::RemoveNext (void)
+{
+  NS_LOG_FUNCTION (this);
+  NS_ASSERT (m_bottomNext < m_bottom.size ());
+  Scheduler::Event next = m_bottom[m_bottomNext];
+  m_bottomNext++;
+  Refill ();
+  return next;
+}
+
+void
+LadderQueueScheduler::Remove (const Event &ev)
+{
+  NS_LOG_FUNCTION (this << ev.impl << ev.key.m_ts << ev.key.m_uid);
+  uint64_t ts = ev.key.m_ts;
+  if (ts >= m_topStart)
+    {
+      EraseUnsorted (m_top, ev);
+      return;
+    }
+  for (uint32_t i = 0; i < m_nRungs; i++)
+    {
+      Rung &rung = m_rungs[i];
+      if (ts >= CurrentStart (rung))
+        {
+          EraseUnsorted (rung.buckets[(ts - rung.start) / rung.width], ev);
+          return;
+        }
+    }
+  Bucket::iterator pos = std::lower_bound (m_bottom.begin () + m_bottomNext, m_bottom.end (), ev);
+  NS_ASSERT (pos != m_bottom.end () && pos->key.m_uid == ev.key.m_uid);
+  m_bottom.erase (pos);
+  Refill ();
+}
+
+} // namespace ns3
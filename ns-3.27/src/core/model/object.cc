@@ -102,6 +102,7 @@ Object::Object ()
 {
   NS_LOG_FUNCTION (this);
   m_aggregates->n = 1;
+  m_aggregates->cache = 0;
   m_aggregates->buffer[0] = this;
 }
 Object::~Object () 
@@ -120,6 +121,9 @@ Object::~Object ()
           m_aggregates->n--;
         }
     }
+  // the cache may point to this object, so drop it
+  std::free (m_aggregates->cache);
+  m_aggregates->cache = 0;
   // finally, if all objects have been removed from the list,
   // delete the aggregate list
   if (m_aggregates->n == 0)
@@ -136,6 +140,7 @@ Object::Object (const Object &o)
     m_getObjectCount (0)
 {
   m_aggregates->n = 1;
+  m_aggregates->cache = 0;
   m_aggregates->buffer[0] = this;
 }
 void
@@ -151,6 +156,13 @@ Object::DoGetObject (TypeId tid) const
   NS_LOG_FUNCTION (this << tid);
   NS_ASSERT (CheckLoose ());
 
+  uint16_t uid = tid.GetUid ();
+  const AggregatesCache *cache = m_aggregates->cache;
+  if (cache != 0 && cache->tid[uid % AGGREGATES_CACHE_SIZE] == uid)
+    {
+      return cache->object[uid % AGGREGATES_CACHE_SIZE];
+    }
+
   uint32_t n = m_aggregates->n;
   TypeId objectTid = Object::GetTypeId ();
   for (uint32_t i = 0; i < n; i++)
@@ -174,12 +186,27 @@ Object::DoGetObject (TypeId tid) const
           // then, update the sort
           UpdateSortedArray (m_aggregates, i);
           // finally, return the match
+          CacheObject (uid, current);
           return const_cast<Object *> (current);
         }
     }
+  CacheObject (uid, 0);
   return 0;
 }
 void
+Object::CacheObject (uint16_t uid, Object *object) const
+{
+  NS_LOG_FUNCTION (this << uid << object);
+  AggregatesCache *cache = m_aggregates->cache;
+  if (cache == 0)
+    {
+      cache = (AggregatesCache *) std::calloc (1, sizeof (AggregatesCache));
+      m_aggregates->cache = cache;
+    }
+  cache->tid[uid % AGGREGATES_CACHE_SIZE] = uid;
+  cache->object[uid % AGGREGATES_CACHE_SIZE] = object;
+}
+void
 Object::Initialize (void)
 {
   /**
@@ -263,6 +290,7 @@ Object::AggregateObject (Ptr<Object> o)
   struct Aggregates *aggregates = 
     (struct Aggregates *)std::malloc (sizeof(struct Aggregates)+(total-1)*sizeof(Object*));
   aggregates->n = total;
+  aggregates->cache = 0;
 
   // copy our buffer to the new buffer
   std::memcpy (&aggregates->buffer[0], 
@@ -314,7 +342,9 @@ Object::AggregateObject (Ptr<Object> o)
     }
 
   // Now that we are done with them, we can free our old aggregate buffers
+  std::free (a->cache);
   std::free (a);
+  std::free (b->cache);
   std::free (b);
 }
 /**
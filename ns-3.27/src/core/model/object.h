@@ -320,6 +320,25 @@ private:
   friend class AggregateIterator;
   friend struct ObjectDeleter;
 
+  /** Number of entries of an AggregatesCache. */
+  enum { AGGREGATES_CACHE_SIZE = 16 };
+
+  /**
+   * The results of recent GetObject() lookups in a list of aggregates.
+   *
+   * A TypeId maps to the entry selected by its uid.  The entry holds
+   * the uid it was last filled for and the Object found, which is
+   * null if no aggregate is of that TypeId.  The list of aggregates
+   * is reallocated with an empty cache whenever an Object is
+   * aggregated, so the cache never needs to be invalidated otherwise.
+   */
+  struct AggregatesCache {
+    /** The uids of the cached lookups, 0 for an unused entry. */
+    uint16_t tid[AGGREGATES_CACHE_SIZE];
+    /** The Objects found. */
+    Object *object[AGGREGATES_CACHE_SIZE];
+  };
+
   /**
    * The list of Objects aggregated to this one.
    *
@@ -335,6 +354,8 @@ private:
   struct Aggregates {
     /** The number of entries in \c buffer. */
     uint32_t n;
+    /** The results of the lookups in \c buffer, allocated on the first lookup. */
+    AggregatesCache *cache;
     /** The array of Objects. */
     Object *buffer[1];
   };
@@ -346,6 +367,13 @@ private:
    * \return The matching Object, if it is found
    */
   Ptr<Object> DoGetObject (TypeId tid) const;
+  /**
+   * Record the result of a lookup in the cache of our aggregates.
+   *
+   * \param [in] uid The uid of the TypeId looked up.
+   * \param [in] object The matching Object, or null if none matched.
+   */
+  void CacheObject (uint16_t uid, Object *object) const;
   /**
    * Verify that this Object is still live, by checking it's reference count.
    * \return \c true if the reference count is non zero.
@@ -458,11 +486,20 @@ template <typename T>
 Ptr<T> 
 Object::GetObject () const
 {
+  // The uid of T is computed once per type, so a lookup which was
+  // already made on these aggregates costs one probe of their cache.
+  static const uint16_t uid = T::GetTypeId ().GetUid ();
+  const AggregatesCache *cache = m_aggregates->cache;
+  if (cache != 0 && cache->tid[uid % AGGREGATES_CACHE_SIZE] == uid)
+    {
+      return Ptr<T> (static_cast<T *> (cache->object[uid % AGGREGATES_CACHE_SIZE]));
+    }
   // This is an optimization: if the cast works (which is likely),
   // things will be pretty fast.
   T *result = dynamic_cast<T *> (m_aggregates->buffer[0]);
   if (result != 0)
     {
+      CacheObject (uid, m_aggregates->buffer[0]);
       return Ptr<T> (result);
     }
   // if the cast does not work, we try to do a full type check.
@@ -24,6 +24,7 @@
 #include "trace-source-accessor.h"
 
 #include <map>
+#include <unordered_map>
 #include <vector>
 #include <sstream>
 #include <iomanip>
@@ -53,6 +54,11 @@ NS_LOG_COMPONENT_DEFINE ("TypeId");
  * Information records are stored in a vector.  Name and hash lookup
  * are performed by maps to the vector index.
  *
+ * Each record also carries hashed indices of the Attributes and
+ * TraceSources of the type and of its parents, by name.  These are
+ * built on the first lookup and rebuilt if types are registered
+ * or extended afterwards.
+ *
  * \internal
  * <b>Hash Chaining</b>
  *
@@ -78,6 +84,8 @@ NS_LOG_COMPONENT_DEFINE ("TypeId");
 class IidManager : public Singleton<IidManager>
 {
 public:
+  /** Constructor. */
+  IidManager ();
   /**
    * Create a new unique type id.
    * \param [in] name The name of this type id.
@@ -229,6 +237,16 @@ public:
    * \returns The information associated to attribute whose index is \p i.
    */
   struct TypeId::AttributeInformation GetAttribute(uint16_t uid, uint32_t i) const;
+  /**
+   * Find an Attribute by name in a type id or in its parents.
+   * \param [in] uid The id.
+   * \param [in] name The Attribute name.
+   * \param [out] owner The id of the type which registered the Attribute.
+   * \param [out] i The index of the Attribute in \p owner.
+   * \returns \c true if the Attribute was found.
+   */
+  bool FindAttribute (uint16_t uid, const std::string &name,
+                      uint16_t *owner, uint32_t *i);
   /**
    * Record a new TraceSource.
    * \param [in] uid The id.
@@ -264,6 +282,16 @@ public:
    * \returns Detailed information about the requested trace source.
    */
   struct TypeId::TraceSourceInformation GetTraceSource(uint16_t uid, uint32_t i) const;
+  /**
+   * Find a TraceSource by name in a type id or in its parents.
+   * \param [in] uid The id.
+   * \param [in] name The TraceSource name.
+   * \param [out] owner The id of the type which registered the TraceSource.
+   * \param [out] i The index of the TraceSource in \p owner.
+   * \returns \c true if the TraceSource was found.
+   */
+  bool FindTraceSource (uint16_t uid, const std::string &name,
+                        uint16_t *owner, uint32_t *i);
   /**
    * Check if this TypeId should not be listed in documentation.
    * \param [in] uid The id.
@@ -293,6 +321,13 @@ private:
    */
   static TypeId::hash_t Hasher (const std::string name);
 
+  /**
+   * Location of an Attribute or TraceSource: the id of the type
+   * which registered it, and its index in that type.
+   */
+  typedef std::pair<uint16_t, uint32_t> location_t;
+  /** Type of the Attribute and TraceSource by-name indices. */
+  typedef std::unordered_map<std::string, location_t> nameindex_t;
   /** The information record about a single type id. */
   struct IidInformation {
     /** The type id name. */
@@ -319,6 +354,12 @@ private:
     TypeId::SupportLevel supportLevel;
     /** Support message. */
     std::string supportMsg;
+    /** The Attributes of this type and its parents, by name. */
+    nameindex_t attributeIndex;
+    /** The TraceSources of this type and its parents, by name. */
+    nameindex_t traceSourceIndex;
+    /** The value of m_generation when the indices were built. */
+    uint32_t indexGeneration;
   };
   /** Iterator type. */
   typedef std::vector<struct IidInformation>::const_iterator Iterator;
@@ -329,6 +370,16 @@ private:
    * \returns The information record.
    */
   struct IidManager::IidInformation *LookupInformation (uint16_t uid) const;
+  /**
+   * Make sure the Attribute and TraceSource indices of a type are
+   * up to date.
+   *
+   * Names registered by a type hide those of its parents, as
+   * they would in a search walking up the inheritance tree.
+   * \param [in] uid The id.
+   * \returns The information record, with current indices.
+   */
+  struct IidManager::IidInformation *LookupIndexedInformation (uint16_t uid);
 
   /** The container of all type id records. */
   std::vector<struct IidInformation> m_information;
@@ -343,6 +394,12 @@ private:
   /** The by-hash index. */
   hashmap_t m_hashmap;
 
+  /**
+   * Count of the changes to the inheritance tree and to the registered
+   * Attributes and TraceSources, to invalidate the by-name indices.
+   */
+  uint32_t m_generation;
+
 
   /** IidManager constants. */
   enum {
@@ -378,6 +435,12 @@ IidManager::Hasher (const std::string name)
  */
 #define IIDL IID << ": "
 
+IidManager::IidManager ()
+  : m_generation (1)
+{
+  NS_LOG_FUNCTION (IID);
+}
+
 uint16_t
 IidManager::AllocateUid (std::string name)
 {
@@ -439,6 +502,7 @@ IidManager::AllocateUid (std::string name)
   information.size = (std::size_t)(-1);
   information.hasConstructor = false;
   information.mustHideFromDocumentation = false;
+  information.indexGeneration = 0;
   m_information.push_back (information);
   uint32_t uid = m_information.size ();
   NS_ASSERT (uid <= 0xffff);
@@ -466,6 +530,7 @@ IidManager::SetParent (uint16_t uid, uint16_t parent)
   NS_ASSERT (parent <= m_information.size ());
   struct IidInformation *information = LookupInformation (uid);
   information->parent = parent;
+  m_generation++;
 }
 void 
 IidManager::SetGroupName (uint16_t uid, std::string groupName)
@@ -675,6 +740,7 @@ IidManager::AddAttribute (uint16_t uid,
   info.supportLevel = supportLevel;
   info.supportMsg = supportMsg;
   information->attributes.push_back (info);
+  m_generation++;
   NS_LOG_LOGIC (IIDL << information->attributes.size () - 1);
 }
 void 
@@ -709,6 +775,24 @@ IidManager::GetAttribute(uint16_t uid, uint32_t i) const
   return information->attributes[i];
 }
 
+bool
+IidManager::FindAttribute (uint16_t uid, const std::string &name,
+                           uint16_t *owner, uint32_t *i)
+{
+  NS_LOG_FUNCTION (IID << uid << name);
+  struct IidInformation *information = LookupIndexedInformation (uid);
+  nameindex_t::const_iterator it = information->attributeIndex.find (name);
+  if (it == information->attributeIndex.end ())
+    {
+      NS_LOG_LOGIC (IIDL << false);
+      return false;
+    }
+  *owner = it->second.first;
+  *i = it->second.second;
+  NS_LOG_LOGIC (IIDL << *owner << " " << *i);
+  return true;
+}
+
 bool
 IidManager::HasTraceSource (uint16_t uid,
                             std::string name)
@@ -766,6 +850,7 @@ IidManager::AddTraceSource (uint16_t uid,
   source.supportLevel = supportLevel;
   source.supportMsg = supportMsg;
   information->traceSources.push_back (source);
+  m_generation++;
   NS_LOG_LOGIC (IIDL << information->traceSources.size () - 1);
 }
 uint32_t 
@@ -786,6 +871,61 @@ IidManager::GetTraceSource(uint16_t uid, uint32_t i) const
   NS_LOG_LOGIC (IIDL << information->name);
   return information->traceSources[i];
 }
+bool
+IidManager::FindTraceSource (uint16_t uid, const std::string &name,
+                             uint16_t *owner, uint32_t *i)
+{
+  NS_LOG_FUNCTION (IID << uid << name);
+  struct IidInformation *information = LookupIndexedInformation (uid);
+  nameindex_t::const_iterator it = information->traceSourceIndex.find (name);
+  if (it == information->traceSourceIndex.end ())
+    {
+      NS_LOG_LOGIC (IIDL << false);
+      return false;
+    }
+  *owner = it->second.first;
+  *i = it->second.second;
+  NS_LOG_LOGIC (IIDL << *owner << " " << *i);
+  return true;
+}
+struct IidManager::IidInformation *
+IidManager::LookupIndexedInformation (uint16_t uid)
+{
+  NS_LOG_FUNCTION (IID << uid);
+  struct IidInformation *information = LookupInformation (uid);
+  if (information->indexGeneration == m_generation)
+    {
+      return information;
+    }
+  information->attributeIndex.clear ();
+  information->traceSourceIndex.clear ();
+  uint16_t current = uid;
+  while (true)
+    {
+      struct IidInformation *ancestor = LookupInformation (current);
+      for (uint32_t i = 0; i < ancestor->attributes.size (); i++)
+        {
+          // insert does not replace the entries of derived types
+          information->attributeIndex.insert
+            (std::make_pair (ancestor->attributes[i].name, location_t (current, i)));
+        }
+      for (uint32_t i = 0; i < ancestor->traceSources.size (); i++)
+        {
+          information->traceSourceIndex.insert
+            (std::make_pair (ancestor->traceSources[i].name, location_t (current, i)));
+        }
+      if (ancestor->parent == current || ancestor->parent == 0)
+        {
+          // top of inheritance tree
+          break;
+        }
+      current = ancestor->parent;
+    }
+  information->indexGeneration = m_generation;
+  NS_LOG_LOGIC (IIDL << information->attributeIndex.size () << " "
+                << information->traceSourceIndex.size ());
+  return information;
+}
 bool 
 IidManager::MustHideFromDocumentation (uint16_t uid) const
 {
@@ -876,38 +1016,26 @@ bool
 TypeId::LookupAttributeByName (std::string name, struct TypeId::AttributeInformation *info) const
 {
   NS_LOG_FUNCTION (this << name << info);
-  TypeId tid;
-  TypeId nextTid = *this;
-  do {
-      tid = nextTid;
-      for (uint32_t i = 0; i < tid.GetAttributeN (); i++)
-        {
-          struct TypeId::AttributeInformation tmp = tid.GetAttribute(i);
-          if (tmp.name == name)
-            {
-              if (tmp.supportLevel == TypeId::SUPPORTED)
-                {
-                  *info = tmp;
-                  return true;
-                }
-              else if (tmp.supportLevel == TypeId::DEPRECATED)
-                {
-                  std::cerr << "Attribute '" << name << "' is deprecated: "
-                                 << tmp.supportMsg << std::endl;
-                  *info = tmp;
-                  return true;
-                }
-              else if (tmp.supportLevel == TypeId::OBSOLETE)
-                {
-                  NS_FATAL_ERROR ("Attribute '" << name
-                                  << "' is obsolete, with no fallback: "
-                                  << tmp.supportMsg);
-                }
-            }
-        }
-      nextTid = tid.GetParent ();
-    } while (nextTid != tid);
-  return false;
+  uint16_t owner;
+  uint32_t i;
+  if (!IidManager::Get ()->FindAttribute (m_tid, name, &owner, &i))
+    {
+      return false;
+    }
+  struct TypeId::AttributeInformation tmp = IidManager::Get ()->GetAttribute (owner, i);
+  if (tmp.supportLevel == TypeId::DEPRECATED)
+    {
+      std::cerr << "Attribute '" << name << "' is deprecated: "
+                << tmp.supportMsg << std::endl;
+    }
+  else if (tmp.supportLevel == TypeId::OBSOLETE)
+    {
+      NS_FATAL_ERROR ("Attribute '" << name
+                      << "' is obsolete, with no fallback: "
+                      << tmp.supportMsg);
+    }
+  *info = tmp;
+  return true;
 }
 
 TypeId 
@@ -1136,39 +1264,26 @@ TypeId::LookupTraceSourceByName (std::string name,
                                  struct TraceSourceInformation *info) const
 {
   NS_LOG_FUNCTION (this << name);
-  TypeId tid;
-  TypeId nextTid = *this;
-  struct TypeId::TraceSourceInformation tmp;
-  do {
-      tid = nextTid;
-      for (uint32_t i = 0; i < tid.GetTraceSourceN (); i++)
-        {
-          tmp = tid.GetTraceSource (i);
-          if (tmp.name == name)
-            {
-              if (tmp.supportLevel == TypeId::SUPPORTED)
-                {
-                  *info = tmp;
-                   return tmp.accessor;
-                }
-              else if (tmp.supportLevel == TypeId::DEPRECATED)
-                {
-                  std::cerr << "TraceSource '" << name << "' is deprecated: "
-                                 << tmp.supportMsg << std::endl;
-                  *info = tmp;
-                  return tmp.accessor;
-                }
-              else  if (tmp.supportLevel == TypeId::OBSOLETE)
-                {
-                  NS_FATAL_ERROR ("TraceSource '" << name
-                                  << "' is obsolete, with no fallback: "
-                                  << tmp.supportMsg);
-                }
-            }
-        }
-      nextTid = tid.GetParent ();
-    } while (nextTid != tid);
-  return 0;
+  uint16_t owner;
+  uint32_t i;
+  if (!IidManager::Get ()->FindTraceSource (m_tid, name, &owner, &i))
+    {
+      return 0;
+    }
+  struct TypeId::TraceSourceInformation tmp = IidManager::Get ()->GetTraceSource (owner, i);
+  if (tmp.supportLevel == TypeId::DEPRECATED)
+    {
+      std::cerr << "TraceSource '" << name << "' is deprecated: "
+                << tmp.supportMsg << std::endl;
+    }
+  else if (tmp.supportLevel == TypeId::OBSOLETE)
+    {
+      NS_FATAL_ERROR ("TraceSource '" << name
+                      << "' is obsolete, with no fallback: "
+                      << tmp.supportMsg);
+    }
+  *info = tmp;
+  return tmp.accessor;
 }
 
 Ptr<const TraceSourceAccessor> 
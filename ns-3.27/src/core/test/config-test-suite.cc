@@ -821,6 +821,129 @@ SearchAttributesOfParentObjectsTestCase::DoRun (void)
 
 }
 
+/**
+ * \ingroup config-tests
+ * Test for compiled paths and bulk trace connections.
+ */
+class CompiledPathConfigTestCase : public TestCase
+{
+public:
+  /** Constructor. */
+  CompiledPathConfigTestCase ();
+  /** Destructor. */
+  virtual ~CompiledPathConfigTestCase () {}
+
+  /**
+   * Trace callback with context path.
+   * \param path The context path.
+   * \param old The old value.
+   * \param newValue The new value.
+   */
+  void TraceWithPath (std::string path, int16_t old, int16_t newValue)
+  { m_newValue = newValue; m_path = path; }
+  /**
+   * Trace callback counting the notifications.
+   * \param path The context path.
+   * \param oldValue The old value.
+   * \param newValue The new value.
+   */
+  void Count (std::string path, int16_t oldValue, int16_t newValue) { m_count++; }
+
+private:
+  virtual void DoRun (void);
+
+  int16_t m_newValue; //!< Flag to detect tracing result.
+  std::string m_path; //!< The context path.
+  uint32_t m_count;   //!< Number of notifications received by Count.
+};
+
+CompiledPathConfigTestCase::CompiledPathConfigTestCase ()
+  : TestCase ("Check compiled paths and bulk trace connections")
+{
+}
+
+void
+CompiledPathConfigTestCase::DoRun (void)
+{
+  IntegerValue iv;
+
+  //
+  // Use a named root, so that the objects registered in the root
+  // namespace by the other tests do not match.
+  //
+  Ptr<ConfigTestObject> root = CreateObject<ConfigTestObject> ();
+  Names::Add ("CompiledRoot", root);
+  std::vector<Ptr<ConfigTestObject> > objects;
+  for (uint32_t i = 0; i < 4; ++i)
+    {
+      objects.push_back (CreateObject<ConfigTestObject> ());
+      root->AddNodeA (objects[i]);
+    }
+
+  //
+  // A range and an index select three objects of the vector.
+  //
+  Config::CompiledPath set ("/Names/CompiledRoot/NodesA/[1-2]|0/A");
+  NS_TEST_ASSERT_MSG_EQ (set.LookupMatches ().GetN (), 3, "Unexpected number of matches");
+  set.Set (IntegerValue (3));
+  for (uint32_t i = 0; i < 4; ++i)
+    {
+      objects[i]->GetAttribute ("A", iv);
+      NS_TEST_ASSERT_MSG_EQ (iv.Get (), (i < 3 ? 3 : 10), "Object Attribute \"A\" not set as expected");
+    }
+
+  //
+  // A compiled path matches the objects present when it is used.
+  //
+  Config::CompiledPath last ("/Names/CompiledRoot/NodesA/4/A");
+  last.Set (IntegerValue (5));
+  objects.push_back (CreateObject<ConfigTestObject> ());
+  root->AddNodeA (objects[4]);
+  last.Set (IntegerValue (5));
+  objects[4]->GetAttribute ("A", iv);
+  NS_TEST_ASSERT_MSG_EQ (iv.Get (), 5, "Object Attribute \"A\" not set as expected");
+  NS_TEST_ASSERT_MSG_EQ (last.LookupMatches ().GetMatchedPath (0), "/Names/CompiledRoot/NodesA/4/",
+                         "Unexpected matched path");
+
+  //
+  // Connect and disconnect a trace source through a compiled path.
+  //
+  Config::CompiledPath source ("/Names/CompiledRoot/NodesA/1/Source");
+  source.Connect (MakeCallback (&CompiledPathConfigTestCase::TraceWithPath, this));
+  m_newValue = 0;
+  m_path = "";
+  objects[1]->SetAttribute ("Source", IntegerValue (-2));
+  NS_TEST_ASSERT_MSG_EQ (m_newValue, -2, "Trace 1 did not fire as expected");
+  NS_TEST_ASSERT_MSG_EQ (m_path, "/Names/CompiledRoot/NodesA/1/Source", "Trace 1 did not provide expected context");
+  m_newValue = 0;
+  objects[2]->SetAttribute ("Source", IntegerValue (-3));
+  NS_TEST_ASSERT_MSG_EQ (m_newValue, 0, "Trace 2 fired unexpectedly");
+  source.Disconnect (MakeCallback (&CompiledPathConfigTestCase::TraceWithPath, this));
+  objects[1]->SetAttribute ("Source", IntegerValue (-4));
+  NS_TEST_ASSERT_MSG_EQ (m_newValue, 0, "Trace 1 fired after being disconnected");
+
+  //
+  // Connect two sinks to the sources of all the objects at once.
+  //
+  std::vector<std::pair<std::string, CallbackBase> > connections;
+  connections.push_back (std::make_pair ("/Names/CompiledRoot/NodesA/*/Source",
+                                         MakeCallback (&CompiledPathConfigTestCase::TraceWithPath, this)));
+  connections.push_back (std::make_pair ("/Names/CompiledRoot/NodesA/3|4/Source",
+                                         MakeCallback (&CompiledPathConfigTestCase::Count, this)));
+  Config::ConnectMany (connections);
+  m_count = 0;
+  m_newValue = 0;
+  objects[0]->SetAttribute ("Source", IntegerValue (-5));
+  NS_TEST_ASSERT_MSG_EQ (m_newValue, -5, "Trace 0 did not fire as expected");
+  NS_TEST_ASSERT_MSG_EQ (m_path, "/Names/CompiledRoot/NodesA/0/Source", "Trace 0 did not provide expected context");
+  NS_TEST_ASSERT_MSG_EQ (m_count, 0, "Trace 0 fired unexpectedly");
+  objects[4]->SetAttribute ("Source", IntegerValue (-6));
+  NS_TEST_ASSERT_MSG_EQ (m_newValue, -6, "Trace 4 did not fire as expected");
+  NS_TEST_ASSERT_MSG_EQ (m_count, 1, "Trace 4 did not fire as expected");
+
+  Names::Clear ();
+}
+
 /**
  * \ingroup config-tests
  * The Test Suite that glues all of the Test Cases together.
@@ -839,6 +962,7 @@ ConfigTestSuite::ConfigTestSuite ()
   AddTestCase (new UnderRootNamespaceConfigTestCase);
   AddTestCase (new ObjectVectorConfigTestCase);
   AddTestCase (new SearchAttributesOfParentObjectsTestCase);
+  AddTestCase (new CompiledPathConfigTestCase);
 }
 
 /**
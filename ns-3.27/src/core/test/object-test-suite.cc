@@ -398,6 +398,73 @@ AggregateObjectTestCase::DoRun (void)
   NS_TEST_ASSERT_MSG_NE (baseA, 0, "Unable to GetObject on released object");
 }
 
+/**
+ * \ingroup object-tests
+ * Test the lookups cached in an aggregation follow its changes.
+ */
+class AggregateLookupCacheTestCase : public TestCase
+{
+public:
+  /** Constructor. */
+  AggregateLookupCacheTestCase ();
+  /** Destructor. */
+  virtual ~AggregateLookupCacheTestCase ();
+
+private:
+  virtual void DoRun (void);
+};
+
+AggregateLookupCacheTestCase::AggregateLookupCacheTestCase ()
+  : TestCase ("Check cached Object aggregation lookups")
+{
+}
+
+AggregateLookupCacheTestCase::~AggregateLookupCacheTestCase ()
+{
+}
+
+void
+AggregateLookupCacheTestCase::DoRun (void)
+{
+  Ptr<BaseA> baseA = CreateObject<BaseA> ();
+  Ptr<DerivedB> derivedB = CreateObject<DerivedB> ();
+
+  //
+  // Look up types missing from the aggregation, twice, so that the second
+  // lookups are answered by the cache.
+  //
+  for (uint32_t i = 0; i < 2; i++)
+    {
+      NS_TEST_ASSERT_MSG_EQ (baseA->GetObject<BaseB> (), 0, "Unexpectedly found a BaseB through baseA");
+      NS_TEST_ASSERT_MSG_EQ (baseA->GetObject<BaseB> (BaseB::GetTypeId ()), 0,
+                             "Unexpectedly found a BaseB by TypeId through baseA");
+      NS_TEST_ASSERT_MSG_EQ (baseA->GetObject<BaseA> (), baseA, "Cannot GetObject (through baseA) for BaseA Object");
+    }
+
+  //
+  // Aggregating must make the missing types visible.
+  //
+  baseA->AggregateObject (derivedB);
+  for (uint32_t i = 0; i < 2; i++)
+    {
+      NS_TEST_ASSERT_MSG_EQ (baseA->GetObject<BaseB> (), derivedB, "Cannot GetObject (through baseA) for BaseB Object");
+      NS_TEST_ASSERT_MSG_EQ (baseA->GetObject<DerivedB> (DerivedB::GetTypeId ()), derivedB,
+                             "Cannot GetObject by TypeId (through baseA) for DerivedB Object");
+      NS_TEST_ASSERT_MSG_EQ (derivedB->GetObject<BaseA> (), baseA, "Cannot GetObject (through derivedB) for BaseA Object");
+      NS_TEST_ASSERT_MSG_EQ (derivedB->GetObject<DerivedA> (), 0, "Unexpectedly found a DerivedA through derivedB");
+    }
+
+  //
+  // A further aggregation must be visible through all the aggregated Objects.
+  //
+  Ptr<DerivedA> derivedA = CreateObject<DerivedA> ();
+  NS_TEST_ASSERT_MSG_EQ (derivedA->GetObject<BaseB> (), 0, "Unexpectedly found a BaseB through derivedA");
+  derivedB->AggregateObject (derivedA);
+  NS_TEST_ASSERT_MSG_EQ (derivedB->GetObject<DerivedA> (), derivedA, "Cannot GetObject (through derivedB) for DerivedA Object");
+  NS_TEST_ASSERT_MSG_EQ (baseA->GetObject<DerivedA> (), derivedA, "Cannot GetObject (through baseA) for DerivedA Object");
+  NS_TEST_ASSERT_MSG_EQ (derivedA->GetObject<BaseB> (), derivedB, "Cannot GetObject (through derivedA) for BaseB Object");
+}
+
 /**
  * \ingroup object-tests
  * Test an Object factory can create Objects
@@ -489,6 +556,7 @@ ObjectTestSuite::ObjectTestSuite ()
 {
   AddTestCase (new CreateObjectTestCase);
   AddTestCase (new AggregateObjectTestCase);
+  AddTestCase (new AggregateLookupCacheTestCase);
   AddTestCase (new ObjectFactoryTestCase);
 }
 
@@ -23,6 +23,15 @@
 #include "ns3/heap-scheduler.h"
 #include "ns3/map-scheduler.h"
 #include "ns3/calendar-scheduler.h"
+#include "ns3/dary-heap-scheduler.h"
+#include "ns3/ladder-queue-scheduler.h"
+#include "ns3/default-simulator-impl.h"
+#include "ns3/config.h"
+#include "ns3/boolean.h"
+#include "ns3/double.h"
+#include "ns3/uinteger.h"
+
+#include <vector>
 
 using namespace ns3;
 
@@ -459,6 +468,85 @@ SimulatorTemplateTestCase::DoRun (void)
   Simulator::Destroy ();
 }
 
+class SimulatorLazyRemoveTestCase : public TestCase
+{
+public:
+  SimulatorLazyRemoveTestCase (ObjectFactory schedulerFactory);
+private:
+  virtual void DoRun (void);
+  void Event (uint32_t i);
+
+  std::vector<bool> m_ran;
+  ObjectFactory m_schedulerFactory;
+};
+
+SimulatorLazyRemoveTestCase::SimulatorLazyRemoveTestCase (ObjectFactory schedulerFactory)
+  : TestCase ("Check lazy removal and compaction of cancelled events with " +
+              schedulerFactory.GetTypeId ().GetName ()),
+    m_schedulerFactory (schedulerFactory)
+{
+}
+
+void
+SimulatorLazyRemoveTestCase::Event (uint32_t i)
+{
+  m_ran[i] = true;
+}
+
+void
+SimulatorLazyRemoveTestCase::DoRun (void)
+{
+  Config::SetDefault ("ns3::DefaultSimulatorImpl::LazyRemove", BooleanValue (true));
+  Config::SetDefault ("ns3::DefaultSimulatorImpl::MaxTombstoneRatio", DoubleValue (0.25));
+  Config::SetDefault ("ns3::DefaultSimulatorImpl::MinTombstones", UintegerValue (10));
+  Simulator::SetScheduler (m_schedulerFactory);
+  Ptr<DefaultSimulatorImpl> impl = DynamicCast<DefaultSimulatorImpl> (Simulator::GetImplementation ());
+  NS_TEST_ASSERT_MSG_NE (impl, 0, "Expected a DefaultSimulatorImpl");
+
+  const uint32_t n = 100;
+  m_ran.assign (n, false);
+  std::vector<EventId> ids;
+  for (uint32_t i = 0; i < n; i++)
+    {
+      ids.push_back (Simulator::Schedule (MicroSeconds (i + 1), &SimulatorLazyRemoveTestCase::Event, this, i));
+    }
+  // remove every even event.
+  for (uint32_t i = 0; i < n; i += 2)
+    {
+      Simulator::Remove (ids[i]);
+      NS_TEST_EXPECT_MSG_EQ (ids[i].IsExpired (), true, "Event was removed: it is now expired");
+    }
+  // the 26th tombstone exceeds a quarter of the 100 pending events,
+  // then the 19th exceeds a quarter of the 74 events left.
+  NS_TEST_EXPECT_MSG_EQ (impl->GetCompactionCount (), 2, "Expected two compactions");
+  NS_TEST_EXPECT_MSG_EQ (impl->GetCompactedEventCount (), 26 + 19, "Wrong number of compacted events");
+  NS_TEST_EXPECT_MSG_EQ (impl->GetTombstoneCount (), 5, "Wrong number of tombstones");
+  // and cancel every odd multiple of 3: the 14th tombstone exceeds a
+  // quarter of the 55 events left.
+  for (uint32_t i = 3; i < n; i += 6)
+    {
+      Simulator::Cancel (ids[i]);
+    }
+  NS_TEST_EXPECT_MSG_EQ (impl->GetCompactionCount (), 3, "Expected a third compaction");
+  NS_TEST_EXPECT_MSG_EQ (impl->GetCompactedEventCount (), 26 + 19 + 14, "Wrong number of compacted events");
+  NS_TEST_EXPECT_MSG_EQ (impl->GetTombstoneCount (), 5 + 17 - 14, "Wrong number of tombstones");
+
+  Simulator::Run ();
+  NS_TEST_EXPECT_MSG_EQ (impl->GetTombstoneCount (), 0, "Tombstones left after the run");
+  NS_TEST_EXPECT_MSG_EQ (impl->GetTombstoneRatio (), 0.0, "Tombstones left after the run");
+  for (uint32_t i = 0; i < n; i++)
+    {
+      bool expected = (i % 2 == 1) && (i % 3 != 0);
+      NS_TEST_EXPECT_MSG_EQ (m_ran[i], expected, "Wrong execution state for event " << i);
+    }
+  impl = 0;
+  Simulator::Destroy ();
+
+  Config::SetDefault ("ns3::DefaultSimulatorImpl::LazyRemove", BooleanValue (false));
+  Config::SetDefault ("ns3::DefaultSimulatorImpl::MaxTombstoneRatio", DoubleValue (0.5));
+  Config::SetDefault ("ns3::DefaultSimulatorImpl::MinTombstones", UintegerValue (1024));
+}
+
 class SimulatorTestSuite : public TestSuite
 {
 public:
@@ -475,5 +563,20 @@ public:
     AddTestCase (new SimulatorEventsTestCase (factory), TestCase::QUICK);
     factory.SetTypeId (CalendarScheduler::GetTypeId ());
     AddTestCase (new SimulatorEventsTestCase (factory), TestCase::QUICK);
+    factory.SetTypeId (DaryHeapScheduler::GetTypeId ());
+    AddTestCase (new SimulatorEventsTestCase (factory), TestCase::QUICK);
+    factory.SetTypeId (LadderQueueScheduler::GetTypeId ());
+    AddTestCase (new SimulatorEventsTestCase (factory), TestCase::QUICK);
+
+    factory.SetTypeId (MapScheduler::GetTypeId ());
+    AddTestCase (new SimulatorLazyRemoveTestCase (factory), TestCase::QUICK);
+    factory.SetTypeId (HeapScheduler::GetTypeId ());
+    AddTestCase (new SimulatorLazyRemoveTestCase (factory), TestCase::QUICK);
+    factory.SetTypeId (CalendarScheduler::GetTypeId ());
+    AddTestCase (new SimulatorLazyRemoveTestCase (factory), TestCase::QUICK);
+    factory.SetTypeId (DaryHeapScheduler::GetTypeId ());
+    AddTestCase (new SimulatorLazyRemoveTestCase (factory), TestCase::QUICK);
+    factory.SetTypeId (LadderQueueScheduler::GetTypeId ());
+    AddTestCase (new SimulatorLazyRemoveTestCase (factory), TestCase::QUICK);
   }
 } g_simulatorTestSuite;
@@ -325,7 +325,86 @@ DeprecatedAttributeTestCase::DoRun (void)
        << endl;
 }
 
-  
+
+
+//----------------------------
+//
+// Inherited Attribute and TraceSource lookup test
+
+class InheritedLookupTestCase : public TestCase
+{
+public:
+  InheritedLookupTestCase ();
+  virtual ~InheritedLookupTestCase ();
+private:
+  virtual void DoRun (void);
+
+};
+
+InheritedLookupTestCase::InheritedLookupTestCase ()
+  : TestCase ("Check lookups of inherited Attributes and TraceSources")
+{
+}
+
+InheritedLookupTestCase::~InheritedLookupTestCase ()
+{
+}
+
+void
+InheritedLookupTestCase::DoRun (void)
+{
+  TypeId parent = TypeId ("InheritedLookupParent")
+    .SetParent<Object> ()
+    .AddAttribute ("parentAttribute", "an attribute of the parent",
+                   EmptyAttributeValue (),
+                   MakeEmptyAttributeAccessor (),
+                   MakeEmptyAttributeChecker ())
+    .AddTraceSource ("parentTrace", "a trace source of the parent",
+                     MakeEmptyTraceSourceAccessor (),
+                     "ns3::TracedValueCallback::Void");
+  TypeId child = TypeId ("InheritedLookupChild")
+    .SetParent (parent)
+    .AddAttribute ("childAttribute", "an attribute of the child",
+                   EmptyAttributeValue (),
+                   MakeEmptyAttributeAccessor (),
+                   MakeEmptyAttributeChecker ());
+
+  struct TypeId::AttributeInformation ainfo;
+  NS_TEST_ASSERT_MSG_EQ (child.LookupAttributeByName ("childAttribute", &ainfo), true,
+                         "lookup attribute of the type");
+  NS_TEST_ASSERT_MSG_EQ (ainfo.name, "childAttribute", "wrong attribute found");
+  NS_TEST_ASSERT_MSG_EQ (child.LookupAttributeByName ("parentAttribute", &ainfo), true,
+                         "lookup inherited attribute");
+  NS_TEST_ASSERT_MSG_EQ (ainfo.name, "parentAttribute", "wrong attribute found");
+  NS_TEST_ASSERT_MSG_EQ (parent.LookupAttributeByName ("childAttribute", &ainfo), false,
+                         "lookup attribute of a derived type");
+  NS_TEST_ASSERT_MSG_EQ (child.LookupAttributeByName ("noAttribute", &ainfo), false,
+                         "lookup missing attribute");
+
+  // The empty accessors are null, so check which trace source was found
+  struct TypeId::TraceSourceInformation tinfo;
+  child.LookupTraceSourceByName ("parentTrace", &tinfo);
+  NS_TEST_ASSERT_MSG_EQ (tinfo.name, "parentTrace", "lookup inherited trace source");
+  tinfo.name = "";
+  child.LookupTraceSourceByName ("noTrace", &tinfo);
+  NS_TEST_ASSERT_MSG_EQ (tinfo.name, "", "lookup missing trace source");
+
+  // Extending the parent after the lookups above must be seen by the child
+  parent.AddAttribute ("lateAttribute", "an attribute added after lookups",
+                       EmptyAttributeValue (),
+                       MakeEmptyAttributeAccessor (),
+                       MakeEmptyAttributeChecker ())
+    .AddTraceSource ("lateTrace", "a trace source added after lookups",
+                     MakeEmptyTraceSourceAccessor (),
+                     "ns3::TracedValueCallback::Void");
+  NS_TEST_ASSERT_MSG_EQ (child.LookupAttributeByName ("lateAttribute", &ainfo), true,
+                         "lookup attribute added to the parent");
+  NS_TEST_ASSERT_MSG_EQ (ainfo.name, "lateAttribute", "wrong attribute found");
+  child.LookupTraceSourceByName ("lateTrace", &tinfo);
+  NS_TEST_ASSERT_MSG_EQ (tinfo.name, "lateTrace", "lookup trace source added to the parent");
+}
+
+
 //----------------------------
 //
 // Performance test
@@ -383,6 +462,28 @@ LookupTimeTestCase::DoRun (void)
   }
   stop = clock ();
   Report ("hash", stop - start);
+
+  start = clock ();
+  uint32_t nattributes = 0;
+  for (uint32_t j = 0; j < REPETITIONS / 100; ++j)
+    {
+      for (uint32_t i = 0; i < nids; ++i)
+        {
+          const TypeId tid = TypeId::GetRegistered (i);
+          for (uint32_t k = 0; k < tid.GetAttributeN (); ++k)
+            {
+              struct TypeId::AttributeInformation info;
+              tid.LookupAttributeByName (tid.GetAttribute (k).name, &info);
+              ++nattributes;
+            }
+        }
+    }
+  stop = clock ();
+  cout << suite << "Lookup time: by attribute name: "
+       << "ticks: " << stop - start
+       << "\tper: " << 1E6 * double(stop - start) / (nattributes * double(CLOCKS_PER_SEC))
+       << " microsec/lookup"
+       << endl;
   
 }
 
@@ -437,6 +538,7 @@ TypeIdTestSuite::TypeIdTestSuite ()
   AddTestCase (new UniqueTypeIdTestCase, QUICK);
   AddTestCase (new CollisionTestCase, QUICK);
   AddTestCase (new DeprecatedAttributeTestCase, QUICK);
+  AddTestCase (new InheritedLookupTestCase, QUICK);
 }
 
 static TypeIdTestSuite g_TypeIdTestSuite;  
@@ -50,7 +50,6 @@ void
 LteChunkProcessor::Start ()
 {
   NS_LOG_FUNCTION (this);
-  m_sumValues = 0;
   m_totDuration = MicroSeconds (0);
 }
 
@@ -59,11 +58,16 @@ void
 LteChunkProcessor::EvaluateChunk (const SpectrumValue& sinr, Time duration)
 {
   NS_LOG_FUNCTION (this << sinr << duration);
-  if (m_sumValues == 0)
+  if (m_sumValues == 0 || m_sumValues->GetSpectrumModel () != sinr.GetSpectrumModel ())
     {
       m_sumValues = Create<SpectrumValue> (sinr.GetSpectrumModel ());
     }
-  (*m_sumValues) += sinr * duration.GetSeconds ();
+  else if (m_totDuration.IsZero ())
+    {
+      // first chunk since Start (): clear the sum of the previous calculation
+      (*m_sumValues) = 0.0;
+    }
+  m_sumValues->AddScaled (sinr, duration.GetSeconds ());
   m_totDuration += duration;
 }
 
@@ -73,10 +77,12 @@ LteChunkProcessor::End ()
   NS_LOG_FUNCTION (this);
   if (m_totDuration.GetSeconds () > 0)
     {
+      m_meanValues = (*m_sumValues);
+      m_meanValues /= m_totDuration.GetSeconds ();
       std::vector<LteChunkProcessorCallback>::iterator it;
       for (it = m_lteChunkProcessorCallbacks.begin (); it != m_lteChunkProcessorCallbacks.end (); it++)
         {
-          (*it)((*m_sumValues) / m_totDuration.GetSeconds ());
+          (*it)(m_meanValues);
         }
     }
   else
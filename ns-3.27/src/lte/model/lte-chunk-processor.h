@@ -30,11 +30,10 @@
 #include <ns3/ptr.h>
 #include <ns3/nstime.h>
 #include <ns3/object.h>
+#include <ns3/spectrum-value.h>
 
 namespace ns3 {
 
-class SpectrumValue;
-
 /// Chunk processor callback typedef
 typedef Callback< void, const SpectrumValue& > LteChunkProcessorCallback;
 
@@ -88,7 +87,8 @@ public:
   virtual void End ();
 
 private:
-  Ptr<SpectrumValue> m_sumValues; ///< sum values
+  Ptr<SpectrumValue> m_sumValues; ///< sum values, kept from a calculation to the next one to reuse their storage
+  SpectrumValue m_meanValues; ///< the mean of the values, kept to reuse its storage
   Time m_totDuration; ///< total duration
 
   std::vector<LteChunkProcessorCallback> m_lteChunkProcessorCallbacks; ///< chunk processor callback
@@ -31,9 +31,7 @@ namespace ns3 {
 NS_LOG_COMPONENT_DEFINE ("LteInterference");
 
 LteInterference::LteInterference ()
-  : m_receiving (false),
-    m_lastSignalId (0),
-    m_lastSignalIdBeforeReset (0)
+  : m_receiving (false)
 {
   NS_LOG_FUNCTION (this);
 }
@@ -50,6 +48,7 @@ LteInterference::DoDispose ()
   m_rsPowerChunkProcessorList.clear ();
   m_sinrChunkProcessorList.clear ();
   m_interfChunkProcessorList.clear ();
+  m_pendingSignals.clear ();
   m_rxSignal = 0;
   m_allSignals = 0;
   m_noise = 0;
@@ -75,7 +74,15 @@ LteInterference::StartRx (Ptr<const SpectrumValue> rxPsd)
   if (m_receiving == false)
     {
       NS_LOG_LOGIC ("first signal");
-      m_rxSignal = rxPsd->Copy ();
+      if (m_rxSignal != 0 && m_rxSignal->GetSpectrumModel () == rxPsd->GetSpectrumModel ())
+        {
+          // reuse the storage of the previous signal
+          (*m_rxSignal) = (*rxPsd);
+        }
+      else
+        {
+          m_rxSignal = rxPsd->Copy ();
+        }
       m_lastChangeTime = Now ();
       m_receiving = true;
       for (std::list<Ptr<LteChunkProcessor> >::const_iterator it = m_rsPowerChunkProcessorList.begin (); it != m_rsPowerChunkProcessorList.end (); ++it)
@@ -136,17 +143,21 @@ LteInterference::AddSignal (Ptr<const SpectrumValue> spd, const Time duration)
 {
   NS_LOG_FUNCTION (this << *spd << duration);
   DoAddSignal (spd);
-  uint32_t signalId = ++m_lastSignalId;
-  if (signalId == m_lastSignalIdBeforeReset)
+  PendingSignal signal;
+  signal.end = Now () + duration;
+  signal.spd = spd;
+  // the signals of a TTI usually end together, after the pending ones
+  std::vector<PendingSignal>::iterator it = m_pendingSignals.end ();
+  while (it != m_pendingSignals.begin () && (it - 1)->end > signal.end)
+    {
+      --it;
+    }
+  bool scheduled = (it != m_pendingSignals.begin () && (it - 1)->end == signal.end);
+  m_pendingSignals.insert (it, signal);
+  if (!scheduled)
     {
-      // This happens when m_lastSignalId eventually wraps around. Given that so
-      // many signals have elapsed since the last reset, we hope that by now there is
-      // no stale pending signal (i.e., a signal that was scheduled
-      // for subtraction before the reset). So we just move the
-      // boundary further.
-      m_lastSignalIdBeforeReset += 0x10000000;
+      Simulator::Schedule (duration, &LteInterference::DoSubtractSignals, this);
     }
-  Simulator::Schedule (duration, &LteInterference::DoSubtractSignal, this, spd, signalId);
 }
 
 
@@ -159,19 +170,19 @@ LteInterference::DoAddSignal  (Ptr<const SpectrumValue> spd)
 }
 
 void
-LteInterference::DoSubtractSignal  (Ptr<const SpectrumValue> spd, uint32_t signalId)
+LteInterference::DoSubtractSignals ()
 { 
-  NS_LOG_FUNCTION (this << *spd);
+  NS_LOG_FUNCTION (this);
   ConditionallyEvaluateChunk ();   
-  int32_t deltaSignalId = signalId - m_lastSignalIdBeforeReset;
-  if (deltaSignalId > 0)
-    {   
-      (*m_allSignals) -= (*spd);
-    }
-  else
+  // the signals pending before the last reset were dropped with it
+  std::vector<PendingSignal>::iterator it = m_pendingSignals.begin ();
+  while (it != m_pendingSignals.end () && it->end <= Now ())
     {
-      NS_LOG_INFO ("ignoring signal scheduled for subtraction before last reset");
+      NS_LOG_LOGIC (this << *(it->spd));
+      (*m_allSignals) -= (*(it->spd));
+      ++it;
     }
+  m_pendingSignals.erase (m_pendingSignals.begin (), it);
 }
 
 
@@ -188,17 +199,21 @@ LteInterference::ConditionallyEvaluateChunk ()
     {
       NS_LOG_LOGIC (this << " signal = " << *m_rxSignal << " allSignals = " << *m_allSignals << " noise = " << *m_noise);
 
-      SpectrumValue interf =  (*m_allSignals) - (*m_rxSignal) + (*m_noise);
+      // computed in place in the storage of the previous chunk
+      m_interf = (*m_allSignals);
+      m_interf -= (*m_rxSignal);
+      m_interf += (*m_noise);
 
-      SpectrumValue sinr = (*m_rxSignal) / interf;
+      m_sinr = (*m_rxSignal);
+      m_sinr /= m_interf;
       Time duration = Now () - m_lastChangeTime;
       for (std::list<Ptr<LteChunkProcessor> >::const_iterator it = m_sinrChunkProcessorList.begin (); it != m_sinrChunkProcessorList.end (); ++it)
         {
-          (*it)->EvaluateChunk (sinr, duration);
+          (*it)->EvaluateChunk (m_sinr, duration);
         }
       for (std::list<Ptr<LteChunkProcessor> >::const_iterator it = m_interfChunkProcessorList.begin (); it != m_interfChunkProcessorList.end (); ++it)
         {
-          (*it)->EvaluateChunk (interf, duration);
+          (*it)->EvaluateChunk (m_interf, duration);
         }
       for (std::list<Ptr<LteChunkProcessor> >::const_iterator it = m_rsPowerChunkProcessorList.begin (); it != m_rsPowerChunkProcessorList.end (); ++it)
         {
@@ -222,9 +237,9 @@ LteInterference::SetNoisePowerSpectralDensity (Ptr<const SpectrumValue> noisePsd
       // abort rx
       m_receiving = false;
     }
-  // record the last SignalId so that we can ignore all signals that
-  // were scheduled for subtraction before m_allSignal 
-  m_lastSignalIdBeforeReset = m_lastSignalId;
+  // drop the signals to subtract, so that those received before the
+  // reset are not subtracted from the new m_allSignals
+  m_pendingSignals.clear ();
 }
 
 void
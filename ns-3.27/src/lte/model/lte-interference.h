@@ -28,6 +28,7 @@
 #include <ns3/spectrum-value.h>
 
 #include <list>
+#include <vector>
 
 namespace ns3 {
 
@@ -129,12 +130,9 @@ private:
    */
   void DoAddSignal  (Ptr<const SpectrumValue> spd);
   /**
-   * Subtract signal
-   *
-   * @param spd the power spectral density of the new signal
-   * @param signalId the signal ID
+   * Subtract the signals ending now
    */
-  void DoSubtractSignal  (Ptr<const SpectrumValue> spd, uint32_t signalId);
+  void DoSubtractSignals ();
 
 
 
@@ -152,11 +150,22 @@ private:
 
   Ptr<const SpectrumValue> m_noise; ///< the noise value
 
+  SpectrumValue m_interf; ///< the interference and noise of the last chunk, kept to reuse its storage
+  SpectrumValue m_sinr; ///< the SINR of the last chunk, kept to reuse its storage
+
   Time m_lastChangeTime;     /**< the time of the last change in
                                 m_TotalPower */
 
-  uint32_t m_lastSignalId; ///< the last signal ID
-  uint32_t m_lastSignalIdBeforeReset; ///< the last signal ID before reset
+  /// A signal to subtract from m_allSignals when it ends
+  struct PendingSignal
+  {
+    Time end; ///< the end of the signal
+    Ptr<const SpectrumValue> spd; ///< the power spectral density of the signal
+  };
+
+  /** the signals to subtract from m_allSignals, ordered by end time; a
+      single event subtracts all the signals ending at the same time */
+  std::vector<PendingSignal> m_pendingSignals;
 
   /** all the processor instances that need to be notified whenever
   a new interference chunk is calculated */
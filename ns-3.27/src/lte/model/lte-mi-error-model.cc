@@ -335,83 +335,195 @@ static const double cEcrTable [9][38] = {
 };
 
 
-double 
-LteMiErrorModel::Mib (const SpectrumValue& sinr, const std::vector<int>& map, uint8_t mcs)
+/// An SINR to MI map, with uniformly spaced SINRs
+struct MiMap
 {
-  NS_LOG_FUNCTION (sinr << &map << (uint32_t) mcs);
-  
-  double MI;
-  double MIsum = 0.0;
-  SpectrumValue sinrCopy = sinr;
-  
-  for (uint32_t i = 0; i < map.size (); i++)
+  const double *mi; ///< the MI of each SINR
+  const double *sinr; ///< the SINRs (linear)
+  uint16_t size; ///< the number of SINRs
+  double scalingCoeff; ///< the number of SINR steps per unit of SINR
+};
+
+/**
+ * \param mi the MI of each SINR
+ * \param sinr the uniformly spaced SINRs (linear)
+ * \param size the number of SINRs
+ * \return the SINR to MI map
+ */
+static MiMap
+MakeMiMap (const double *mi, const double *sinr, uint16_t size)
+{
+  // since the SINRs are uniformly spaced, we have
+  // index = ((sinrLin - value[0]) / (value[SIZE-1] - value[0])) * (SIZE-1)
+  // the scaling coefficient is always the same, so it is computed once
+  MiMap map;
+  map.mi = mi;
+  map.sinr = sinr;
+  map.size = size;
+  map.scalingCoeff = (size - 1) / (sinr[size - 1] - sinr[0]);
+  return map;
+}
+
+/// SINR to MI map of QPSK
+static const MiMap g_miMapQpsk = MakeMiMap (MI_map_qpsk, MI_map_qpsk_axis, MI_MAP_QPSK_SIZE);
+/// SINR to MI map of 16-QAM
+static const MiMap g_miMap16qam = MakeMiMap (MI_map_16qam, MI_map_16qam_axis, MI_MAP_16QAM_SIZE);
+/// SINR to MI map of 64-QAM
+static const MiMap g_miMap64qam = MakeMiMap (MI_map_64qam, MI_map_64qam_axis, MI_MAP_64QAM_SIZE);
+
+/**
+ * \param map the SINR to MI map
+ * \param sinrLin the SINR (linear)
+ * \return the MI of the SINR
+ */
+static inline double
+GetMi (const MiMap &map, double sinrLin)
+{
+  if (sinrLin > map.sinr[map.size - 1])
     {
-      double sinrLin = sinrCopy[map.at (i)];
-      if (mcs <= MI_QPSK_MAX_ID) // QPSK
-        {
+      return 1;
+    }
+  double sinrIndexDouble = (sinrLin - map.sinr[0]) * map.scalingCoeff + 1;
+  // same as std::max (0.0, std::floor (sinrIndexDouble)), without the calls
+  uint32_t sinrIndex = sinrIndexDouble > 0 ? static_cast<uint32_t> (sinrIndexDouble) : 0;
+  NS_ASSERT_MSG (sinrIndex < map.size, "MI map out of data");
+  return map.mi[sinrIndex];
+}
 
-          if (sinrLin > MI_map_qpsk_axis[MI_MAP_QPSK_SIZE-1])
-            {
-              MI = 1;
-            }
-          else 
-            { 
-              // since the values in MI_map_qpsk_axis are uniformly spaced, we have
-              // index = ((sinrLin - value[0]) / (value[SIZE-1] - value[0])) * (SIZE-1)
-              // the scaling coefficient is always the same, so we use a static const
-              // to speed up the calculation
-              static const double scalingCoeffQpsk = 
-                (MI_MAP_QPSK_SIZE - 1) / (MI_map_qpsk_axis[MI_MAP_QPSK_SIZE-1] - MI_map_qpsk_axis[0]);
-              double sinrIndexDouble = (sinrLin -  MI_map_qpsk_axis[0]) * scalingCoeffQpsk + 1;
-              uint32_t sinrIndex = std::max(0.0, std::floor (sinrIndexDouble));
-              NS_ASSERT_MSG (sinrIndex < MI_MAP_QPSK_SIZE, "MI map out of data");
-              MI = MI_map_qpsk[sinrIndex];
-            }
-        }
-      else
+/// The parameters of the BLER curve of an ECR and a CB size
+struct BlerCurve
+{
+  double b; ///< the MI of a BLER of 0.5
+  double c; ///< the spread of the curve
+  double scale; ///< 1 / (sqrt (2) * c)
+};
+
+/// The BLER curves of each CB size and ECR, with the missing curves replaced
+class BlerCurves
+{
+public:
+  BlerCurves ();
+  BlerCurve m_curves[9][MI_64QAM_BLER_MAX_ID + 1]; ///< the BLER curves
+};
+
+BlerCurves::BlerCurves ()
+{
+  for (int cbIndex = 0; cbIndex < 9; cbIndex++)
+    {
+      for (int ecrId = 0; ecrId <= MI_64QAM_BLER_MAX_ID; ecrId++)
         {
-          if (mcs > MI_QPSK_MAX_ID && mcs <= MI_16QAM_MAX_ID )	// 16-QAM
+          double b = bEcrTable[cbIndex][ecrId];
+          if (b < 0.0)
             {
-              if (sinrLin > MI_map_16qam_axis[MI_MAP_16QAM_SIZE-1])
-                {
-                  MI = 1;
-                }
-              else 
+              //take the lowest CB size including this CB for removing CB size
+              //quatization errors
+              int i = cbIndex;
+              while ((i < 9) && (b < 0))
                 {
-                  // since the values in MI_map_16QAM_axis are uniformly spaced, we have
-                  // index = ((sinrLin - value[0]) / (value[SIZE-1] - value[0])) * (SIZE-1)
-                  // the scaling coefficient is always the same, so we use a static const
-                  // to speed up the calculation
-                  static const double scalingCoeff16qam = 
-                    (MI_MAP_16QAM_SIZE - 1) / (MI_map_16qam_axis[MI_MAP_16QAM_SIZE-1] - MI_map_16qam_axis[0]);
-                  double sinrIndexDouble = (sinrLin -  MI_map_16qam_axis[0]) * scalingCoeff16qam + 1;
-                  uint32_t sinrIndex = std::max(0.0, std::floor (sinrIndexDouble));
-                  NS_ASSERT_MSG (sinrIndex < MI_MAP_16QAM_SIZE, "MI map out of data");
-                  MI = MI_map_16qam[sinrIndex];
+                  b = bEcrTable[i++][ecrId];
                 }
             }
-          else // 64-QAM
+          double c = cEcrTable[cbIndex][ecrId];
+          if (c < 0.0)
             {
-              if (sinrLin > MI_map_64qam_axis[MI_MAP_64QAM_SIZE-1])
+              //take the lowest CB size including this CB for removing CB size
+              //quatization errors
+              int i = cbIndex;
+              while ((i < 9) && (c < 0))
                 {
-                  MI = 1;
-                }
-              else
-                {
-                  // since the values in MI_map_64QAM_axis are uniformly spaced, we have
-                  // index = ((sinrLin - value[0]) / (value[SIZE-1] - value[0])) * (SIZE-1)
-                  // the scaling coefficient is always the same, so we use a static const
-                  // to speed up the calculation
-                  static const double scalingCoeff64qam = 
-                    (MI_MAP_64QAM_SIZE - 1) / (MI_map_64qam_axis[MI_MAP_64QAM_SIZE-1] - MI_map_64qam_axis[0]);
-                  double sinrIndexDouble = (sinrLin -  MI_map_64qam_axis[0]) * scalingCoeff64qam + 1;
-                  uint32_t sinrIndex = std::max(0.0, std::floor (sinrIndexDouble));
-                  NS_ASSERT_MSG (sinrIndex < MI_MAP_64QAM_SIZE, "MI map out of data");
-                  MI = MI_map_64qam[sinrIndex];
+                  c = cEcrTable[i++][ecrId];
                 }
             }
+          m_curves[cbIndex][ecrId].b = b;
+          m_curves[cbIndex][ecrId].c = c;
+          m_curves[cbIndex][ecrId].scale = 1 / (std::sqrt (2.0) * c);
         }
-      NS_LOG_LOGIC (" RB " << map.at (i) << "Minimum SNR = " << 10 * std::log10 (sinrLin) << " dB, " << sinrLin << " V, MCS = " << (uint16_t)mcs << ", MI = " << MI);
+    }
+}
+
+/// BLER curves
+static const BlerCurves g_blerCurves;
+
+/// The largest argument of the BLER table, beyond which the BLER is 0 or 1
+static const double g_blerTableLimit = 6.0;
+/// The number of samples of the BLER table per unit of argument
+static const double g_blerTableScale = 512.0;
+/// The number of samples of the BLER table
+static const uint32_t g_blerTableSize = 2 * 6 * 512 + 1;
+
+/// The BLER 0.5 * (1 - erf (x)) for uniformly spaced arguments x
+class BlerTable
+{
+public:
+  BlerTable ();
+  /**
+   * \param x the argument
+   * \return the BLER, linearly interpolated between the two closest samples
+   */
+  double Get (double x) const;
+
+private:
+  double m_bler[g_blerTableSize + 1]; ///< the BLER of each argument, and a guard sample
+};
+
+BlerTable::BlerTable ()
+{
+  for (uint32_t i = 0; i < g_blerTableSize; i++)
+    {
+      m_bler[i] = 0.5 * (1 - erf (i / g_blerTableScale - g_blerTableLimit));
+    }
+  m_bler[g_blerTableSize] = m_bler[g_blerTableSize - 1];
+}
+
+double
+BlerTable::Get (double x) const
+{
+  if (x <= -g_blerTableLimit)
+    {
+      return 1.0;
+    }
+  if (x >= g_blerTableLimit)
+    {
+      return 0.0;
+    }
+  double position = (x + g_blerTableLimit) * g_blerTableScale;
+  uint32_t index = static_cast<uint32_t> (position);
+  double fraction = position - index;
+  return m_bler[index] + fraction * (m_bler[index + 1] - m_bler[index]);
+}
+
+/// BLER table
+static const BlerTable g_blerTable;
+
+
+double 
+LteMiErrorModel::Mib (const SpectrumValue& sinr, const std::vector<int>& map, uint8_t mcs)
+{
+  NS_LOG_FUNCTION (sinr << &map << (uint32_t) mcs);
+
+  const MiMap *miMap;
+  if (mcs <= MI_QPSK_MAX_ID) // QPSK
+    {
+      miMap = &g_miMapQpsk;
+    }
+  else if (mcs <= MI_16QAM_MAX_ID) // 16-QAM
+    {
+      miMap = &g_miMap16qam;
+    }
+  else // 64-QAM
+    {
+      miMap = &g_miMap64qam;
+    }
+
+  double MI;
+  double MIsum = 0.0;
+  Values::const_iterator sinrBegin = sinr.ConstValuesBegin ();
+  for (uint32_t i = 0; i < map.size (); i++)
+    {
+      NS_ASSERT (map[i] >= 0 && sinrBegin + map[i] < sinr.ConstValuesEnd ());
+      double sinrLin = sinrBegin[map[i]];
+      MI = GetMi (*miMap, sinrLin);
+      NS_LOG_LOGIC (" RB " << map[i] << "Minimum SNR = " << 10 * std::log10 (sinrLin) << " dB, " << sinrLin << " V, MCS = " << (uint16_t)mcs << ", MI = " << MI);
       MIsum += MI;
     }
   MI = MIsum / map.size ();
@@ -424,8 +536,6 @@ double
 LteMiErrorModel::MappingMiBler (double mib, uint8_t ecrId, uint16_t cbSize)
 {
   NS_LOG_FUNCTION (mib << (uint32_t) ecrId << (uint32_t) cbSize);
-  double b = 0;
-  double c = 0;
 
   NS_ASSERT_MSG (ecrId <= MI_64QAM_BLER_MAX_ID, "ECR out of range [0..37]: " << (uint16_t) ecrId);
   int cbIndex = 1;
@@ -436,31 +546,11 @@ LteMiErrorModel::MappingMiBler (double mib, uint8_t ecrId, uint16_t cbSize)
   cbIndex--;
   NS_LOG_LOGIC (" ECRid " << (uint16_t)ecrId << " ECR " << BlerCurvesEcrMap[ecrId] << " CB size " << cbSize << " CB size curve " << cbMiSizeTable[cbIndex]);
 
-  b = bEcrTable[cbIndex][ecrId];
-  if (b<0.0)
-    {
-      //take the lowest CB size including this CB for removing CB size
-      //quatization errors
-      int i = cbIndex;
-      while ((i<9)&&(b<0))
-        {
-          b = bEcrTable[i++][ecrId];
-        }
-    }
-  c = cEcrTable[cbIndex][ecrId];
-  if (c<0.0)
-    {
-      //take the lowest CB size including this CB for removing CB size
-      //quatization errors
-      int i = cbIndex;
-      while ((i<9)&&(c<0))
-        {
-          c = cEcrTable[i++][ecrId];
-        }
-    }
+  const BlerCurve &curve = g_blerCurves.m_curves[cbIndex][ecrId];
   // see IEEE802.16m EMD formula 55 of section 4.3.2.1
-  double bler = 0.5*( 1 - erf((mib-b)/(sqrt(2)*c)) );
-  NS_LOG_LOGIC ("MIB: " << mib << " BLER:" << bler << " b:" << b << " c:" << c);
+  // 0.5*( 1 - erf((mib-b)/(sqrt(2)*c)) ), interpolated from a table
+  double bler = g_blerTable.Get ((mib - curve.b) * curve.scale);
+  NS_LOG_LOGIC ("MIB: " << mib << " BLER:" << bler << " b:" << curve.b << " c:" << curve.c);
   return bler;
 }
 
@@ -472,30 +562,12 @@ LteMiErrorModel::GetPcfichPdcchError (const SpectrumValue& sinr)
   NS_LOG_FUNCTION (sinr);
   double MI;
   double MIsum = 0.0;
-  SpectrumValue sinrCopy = sinr;
-  Values::iterator sinrIt = sinrCopy.ValuesBegin ();
+  Values::const_iterator sinrIt = sinr.ConstValuesBegin ();
   uint16_t rb = 0;
-  NS_ASSERT (sinrIt!=sinrCopy.ValuesEnd ());
-  while (sinrIt!=sinrCopy.ValuesEnd ())
+  NS_ASSERT (sinrIt!=sinr.ConstValuesEnd ());
+  while (sinrIt!=sinr.ConstValuesEnd ())
     {
-      double sinrLin = *sinrIt;
-      if (sinrLin > MI_map_qpsk_axis[MI_MAP_QPSK_SIZE-1])
-        {
-          MI = 1;
-        }
-      else 
-        { 
-          // since the values in MI_map_qpsk_axis are uniformly spaced, we have
-          // index = ((sinrLin - value[0]) / (value[SIZE-1] - value[0])) * (SIZE-1)
-              // the scaling coefficient is always the same, so we use a static const
-              // to speed up the calculation
-          static const double scalingCoeffQpsk = 
-            (MI_MAP_QPSK_SIZE - 1) / (MI_map_qpsk_axis[MI_MAP_QPSK_SIZE-1] - MI_map_qpsk_axis[0]);
-          double sinrIndexDouble = (sinrLin -  MI_map_qpsk_axis[0]) * scalingCoeffQpsk + 1;
-          uint32_t sinrIndex = std::max(0.0, std::floor (sinrIndexDouble));
-          NS_ASSERT_MSG (sinrIndex < MI_MAP_QPSK_SIZE, "MI map out of data");
-          MI = MI_map_qpsk[sinrIndex];
-        }
+      MI = GetMi (g_miMapQpsk, *sinrIt);
       MIsum += MI;
       sinrIt++;
       rb++;
@@ -558,7 +630,7 @@ LteMiErrorModel::GetPcfichPdcchError (const SpectrumValue& sinr)
 
 
 TbStats_t
-LteMiErrorModel::GetTbDecodificationStats (const SpectrumValue& sinr, const std::vector<int>& map, uint16_t size, uint8_t mcs, HarqProcessInfoList_t miHistory)
+LteMiErrorModel::GetTbDecodificationStats (const SpectrumValue& sinr, const std::vector<int>& map, uint16_t size, uint8_t mcs, const HarqProcessInfoList_t &miHistory)
 {
   NS_LOG_FUNCTION (sinr << &map << (uint32_t) size << (uint32_t) mcs);
 
@@ -27,19 +27,43 @@
 #include <ns3/string.h>
 #include <ns3/double.h>
 #include "ns3/uinteger.h"
+#include <ns3/abort.h>
 #include <fstream>
+#include <cstring>
 #include <ns3/simulator.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
 
 namespace ns3 {
 
 NS_LOG_COMPONENT_DEFINE ("TraceFadingLossModel");
 
 NS_OBJECT_ENSURE_REGISTERED (TraceFadingLossModel);
+
+namespace {
+
+/// The first bytes of a binary fading trace
+const char g_binaryTraceMagic[8] = { 'n', 's', '3', '-', 'f', 'a', 'd', '\0' };
+
+/// The header of a binary fading trace, followed by the samples
+struct BinaryTraceHeader
+{
+  char magic[8]; ///< g_binaryTraceMagic
+  uint32_t rbNum; ///< the number of RB
+  uint32_t samplesNum; ///< the number of samples per RB
+};
+
+} // unnamed namespace
   
 
 
 TraceFadingLossModel::TraceFadingLossModel ()
-  : m_streamsAssigned (false)
+  : m_mappedTrace (0),
+    m_mappedSize (0),
+    m_fadingTrace (0),
+    m_streamsAssigned (false)
 {
   NS_LOG_FUNCTION (this);
   SetNext (NULL);
@@ -48,7 +72,8 @@ TraceFadingLossModel::TraceFadingLossModel ()
 
 TraceFadingLossModel::~TraceFadingLossModel ()
 {
-  m_fadingTrace.clear ();
+  UnmapTrace ();
+  m_textTrace.clear ();
   m_windowOffsetsMap.clear ();
   m_startVariableMap.clear ();
 }
@@ -117,31 +142,90 @@ TraceFadingLossModel::DoInitialize ()
 
 
 void
-TraceFadingLossModel::LoadTrace ()
+TraceFadingLossModel::ReadTextTrace (std::string fileName, uint8_t rbNum, uint32_t samplesNum, std::vector<double> &samples)
 {
-  NS_LOG_FUNCTION (this << "Loading Fading Trace " << m_traceFile);
+  NS_LOG_FUNCTION (fileName << (uint32_t) rbNum << samplesNum);
   std::ifstream ifTraceFile;
-  ifTraceFile.open (m_traceFile.c_str (), std::ifstream::in);
-  m_fadingTrace.clear ();
-  if (!ifTraceFile.good ())
+  ifTraceFile.open (fileName.c_str (), std::ifstream::in);
+  NS_ABORT_MSG_IF (!ifTraceFile.good (), "Fading trace file " << fileName << " not found");
+  samples.clear ();
+  samples.reserve (rbNum * samplesNum);
+  for (uint32_t i = 0; i < rbNum * samplesNum; i++)
+    {
+      double sample;
+      ifTraceFile >> sample;
+      NS_ABORT_MSG_IF (ifTraceFile.fail (), "Fading trace file " << fileName << " has less than "
+                       << (uint32_t) rbNum << " RB of " << samplesNum << " samples");
+      samples.push_back (sample);
+    }
+}
+
+void
+TraceFadingLossModel::ConvertTrace (std::string textFile, std::string binaryFile, uint8_t rbNum, uint32_t samplesNum)
+{
+  NS_LOG_FUNCTION (textFile << binaryFile << (uint32_t) rbNum << samplesNum);
+  std::vector<double> samples;
+  ReadTextTrace (textFile, rbNum, samplesNum, samples);
+
+  BinaryTraceHeader header;
+  std::memcpy (header.magic, g_binaryTraceMagic, sizeof (header.magic));
+  header.rbNum = rbNum;
+  header.samplesNum = samplesNum;
+  std::ofstream ofTraceFile (binaryFile.c_str (), std::ofstream::out | std::ofstream::binary | std::ofstream::trunc);
+  NS_ABORT_MSG_IF (!ofTraceFile.good (), "Cannot open fading trace file " << binaryFile);
+  ofTraceFile.write (reinterpret_cast<const char *> (&header), sizeof (header));
+  ofTraceFile.write (reinterpret_cast<const char *> (&samples[0]), samples.size () * sizeof (double));
+  ofTraceFile.close ();
+  NS_ABORT_MSG_IF (ofTraceFile.fail (), "Cannot write fading trace file " << binaryFile);
+}
+
+void
+TraceFadingLossModel::UnmapTrace ()
+{
+  if (m_mappedTrace != 0)
     {
-      NS_LOG_INFO (this << " File: " << m_traceFile);
-      NS_ASSERT_MSG(ifTraceFile.good (), " Fading trace file not found");
+      munmap (m_mappedTrace, m_mappedSize);
+      m_mappedTrace = 0;
+      m_mappedSize = 0;
     }
+}
 
-//   NS_LOG_INFO (this << " length " << m_traceLength.GetSeconds ());
-//   NS_LOG_INFO (this << " RB " << (uint32_t)m_rbNum << " samples " << m_samplesNum);
-  for (uint32_t i = 0; i < m_rbNum; i++)
+void
+TraceFadingLossModel::LoadTrace ()
+{
+  NS_LOG_FUNCTION (this << "Loading Fading Trace " << m_traceFile);
+  UnmapTrace ();
+  m_textTrace.clear ();
+
+  int fd = open (m_traceFile.c_str (), O_RDONLY);
+  NS_ABORT_MSG_IF (fd < 0, "Fading trace file " << m_traceFile << " not found");
+  struct stat st;
+  BinaryTraceHeader header;
+  if (fstat (fd, &st) == 0 && (size_t) st.st_size >= sizeof (header)
+      && read (fd, &header, sizeof (header)) == (ssize_t) sizeof (header)
+      && std::memcmp (header.magic, g_binaryTraceMagic, sizeof (header.magic)) == 0)
     {
-      FadingTraceSample rbTimeFadingTrace;
-      for (uint32_t j = 0; j < m_samplesNum; j++)
-        {
-          double sample;
-          ifTraceFile >> sample;
-          rbTimeFadingTrace.push_back (sample);
-        }
-      m_fadingTrace.push_back (rbTimeFadingTrace);
+      // A binary trace: the samples are looked up in the mapped file, so
+      // that all the processes using the trace share the same pages
+      NS_ABORT_MSG_IF (header.rbNum != m_rbNum || header.samplesNum != m_samplesNum,
+                       "Fading trace file " << m_traceFile << " has " << header.rbNum << " RB of " << header.samplesNum
+                       << " samples instead of " << (uint32_t) m_rbNum << " RB of " << m_samplesNum);
+      size_t size = sizeof (header) + (size_t) m_rbNum * m_samplesNum * sizeof (double);
+      NS_ABORT_MSG_IF ((size_t) st.st_size != size, "Fading trace file " << m_traceFile << " is truncated");
+      void *trace = mmap (0, size, PROT_READ, MAP_SHARED, fd, 0);
+      close (fd);
+      NS_ABORT_MSG_IF (trace == MAP_FAILED, "Cannot map fading trace file " << m_traceFile);
+      m_mappedTrace = trace;
+      m_mappedSize = size;
+      m_fadingTrace = reinterpret_cast<const double *> (static_cast<const char *> (trace) + sizeof (header));
     }
+  else
+    {
+      close (fd);
+      ReadTextTrace (m_traceFile, m_rbNum, m_samplesNum, m_textTrace);
+      m_fadingTrace = &m_textTrace[0];
+    }
+
   m_timeGranularity = m_traceLength.GetMilliSeconds () / m_samplesNum;
   m_lastWindowUpdate = Simulator::Now ();
 }
@@ -201,17 +285,17 @@ TraceFadingLossModel::DoCalcRxPowerSpectralDensity (
   //double speed = std::sqrt (std::pow (aSpeedVector.x-bSpeedVector.x,2) + std::pow (aSpeedVector.y-bSpeedVector.y,2));
 
   NS_LOG_LOGIC (this << *rxPsd);
-  NS_ASSERT (!m_fadingTrace.empty ());
+  NS_ASSERT (m_fadingTrace != 0);
   int now_ms = static_cast<int> (Simulator::Now ().GetMilliSeconds () * m_timeGranularity);
   int lastUpdate_ms = static_cast<int> (m_lastWindowUpdate.GetMilliSeconds () * m_timeGranularity);
   int index = ((*itOff).second + now_ms - lastUpdate_ms) % m_samplesNum;
   int subChannel = 0;
   while (vit != rxPsd->ValuesEnd ())
     {
-      NS_ASSERT (subChannel < 100);
       if (*vit != 0.)
         {
-          double fading = m_fadingTrace.at (subChannel).at (index);
+          NS_ABORT_MSG_IF (subChannel >= m_rbNum, "Fading trace has no RB " << subChannel);
+          double fading = m_fadingTrace[subChannel * m_samplesNum + index];
           NS_LOG_INFO (this << " FADING now " << now_ms << " offset " << (*itOff).second << " id " << index << " fading " << fading);
           double power = *vit; // in Watt/Hz
           power = 10 * std::log10 (180000 * power); // in dB
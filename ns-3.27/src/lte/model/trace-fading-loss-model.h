@@ -27,6 +27,7 @@
 #include <ns3/object.h>
 #include <ns3/spectrum-propagation-loss-model.h>
 #include <map>
+#include <vector>
 #include "ns3/random-variable-stream.h"
 #include <ns3/nstime.h>
 
@@ -70,7 +71,21 @@ public:
   */
   int64_t AssignStreams (int64_t stream);
 
-  
+  /**
+   * \brief Convert a fading trace from the text format to the binary format
+   *
+   * The binary trace holds a header with the number of RB and samples,
+   * followed by the samples of each RB in turn as native doubles.  It is
+   * memory-mapped read-only instead of being parsed, so that the pages
+   * are shared by all the simulations using the trace on a host.
+   *
+   * \param textFile the name of the text trace to read
+   * \param binaryFile the name of the binary trace to write
+   * \param rbNum the number of RB the trace is made of
+   * \param samplesNum the number of samples per RB
+   */
+  static void ConvertTrace (std::string textFile, std::string binaryFile, uint8_t rbNum, uint32_t samplesNum);
+
 private:
   /**
    * \param txPsd set of values vs frequency representing the
@@ -105,6 +120,16 @@ private:
   
   /// Load trace function
   void LoadTrace ();
+  /// Unmap the binary trace, if one is mapped
+  void UnmapTrace ();
+  /**
+   * \brief Parse a text trace
+   * \param fileName the text trace
+   * \param rbNum the number of RB the trace is made of
+   * \param samplesNum the number of samples per RB
+   * \param samples the samples of each RB in turn
+   */
+  static void ReadTextTrace (std::string fileName, uint8_t rbNum, uint32_t samplesNum, std::vector<double> &samples);
 
 
    
@@ -112,20 +137,12 @@ private:
   
   mutable std::map <ChannelRealizationId_t, Ptr<UniformRandomVariable> > m_startVariableMap; ///< start variable map
   
-  /**
-   * Vector with fading samples in time domain (for a fixed RB)
-   */
-  typedef std::vector<double> FadingTraceSample;
-  /**
-   * Vector collecting the time fading traces in the frequency domain (per RB)
-   */
-  typedef std::vector<FadingTraceSample> FadingTrace;
-
-
-  
   std::string m_traceFile; ///< the trace file name
   
-  FadingTrace m_fadingTrace; ///< fading trace
+  std::vector<double> m_textTrace; ///< the samples parsed from a text trace
+  void *m_mappedTrace; ///< the binary trace mapped in memory, or 0
+  size_t m_mappedSize; ///< the size of the binary trace mapped in memory
+  const double *m_fadingTrace; ///< the fading samples of each RB in turn, in either trace
 
   
   Time m_traceLength; ///< the trace time
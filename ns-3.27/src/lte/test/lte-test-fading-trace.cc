@@ -0,0 +1,193 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/test.h"
+#include "ns3/log.h"
+#include "ns3/simulator.h"
+#include "ns3/string.h"
+#include "ns3/uinteger.h"
+#include "ns3/nstime.h"
+#include "ns3/spectrum-value.h"
+#include "ns3/constant-position-mobility-model.h"
+#include "ns3/trace-fading-loss-model.h"
+#include <fstream>
+#include <cmath>
+
+using namespace ns3;
+
+NS_LOG_COMPONENT_DEFINE ("LteTestFadingTrace");
+
+/**
+ * \ingroup lte-test
+ * \ingroup tests
+ *
+ * \brief Test case that checks that a fading trace converted to the
+ * binary format gives the same fading as the text trace it comes from.
+ *
+ * The sample j of RB k is -k - j / 100 dB, so that the sample used can be
+ * told from the fading applied to the first RB.
+ */
+class LteFadingTraceTestCase : public TestCase
+{
+public:
+  LteFadingTraceTestCase ();
+  virtual ~LteFadingTraceTestCase ();
+
+private:
+  virtual void DoRun (void);
+
+  /**
+   * Create a fading model
+   * \param fileName the trace file
+   * \return the fading model
+   */
+  Ptr<TraceFadingLossModel> CreateModel (std::string fileName) const;
+  /**
+   * \param psd the received PSD
+   * \param rb the RB
+   * \return the fading applied to the RB (dB)
+   */
+  double GetFading (Ptr<const SpectrumValue> psd, uint32_t rb) const;
+  /// Check the fading of both models at the current time
+  void CheckFading (void);
+
+  Ptr<TraceFadingLossModel> m_textModel; ///< the model using the text trace
+  Ptr<TraceFadingLossModel> m_binaryModel; ///< the model using the binary trace
+  Ptr<MobilityModel> m_a; ///< the sender
+  Ptr<MobilityModel> m_b; ///< the receiver
+  Ptr<SpectrumValue> m_txPsd; ///< the transmitted PSD
+  int64_t m_lastSample; ///< the sample used at the previous check
+};
+
+/// The number of RB of the trace
+static const uint32_t g_rbNum = 4;
+/// The number of samples per RB of the trace
+static const uint32_t g_samplesNum = 100;
+
+LteFadingTraceTestCase::LteFadingTraceTestCase ()
+  : TestCase ("Check that a binary fading trace gives the fading of the text trace"),
+    m_lastSample (-1)
+{
+}
+
+LteFadingTraceTestCase::~LteFadingTraceTestCase ()
+{
+}
+
+Ptr<TraceFadingLossModel>
+LteFadingTraceTestCase::CreateModel (std::string fileName) const
+{
+  Ptr<TraceFadingLossModel> model = CreateObject<TraceFadingLossModel> ();
+  model->SetAttribute ("TraceFilename", StringValue (fileName));
+  model->SetAttribute ("TraceLength", TimeValue (MilliSeconds (g_samplesNum)));
+  model->SetAttribute ("SamplesNum", UintegerValue (g_samplesNum));
+  model->SetAttribute ("WindowSize", TimeValue (MilliSeconds (20)));
+  model->SetAttribute ("RbNum", UintegerValue (g_rbNum));
+  model->AssignStreams (1);
+  model->Initialize ();
+  return model;
+}
+
+double
+LteFadingTraceTestCase::GetFading (Ptr<const SpectrumValue> psd, uint32_t rb) const
+{
+  return 10 * std::log10 ((*psd)[rb] / (*m_txPsd)[rb]);
+}
+
+void
+LteFadingTraceTestCase::CheckFading (void)
+{
+  Ptr<SpectrumValue> textPsd = m_textModel->CalcRxPowerSpectralDensity (m_txPsd, m_a, m_b);
+  Ptr<SpectrumValue> binaryPsd = m_binaryModel->CalcRxPowerSpectralDensity (m_txPsd, m_a, m_b);
+
+  double fading = GetFading (textPsd, 0);
+  int64_t sample = std::floor (-fading * 100 + 0.5);
+  NS_TEST_ASSERT_MSG_EQ_TOL (fading, -sample / 100.0, 1e-9, "The fading is not a sample of the trace");
+  for (uint32_t rb = 0; rb < g_rbNum; rb++)
+    {
+      double textFading = GetFading (textPsd, rb);
+      double binaryFading = GetFading (binaryPsd, rb);
+      NS_TEST_ASSERT_MSG_EQ (binaryFading, textFading, "Different fading of RB " << rb << " at " << Simulator::Now ().GetMilliSeconds () << " ms");
+      NS_TEST_ASSERT_MSG_EQ_TOL (textFading, -(double) rb - sample / 100.0, 1e-9, "Wrong sample of RB " << rb);
+    }
+  // The samples follow each other within a window
+  if (m_lastSample >= 0 && Simulator::Now () != MilliSeconds (20) && Simulator::Now () != MilliSeconds (40))
+    {
+      NS_TEST_ASSERT_MSG_EQ (sample, (m_lastSample + 1) % g_samplesNum, "Wrong sample at " << Simulator::Now ().GetMilliSeconds () << " ms");
+    }
+  m_lastSample = sample;
+}
+
+void
+LteFadingTraceTestCase::DoRun (void)
+{
+  std::string textFile = CreateTempDirFilename ("fading-trace.fad");
+  std::string binaryFile = CreateTempDirFilename ("fading-trace.fadb");
+  std::ofstream text (textFile.c_str ());
+  text.precision (17);
+  for (uint32_t rb = 0; rb < g_rbNum; rb++)
+    {
+      for (uint32_t j = 0; j < g_samplesNum; j++)
+        {
+          text << -(double) rb - j / 100.0 << " ";
+        }
+      text << std::endl;
+    }
+  text.close ();
+  TraceFadingLossModel::ConvertTrace (textFile, binaryFile, g_rbNum, g_samplesNum);
+
+  m_textModel = CreateModel (textFile);
+  m_binaryModel = CreateModel (binaryFile);
+  m_a = CreateObject<ConstantPositionMobilityModel> ();
+  m_b = CreateObject<ConstantPositionMobilityModel> ();
+  std::vector<double> frequencies;
+  for (uint32_t rb = 0; rb < g_rbNum; rb++)
+    {
+      frequencies.push_back (2.1e9 + rb * 180000);
+    }
+  m_txPsd = Create<SpectrumValue> (Create<SpectrumModel> (frequencies));
+  (*m_txPsd) = 1e-16;
+
+  for (uint32_t t = 0; t < 60; t++)
+    {
+      Simulator::Schedule (MilliSeconds (t), &LteFadingTraceTestCase::CheckFading, this);
+    }
+  Simulator::Run ();
+  Simulator::Destroy ();
+
+  m_textModel = 0;
+  m_binaryModel = 0;
+}
+
+/**
+ * \ingroup lte-test
+ * \ingroup tests
+ *
+ * \brief Test suite for the fading traces
+ */
+class LteFadingTraceTestSuite : public TestSuite
+{
+public:
+  LteFadingTraceTestSuite ();
+};
+
+static LteFadingTraceTestSuite g_lteFadingTraceTestSuite; ///< the test suite
+
+LteFadingTraceTestSuite::LteFadingTraceTestSuite ()
+  : TestSuite ("lte-fading-trace", UNIT)
+{
+  AddTestCase (new LteFadingTraceTestCase, TestCase::QUICK);
+}
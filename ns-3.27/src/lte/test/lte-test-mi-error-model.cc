@@ -0,0 +1,217 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/test.h"
+#include "ns3/log.h"
+#include "ns3/spectrum-value.h"
+#include "ns3/lte-mi-error-model.h"
+#include <cmath>
+
+using namespace ns3;
+
+NS_LOG_COMPONENT_DEFINE ("LteTestMiErrorModel");
+
+/// The BLER of a CB, as computed with erf before the BLER table was used
+struct CbBlerReference
+{
+  uint8_t ecrId; ///< the ECR ID
+  uint16_t cbSize; ///< the CB size
+  double mib; ///< the MI per bit
+  double bler; ///< the BLER
+};
+
+/// The BLER at the middle of some of the curves
+static const CbBlerReference g_cbBlerReferences[] = {
+  { 0, 40, 0.025, 0.47943750367346649 },
+  { 0, 1000, 0.017, 0.37785807728839654 },
+  { 0, 6144, 0.016, 0.47844604912351413 },
+  { 5, 40, 0.189, 0.48713312572714129 },
+  { 5, 1000, 0.167, 0.48902132333402842 },
+  { 5, 6144, 0.162, 0.40129367431707685 },
+  { 9, 40, 0.393, 0.49606313350051073 },
+  { 9, 1000, 0.382, 0.49635674214520314 },
+  { 9, 6144, 0.373, 0.47508233097075209 },
+  { 12, 40, 0.609, 0.48770578041959756 },
+  { 12, 1000, 0.609, 0.48770578041959756 },
+  { 12, 6144, 0.589, 0.45808349812990284 },
+  { 13, 40, 0.151, 0.46276265047230625 },
+  { 13, 1000, 0.151, 0.46276265047230625 },
+  { 13, 6144, 0.145, 0.48538999691394008 },
+  { 18, 40, 0.448, 0.48549620448458608 },
+  { 18, 1000, 0.448, 0.48549620448458608 },
+  { 18, 6144, 0.434, 0.49376678050011102 },
+  { 22, 40, 0.662, 0.49787797660013783 },
+  { 22, 1000, 0.662, 0.49787797660013783 },
+  { 22, 6144, 0.653, 0.49002748180476308 },
+  { 23, 40, 0.140, 0.46496088567772853 },
+  { 23, 1000, 0.140, 0.46496088567772853 },
+  { 23, 6144, 0.138, 0.43706456580877362 },
+  { 30, 40, 0.658, 0.49353094924750335 },
+  { 30, 1000, 0.658, 0.49353094924750335 },
+  { 30, 6144, 0.650, 0.46535303588420468 },
+  { 37, 40, 0.937, 0.4953066696732692 },
+  { 37, 1000, 0.937, 0.4953066696732692 },
+  { 37, 6144, 0.933, 0.46565097423210533 },
+};
+
+/// The statistics of a TB, as computed before the BLER table was used
+struct TbStatsReference
+{
+  uint8_t mcs; ///< the MCS
+  uint16_t size; ///< the TB size (bytes)
+  double sinrDb; ///< the mean SINR (dB)
+  double mi; ///< the MI of the TB
+  double tbler; ///< the TBLER of a first transmission
+  double harqTbler; ///< the TBLER of a retransmission
+};
+
+/// The statistics of the TBs with neither a null nor a certain error
+static const TbStatsReference g_tbStatsReferences[] = {
+  { 0, 40, -6, 0.17663532000000001, 8.530745077922619e-05, 0 },
+  { 4, 40, -6, 0.17663532000000001, 0.99997215241125492, 0.65671547829744248 },
+  { 4, 40, -3, 0.30938324, 0.10796371404379901, 1.5187850976872141e-13 },
+  { 4, 400, -6, 0.17663532000000001, 1, 0.13970032015273093 },
+  { 9, 40, -3, 0.30938324, 1, 0.96934281104484288 },
+  { 9, 40, 0, 0.49795391999999994, 0.99991906877014536, 6.682714885319907e-05 },
+  { 9, 40, 3, 0.74070959999999986, 2.7937677213318857e-06, 0 },
+  { 9, 400, -3, 0.30938324, 1, 0.99998157548333477 },
+  { 10, 40, 0, 0.23777575999999992, 0.99999999999825762, 0.91945963019050803 },
+  { 10, 40, 3, 0.37029856, 0.6539883879332884, 3.5267344600242723e-12 },
+  { 10, 400, 0, 0.23777575999999992, 1, 0.99198298975400845 },
+  { 10, 400, 3, 0.37029856, 0.62302167546111764, 0 },
+  { 10, 1500, 3, 0.37029856, 0.99839634556069545, 0 },
+  { 13, 40, 0, 0.23777575999999992, 1, 0.95143203447749525 },
+  { 13, 40, 6, 0.53118159999999992, 0.075891835069565428, 0 },
+  { 13, 400, 0, 0.23777575999999992, 1, 0.99867948784517457 },
+  { 13, 400, 6, 0.53118159999999992, 3.1242152435106973e-06, 0 },
+  { 16, 40, 0, 0.23777575999999992, 1, 0.97435456287851552 },
+  { 16, 400, 0, 0.23777575999999992, 1, 0.9998726732483646 },
+  { 17, 40, 6, 0.34635808000000007, 1, 0.030445630715682515 },
+  { 17, 40, 9, 0.47426728000000007, 0.9742796930043307, 0 },
+  { 17, 400, 9, 0.47426728000000007, 0.99688384459036405, 0 },
+  { 17, 1500, 6, 0.34635808000000007, 1, 4.0399453109962735e-05 },
+  { 22, 40, 6, 0.34635808000000007, 1, 0.088018528825589804 },
+  { 22, 40, 15, 0.75225359999999997, 0.0061142400836756705, 0 },
+  { 22, 400, 6, 0.34635808000000007, 1, 3.9864325313665461e-05 },
+  { 22, 1500, 6, 0.34635808000000007, 1, 0.0016992292113499063 },
+  { 28, 40, 6, 0.34635808000000007, 1, 0.17256141252150808 },
+  { 28, 40, 21, 0.96011372000000028, 0.0031568756482536764, 0 },
+  { 28, 400, 6, 0.34635808000000007, 1, 0.00063654626937031944 },
+  { 28, 400, 21, 0.96011372000000028, 0.0031568756482536764, 0 },
+  { 28, 1500, 6, 0.34635808000000007, 1, 0.018134755600855312 },
+  { 28, 1500, 21, 0.96011372000000028, 0.00022242101593017427, 0 },
+};
+
+/**
+ * \ingroup lte-test
+ * \ingroup tests
+ *
+ * \brief Test case that checks the BLER of the MI error model against the
+ * values computed before the BLER curves were interpolated from a table.
+ */
+class LteMiErrorModelTestCase : public TestCase
+{
+public:
+  LteMiErrorModelTestCase ();
+  virtual ~LteMiErrorModelTestCase ();
+
+private:
+  virtual void DoRun (void);
+};
+
+LteMiErrorModelTestCase::LteMiErrorModelTestCase ()
+  : TestCase ("Check the BLER of the MI error model against the erf BLER curves")
+{
+}
+
+LteMiErrorModelTestCase::~LteMiErrorModelTestCase ()
+{
+}
+
+void
+LteMiErrorModelTestCase::DoRun (void)
+{
+  for (uint32_t i = 0; i < sizeof (g_cbBlerReferences) / sizeof (g_cbBlerReferences[0]); i++)
+    {
+      const CbBlerReference &ref = g_cbBlerReferences[i];
+      double bler = LteMiErrorModel::MappingMiBler (ref.mib, ref.ecrId, ref.cbSize);
+      NS_TEST_ASSERT_MSG_EQ_TOL (bler, ref.bler, 1e-6, "Wrong BLER of ECR " << (uint32_t) ref.ecrId << " CB size " << ref.cbSize);
+      // The curves decrease from 1 to 0
+      double lower = LteMiErrorModel::MappingMiBler (ref.mib - 0.01, ref.ecrId, ref.cbSize);
+      double higher = LteMiErrorModel::MappingMiBler (ref.mib + 0.01, ref.ecrId, ref.cbSize);
+      NS_TEST_ASSERT_MSG_GT (lower, bler, "BLER curve not decreasing");
+      NS_TEST_ASSERT_MSG_LT (higher, bler, "BLER curve not decreasing");
+      double first = LteMiErrorModel::MappingMiBler (0, ref.ecrId, ref.cbSize);
+      double last = LteMiErrorModel::MappingMiBler (1, ref.ecrId, ref.cbSize);
+      NS_TEST_ASSERT_MSG_GT (first, 0.3, "Wrong BLER at no MI");
+      NS_TEST_ASSERT_MSG_LT (last, 1e-6, "Wrong BLER at full MI");
+    }
+
+  // 50 RBs with a SINR varying around its mean, and a TB on every other RB
+  std::vector<double> frequencies;
+  for (uint32_t rb = 0; rb < 50; rb++)
+    {
+      frequencies.push_back (2.1e9 + rb * 180000);
+    }
+  Ptr<SpectrumModel> model = Create<SpectrumModel> (frequencies);
+  std::vector<int> map;
+  for (int rb = 0; rb < 50; rb += 2)
+    {
+      map.push_back (rb);
+    }
+  for (uint32_t i = 0; i < sizeof (g_tbStatsReferences) / sizeof (g_tbStatsReferences[0]); i++)
+    {
+      const TbStatsReference &ref = g_tbStatsReferences[i];
+      SpectrumValue sinr (model);
+      for (uint32_t rb = 0; rb < 50; rb++)
+        {
+          sinr[rb] = std::pow (10, (ref.sinrDb + 3 * std::sin (rb)) / 10);
+        }
+      HarqProcessInfoList_t history;
+      TbStats_t stats = LteMiErrorModel::GetTbDecodificationStats (sinr, map, ref.size, ref.mcs, history);
+      NS_TEST_ASSERT_MSG_EQ_TOL (stats.mi, ref.mi, 1e-12, "Wrong MI of MCS " << (uint32_t) ref.mcs << " at " << ref.sinrDb << " dB");
+      NS_TEST_ASSERT_MSG_EQ_TOL (stats.tbler, ref.tbler, 1e-6, "Wrong TBLER of MCS " << (uint32_t) ref.mcs << " size " << ref.size << " at " << ref.sinrDb << " dB");
+
+      HarqProcessInfoElement_t element;
+      element.m_mi = stats.mi * 0.8;
+      element.m_rv = 1;
+      element.m_infoBits = ref.size * 8;
+      element.m_codeBits = ref.size * 16;
+      history.push_back (element);
+      stats = LteMiErrorModel::GetTbDecodificationStats (sinr, map, ref.size, ref.mcs, history);
+      NS_TEST_ASSERT_MSG_EQ_TOL (stats.tbler, ref.harqTbler, 1e-6, "Wrong TBLER of the retransmission of MCS " << (uint32_t) ref.mcs << " size " << ref.size << " at " << ref.sinrDb << " dB");
+    }
+}
+
+/**
+ * \ingroup lte-test
+ * \ingroup tests
+ *
+ * \brief Test suite for the MI error model
+ */
+class LteMiErrorModelTestSuite : public TestSuite
+{
+public:
+  LteMiErrorModelTestSuite ();
+};
+
+static LteMiErrorModelTestSuite g_lteMiErrorModelTestSuite; ///< the test suite
+
+LteMiErrorModelTestSuite::LteMiErrorModelTestSuite ()
+  : TestSuite ("lte-mi-error-model", UNIT)
+{
+  AddTestCase (new LteMiErrorModelTestCase, TestCase::QUICK);
+}
@@ -0,0 +1,202 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+#include "spatial-grid.h"
+#include "mobility-model.h"
+#include "constant-position-mobility-model.h"
+#include "ns3/assert.h"
+#include "ns3/log.h"
+#include <algorithm>
+#include <cmath>
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("SpatialGrid");
+
+SpatialGrid::SpatialGrid (double cellSize)
+  : m_cellSize (cellSize)
+{
+  NS_LOG_FUNCTION (this << cellSize);
+  NS_ASSERT (cellSize > 0);
+}
+
+SpatialGrid::~SpatialGrid ()
+{
+  NS_LOG_FUNCTION (this);
+  Clear ();
+}
+
+void
+SpatialGrid::SetCellSize (double cellSize)
+{
+  NS_LOG_FUNCTION (this << cellSize);
+  NS_ASSERT (cellSize > 0);
+  NS_ASSERT_MSG (m_entries.empty (), "The cell size of a SpatialGrid can only be changed while it is empty");
+  m_cellSize = cellSize;
+}
+
+double
+SpatialGrid::GetCellSize (void) const
+{
+  return m_cellSize;
+}
+
+uint32_t
+SpatialGrid::GetN (void) const
+{
+  return m_entries.size ();
+}
+
+uint64_t
+SpatialGrid::GetCellKey (int64_t x, int64_t y)
+{
+  // Far away cells may share a key, which only costs a few distance
+  // checks, since the entries of a cell are always checked.
+  return (static_cast<uint64_t> (static_cast<uint32_t> (x)) << 32) | static_cast<uint32_t> (y);
+}
+
+uint64_t
+SpatialGrid::GetCellKey (const Vector &position) const
+{
+  return GetCellKey (static_cast<int64_t> (std::floor (position.x / m_cellSize)),
+                     static_cast<int64_t> (std::floor (position.y / m_cellSize)));
+}
+
+void
+SpatialGrid::Add (uint32_t id, Ptr<MobilityModel> model)
+{
+  NS_LOG_FUNCTION (this << id << model);
+  Entry entry;
+  entry.id = id;
+  entry.model = model;
+  entry.cell = 0;
+  uint32_t index = m_entries.size ();
+  if (model != 0 && model->GetInstanceTypeId () == ConstantPositionMobilityModel::GetTypeId ())
+    {
+      entry.position = model->GetPosition ();
+      entry.cell = GetCellKey (entry.position);
+      m_cells[entry.cell].push_back (index);
+      if (m_stationary.find (PeekPointer (model)) == m_stationary.end ())
+        {
+          model->TraceConnectWithoutContext ("CourseChange", MakeCallback (&SpatialGrid::CourseChanged, this));
+        }
+      m_stationary.insert (std::make_pair (PeekPointer (model), index));
+    }
+  else
+    {
+      m_moving.push_back (index);
+    }
+  m_entries.push_back (entry);
+}
+
+void
+SpatialGrid::Clear (void)
+{
+  NS_LOG_FUNCTION (this);
+  std::multimap<const MobilityModel *, uint32_t>::const_iterator i = m_stationary.begin ();
+  while (i != m_stationary.end ())
+    {
+      m_entries[i->second].model->TraceDisconnectWithoutContext ("CourseChange", MakeCallback (&SpatialGrid::CourseChanged, this));
+      i = m_stationary.upper_bound (i->first);
+    }
+  m_entries.clear ();
+  m_cells.clear ();
+  m_moving.clear ();
+  m_stationary.clear ();
+}
+
+void
+SpatialGrid::FindInCell (const std::vector<uint32_t> &entries, const Vector &position,
+                         double distance, std::vector<uint32_t> &ids) const
+{
+  for (std::vector<uint32_t>::const_iterator i = entries.begin (); i != entries.end (); ++i)
+    {
+      const Entry &entry = m_entries[*i];
+      if (CalculateDistance (entry.position, position) <= distance)
+        {
+          ids.push_back (entry.id);
+        }
+    }
+}
+
+void
+SpatialGrid::Find (const Vector &position, double distance, std::vector<uint32_t> &ids) const
+{
+  NS_LOG_FUNCTION (this << position << distance);
+  ids.clear ();
+  double xMin = std::floor ((position.x - distance) / m_cellSize);
+  double xMax = std::floor ((position.x + distance) / m_cellSize);
+  double yMin = std::floor ((position.y - distance) / m_cellSize);
+  double yMax = std::floor ((position.y + distance) / m_cellSize);
+  if ((xMax - xMin + 1) * (yMax - yMin + 1) > m_cells.size ())
+    {
+      // There are fewer cells holding entries than cells in the square
+      for (std::unordered_map<uint64_t, std::vector<uint32_t> >::const_iterator i = m_cells.begin ();
+           i != m_cells.end (); ++i)
+        {
+          FindInCell (i->second, position, distance, ids);
+        }
+    }
+  else
+    {
+      for (int64_t x = static_cast<int64_t> (xMin); x <= static_cast<int64_t> (xMax); x++)
+        {
+          for (int64_t y = static_cast<int64_t> (yMin); y <= static_cast<int64_t> (yMax); y++)
+            {
+              std::unordered_map<uint64_t, std::vector<uint32_t> >::const_iterator i = m_cells.find (GetCellKey (x, y));
+              if (i != m_cells.end ())
+                {
+                  FindInCell (i->second, position, distance, ids);
+                }
+            }
+        }
+    }
+  for (std::vector<uint32_t>::const_iterator i = m_moving.begin (); i != m_moving.end (); ++i)
+    {
+      const Entry &entry = m_entries[*i];
+      if (entry.model == 0 || CalculateDistance (entry.model->GetPosition (), position) <= distance)
+        {
+          ids.push_back (entry.id);
+        }
+    }
+  std::sort (ids.begin (), ids.end ());
+}
+
+void
+SpatialGrid::CourseChanged (Ptr<const MobilityModel> model)
+{
+  NS_LOG_FUNCTION (this << model);
+  typedef std::multimap<const MobilityModel *, uint32_t>::const_iterator Iterator;
+  std::pair<Iterator, Iterator> range = m_stationary.equal_range (PeekPointer (model));
+  for (Iterator i = range.first; i != range.second; ++i)
+    {
+      Entry &entry = m_entries[i->second];
+      entry.position = model->GetPosition ();
+      uint64_t cell = GetCellKey (entry.position);
+      if (cell != entry.cell)
+        {
+          std::vector<uint32_t> &entries = m_cells[entry.cell];
+          entries.erase (std::find (entries.begin (), entries.end (), i->second));
+          if (entries.empty ())
+            {
+              m_cells.erase (entry.cell);
+            }
+          m_cells[cell].push_back (i->second);
+          entry.cell = cell;
+        }
+    }
+}
+
+} // namespace ns3
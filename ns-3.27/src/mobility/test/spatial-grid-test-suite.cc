@@ -0,0 +1,174 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/test.h"
+#include "ns3/simulator.h"
+#include "ns3/random-variable-stream.h"
+#include "ns3/spatial-grid.h"
+#include "ns3/constant-position-mobility-model.h"
+#include "ns3/constant-velocity-mobility-model.h"
+#include <vector>
+
+using namespace ns3;
+
+/**
+ * \ingroup mobility-test
+ * \ingroup tests
+ *
+ * \brief Compare the queries of a SpatialGrid with an exhaustive search,
+ * for stationary models, models which are given a new position, moving
+ * models and entries without a model.
+ */
+class SpatialGridFindTestCase : public TestCase
+{
+public:
+  SpatialGridFindTestCase ();
+  virtual ~SpatialGridFindTestCase ();
+
+private:
+  /**
+   * Check the queries at a set of positions and distances against
+   * the current positions of the models.
+   * \param grid the grid
+   */
+  void CheckQueries (const SpatialGrid &grid);
+  virtual void DoRun (void);
+
+  std::vector<Ptr<MobilityModel> > m_models; ///< the model of each id, possibly null
+  Ptr<UniformRandomVariable> m_random; ///< the positions
+};
+
+SpatialGridFindTestCase::SpatialGridFindTestCase ()
+  : TestCase ("Find the entries of a SpatialGrid near a position")
+{
+}
+
+SpatialGridFindTestCase::~SpatialGridFindTestCase ()
+{
+}
+
+void
+SpatialGridFindTestCase::CheckQueries (const SpatialGrid &grid)
+{
+  double distances[] = { 0, 5, 30, 99.9, 250, 1e6 };
+  std::vector<uint32_t> ids;
+  for (uint32_t i = 0; i < 50; i++)
+    {
+      Vector position (m_random->GetValue (-300, 300), m_random->GetValue (-300, 300), m_random->GetValue (0, 20));
+      for (uint32_t j = 0; j < sizeof (distances) / sizeof (distances[0]); j++)
+        {
+          std::vector<uint32_t> expected;
+          for (uint32_t id = 0; id < m_models.size (); id++)
+            {
+              if (m_models[id] == 0 || CalculateDistance (m_models[id]->GetPosition (), position) <= distances[j])
+                {
+                  expected.push_back (id);
+                }
+            }
+          grid.Find (position, distances[j], ids);
+          NS_TEST_ASSERT_MSG_EQ (ids.size (), expected.size (), "Wrong number of entries within " << distances[j] << " m of " << position);
+          for (uint32_t k = 0; k < ids.size (); k++)
+            {
+              NS_TEST_ASSERT_MSG_EQ (ids[k], expected[k], "Wrong entry within " << distances[j] << " m of " << position);
+            }
+        }
+    }
+}
+
+void
+SpatialGridFindTestCase::DoRun (void)
+{
+  m_random = CreateObject<UniformRandomVariable> ();
+  m_random->SetStream (1);
+
+  SpatialGrid grid (100);
+  for (uint32_t id = 0; id < 400; id++)
+    {
+      Ptr<MobilityModel> model;
+      if (id % 10 == 3)
+        {
+          Ptr<ConstantVelocityMobilityModel> moving = CreateObject<ConstantVelocityMobilityModel> ();
+          moving->SetVelocity (Vector (m_random->GetValue (-20, 20), m_random->GetValue (-20, 20), 0));
+          model = moving;
+        }
+      else if (id % 10 == 7 && id > 100)
+        {
+          // A model shared by several entries
+          model = m_models[id - 100];
+        }
+      else if (id % 50 != 9)
+        {
+          model = CreateObject<ConstantPositionMobilityModel> ();
+        }
+      if (model != 0)
+        {
+          model->SetPosition (Vector (m_random->GetValue (-300, 300), m_random->GetValue (-300, 300), m_random->GetValue (0, 20)));
+        }
+      m_models.push_back (model);
+      grid.Add (id, model);
+    }
+  NS_TEST_ASSERT_MSG_EQ (grid.GetN (), 400, "Wrong number of entries");
+  CheckQueries (grid);
+
+  // Move some stationary models, in and across cells
+  for (uint32_t id = 0; id < m_models.size (); id += 3)
+    {
+      if (m_models[id] != 0)
+        {
+          Vector position = m_models[id]->GetPosition ();
+          position.x += m_random->GetValue (-150, 150);
+          position.y += m_random->GetValue (-1, 1);
+          m_models[id]->SetPosition (position);
+        }
+    }
+  CheckQueries (grid);
+
+  // Let the moving models move
+  Simulator::Stop (Seconds (5));
+  Simulator::Run ();
+  CheckQueries (grid);
+
+  // Models are no longer followed once the grid is cleared
+  grid.Clear ();
+  NS_TEST_ASSERT_MSG_EQ (grid.GetN (), 0, "Entries left after Clear");
+  m_models[0]->SetPosition (Vector (0, 0, 0));
+  std::vector<uint32_t> ids;
+  grid.Find (Vector (0, 0, 0), 1e6, ids);
+  NS_TEST_ASSERT_MSG_EQ (ids.size (), 0, "Entries found after Clear");
+
+  m_models.clear ();
+  Simulator::Destroy ();
+}
+
+/**
+ * \ingroup mobility-test
+ * \ingroup tests
+ *
+ * \brief SpatialGrid Test Suite
+ */
+class SpatialGridTestSuite : public TestSuite
+{
+public:
+  SpatialGridTestSuite ();
+};
+
+SpatialGridTestSuite::SpatialGridTestSuite ()
+  : TestSuite ("spatial-grid", UNIT)
+{
+  AddTestCase (new SpatialGridFindTestCase, TestCase::QUICK);
+}
+
+static SpatialGridTestSuite spatialGridTestSuite; ///< the test suite
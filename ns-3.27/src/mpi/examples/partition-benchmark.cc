@@ -0,0 +1,219 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2017
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+// Compare a manual and an automatic assignment of system ids on the
+// topologies built by the point-to-point layout helpers.
+//
+// The manual assignment splits the node ids into contiguous blocks,
+// one per partition; the automatic one is computed by PartitionHelper.
+// Both are evaluated (links cut, lookahead, load imbalance), and the
+// one selected by --partitioner is then simulated by
+// MultithreadedSimulatorImpl, with one thread per partition.
+//
+// Topologies:
+//  - grid: a rows x cols PointToPointGridHelper grid with 1ms links;
+//    the first node of each column sends a UDP flow to the last one.
+//  - dumbbell: a PointToPointDumbbellHelper with 1ms leaf links and a
+//    5ms bottleneck; each left leaf sends a UDP flow to a right leaf.
+//
+// Usage:
+//   ./waf --run "partition-benchmark --topology=grid --partitions=4 --partitioner=manual"
+//   ./waf --run "partition-benchmark --topology=grid --partitions=4 --partitioner=auto"
+
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/internet-module.h"
+#include "ns3/point-to-point-module.h"
+#include "ns3/point-to-point-layout-module.h"
+#include "ns3/applications-module.h"
+#include "ns3/partition-helper.h"
+#include "ns3/multithreaded-simulator-impl.h"
+
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+
+using namespace ns3;
+
+NS_LOG_COMPONENT_DEFINE ("PartitionBenchmark");
+
+/**
+ * Print the metrics of the last partition evaluated by a helper.
+ *
+ * \param [in] name The name of the partition.
+ * \param [in] helper The helper.
+ * \param [in] ms The time taken to compute the partition.
+ */
+static void
+Report (std::string name, const PartitionHelper &helper, int64_t ms)
+{
+  std::ostringstream lookAhead;
+  if (helper.GetLookAhead () == Time::Max ())
+    {
+      lookAhead << "none";
+    }
+  else
+    {
+      lookAhead << helper.GetLookAhead ().GetSeconds () * 1000 << "ms";
+    }
+  std::cout << std::setw (8) << name
+            << std::setw (12) << helper.GetCutLinks ()
+            << std::setw (14) << lookAhead.str ()
+            << std::setw (12) << std::setprecision (3) << helper.GetLoadImbalance ()
+            << std::setw (10) << ms << std::endl;
+}
+
+int
+main (int argc, char *argv[])
+{
+  std::string topology = "grid";
+  std::string partitioner = "auto";
+  uint32_t rows = 16;
+  uint32_t cols = 16;
+  uint32_t leaves = 64;
+  uint32_t partitions = 4;
+  double stop = 5;
+
+  CommandLine cmd;
+  cmd.AddValue ("topology", "grid or dumbbell", topology);
+  cmd.AddValue ("partitioner", "partition to simulate: manual or auto", partitioner);
+  cmd.AddValue ("rows", "number of rows of the grid", rows);
+  cmd.AddValue ("cols", "number of columns of the grid", cols);
+  cmd.AddValue ("leaves", "number of leaves on each side of the dumbbell", leaves);
+  cmd.AddValue ("partitions", "number of partitions (threads)", partitions);
+  cmd.AddValue ("stop", "simulation stop time, in seconds", stop);
+  cmd.Parse (argc, argv);
+
+  NS_ABORT_MSG_IF (partitions == 0, "At least one partition is needed");
+  NS_ABORT_MSG_IF (partitioner != "manual" && partitioner != "auto",
+                   "Unknown partitioner " << partitioner);
+
+  GlobalValue::Bind ("SimulatorImplementationType",
+                     StringValue ("ns3::MultithreadedSimulatorImpl"));
+
+  InternetStackHelper stack;
+  // the flows go from sources[i] to sinks[i], at sinkAddresses[i]
+  NodeContainer sources;
+  NodeContainer sinks;
+  std::vector<Ipv4Address> sinkAddresses;
+  if (topology == "grid")
+    {
+      PointToPointHelper link;
+      link.SetDeviceAttribute ("DataRate", StringValue ("10Mbps"));
+      link.SetChannelAttribute ("Delay", StringValue ("1ms"));
+      PointToPointGridHelper grid (rows, cols, link);
+      grid.InstallStack (stack);
+      grid.AssignIpv4Addresses (Ipv4AddressHelper ("10.1.0.0", "255.255.255.0"),
+                                Ipv4AddressHelper ("10.128.0.0", "255.255.255.0"));
+      for (uint32_t c = 0; c < cols; ++c)
+        {
+          sources.Add (grid.GetNode (0, c));
+          sinks.Add (grid.GetNode (rows - 1, c));
+          sinkAddresses.push_back (grid.GetIpv4Address (rows - 1, c));
+        }
+    }
+  else if (topology == "dumbbell")
+    {
+      PointToPointHelper leaf;
+      leaf.SetDeviceAttribute ("DataRate", StringValue ("10Mbps"));
+      leaf.SetChannelAttribute ("Delay", StringValue ("1ms"));
+      PointToPointHelper bottleneck;
+      bottleneck.SetDeviceAttribute ("DataRate", StringValue ("1Gbps"));
+      bottleneck.SetChannelAttribute ("Delay", StringValue ("5ms"));
+      PointToPointDumbbellHelper dumbbell (leaves, leaf, leaves, leaf, bottleneck);
+      dumbbell.InstallStack (stack);
+      dumbbell.AssignIpv4Addresses (Ipv4AddressHelper ("10.1.0.0", "255.255.255.0"),
+                                    Ipv4AddressHelper ("10.128.0.0", "255.255.255.0"),
+                                    Ipv4AddressHelper ("10.255.0.0", "255.255.255.0"));
+      for (uint32_t i = 0; i < leaves; ++i)
+        {
+          sources.Add (dumbbell.GetLeft (i));
+          sinks.Add (dumbbell.GetRight (i));
+          sinkAddresses.push_back (dumbbell.GetRightIpv4Address (i));
+        }
+    }
+  else
+    {
+      NS_FATAL_ERROR ("Unknown topology " << topology);
+    }
+  Ipv4GlobalRoutingHelper::PopulateRoutingTables ();
+
+  uint16_t port = 9;
+  ApplicationContainer servers;
+  for (uint32_t i = 0; i < sources.GetN (); ++i)
+    {
+      UdpServerHelper server (port);
+      servers.Add (server.Install (sinks.Get (i)));
+      UdpClientHelper client (sinkAddresses[i], port);
+      client.SetAttribute ("MaxPackets", UintegerValue (1000000));
+      client.SetAttribute ("Interval", TimeValue (MilliSeconds (1)));
+      client.SetAttribute ("PacketSize", UintegerValue (512));
+      ApplicationContainer app = client.Install (sources.Get (i));
+      app.Start (Seconds (1));
+    }
+
+  // Evaluate both partitions, and keep the selected one.
+  NodeContainer nodes = NodeContainer::GetGlobal ();
+  uint32_t n = nodes.GetN ();
+  std::cout << topology << ", " << n << " nodes, " << partitions << " partitions" << std::endl
+            << std::setw (8) << "" << std::setw (12) << "links cut"
+            << std::setw (14) << "lookahead" << std::setw (12) << "imbalance"
+            << std::setw (10) << "ms" << std::endl;
+
+  PartitionHelper helper;
+  std::vector<uint32_t> manual (n);
+  for (uint32_t i = 0; i < n; ++i)
+    {
+      manual[i] = static_cast<uint64_t> (i) * partitions / n;
+      nodes.Get (i)->SetAttribute ("SystemId", UintegerValue (manual[i]));
+    }
+  helper.Evaluate (nodes);
+  Report ("manual", helper, 0);
+
+  SystemWallClockMs clock;
+  clock.Start ();
+  std::vector<uint32_t> automatic = helper.Partition (nodes, partitions);
+  Report ("auto", helper, clock.End ());
+
+  if (partitioner == "auto")
+    {
+      for (uint32_t i = 0; i < n; ++i)
+        {
+          nodes.Get (i)->SetAttribute ("SystemId", UintegerValue (automatic[i]));
+        }
+    }
+
+  Simulator::Stop (Seconds (stop));
+  clock.Start ();
+  Simulator::Run ();
+  int64_t ms = clock.End ();
+
+  uint64_t received = 0;
+  for (ApplicationContainer::Iterator i = servers.Begin (); i != servers.End (); ++i)
+    {
+      received += DynamicCast<UdpServer> (*i)->GetReceived ();
+    }
+  Ptr<MultithreadedSimulatorImpl> impl =
+    DynamicCast<MultithreadedSimulatorImpl> (Simulator::GetImplementation ());
+  std::cout << partitioner << " run: lookahead " << impl->GetLookAhead ().GetSeconds () * 1000
+            << " ms, " << impl->GetWindowCount () << " windows, "
+            << received << " packets received in " << ms << " ms" << std::endl;
+
+  Simulator::Destroy ();
+  return 0;
+}
@@ -0,0 +1,692 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2017
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "partition-helper.h"
+
+#include "ns3/node.h"
+#include "ns3/net-device.h"
+#include "ns3/channel.h"
+#include "ns3/uinteger.h"
+#include "ns3/log.h"
+#include "ns3/assert.h"
+
+#include <algorithm>
+#include <cmath>
+#include <map>
+#include <queue>
+#include <set>
+
+/**
+ * \file
+ * \ingroup mpi
+ * ns3::PartitionHelper implementation.
+ */
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("PartitionHelper");
+
+namespace {
+
+/** Marker of an unassigned vertex. */
+const uint32_t NONE = 0xffffffff;
+
+/**
+ * Find the root of a vertex in a union-find forest, compressing the path.
+ *
+ * \param [in,out] parent The forest.
+ * \param [in] v The vertex.
+ * \returns The root of \p v.
+ */
+uint32_t
+FindRoot (std::vector<uint32_t> &parent, uint32_t v)
+{
+  while (parent[v] != v)
+    {
+      parent[v] = parent[parent[v]];
+      v = parent[v];
+    }
+  return v;
+}
+
+} // unnamed namespace
+
+PartitionHelper::PartitionHelper ()
+  : m_imbalance (0.05),
+    m_cutLinks (0),
+    m_lookAhead (Time::Max ()),
+    m_loadImbalance (1)
+{
+  NS_LOG_FUNCTION (this);
+}
+
+void
+PartitionHelper::SetImbalance (double imbalance)
+{
+  NS_LOG_FUNCTION (this << imbalance);
+  NS_ASSERT (imbalance >= 0);
+  m_imbalance = imbalance;
+}
+
+void
+PartitionHelper::AddLink (Ptr<Node> a, Ptr<Node> b, Time delay)
+{
+  NS_LOG_FUNCTION (this << a << b << delay);
+  DeclaredLink link;
+  link.a = a;
+  link.b = b;
+  link.delay = delay;
+  m_declared.push_back (link);
+}
+
+std::vector<PartitionHelper::Link>
+PartitionHelper::GetLinks (NodeContainer nodes) const
+{
+  NS_LOG_FUNCTION (this);
+
+  std::map<uint32_t, uint32_t> index;
+  for (uint32_t i = 0; i < nodes.GetN (); ++i)
+    {
+      index[nodes.Get (i)->GetId ()] = i;
+    }
+
+  std::vector<Link> links;
+  std::set<uint32_t> channels;
+  for (uint32_t i = 0; i < nodes.GetN (); ++i)
+    {
+      Ptr<Node> node = nodes.Get (i);
+      for (uint32_t d = 0; d < node->GetNDevices (); ++d)
+        {
+          Ptr<Channel> channel = node->GetDevice (d)->GetChannel ();
+          if (channel == 0 || !channels.insert (channel->GetId ()).second)
+            {
+              continue;
+            }
+          std::vector<uint32_t> ends;
+          for (uint32_t j = 0; j < channel->GetNDevices (); ++j)
+            {
+              Ptr<Node> other = channel->GetDevice (j)->GetNode ();
+              std::map<uint32_t, uint32_t>::const_iterator it;
+              if (other != 0 && (it = index.find (other->GetId ())) != index.end ())
+                {
+                  ends.push_back (it->second);
+                }
+            }
+          TimeValue delay;
+          bool cuttable = channel->GetNDevices () == 2
+            && channel->GetAttributeFailSafe ("Delay", delay);
+          for (uint32_t j = 1; j < ends.size (); ++j)
+            {
+              Link link;
+              link.a = ends[0];
+              link.b = ends[j];
+              link.delay = cuttable ? delay.Get ().GetTimeStep () : -1;
+              links.push_back (link);
+            }
+        }
+    }
+
+  for (std::vector<DeclaredLink>::const_iterator i = m_declared.begin (); i != m_declared.end (); ++i)
+    {
+      std::map<uint32_t, uint32_t>::const_iterator a = index.find (i->a->GetId ());
+      std::map<uint32_t, uint32_t>::const_iterator b = index.find (i->b->GetId ());
+      if (a != index.end () && b != index.end ())
+        {
+          Link link;
+          link.a = a->second;
+          link.b = b->second;
+          link.delay = i->delay.GetTimeStep ();
+          links.push_back (link);
+        }
+    }
+  return links;
+}
+
+void
+PartitionHelper::Coarsen (const Graph &graph, uint32_t maxWeight,
+                          Graph &coarse, std::vector<uint32_t> &map)
+{
+  uint32_t n = graph.vertexWeight.size ();
+
+  // Visit the vertices by increasing degree, so that the vertices
+  // with few neighbours find a match.
+  std::vector<std::pair<uint32_t, uint32_t> > order;
+  order.reserve (n);
+  for (uint32_t v = 0; v < n; ++v)
+    {
+      order.push_back (std::make_pair (graph.start[v + 1] - graph.start[v], v));
+    }
+  std::stable_sort (order.begin (), order.end ());
+
+  std::vector<uint32_t> match (n, NONE);
+  for (uint32_t i = 0; i < n; ++i)
+    {
+      uint32_t v = order[i].second;
+      if (match[v] != NONE)
+        {
+          continue;
+        }
+      uint32_t best = v;
+      uint32_t bestWeight = 0;
+      for (uint32_t e = graph.start[v]; e < graph.start[v + 1]; ++e)
+        {
+          uint32_t u = graph.adjacent[e];
+          if (match[u] == NONE && u != v
+              && graph.edgeWeight[e] > bestWeight
+              && graph.vertexWeight[v] + graph.vertexWeight[u] <= maxWeight)
+            {
+              best = u;
+              bestWeight = graph.edgeWeight[e];
+            }
+        }
+      match[v] = best;
+      match[best] = v;
+    }
+
+  map.assign (n, NONE);
+  uint32_t nCoarse = 0;
+  for (uint32_t v = 0; v < n; ++v)
+    {
+      if (map[v] == NONE)
+        {
+          map[v] = nCoarse;
+          map[match[v]] = nCoarse;
+          nCoarse++;
+        }
+    }
+
+  coarse.vertexWeight.assign (nCoarse, 0);
+  coarse.start.assign (1, 0);
+  coarse.adjacent.clear ();
+  coarse.edgeWeight.clear ();
+  // position of each coarse neighbour in the edges of the current
+  // coarse vertex, or NONE
+  std::vector<uint32_t> position (nCoarse, NONE);
+  for (uint32_t v = 0; v < n; ++v)
+    {
+      if (map[v] != coarse.start.size () - 1)
+        {
+          continue;
+        }
+      // v is the first vertex of the next coarse vertex c
+      uint32_t c = map[v];
+      uint32_t first = coarse.adjacent.size ();
+      uint32_t members[2] = { v, match[v] };
+      for (uint32_t m = 0; m < (match[v] == v ? 1U : 2U); ++m)
+        {
+          uint32_t w = members[m];
+          coarse.vertexWeight[c] += graph.vertexWeight[w];
+          for (uint32_t e = graph.start[w]; e < graph.start[w + 1]; ++e)
+            {
+              uint32_t cu = map[graph.adjacent[e]];
+              if (cu == c)
+                {
+                  continue;
+                }
+              if (position[cu] == NONE)
+                {
+                  position[cu] = coarse.adjacent.size ();
+                  coarse.adjacent.push_back (cu);
+                  coarse.edgeWeight.push_back (0);
+                }
+              coarse.edgeWeight[position[cu]] += graph.edgeWeight[e];
+            }
+        }
+      for (uint32_t e = first; e < coarse.adjacent.size (); ++e)
+        {
+          position[coarse.adjacent[e]] = NONE;
+        }
+      coarse.start.push_back (coarse.adjacent.size ());
+    }
+}
+
+std::vector<uint32_t>
+PartitionHelper::Grow (const Graph &graph, uint32_t nPartitions)
+{
+  uint32_t n = graph.vertexWeight.size ();
+  std::vector<uint32_t> part (n, NONE);
+  std::vector<uint32_t> connection (n, 0);
+  std::vector<uint32_t> distance (n, NONE);
+  uint64_t remaining = 0;
+  for (uint32_t v = 0; v < n; ++v)
+    {
+      remaining += graph.vertexWeight[v];
+    }
+
+  uint32_t next = 0;  // lowest vertex which may be unassigned
+  for (uint32_t p = 0; p + 1 < nPartitions; ++p)
+    {
+      uint64_t target = (remaining + (nPartitions - p) / 2) / (nPartitions - p);
+      uint64_t weight = 0;
+      std::priority_queue<std::pair<uint32_t, uint32_t> > frontier;
+      std::vector<uint32_t> touched;
+      while (weight < target)
+        {
+          uint32_t v = NONE;
+          while (!frontier.empty ())
+            {
+              std::pair<uint32_t, uint32_t> top = frontier.top ();
+              frontier.pop ();
+              if (part[top.second] == NONE && connection[top.second] == top.first)
+                {
+                  v = top.second;
+                  break;
+                }
+            }
+          if (v == NONE)
+            {
+              // Start a new region from a pseudo-peripheral vertex: the
+              // last one reached by a breadth-first search.
+              while (next < n && part[next] != NONE)
+                {
+                  next++;
+                }
+              if (next == n)
+                {
+                  break;
+                }
+              std::vector<uint32_t> queue (1, next);
+              distance[next] = 0;
+              for (uint32_t q = 0; q < queue.size (); ++q)
+                {
+                  uint32_t u = queue[q];
+                  for (uint32_t e = graph.start[u]; e < graph.start[u + 1]; ++e)
+                    {
+                      uint32_t w = graph.adjacent[e];
+                      if (part[w] == NONE && distance[w] == NONE)
+                        {
+                          distance[w] = distance[u] + 1;
+                          queue.push_back (w);
+                        }
+                    }
+                }
+              v = queue.back ();
+              for (uint32_t q = 0; q < queue.size (); ++q)
+                {
+                  distance[queue[q]] = NONE;
+                }
+            }
+          uint64_t w = graph.vertexWeight[v];
+          if (weight > 0 && weight + w > target && weight + w - target > target - weight)
+            {
+              break;
+            }
+          part[v] = p;
+          weight += w;
+          for (uint32_t e = graph.start[v]; e < graph.start[v + 1]; ++e)
+            {
+              uint32_t u = graph.adjacent[e];
+              if (part[u] == NONE)
+                {
+                  if (connection[u] == 0)
+                    {
+                      touched.push_back (u);
+                    }
+                  connection[u] += graph.edgeWeight[e];
+                  frontier.push (std::make_pair (connection[u], u));
+                }
+            }
+        }
+      for (uint32_t i = 0; i < touched.size (); ++i)
+        {
+          connection[touched[i]] = 0;
+        }
+      remaining -= weight;
+    }
+  for (uint32_t v = 0; v < n; ++v)
+    {
+      if (part[v] == NONE)
+        {
+          part[v] = nPartitions - 1;
+        }
+    }
+  return part;
+}
+
+void
+PartitionHelper::Refine (const Graph &graph, uint32_t nPartitions, uint32_t maxWeight,
+                         std::vector<uint32_t> &part)
+{
+  uint32_t n = graph.vertexWeight.size ();
+  std::vector<uint64_t> partWeight (nPartitions, 0);
+  for (uint32_t v = 0; v < n; ++v)
+    {
+      partWeight[part[v]] += graph.vertexWeight[v];
+    }
+
+  std::vector<uint32_t> connection (nPartitions, 0);
+  std::vector<uint32_t> touched;
+  const uint32_t MAX_PASSES = 8;
+  for (uint32_t pass = 0; pass < MAX_PASSES; ++pass)
+    {
+      uint32_t moves = 0;
+      for (uint32_t v = 0; v < n; ++v)
+        {
+          uint32_t own = part[v];
+          uint64_t w = graph.vertexWeight[v];
+          for (uint32_t e = graph.start[v]; e < graph.start[v + 1]; ++e)
+            {
+              uint32_t q = part[graph.adjacent[e]];
+              if (connection[q] == 0)
+                {
+                  touched.push_back (q);
+                }
+              connection[q] += graph.edgeWeight[e];
+            }
+          bool overweight = partWeight[own] > maxWeight;
+          uint32_t best = own;
+          int64_t bestGain = 0;
+          for (uint32_t i = 0; i < touched.size (); ++i)
+            {
+              uint32_t q = touched[i];
+              if (q == own || partWeight[q] + w > maxWeight)
+                {
+                  continue;
+                }
+              int64_t gain = static_cast<int64_t> (connection[q]) - connection[own];
+              bool better;
+              if (best == own)
+                {
+                  // Move if the cut shrinks, or if the balance improves
+                  // without growing the cut, or out of an overweight part.
+                  better = gain > 0
+                    || (gain == 0 && partWeight[q] + w < partWeight[own])
+                    || overweight;
+                }
+              else
+                {
+                  better = gain > bestGain
+                    || (gain == bestGain && partWeight[q] < partWeight[best]);
+                }
+              if (better)
+                {
+                  best = q;
+                  bestGain = gain;
+                }
+            }
+          for (uint32_t i = 0; i < touched.size (); ++i)
+            {
+              connection[touched[i]] = 0;
+            }
+          touched.clear ();
+          if (best != own)
+            {
+              part[v] = best;
+              partWeight[own] -= w;
+              partWeight[best] += w;
+              moves++;
+            }
+        }
+
+      // Move the vertices of the parts still overweight, which have
+      // no neighbour in a part with room, to the lightest part.
+      for (uint32_t v = 0; v < n; ++v)
+        {
+          uint32_t own = part[v];
+          uint64_t w = graph.vertexWeight[v];
+          if (partWeight[own] <= maxWeight)
+            {
+              continue;
+            }
+          uint32_t lightest = std::min_element (partWeight.begin (), partWeight.end ())
+            - partWeight.begin ();
+          if (partWeight[lightest] + w <= maxWeight)
+            {
+              part[v] = lightest;
+              partWeight[own] -= w;
+              partWeight[lightest] += w;
+              moves++;
+            }
+        }
+      if (moves == 0)
+        {
+          break;
+        }
+    }
+}
+
+std::vector<uint32_t>
+PartitionHelper::Partition (NodeContainer nodes, uint32_t nPartitions)
+{
+  NS_LOG_FUNCTION (this << nPartitions);
+  NS_ASSERT (nPartitions > 0);
+
+  uint32_t n = nodes.GetN ();
+  std::vector<Link> links = GetLinks (nodes);
+  std::vector<uint32_t> result (n, 0);
+  if (nPartitions == 1 || n == 0)
+    {
+      Measure (links, nPartitions, result);
+      return result;
+    }
+
+  uint32_t maxWeight = static_cast<uint32_t> (std::ceil (n * (1 + m_imbalance) / nPartitions));
+  maxWeight = std::max (maxWeight, (n + nPartitions - 1) / nPartitions);
+
+  // Find the largest delay threshold for which the groups of nodes
+  // joined by shorter links, or by links which cannot be cut, fit
+  // in a partition.
+  std::vector<int64_t> delays;
+  for (uint32_t i = 0; i < links.size (); ++i)
+    {
+      if (links[i].delay >= 0)
+        {
+          delays.push_back (links[i].delay);
+        }
+    }
+  std::sort (delays.begin (), delays.end ());
+  delays.erase (std::unique (delays.begin (), delays.end ()), delays.end ());
+
+  if (delays.empty ())
+    {
+      delays.push_back (0);
+    }
+
+  // The smallest threshold only joins the nodes which cannot be separated.
+  std::vector<uint32_t> parent;
+  int64_t threshold = 0;
+  for (uint32_t t = delays.size (); t-- > 0; )
+    {
+      threshold = delays[t];
+      parent.resize (n);
+      for (uint32_t v = 0; v < n; ++v)
+        {
+          parent[v] = v;
+        }
+      for (uint32_t i = 0; i < links.size (); ++i)
+        {
+          if (links[i].delay < threshold)
+            {
+              parent[FindRoot (parent, links[i].a)] = FindRoot (parent, links[i].b);
+            }
+        }
+      std::vector<uint32_t> size (n, 0);
+      uint32_t largest = 0;
+      for (uint32_t v = 0; v < n; ++v)
+        {
+          largest = std::max (largest, ++size[FindRoot (parent, v)]);
+        }
+      if (largest <= maxWeight || t == 0)
+        {
+          if (largest > maxWeight)
+            {
+              NS_LOG_WARN ("Nodes which cannot be separated exceed the partition size");
+              maxWeight = largest;
+            }
+          break;
+        }
+    }
+  NS_LOG_INFO ("Links shorter than " << TimeStep (threshold) << " are not cut");
+
+  // Build the contracted graph, whose vertices are the groups.
+  std::vector<uint32_t> group (n, NONE);
+  Graph graph;
+  for (uint32_t v = 0; v < n; ++v)
+    {
+      uint32_t root = FindRoot (parent, v);
+      if (group[root] == NONE)
+        {
+          group[root] = graph.vertexWeight.size ();
+          graph.vertexWeight.push_back (0);
+        }
+      group[v] = group[root];
+      graph.vertexWeight[group[v]]++;
+    }
+  std::vector<std::pair<uint32_t, uint32_t> > edges;
+  for (uint32_t i = 0; i < links.size (); ++i)
+    {
+      uint32_t a = group[links[i].a];
+      uint32_t b = group[links[i].b];
+      if (a != b)
+        {
+          edges.push_back (std::make_pair (a, b));
+          edges.push_back (std::make_pair (b, a));
+        }
+    }
+  std::sort (edges.begin (), edges.end ());
+  uint32_t nGroups = graph.vertexWeight.size ();
+  graph.start.assign (1, 0);
+  for (uint32_t v = 0, e = 0; v < nGroups; ++v)
+    {
+      for (; e < edges.size () && edges[e].first == v; ++e)
+        {
+          if (graph.adjacent.size () > graph.start.back ()
+              && graph.adjacent.back () == edges[e].second)
+            {
+              graph.edgeWeight.back ()++;
+            }
+          else
+            {
+              graph.adjacent.push_back (edges[e].second);
+              graph.edgeWeight.push_back (1);
+            }
+        }
+      graph.start.push_back (graph.adjacent.size ());
+    }
+
+  // Coarsen until the graph is small or stops shrinking.
+  std::vector<Graph> levels (1, graph);
+  std::vector<std::vector<uint32_t> > maps;
+  uint32_t coarsest = std::max (20U, 8 * nPartitions);
+  uint32_t matchWeight = std::max (1U, n / (4 * nPartitions));
+  while (levels.back ().vertexWeight.size () > coarsest)
+    {
+      Graph coarse;
+      std::vector<uint32_t> map;
+      Coarsen (levels.back (), matchWeight, coarse, map);
+      if (coarse.vertexWeight.size () * 20 > levels.back ().vertexWeight.size () * 19)
+        {
+          break;
+        }
+      levels.push_back (coarse);
+      maps.push_back (map);
+    }
+  NS_LOG_INFO (nGroups << " groups coarsened over " << levels.size ()
+               << " levels to " << levels.back ().vertexWeight.size ());
+
+  std::vector<uint32_t> part = Grow (levels.back (), nPartitions);
+  Refine (levels.back (), nPartitions, maxWeight, part);
+  for (uint32_t l = maps.size (); l-- > 0; )
+    {
+      std::vector<uint32_t> finer (maps[l].size ());
+      for (uint32_t v = 0; v < finer.size (); ++v)
+        {
+          finer[v] = part[maps[l][v]];
+        }
+      part.swap (finer);
+      Refine (levels[l], nPartitions, maxWeight, part);
+    }
+
+  for (uint32_t v = 0; v < n; ++v)
+    {
+      result[v] = part[group[v]];
+    }
+  Measure (links, nPartitions, result);
+  return result;
+}
+
+void
+PartitionHelper::Assign (NodeContainer nodes, uint32_t nPartitions)
+{
+  NS_LOG_FUNCTION (this << nPartitions);
+  std::vector<uint32_t> part = Partition (nodes, nPartitions);
+  for (uint32_t i = 0; i < nodes.GetN (); ++i)
+    {
+      nodes.Get (i)->SetAttribute ("SystemId", UintegerValue (part[i]));
+    }
+}
+
+void
+PartitionHelper::Evaluate (NodeContainer nodes)
+{
+  NS_LOG_FUNCTION (this);
+  std::vector<uint32_t> part (nodes.GetN ());
+  uint32_t nPartitions = 1;
+  for (uint32_t i = 0; i < nodes.GetN (); ++i)
+    {
+      part[i] = nodes.Get (i)->GetSystemId ();
+      nPartitions = std::max (nPartitions, part[i] + 1);
+    }
+  Measure (GetLinks (nodes), nPartitions, part);
+}
+
+void
+PartitionHelper::Measure (const std::vector<Link> &links, uint32_t nPartitions,
+                          const std::vector<uint32_t> &part)
+{
+  m_cutLinks = 0;
+  m_lookAhead = Time::Max ();
+  for (uint32_t i = 0; i < links.size (); ++i)
+    {
+      if (part[links[i].a] != part[links[i].b])
+        {
+          m_cutLinks++;
+          // a link which cannot be cut leaves no lookahead
+          m_lookAhead = std::min (m_lookAhead, TimeStep (std::max (links[i].delay, int64_t (0))));
+        }
+    }
+  std::vector<uint32_t> size (nPartitions, 0);
+  uint32_t largest = 0;
+  for (uint32_t v = 0; v < part.size (); ++v)
+    {
+      largest = std::max (largest, ++size[part[v]]);
+    }
+  m_loadImbalance = part.empty () ? 1 : largest * static_cast<double> (nPartitions) / part.size ();
+  NS_LOG_INFO (m_cutLinks << " links cut, lookahead " << m_lookAhead
+               << ", load imbalance " << m_loadImbalance);
+}
+
+uint32_t
+PartitionHelper::GetCutLinks (void) const
+{
+  return m_cutLinks;
+}
+
+Time
+PartitionHelper::GetLookAhead (void) const
+{
+  return m_lookAhead;
+}
+
+double
+PartitionHelper::GetLoadImbalance (void) const
+{
+  return m_loadImbalance;
+}
+
+} // namespace ns3
@@ -100,6 +100,7 @@ DistributedSimulatorImpl::DistributedSimulatorImpl ()
   // Allocate the LBTS message buffer
   m_pLBTS = new LbtsMessage[m_systemCount];
   m_grantedTime = Seconds (0);
+  m_windows = 0;
 #else
   NS_UNUSED (m_systemCount);
   NS_FATAL_ERROR ("Can't use distributed simulator without MPI compiled in");
@@ -385,7 +386,9 @@ DistributedSimulatorImpl::Run (void)
       if (nextTime > m_grantedTime || IsLocalFinished () )
         {
           // Can't process next event, calculate a new LBTS
-          // First receive any pending messages
+          // First send the packets batched during the window
+          GrantedTimeWindowMpiInterface::FlushSendBuffers ();
+          // Then receive any pending messages
           GrantedTimeWindowMpiInterface::ReceiveMessages ();
           // reset next time
           nextTime = Next ();
@@ -429,6 +432,7 @@ DistributedSimulatorImpl::Run (void)
                   // Overflow is possible here if near end of representable time.
                   m_grantedTime = smallestTime + m_lookAhead;
                 }
+              m_windows++;
             }
         }
 
@@ -440,6 +444,11 @@ DistributedSimulatorImpl::Run (void)
         }
     }
 
+  NS_LOG_INFO ("Rank " << m_myId << ": " << m_windows << " windows, "
+               << GrantedTimeWindowMpiInterface::GetTxCount () << " messages, "
+               << GrantedTimeWindowMpiInterface::GetTxPacketCount () << " packets, "
+               << GrantedTimeWindowMpiInterface::GetTxByteCount () << " bytes sent");
+
   // If the simulator stopped naturally by lack of events, make a
   // consistency test to check that we didn't lose any events along the way.
   NS_ASSERT (!m_events->IsEmpty () || m_unscheduledEvents == 0);
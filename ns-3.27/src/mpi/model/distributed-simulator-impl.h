@@ -153,6 +153,7 @@ private:
   uint32_t     m_myId;        // MPI Rank
   uint32_t     m_systemCount; // MPI Size
   Time         m_grantedTime; // Last LBTS
+  uint64_t     m_windows;     // Number of time windows granted
   static Time  m_lookAhead;   // Lookahead value
 
 };
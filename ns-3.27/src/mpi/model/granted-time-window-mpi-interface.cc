@@ -35,6 +35,7 @@
 #include "ns3/simulator-impl.h"
 #include "ns3/nstime.h"
 #include "ns3/log.h"
+#include "ns3/abort.h"
 
 #ifdef NS3_MPI
 #include <mpi.h>
@@ -81,7 +82,19 @@ bool                  GrantedTimeWindowMpiInterface::m_initialized = false;
 bool                  GrantedTimeWindowMpiInterface::m_enabled = false;
 uint32_t              GrantedTimeWindowMpiInterface::m_rxCount = 0;
 uint32_t              GrantedTimeWindowMpiInterface::m_txCount = 0;
+uint64_t              GrantedTimeWindowMpiInterface::m_txPackets = 0;
+uint64_t              GrantedTimeWindowMpiInterface::m_txBytes = 0;
 std::list<SentBuffer> GrantedTimeWindowMpiInterface::m_pendingTx;
+std::vector<uint8_t*> GrantedTimeWindowMpiInterface::m_txBuffers;
+std::vector<uint32_t> GrantedTimeWindowMpiInterface::m_txSizes;
+std::vector<uint8_t*> GrantedTimeWindowMpiInterface::m_txPool;
+
+/**
+ * Size of the header of each packet in a message: the receive time,
+ * the destination node and device, and the serialized packet size,
+ * padded to keep the next packet 8-byte aligned.
+ */
+static const uint32_t PACKET_HEADER_SIZE = 24;
 
 #ifdef NS3_MPI
 MPI_Request* GrantedTimeWindowMpiInterface::m_requests;
@@ -112,6 +125,17 @@ GrantedTimeWindowMpiInterface::Destroy ()
   delete [] m_requests;
 
   m_pendingTx.clear ();
+  for (uint32_t i = 0; i < m_txBuffers.size (); ++i)
+    {
+      delete [] m_txBuffers[i];
+    }
+  m_txBuffers.clear ();
+  m_txSizes.clear ();
+  for (uint32_t i = 0; i < m_txPool.size (); ++i)
+    {
+      delete [] m_txPool[i];
+    }
+  m_txPool.clear ();
 #endif
 }
 
@@ -127,6 +151,18 @@ GrantedTimeWindowMpiInterface::GetTxCount ()
   return m_txCount;
 }
 
+uint64_t
+GrantedTimeWindowMpiInterface::GetTxPacketCount ()
+{
+  return m_txPackets;
+}
+
+uint64_t
+GrantedTimeWindowMpiInterface::GetTxByteCount ()
+{
+  return m_txBytes;
+}
+
 uint32_t
 GrantedTimeWindowMpiInterface::GetSystemId ()
 {
@@ -176,6 +212,8 @@ GrantedTimeWindowMpiInterface::Enable (int* pargc, char*** pargv)
   // Post a non-blocking receive for all peers
   m_pRxBuffers = new char*[m_size];
   m_requests = new MPI_Request[m_size];
+  m_txBuffers.assign (m_size, 0);
+  m_txSizes.assign (m_size, 0);
   for (uint32_t i = 0; i < GetSize (); ++i)
     {
       m_pRxBuffers[i] = new char[MAX_MPI_MSG_SIZE];
@@ -193,35 +231,102 @@ GrantedTimeWindowMpiInterface::SendPacket (Ptr<Packet> p, const Time& rxTime, ui
   NS_LOG_FUNCTION (this << p << rxTime.GetTimeStep () << node << dev);
 
 #ifdef NS3_MPI
-  SentBuffer sendBuf;
-  m_pendingTx.push_back (sendBuf);
-  std::list<SentBuffer>::reverse_iterator i = m_pendingTx.rbegin (); // Points to the last element
-
   uint32_t serializedSize = p->GetSerializedSize ();
-  uint8_t* buffer =  new uint8_t[serializedSize + 16];
-  i->SetBuffer (buffer);
-  // Add the time, dest node and dest device
+  // Keep the next packet header aligned
+  uint32_t recordSize = PACKET_HEADER_SIZE + ((serializedSize + 7) & ~7U);
+  NS_ABORT_MSG_IF (recordSize > MAX_MPI_MSG_SIZE,
+                   "Packet of " << serializedSize << " bytes too large for an MPI message");
+
+  // Find the system id for the destination node
+  Ptr<Node> destNode = NodeList::GetNode (node);
+  uint32_t nodeSysId = destNode->GetSystemId ();
+
+  if (m_txSizes[nodeSysId] + recordSize > MAX_MPI_MSG_SIZE)
+    {
+      Flush (nodeSysId);
+    }
+  if (m_txBuffers[nodeSysId] == 0)
+    {
+      m_txBuffers[nodeSysId] = AllocateSendBuffer ();
+    }
+
+  uint8_t* buffer = m_txBuffers[nodeSysId] + m_txSizes[nodeSysId];
+  // Add the time, dest node, dest device and packet size
   uint64_t t = rxTime.GetInteger ();
   uint64_t* pTime = reinterpret_cast <uint64_t *> (buffer);
   *pTime++ = t;
   uint32_t* pData = reinterpret_cast<uint32_t *> (pTime);
   *pData++ = node;
   *pData++ = dev;
-  // Serialize the packet
+  *pData++ = serializedSize;
+  *pData++ = 0;
+  // Serialize the packet in place
   p->Serialize (reinterpret_cast<uint8_t *> (pData), serializedSize);
 
-  // Find the system id for the destination node
-  Ptr<Node> destNode = NodeList::GetNode (node);
-  uint32_t nodeSysId = destNode->GetSystemId ();
+  m_txSizes[nodeSysId] += recordSize;
+  m_txPackets++;
+#else
+  NS_FATAL_ERROR ("Can't use distributed simulator without MPI compiled in");
+#endif
+}
 
-  MPI_Isend (reinterpret_cast<void *> (i->GetBuffer ()), serializedSize + 16, MPI_CHAR, nodeSysId,
+uint8_t*
+GrantedTimeWindowMpiInterface::AllocateSendBuffer ()
+{
+  if (m_txPool.empty ())
+    {
+      return new uint8_t[MAX_MPI_MSG_SIZE];
+    }
+  uint8_t* buffer = m_txPool.back ();
+  m_txPool.pop_back ();
+  return buffer;
+}
+
+void
+GrantedTimeWindowMpiInterface::Flush (uint32_t rank)
+{
+  NS_LOG_FUNCTION (rank);
+
+#ifdef NS3_MPI
+  if (m_txSizes[rank] == 0)
+    {
+      return;
+    }
+  SentBuffer sendBuf;
+  m_pendingTx.push_back (sendBuf);
+  std::list<SentBuffer>::reverse_iterator i = m_pendingTx.rbegin (); // Points to the last element
+  i->SetBuffer (m_txBuffers[rank]);
+
+  MPI_Isend (reinterpret_cast<void *> (i->GetBuffer ()), m_txSizes[rank], MPI_CHAR, rank,
              0, MPI_COMM_WORLD, (i->GetRequest ()));
   m_txCount++;
+  m_txBytes += m_txSizes[rank];
+
+  m_txBuffers[rank] = 0;
+  m_txSizes[rank] = 0;
 #else
   NS_FATAL_ERROR ("Can't use distributed simulator without MPI compiled in");
 #endif
 }
 
+void
+GrantedTimeWindowMpiInterface::FlushSendBuffers ()
+{
+  NS_LOG_FUNCTION_NOARGS ();
+
+  uint32_t txCount = m_txCount;
+  uint64_t txBytes = m_txBytes;
+  for (uint32_t rank = 0; rank < m_txSizes.size (); ++rank)
+    {
+      Flush (rank);
+    }
+  if (m_txCount != txCount)
+    {
+      NS_LOG_INFO ("Sent " << m_txCount - txCount << " messages, "
+                   << m_txBytes - txBytes << " bytes");
+    }
+}
+
 void
 GrantedTimeWindowMpiInterface::ReceiveMessages ()
 { 
@@ -244,38 +349,45 @@ GrantedTimeWindowMpiInterface::ReceiveMessages ()
       MPI_Get_count (&status, MPI_CHAR, &count);
       m_rxCount++; // Count this receive
 
-      // Get the meta data first
-      uint64_t* pTime = reinterpret_cast<uint64_t *> (m_pRxBuffers[index]);
-      uint64_t time = *pTime++;
-      uint32_t* pData = reinterpret_cast<uint32_t *> (pTime);
-      uint32_t node = *pData++;
-      uint32_t dev  = *pData++;
-
-      Time rxTime (time);
-
-      count -= sizeof (time) + sizeof (node) + sizeof (dev);
-
-      Ptr<Packet> p = Create<Packet> (reinterpret_cast<uint8_t *> (pData), count, true);
-
-      // Find the correct node/device to schedule receive event
-      Ptr<Node> pNode = NodeList::GetNode (node);
-      Ptr<MpiReceiver> pMpiRec = 0;
-      uint32_t nDevices = pNode->GetNDevices ();
-      for (uint32_t i = 0; i < nDevices; ++i)
+      // The message holds one or more packets
+      uint8_t* buffer = reinterpret_cast<uint8_t *> (m_pRxBuffers[index]);
+      uint8_t* end = buffer + count;
+      while (buffer < end)
         {
-          Ptr<NetDevice> pThisDev = pNode->GetDevice (i);
-          if (pThisDev->GetIfIndex () == dev)
+          // Get the meta data first
+          uint64_t* pTime = reinterpret_cast<uint64_t *> (buffer);
+          uint64_t time = *pTime++;
+          uint32_t* pData = reinterpret_cast<uint32_t *> (pTime);
+          uint32_t node = *pData++;
+          uint32_t dev  = *pData++;
+          uint32_t size = *pData++;
+          pData++;
+
+          Time rxTime (time);
+
+          Ptr<Packet> p = Create<Packet> (reinterpret_cast<uint8_t *> (pData), size, true);
+          buffer += PACKET_HEADER_SIZE + ((size + 7) & ~7U);
+
+          // Find the correct node/device to schedule receive event
+          Ptr<Node> pNode = NodeList::GetNode (node);
+          Ptr<MpiReceiver> pMpiRec = 0;
+          uint32_t nDevices = pNode->GetNDevices ();
+          for (uint32_t i = 0; i < nDevices; ++i)
             {
-              pMpiRec = pThisDev->GetObject<MpiReceiver> ();
-              break;
+              Ptr<NetDevice> pThisDev = pNode->GetDevice (i);
+              if (pThisDev->GetIfIndex () == dev)
+                {
+                  pMpiRec = pThisDev->GetObject<MpiReceiver> ();
+                  break;
+                }
             }
-        }
 
-      NS_ASSERT (pNode && pMpiRec);
+          NS_ASSERT (pNode && pMpiRec);
 
-      // Schedule the rx event
-      Simulator::ScheduleWithContext (pNode->GetId (), rxTime - Simulator::Now (),
-                                      &MpiReceiver::Receive, pMpiRec, p);
+          // Schedule the rx event
+          Simulator::ScheduleWithContext (pNode->GetId (), rxTime - Simulator::Now (),
+                                          &MpiReceiver::Receive, pMpiRec, p);
+        }
 
       // Re-queue the next read
       MPI_Irecv (m_pRxBuffers[index], MAX_MPI_MSG_SIZE, MPI_CHAR, MPI_ANY_SOURCE, 0,
@@ -301,7 +413,9 @@ GrantedTimeWindowMpiInterface::TestSendComplete ()
       std::list<SentBuffer>::iterator current = i; // Save current for erasing
       i++;                                    // Advance to next
       if (flag)
-        { // This message is complete
+        { // This message is complete, keep its buffer for reuse
+          m_txPool.push_back (current->GetBuffer ());
+          current->SetBuffer (0);
           m_pendingTx.erase (current);
         }
     }
@@ -25,6 +25,7 @@
 
 #include <stdint.h>
 #include <list>
+#include <vector>
 
 #include "ns3/nstime.h"
 #include "ns3/buffer.h"
@@ -41,9 +42,10 @@ namespace ns3 {
 
 /**
  * maximum MPI message size for easy
- * buffer creation
+ * buffer creation.  A message holds all the packets sent to the
+ * same rank during a time window, up to this size.
  */
-const uint32_t MAX_MPI_MSG_SIZE = 2000;
+const uint32_t MAX_MPI_MSG_SIZE = 65536;
 
 /**
  * \ingroup mpi
@@ -128,9 +130,19 @@ public:
    * \param node destination node
    * \param dev destination device
    *
-   * Serialize and send a packet to the specified node and net device
+   * Serialize a packet for the specified node and net device.
+   *
+   * The packet is appended to the message being assembled for the
+   * rank of the node, which is sent by FlushSendBuffers, or earlier
+   * if it is full.
    */
   virtual void SendPacket (Ptr<Packet> p, const Time &rxTime, uint32_t node, uint32_t dev);
+  /**
+   * Send the messages assembled since the last call, one per rank.
+   * This must be called before the counts are exchanged at the end
+   * of each time window.
+   */
+  static void FlushSendBuffers ();
   /**
    * Check for received messages complete
    */
@@ -140,23 +152,50 @@ public:
    */
   static void TestSendComplete ();
   /**
-   * \return received count in packets
+   * \return received count in messages
    */
   static uint32_t GetRxCount ();
   /**
-   * \return transmitted count in packets
+   * \return transmitted count in messages
    */
   static uint32_t GetTxCount ();
+  /**
+   * \return transmitted count in packets
+   */
+  static uint64_t GetTxPacketCount ();
+  /**
+   * \return transmitted count in bytes, message headers included
+   */
+  static uint64_t GetTxByteCount ();
 
 private:
+  /**
+   * Get a send buffer of MAX_MPI_MSG_SIZE bytes from the pool.
+   *
+   * \return The buffer.
+   */
+  static uint8_t* AllocateSendBuffer ();
+  /**
+   * Send the message assembled for a rank, if any.
+   *
+   * \param rank The destination rank.
+   */
+  static void Flush (uint32_t rank);
+
   static uint32_t m_sid;
   static uint32_t m_size;
 
-  // Total packets received
+  // Total messages received
   static uint32_t m_rxCount;
 
-  // Total packets sent
+  // Total messages sent
   static uint32_t m_txCount;
+
+  // Total packets sent
+  static uint64_t m_txPackets;
+
+  // Total bytes sent
+  static uint64_t m_txBytes;
   static bool     m_initialized;
   static bool     m_enabled;
 
@@ -168,6 +207,15 @@ private:
 
   // List of pending non-blocking sends
   static std::list<SentBuffer> m_pendingTx;
+
+  // Message being assembled for each rank, 0 if none
+  static std::vector<uint8_t*> m_txBuffers;
+
+  // Size of the message being assembled for each rank
+  static std::vector<uint32_t> m_txSizes;
+
+  // Send buffers whose send completed, for reuse
+  static std::vector<uint8_t*> m_txPool;
 };
 
 } // namespace ns3
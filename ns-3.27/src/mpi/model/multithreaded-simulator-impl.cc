@@ -0,0 +1,723 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2017
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "multithreaded-simulator-impl.h"
+
+#include "ns3/simulator.h"
+#include "ns3/scheduler.h"
+#include "ns3/event-impl.h"
+#include "ns3/channel.h"
+#include "ns3/node-container.h"
+#include "ns3/system-thread.h"
+#include "ns3/ptr.h"
+#include "ns3/assert.h"
+#include "ns3/log.h"
+
+#include <algorithm>
+#include <thread>
+
+/**
+ * \file
+ * \ingroup mpi
+ * ns3::MultithreadedSimulatorImpl implementation.
+ */
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("MultithreadedSimulatorImpl");
+
+NS_OBJECT_ENSURE_REGISTERED (MultithreadedSimulatorImpl);
+
+thread_local MultithreadedSimulatorImpl::Partition *MultithreadedSimulatorImpl::m_currentPartition = 0;
+
+TypeId
+MultithreadedSimulatorImpl::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::MultithreadedSimulatorImpl")
+    .SetParent<SimulatorImpl> ()
+    .SetGroupName ("Mpi")
+    .AddConstructor<MultithreadedSimulatorImpl> ()
+  ;
+  return tid;
+}
+
+MultithreadedSimulatorImpl::MultithreadedSimulatorImpl ()
+{
+  NS_LOG_FUNCTION (this);
+  // uids are allocated from 4.
+  // uid 0 is "invalid" events
+  // uid 1 is "now" events
+  // uid 2 is "destroy" events
+  m_uid = 4;
+  // before ::Run is entered, the m_currentUid will be zero
+  m_currentUid = 0;
+  m_currentTs = 0;
+  m_stopTs = GetMaximumSimulationTime ().GetTimeStep ();
+  m_stopUid = 0;
+  m_running = false;
+  m_maximumLookAhead = GetMaximumSimulationTime ();
+  m_lookAhead = GetMaximumSimulationTime ().GetTimeStep ();
+  m_windows = 0;
+  m_barrierCount = 0;
+  m_barrierGeneration = 0;
+}
+
+MultithreadedSimulatorImpl::~MultithreadedSimulatorImpl ()
+{
+  NS_LOG_FUNCTION (this);
+}
+
+void
+MultithreadedSimulatorImpl::DoDispose (void)
+{
+  NS_LOG_FUNCTION (this);
+  for (std::vector<Scheduler::Event>::iterator i = m_pending.begin (); i != m_pending.end (); ++i)
+    {
+      i->impl->Unref ();
+    }
+  m_pending.clear ();
+  for (std::vector<Partition *>::iterator i = m_partitions.begin (); i != m_partitions.end (); ++i)
+    {
+      Partition *p = *i;
+      while (!p->events->IsEmpty ())
+        {
+          Scheduler::Event next = p->events->RemoveNext ();
+          next.impl->Unref ();
+        }
+      for (uint32_t j = 0; j < p->outbox.size (); ++j)
+        {
+          for (uint32_t k = 0; k < p->outbox[j].size (); ++k)
+            {
+              p->outbox[j][k].impl->Unref ();
+            }
+        }
+      delete p;
+    }
+  m_partitions.clear ();
+  SimulatorImpl::DoDispose ();
+}
+
+void
+MultithreadedSimulatorImpl::Destroy ()
+{
+  NS_LOG_FUNCTION (this);
+  while (!m_destroyEvents.empty ())
+    {
+      Ptr<EventImpl> ev = m_destroyEvents.front ().PeekEventImpl ();
+      m_destroyEvents.pop_front ();
+      NS_LOG_LOGIC ("handle destroy " << ev);
+      if (!ev->IsCancelled ())
+        {
+          ev->Invoke ();
+        }
+    }
+}
+
+uint32_t
+MultithreadedSimulatorImpl::GetPartition (uint32_t context, uint32_t other) const
+{
+  if (context < m_nodeSystemIds.size ())
+    {
+      return m_nodeSystemIds[context];
+    }
+  return other;
+}
+
+void
+MultithreadedSimulatorImpl::SetUpPartitions (void)
+{
+  NS_LOG_FUNCTION (this);
+  NodeContainer c = NodeContainer::GetGlobal ();
+  m_nodeSystemIds.assign (c.GetN (), 0);
+  uint32_t n = std::max<uint32_t> (1, m_partitions.size ());
+  for (NodeContainer::Iterator iter = c.Begin (); iter != c.End (); ++iter)
+    {
+      uint32_t systemId = (*iter)->GetSystemId ();
+      m_nodeSystemIds[(*iter)->GetId ()] = systemId;
+      n = std::max (n, systemId + 1);
+    }
+
+  while (m_partitions.size () < n)
+    {
+      Partition *p = new Partition ();
+      p->id = m_partitions.size ();
+      p->events = m_schedulerFactory.Create<Scheduler> ();
+      p->unscheduledEvents = 0;
+      m_partitions.push_back (p);
+    }
+  for (std::vector<Partition *>::iterator i = m_partitions.begin (); i != m_partitions.end (); ++i)
+    {
+      Partition *p = *i;
+      p->currentTs = m_currentTs;
+      p->currentUid = m_currentUid;
+      p->currentContext = Simulator::NO_CONTEXT;
+      p->uid = m_uid;
+      p->stop = false;
+      p->outbox.resize (n);
+    }
+
+  // the events keep the uids allocated outside Run, which all
+  // precede those which the partitions will allocate.
+  for (std::vector<Scheduler::Event>::const_iterator i = m_pending.begin (); i != m_pending.end (); ++i)
+    {
+      Partition *p = m_partitions[GetPartition (i->key.m_context, 0)];
+      p->unscheduledEvents++;
+      p->events->Insert (*i);
+    }
+  m_pending.clear ();
+
+  CalculateLookAhead ();
+}
+
+void
+MultithreadedSimulatorImpl::CalculateLookAhead (void)
+{
+  NS_LOG_FUNCTION (this);
+  Time lookAhead = m_maximumLookAhead;
+  NodeContainer c = NodeContainer::GetGlobal ();
+  for (NodeContainer::Iterator iter = c.Begin (); iter != c.End (); ++iter)
+    {
+      for (uint32_t i = 0; i < (*iter)->GetNDevices (); ++i)
+        {
+          Ptr<NetDevice> localNetDevice = (*iter)->GetDevice (i);
+          // only works for p2p links currently
+          if (!localNetDevice->IsPointToPoint ())
+            {
+              continue;
+            }
+          Ptr<Channel> channel = localNetDevice->GetChannel ();
+          if (channel == 0 || channel->GetNDevices () != 2)
+            {
+              continue;
+            }
+
+          // grab the adjacent node
+          Ptr<Node> remoteNode;
+          if (channel->GetDevice (0) == localNetDevice)
+            {
+              remoteNode = (channel->GetDevice (1))->GetNode ();
+            }
+          else
+            {
+              remoteNode = (channel->GetDevice (0))->GetNode ();
+            }
+
+          // if it's in the same partition, don't consider it
+          if (remoteNode->GetSystemId () == (*iter)->GetSystemId ())
+            {
+              continue;
+            }
+
+          TimeValue delay;
+          channel->GetAttribute ("Delay", delay);
+          if (delay.Get () < lookAhead)
+            {
+              lookAhead = delay.Get ();
+            }
+        }
+    }
+  if (m_partitions.size () > 1 && !lookAhead.IsStrictlyPositive ())
+    {
+      NS_FATAL_ERROR ("The channels between partitions must have a strictly positive delay");
+    }
+  m_lookAhead = lookAhead.GetTimeStep ();
+  NS_LOG_INFO (m_partitions.size () << " partitions, lookahead " << lookAhead);
+}
+
+void
+MultithreadedSimulatorImpl::SetMaximumLookAhead (const Time lookAhead)
+{
+  if (lookAhead > 0)
+    {
+      NS_LOG_FUNCTION (this << lookAhead);
+      m_maximumLookAhead = lookAhead;
+    }
+  else
+    {
+      NS_LOG_WARN ("attempted to set look ahead negative: " << lookAhead);
+    }
+}
+
+void
+MultithreadedSimulatorImpl::SetScheduler (ObjectFactory schedulerFactory)
+{
+  NS_LOG_FUNCTION (this << schedulerFactory);
+  NS_ASSERT (!m_running);
+  m_schedulerFactory = schedulerFactory;
+  for (std::vector<Partition *>::iterator i = m_partitions.begin (); i != m_partitions.end (); ++i)
+    {
+      Ptr<Scheduler> scheduler = schedulerFactory.Create<Scheduler> ();
+      while (!(*i)->events->IsEmpty ())
+        {
+          scheduler->Insert ((*i)->events->RemoveNext ());
+        }
+      (*i)->events = scheduler;
+    }
+}
+
+void
+MultithreadedSimulatorImpl::Barrier (void)
+{
+  uint32_t generation = m_barrierGeneration.load (std::memory_order_acquire);
+  if (m_barrierCount.fetch_add (1, std::memory_order_acq_rel) + 1 == m_partitions.size ())
+    {
+      m_barrierCount.store (0, std::memory_order_relaxed);
+      m_barrierGeneration.fetch_add (1, std::memory_order_release);
+      return;
+    }
+  // the windows are usually short: spin for a while before yielding
+  // the processor to the threads which have not arrived yet.
+  uint32_t spins = 0;
+  while (m_barrierGeneration.load (std::memory_order_acquire) == generation)
+    {
+      if (++spins > 1000)
+        {
+          std::this_thread::yield ();
+        }
+    }
+}
+
+uint64_t
+MultithreadedSimulatorImpl::NextTs (Partition *p) const
+{
+  if (p->stop || p->events->IsEmpty ())
+    {
+      return GetMaximumSimulationTime ().GetTimeStep ();
+    }
+  Scheduler::Event ev = p->events->PeekNext ();
+  if (ev.key.m_ts > m_stopTs
+      || (ev.key.m_ts == m_stopTs && ev.key.m_uid > m_stopUid))
+    {
+      // past the stop event scheduled before Run.
+      return GetMaximumSimulationTime ().GetTimeStep ();
+    }
+  return ev.key.m_ts;
+}
+
+void
+MultithreadedSimulatorImpl::ProcessOneEvent (Partition *p)
+{
+  Scheduler::Event next = p->events->RemoveNext ();
+
+  NS_ASSERT (next.key.m_ts >= p->currentTs);
+  p->unscheduledEvents--;
+
+  NS_LOG_LOGIC ("handle " << next.key.m_ts << " in partition " << p->id);
+  p->currentTs = next.key.m_ts;
+  p->currentContext = next.key.m_context;
+  p->currentUid = next.key.m_uid;
+  next.impl->Invoke ();
+  next.impl->Unref ();
+}
+
+void
+MultithreadedSimulatorImpl::RunThread (MultithreadedSimulatorImpl *impl, uint32_t id)
+{
+  impl->RunPartition (impl->m_partitions[id]);
+}
+
+void
+MultithreadedSimulatorImpl::RunPartition (Partition *p)
+{
+  NS_LOG_FUNCTION (this << p->id);
+  m_currentPartition = p;
+  const uint64_t maxTs = GetMaximumSimulationTime ().GetTimeStep ();
+  uint64_t windows = 0;
+  while (true)
+    {
+      // all the partitions are done with the previous window: collect
+      // the events the other partitions sent to this one in the meantime.
+      Barrier ();
+      for (std::vector<Partition *>::const_iterator i = m_partitions.begin (); i != m_partitions.end (); ++i)
+        {
+          std::vector<Scheduler::Event> &inbox = (*i)->outbox[p->id];
+          for (std::vector<Scheduler::Event>::iterator j = inbox.begin (); j != inbox.end (); ++j)
+            {
+              j->key.m_uid = p->uid;
+              p->uid++;
+              p->unscheduledEvents++;
+              p->events->Insert (*j);
+            }
+          inbox.clear ();
+        }
+      p->nextTs = NextTs (p);
+      p->stopped = p->stop;
+      Barrier ();
+
+      // compute the next window from the published state, so that
+      // every partition reaches the same decision.
+      uint64_t smallest = maxTs;
+      bool stopped = false;
+      for (std::vector<Partition *>::const_iterator i = m_partitions.begin (); i != m_partitions.end (); ++i)
+        {
+          smallest = std::min (smallest, (*i)->nextTs);
+          stopped = stopped || (*i)->stopped;
+        }
+      if (smallest == maxTs || stopped)
+        {
+          break;
+        }
+      if (m_lookAhead >= maxTs - smallest)
+        {
+          p->grantedTs = maxTs;
+        }
+      else
+        {
+          p->grantedTs = smallest + m_lookAhead;
+        }
+      windows++;
+
+      while (NextTs (p) < p->grantedTs)
+        {
+          ProcessOneEvent (p);
+        }
+    }
+  m_currentPartition = 0;
+  if (p->id == 0)
+    {
+      m_windows = windows;
+    }
+}
+
+void
+MultithreadedSimulatorImpl::Run (void)
+{
+  NS_LOG_FUNCTION (this);
+  NS_ASSERT (!m_running);
+  SetUpPartitions ();
+  m_running = true;
+
+  std::vector<Ptr<SystemThread> > threads;
+  for (uint32_t i = 1; i < m_partitions.size (); ++i)
+    {
+      threads.push_back (Create<SystemThread> (MakeBoundCallback (&MultithreadedSimulatorImpl::RunThread, this, i)));
+    }
+  for (std::vector<Ptr<SystemThread> >::iterator i = threads.begin (); i != threads.end (); ++i)
+    {
+      (*i)->Start ();
+    }
+  RunPartition (m_partitions[0]);
+  for (std::vector<Ptr<SystemThread> >::iterator i = threads.begin (); i != threads.end (); ++i)
+    {
+      (*i)->Join ();
+    }
+
+  m_running = false;
+  for (std::vector<Partition *>::const_iterator i = m_partitions.begin (); i != m_partitions.end (); ++i)
+    {
+      if ((*i)->currentTs > m_currentTs)
+        {
+          m_currentTs = (*i)->currentTs;
+          m_currentUid = (*i)->currentUid;
+        }
+      m_uid = std::max (m_uid, (*i)->uid);
+      (*i)->stop = false;
+    }
+  m_stopTs = GetMaximumSimulationTime ().GetTimeStep ();
+  NS_LOG_INFO ("ran " << m_windows << " windows, stopped at " << TimeStep (m_currentTs));
+}
+
+bool
+MultithreadedSimulatorImpl::IsFinished (void) const
+{
+  Partition *p = m_currentPartition;
+  if (p != 0)
+    {
+      return p->events->IsEmpty ();
+    }
+  if (!m_pending.empty ())
+    {
+      return false;
+    }
+  for (std::vector<Partition *>::const_iterator i = m_partitions.begin (); i != m_partitions.end (); ++i)
+    {
+      if (!(*i)->events->IsEmpty ())
+        {
+          return false;
+        }
+    }
+  return true;
+}
+
+uint32_t
+MultithreadedSimulatorImpl::GetSystemId () const
+{
+  Partition *p = m_currentPartition;
+  return p != 0 ? p->id : 0;
+}
+
+void
+MultithreadedSimulatorImpl::Stop (void)
+{
+  NS_LOG_FUNCTION (this);
+  Partition *p = m_currentPartition;
+  if (p != 0)
+    {
+      p->stop = true;
+    }
+}
+
+void
+MultithreadedSimulatorImpl::Stop (Time const &delay)
+{
+  NS_LOG_FUNCTION (this << delay.GetTimeStep ());
+  if (m_currentPartition != 0)
+    {
+      Simulator::Schedule (delay, &Simulator::Stop);
+      return;
+    }
+  // stop all the partitions where a sequential simulation would stop.
+  uint64_t ts = m_currentTs + delay.GetTimeStep ();
+  if (ts < m_stopTs)
+    {
+      m_stopTs = ts;
+      m_stopUid = m_uid;
+    }
+  m_uid++;
+}
+
+EventId
+MultithreadedSimulatorImpl::Schedule (Time const &delay, EventImpl *event)
+{
+  NS_LOG_FUNCTION (this << delay.GetTimeStep () << event);
+  NS_ASSERT (delay.IsPositive ());
+  Scheduler::Event ev;
+  ev.impl = event;
+  ev.key.m_context = GetContext ();
+  Partition *p = m_currentPartition;
+  if (p == 0)
+    {
+      NS_ASSERT_MSG (!m_running, "Events can only be scheduled from the simulation threads while running");
+      ev.key.m_ts = m_currentTs + delay.GetTimeStep ();
+      ev.key.m_uid = m_uid;
+      m_uid++;
+      m_pending.push_back (ev);
+    }
+  else
+    {
+      ev.key.m_ts = p->currentTs + delay.GetTimeStep ();
+      ev.key.m_uid = p->uid;
+      p->uid++;
+      p->unscheduledEvents++;
+      p->events->Insert (ev);
+    }
+  return EventId (event, ev.key.m_ts, ev.key.m_context, ev.key.m_uid);
+}
+
+void
+MultithreadedSimulatorImpl::ScheduleWithContext (uint32_t context, Time const &delay, EventImpl *event)
+{
+  NS_LOG_FUNCTION (this << context << delay.GetTimeStep () << event);
+  Partition *p = m_currentPartition;
+  if (p == 0)
+    {
+      NS_ASSERT_MSG (!m_running, "Events can only be scheduled from the simulation threads while running");
+      Scheduler::Event ev;
+      ev.impl = event;
+      ev.key.m_ts = m_currentTs + delay.GetTimeStep ();
+      ev.key.m_context = context;
+      ev.key.m_uid = m_uid;
+      m_uid++;
+      m_pending.push_back (ev);
+      return;
+    }
+
+  Scheduler::Event ev;
+  ev.impl = event;
+  ev.key.m_ts = p->currentTs + delay.GetTimeStep ();
+  ev.key.m_context = context;
+  uint32_t target = GetPartition (context, p->id);
+  if (target == p->id)
+    {
+      ev.key.m_uid = p->uid;
+      p->uid++;
+      p->unscheduledEvents++;
+      p->events->Insert (ev);
+      return;
+    }
+  // the uid is allocated by the receiving partition.
+  NS_ASSERT_MSG (ev.key.m_ts >= p->grantedTs,
+                 "Event for partition " << target << " scheduled within the current window of partition " <<
+                 p->id << ": its delay is shorter than the lookahead");
+  p->outbox[target].push_back (ev);
+}
+
+EventId
+MultithreadedSimulatorImpl::ScheduleNow (EventImpl *event)
+{
+  NS_LOG_FUNCTION (this << event);
+  return Schedule (Time (0), event);
+}
+
+EventId
+MultithreadedSimulatorImpl::ScheduleDestroy (EventImpl *event)
+{
+  NS_LOG_FUNCTION (this << event);
+  EventId id (Ptr<EventImpl> (event, false), Now ().GetTimeStep (), 0xffffffff, 2);
+  CriticalSection cs (m_destroyEventsMutex);
+  m_destroyEvents.push_back (id);
+  return id;
+}
+
+Time
+MultithreadedSimulatorImpl::Now (void) const
+{
+  Partition *p = m_currentPartition;
+  return TimeStep (p != 0 ? p->currentTs : m_currentTs);
+}
+
+Time
+MultithreadedSimulatorImpl::GetDelayLeft (const EventId &id) const
+{
+  if (IsExpired (id))
+    {
+      return TimeStep (0);
+    }
+  else
+    {
+      return TimeStep (id.GetTs () - Now ().GetTimeStep ());
+    }
+}
+
+void
+MultithreadedSimulatorImpl::Remove (const EventId &id)
+{
+  if (id.GetUid () == 2)
+    {
+      // destroy events.
+      CriticalSection cs (m_destroyEventsMutex);
+      for (DestroyEvents::iterator i = m_destroyEvents.begin (); i != m_destroyEvents.end (); i++)
+        {
+          if (*i == id)
+            {
+              m_destroyEvents.erase (i);
+              break;
+            }
+        }
+      return;
+    }
+  if (IsExpired (id))
+    {
+      return;
+    }
+  Scheduler::Event event;
+  event.impl = id.PeekEventImpl ();
+  event.key.m_ts = id.GetTs ();
+  event.key.m_context = id.GetContext ();
+  event.key.m_uid = id.GetUid ();
+  Partition *p = m_currentPartition;
+  if (p == 0)
+    {
+      for (std::vector<Scheduler::Event>::iterator i = m_pending.begin (); i != m_pending.end (); ++i)
+        {
+          if (i->key.m_uid == event.key.m_uid)
+            {
+              m_pending.erase (i);
+              event.impl->Cancel ();
+              event.impl->Unref ();
+              return;
+            }
+        }
+      p = m_partitions[GetPartition (event.key.m_context, 0)];
+    }
+  p->events->Remove (event);
+  event.impl->Cancel ();
+  // whenever we remove an event from the event list, we have to unref it.
+  event.impl->Unref ();
+  p->unscheduledEvents--;
+}
+
+void
+MultithreadedSimulatorImpl::Cancel (const EventId &id)
+{
+  if (!IsExpired (id))
+    {
+      id.PeekEventImpl ()->Cancel ();
+    }
+}
+
+bool
+MultithreadedSimulatorImpl::IsExpired (const EventId &id) const
+{
+  if (id.GetUid () == 2)
+    {
+      if (id.PeekEventImpl () == 0
+          || id.PeekEventImpl ()->IsCancelled ())
+        {
+          return true;
+        }
+      // destroy events.
+      CriticalSection cs (m_destroyEventsMutex);
+      for (DestroyEvents::const_iterator i = m_destroyEvents.begin (); i != m_destroyEvents.end (); i++)
+        {
+          if (*i == id)
+            {
+              return false;
+            }
+        }
+      return true;
+    }
+  Partition *p = m_currentPartition;
+  uint64_t currentTs = p != 0 ? p->currentTs : m_currentTs;
+  uint32_t currentUid = p != 0 ? p->currentUid : m_currentUid;
+  if (id.PeekEventImpl () == 0
+      || id.GetTs () < currentTs
+      || (id.GetTs () == currentTs
+          && id.GetUid () <= currentUid)
+      || id.PeekEventImpl ()->IsCancelled ())
+    {
+      return true;
+    }
+  else
+    {
+      return false;
+    }
+}
+
+Time
+MultithreadedSimulatorImpl::GetMaximumSimulationTime (void) const
+{
+  return TimeStep (0x7fffffffffffffffLL);
+}
+
+uint32_t
+MultithreadedSimulatorImpl::GetContext (void) const
+{
+  Partition *p = m_currentPartition;
+  return p != 0 ? p->currentContext : Simulator::NO_CONTEXT;
+}
+
+uint32_t
+MultithreadedSimulatorImpl::GetPartitionCount (void) const
+{
+  return m_partitions.size ();
+}
+
+Time
+MultithreadedSimulatorImpl::GetLookAhead (void) const
+{
+  return TimeStep (m_lookAhead);
+}
+
+uint64_t
+MultithreadedSimulatorImpl::GetWindowCount (void) const
+{
+  return m_windows;
+}
+
+} // namespace ns3
@@ -0,0 +1,236 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2017
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef NS3_MULTITHREADED_SIMULATOR_IMPL_H
+#define NS3_MULTITHREADED_SIMULATOR_IMPL_H
+
+#include "ns3/simulator-impl.h"
+#include "ns3/scheduler.h"
+#include "ns3/event-impl.h"
+#include "ns3/object-factory.h"
+#include "ns3/system-mutex.h"
+#include "ns3/ptr.h"
+
+#include <atomic>
+#include <list>
+#include <vector>
+
+/**
+ * \file
+ * \ingroup mpi
+ * ns3::MultithreadedSimulatorImpl declaration.
+ */
+
+namespace ns3 {
+
+/**
+ * \ingroup mpi
+ *
+ * \brief Parallel simulator running the partitions of a simulation
+ * in the threads of a single process.
+ *
+ * The nodes are partitioned by system id, as for DistributedSimulatorImpl,
+ * but all the partitions live in the same address space: Run starts
+ * one thread for each partition but the first, which is run by the
+ * calling thread.
+ *
+ * The partitions are synchronized with the same conservative time
+ * window algorithm as GrantedTimeWindowMpiInterface: the lookahead is
+ * the smallest delay of the point-to-point channels which connect nodes
+ * of different partitions, and each window lets every partition
+ * execute its events earlier than the smallest next event time of all
+ * the partitions plus the lookahead. The events scheduled for another
+ * partition during a window, which cannot fall within that window, are
+ * queued by the sending thread and handed over at the barrier that
+ * ends the window. No message passing is involved: the
+ * PointToPointChannel hands a deep copy of the packet, rather than
+ * a serialized one, to the receiving partition.
+ *
+ * The events scheduled before Run are dispatched to the partition of
+ * the node given by their context, or to the first partition.  A call
+ * to Stop (delay) made before Run stops all the partitions at the same
+ * event as in a sequential simulation; a call to Stop made while
+ * running stops the other partitions at the end of the current window.
+ *
+ * The models must not share mutable state across partitions: the
+ * events of a partition should only touch the objects aggregated to
+ * its nodes.  The packet internals keep per-thread free lists and uid
+ * counters for that purpose.
+ */
+class MultithreadedSimulatorImpl : public SimulatorImpl
+{
+public:
+  /**
+   *  Register this type.
+   *  \return The object TypeId.
+   */
+  static TypeId GetTypeId (void);
+
+  /** Constructor. */
+  MultithreadedSimulatorImpl ();
+  /** Destructor. */
+  ~MultithreadedSimulatorImpl ();
+
+  // virtual from SimulatorImpl
+  virtual void Destroy ();
+  virtual bool IsFinished (void) const;
+  virtual void Stop (void);
+  virtual void Stop (Time const &delay);
+  virtual EventId Schedule (Time const &delay, EventImpl *event);
+  virtual void ScheduleWithContext (uint32_t context, Time const &delay, EventImpl *event);
+  virtual EventId ScheduleNow (EventImpl *event);
+  virtual EventId ScheduleDestroy (EventImpl *event);
+  virtual void Remove (const EventId &id);
+  virtual void Cancel (const EventId &id);
+  virtual bool IsExpired (const EventId &id) const;
+  virtual void Run (void);
+  virtual Time Now (void) const;
+  virtual Time GetDelayLeft (const EventId &id) const;
+  virtual Time GetMaximumSimulationTime (void) const;
+  virtual void SetMaximumLookAhead (const Time lookAhead);
+  virtual void SetScheduler (ObjectFactory schedulerFactory);
+  virtual uint32_t GetSystemId (void) const;
+  virtual uint32_t GetContext (void) const;
+
+  /**
+   * Get the number of partitions.
+   *
+   * \returns The number of partitions, one more than the largest
+   *          node system id, as of the last call to Run.
+   */
+  uint32_t GetPartitionCount (void) const;
+  /**
+   * Get the lookahead.
+   *
+   * \returns The lookahead used by the last call to Run.
+   */
+  Time GetLookAhead (void) const;
+  /**
+   * Get the number of time windows.
+   *
+   * \returns The number of time windows executed by the last call to Run.
+   */
+  uint64_t GetWindowCount (void) const;
+
+private:
+  /** The state of a partition, owned by the thread which runs it. */
+  struct Partition
+  {
+    uint32_t id;              /**< The partition index, also its system id. */
+    Ptr<Scheduler> events;    /**< The event queue. */
+    uint64_t currentTs;       /**< Timestamp of the current event. */
+    uint32_t currentUid;      /**< Uid of the current event. */
+    uint32_t currentContext;  /**< Context of the current event. */
+    uint32_t uid;             /**< Next event uid. */
+    int unscheduledEvents;    /**< Number of events in the queue. */
+    bool stop;                /**< Set by Stop while running. */
+    uint64_t grantedTs;       /**< End of the current window, excluded. */
+    uint64_t nextTs;          /**< Next event time, published at the barrier. */
+    bool stopped;             /**< Stop flag, published at the barrier. */
+    /** Events scheduled for each other partition during the current window. */
+    std::vector<std::vector<Scheduler::Event> > outbox;
+  };
+
+  virtual void DoDispose (void);
+
+  /** Create the partitions and dispatch the events scheduled before Run. */
+  void SetUpPartitions (void);
+  /** Compute the lookahead from the channels between partitions. */
+  void CalculateLookAhead (void);
+  /**
+   * Get the partition of the node designated by an event context.
+   *
+   * \param [in] context The event context.
+   * \param [in] other The partition to use if \p context is not a node id.
+   * \returns The partition index.
+   */
+  uint32_t GetPartition (uint32_t context, uint32_t other) const;
+  /**
+   * Thread entry point.
+   *
+   * \param [in] impl The simulator.
+   * \param [in] id The partition to run.
+   */
+  static void RunThread (MultithreadedSimulatorImpl *impl, uint32_t id);
+  /**
+   * Run a partition until the end of the simulation.
+   *
+   * \param [in] p The partition.
+   */
+  void RunPartition (Partition *p);
+  /** Wait until all the partitions reach this point. */
+  void Barrier (void);
+  /**
+   * Get the time of the next event of a partition which may be executed.
+   *
+   * \param [in] p The partition.
+   * \returns The timestamp, or the maximum simulation time if none.
+   */
+  uint64_t NextTs (Partition *p) const;
+  /**
+   * Execute the next event of a partition.
+   *
+   * \param [in] p The partition.
+   */
+  void ProcessOneEvent (Partition *p);
+
+  /** Container type for the destroy events. */
+  typedef std::list<EventId> DestroyEvents;
+
+  /** The partition run by the calling thread, 0 outside Run. */
+  static thread_local Partition *m_currentPartition;
+
+  /** The events to invoke at Destroy. */
+  DestroyEvents m_destroyEvents;
+  /** Protects m_destroyEvents while running. */
+  mutable SystemMutex m_destroyEventsMutex;
+  /** The factory of the event queues. */
+  ObjectFactory m_schedulerFactory;
+  /** The events scheduled outside Run, until they are dispatched. */
+  std::vector<Scheduler::Event> m_pending;
+  /** The partitions. */
+  std::vector<Partition *> m_partitions;
+  /** The system id of each node, indexed by node id. */
+  std::vector<uint32_t> m_nodeSystemIds;
+  /** Next event uid outside Run. */
+  uint32_t m_uid;
+  /** Uid of the current event outside Run. */
+  uint32_t m_currentUid;
+  /** Simulation time outside Run. */
+  uint64_t m_currentTs;
+  /** Timestamp of the stop event scheduled before Run. */
+  uint64_t m_stopTs;
+  /** Uid of the stop event scheduled before Run. */
+  uint32_t m_stopUid;
+  /** True while Run is executing. */
+  bool m_running;
+  /** Upper bound of the lookahead, from SetMaximumLookAhead. */
+  Time m_maximumLookAhead;
+  /** The lookahead. */
+  uint64_t m_lookAhead;
+  /** The number of windows executed by the last Run. */
+  uint64_t m_windows;
+  /** Number of partitions which reached the current barrier. */
+  std::atomic<uint32_t> m_barrierCount;
+  /** Incremented each time all the partitions reach a barrier. */
+  std::atomic<uint32_t> m_barrierGeneration;
+};
+
+} // namespace ns3
+
+#endif /* NS3_MULTITHREADED_SIMULATOR_IMPL_H */
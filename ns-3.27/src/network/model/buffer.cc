@@ -50,7 +50,49 @@ namespace ns3 {
 NS_LOG_COMPONENT_DEFINE ("Buffer");
 
 
-uint32_t Buffer::g_recommendedStart = 0;
+thread_local uint32_t Buffer::g_recommendedStart = 0;
+thread_local uint32_t Buffer::g_recommendedEndSize = 0;
+thread_local Buffer::FreeListStats Buffer::g_freeListStats;
+
+uint32_t
+Buffer::GetSizeClass (uint32_t size)
+{
+  if (size <= 64)
+    {
+      return 0;
+    }
+  // 2^p < size <= 2^(p+1), with p >= 6
+  uint32_t p = 31 - __builtin_clz (size - 1);
+  uint32_t sizeClass = 2 * (p - 6) + (size <= (3U << (p - 1)) ? 1 : 2);
+  return sizeClass < N_SIZE_CLASSES ? sizeClass : N_SIZE_CLASSES;
+}
+
+uint32_t
+Buffer::GetSizeClassSize (uint32_t sizeClass)
+{
+  if (sizeClass == 0)
+    {
+      return 64;
+    }
+  uint32_t p = 6 + (sizeClass - 1) / 2;
+  return (sizeClass % 2) ? (3U << (p - 1)) : (1U << (p + 1));
+}
+
+Buffer::FreeListStats
+Buffer::GetFreeListStats (void)
+{
+  return g_freeListStats;
+}
+
+void
+Buffer::ResetFreeListStats (void)
+{
+  uint64_t bytesRetained = g_freeListStats.bytesRetained;
+  g_freeListStats = FreeListStats ();
+  g_freeListStats.bytesRetained = bytesRetained;
+  g_freeListStats.maxBytesRetained = bytesRetained;
+}
+
 #ifdef BUFFER_FREE_LIST
 /* The following macros are pretty evil but they are needed to allow us to
  * keep track of 3 possible states for the g_freeList variable:
@@ -75,22 +117,26 @@ uint32_t Buffer::g_recommendedStart = 0;
 #define IS_INITIALIZED(x) (!IS_UNINITIALIZED (x) && !IS_DESTROYED (x))
 #define DESTROYED ((Buffer::FreeList*)MAGIC_DESTROYED)
 #define UNINITIALIZED ((Buffer::FreeList*)0)
-uint32_t Buffer::g_maxSize = 0;
-Buffer::FreeList *Buffer::g_freeList = 0;
-struct Buffer::LocalStaticDestructor Buffer::g_localStaticDestructor;
+thread_local Buffer::FreeList *Buffer::g_freeList = 0;
+thread_local struct Buffer::LocalStaticDestructor Buffer::g_localStaticDestructor;
 
 Buffer::LocalStaticDestructor::~LocalStaticDestructor(void)
 {
   NS_LOG_FUNCTION (this);
   if (IS_INITIALIZED (g_freeList))
     {
-      for (Buffer::FreeList::iterator i = g_freeList->begin ();
-           i != g_freeList->end (); i++)
+      for (uint32_t i = 0; i < N_SIZE_CLASSES; ++i)
         {
-          Buffer::Deallocate (*i);
+          while (g_freeList->m_head[i] != 0)
+            {
+              struct Buffer::Data *data = g_freeList->m_head[i];
+              g_freeList->m_head[i] = *reinterpret_cast<struct Buffer::Data **> (data->m_data);
+              Buffer::Deallocate (data);
+            }
         }
       delete g_freeList;
       g_freeList = DESTROYED;
+      g_freeListStats.bytesRetained = 0;
     }
 }
 
@@ -99,19 +145,26 @@ Buffer::Recycle (struct Buffer::Data *data)
 {
   NS_LOG_FUNCTION (data);
   NS_ASSERT (data->m_count == 0);
-  NS_ASSERT (!IS_UNINITIALIZED (g_freeList));
-  g_maxSize = std::max (g_maxSize, data->m_size);
-  /* feed into free list */
-  if (data->m_size < g_maxSize ||
-      IS_DESTROYED (g_freeList) ||
-      g_freeList->size () > 1000)
+  /* feed into the free list of its size class, linking through the
+   * m_data field. The data may have been created by another thread. */
+  uint32_t sizeClass = GetSizeClass (data->m_size);
+  if (IS_INITIALIZED (g_freeList)
+      && sizeClass < N_SIZE_CLASSES
+      && data->m_size == GetSizeClassSize (sizeClass)
+      && (g_freeList->m_count[sizeClass] + 1) * data->m_size <= FREE_LIST_BYTES)
     {
-      Buffer::Deallocate (data);
+      *reinterpret_cast<struct Buffer::Data **> (data->m_data) = g_freeList->m_head[sizeClass];
+      g_freeList->m_head[sizeClass] = data;
+      g_freeList->m_count[sizeClass]++;
+      g_freeListStats.recycled++;
+      g_freeListStats.bytesRetained += data->m_size;
+      g_freeListStats.maxBytesRetained = std::max (g_freeListStats.maxBytesRetained,
+                                                   g_freeListStats.bytesRetained);
     }
   else
     {
-      NS_ASSERT (IS_INITIALIZED (g_freeList));
-      g_freeList->push_back (data);
+      g_freeListStats.released++;
+      Buffer::Deallocate (data);
     }
 }
 
@@ -119,24 +172,31 @@ Buffer::Data *
 Buffer::Create (uint32_t dataSize)
 {
   NS_LOG_FUNCTION (dataSize);
-  /* try to find a buffer correctly sized. */
+  g_freeListStats.requests++;
+  uint32_t sizeClass = GetSizeClass (dataSize);
+  /* try to find a buffer of the right size class. */
   if (IS_UNINITIALIZED (g_freeList))
     {
       g_freeList = new Buffer::FreeList ();
+      // the free list is per thread: make sure that it is released
+      // when this thread exits.
+      (void) &g_localStaticDestructor;
     }
-  else if (IS_INITIALIZED (g_freeList))
+  else if (IS_INITIALIZED (g_freeList)
+           && sizeClass < N_SIZE_CLASSES
+           && g_freeList->m_head[sizeClass] != 0)
     {
-      while (!g_freeList->empty ()) 
-        {
-          struct Buffer::Data *data = g_freeList->back ();
-          g_freeList->pop_back ();
-          if (data->m_size >= dataSize) 
-            {
-              data->m_count = 1;
-              return data;
-            }
-          Buffer::Deallocate (data);
-        }
+      struct Buffer::Data *data = g_freeList->m_head[sizeClass];
+      g_freeList->m_head[sizeClass] = *reinterpret_cast<struct Buffer::Data **> (data->m_data);
+      g_freeList->m_count[sizeClass]--;
+      g_freeListStats.hits++;
+      g_freeListStats.bytesRetained -= data->m_size;
+      data->m_count = 1;
+      return data;
+    }
+  if (sizeClass < N_SIZE_CLASSES)
+    {
+      dataSize = GetSizeClassSize (sizeClass);
     }
   struct Buffer::Data *data = Buffer::Allocate (dataSize);
   NS_ASSERT (data->m_count == 1);
@@ -148,6 +208,7 @@ Buffer::Recycle (struct Buffer::Data *data)
 {
   NS_LOG_FUNCTION (data);
   NS_ASSERT (data->m_count == 0);
+  g_freeListStats.released++;
   Deallocate (data);
 }
 
@@ -155,6 +216,7 @@ Buffer::Data *
 Buffer::Create (uint32_t size)
 {
   NS_LOG_FUNCTION (size);
+  g_freeListStats.requests++;
   return Allocate (size);
 }
 #endif /* BUFFER_FREE_LIST */
@@ -244,7 +306,10 @@ void
 Buffer::Initialize (uint32_t zeroSize)
 {
   NS_LOG_FUNCTION (this << zeroSize);
-  m_data = Buffer::Create (0);
+  /* make room for the headers and trailers which are usually added,
+   * without going past the largest size class */
+  uint32_t recommendedSize = g_recommendedStart + g_recommendedEndSize;
+  m_data = Buffer::Create (std::min (recommendedSize, GetSizeClassSize (N_SIZE_CLASSES - 1)));
   m_start = std::min (m_data->m_size, g_recommendedStart);
   m_maxZeroAreaStart = m_start;
   m_zeroAreaStart = m_start;
@@ -271,6 +336,7 @@ Buffer::operator = (Buffer const&o)
       m_data->m_count++;
     }
   g_recommendedStart = std::max (g_recommendedStart, m_maxZeroAreaStart);
+  g_recommendedEndSize = std::max (g_recommendedEndSize, m_end - m_zeroAreaEnd);
   m_maxZeroAreaStart = o.m_maxZeroAreaStart;
   m_zeroAreaStart = o.m_zeroAreaStart;
   m_zeroAreaEnd = o.m_zeroAreaEnd;
@@ -285,6 +351,7 @@ Buffer::~Buffer ()
   NS_LOG_FUNCTION (this);
   NS_ASSERT (CheckInternalState ());
   g_recommendedStart = std::max (g_recommendedStart, m_maxZeroAreaStart);
+  g_recommendedEndSize = std::max (g_recommendedEndSize, m_end - m_zeroAreaEnd);
   m_data->m_count--;
   if (m_data->m_count == 0) 
     {
@@ -400,6 +467,20 @@ void
 Buffer::AddAtEnd (const Buffer &o)
 {
   NS_LOG_FUNCTION (this << &o);
+  if (m_data == o.m_data &&
+      m_end == o.m_start &&
+      m_zeroAreaStart == m_zeroAreaEnd &&
+      o.m_zeroAreaStart == o.m_zeroAreaEnd)
+    {
+      /**
+       * The two buffers are adjacent slices of the same storage, as
+       * the consecutive fragments of a packet: this buffer can be
+       * extended over the other one without copying anything.
+       */
+      m_end = o.m_end;
+      NS_ASSERT (CheckInternalState ());
+      return;
+    }
   if (m_data->m_count == 1 &&
       m_end == m_zeroAreaEnd &&
       m_end == m_data->m_dirtyEnd &&
@@ -426,14 +507,14 @@ Buffer::AddAtEnd (const Buffer &o)
       return;
     }
 
-  Buffer dst = CreateFullCopy ();
-  Buffer src = o.CreateFullCopy ();
-
-  dst.AddAtEnd (src.GetSize ());
-  Buffer::Iterator destStart = dst.End ();
-  destStart.Prev (src.GetSize ());
-  destStart.Write (src.Begin (), src.End ());
-  *this = dst;
+  /* make room at the end, which copies this buffer only if its storage
+   * is too small or shared, then copy the other buffer, zero area
+   * included, right into it. The other buffer may share the storage of
+   * this one, but not the bytes just added. */
+  uint32_t size = o.GetSize ();
+  AddAtEnd (size);
+  uint32_t dataEnd = m_end - (m_zeroAreaEnd - m_zeroAreaStart);
+  o.CopyData (m_data->m_data + dataEnd - size, size);
   NS_ASSERT (CheckInternalState ());
 }
 
@@ -846,25 +927,36 @@ Buffer::Iterator::Write (Iterator start, Iterator end)
   uint32_t size = end.m_current - start.m_current;
   NS_ASSERT_MSG (CheckNoZero (m_current, m_current + size),
                  GetWriteErrorMessage ());
+  // the bytes written may follow the zero area of this buffer
+  uint8_t *to;
+  if (m_current <= m_zeroStart)
+    {
+      to = &m_data[m_current];
+    }
+  else
+    {
+      to = &m_data[m_current - (m_zeroEnd - m_zeroStart)];
+    }
   if (start.m_current <= start.m_zeroStart)
     {
       uint32_t toCopy = std::min (size, start.m_zeroStart - start.m_current);
-      memcpy (&m_data[m_current], &start.m_data[start.m_current], toCopy);
+      memcpy (to, &start.m_data[start.m_current], toCopy);
       start.m_current += toCopy;
       m_current += toCopy;
+      to += toCopy;
       size -= toCopy;
     }
   if (start.m_current <= start.m_zeroEnd)
     {
       uint32_t toCopy = std::min (size, start.m_zeroEnd - start.m_current);
-      memset (&m_data[m_current], 0, toCopy);
+      memset (to, 0, toCopy);
       start.m_current += toCopy;
       m_current += toCopy;
+      to += toCopy;
       size -= toCopy;
     }
   uint32_t toCopy = std::min (size, start.m_dataEnd - start.m_current);
   uint8_t *from = &start.m_data[start.m_current - (start.m_zeroEnd-start.m_zeroStart)];
-  uint8_t *to = &m_data[m_current];
   memcpy (to, from, toCopy);
   m_current += toCopy;
 }
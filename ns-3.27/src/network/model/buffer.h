@@ -642,6 +642,32 @@ private:
    */
   Buffer (uint32_t dataSize, bool initialize);
   ~Buffer ();
+
+  /**
+   * \brief Statistics of the buffer data free lists of a thread.
+   */
+  struct FreeListStats
+  {
+    uint64_t requests;        //!< Number of buffer data storages requested
+    uint64_t hits;            //!< Number of requests served from a free list
+    uint64_t recycled;        //!< Number of released storages kept in a free list
+    uint64_t released;        //!< Number of released storages freed
+    uint64_t bytesRetained;   //!< Bytes currently held by the free lists
+    uint64_t maxBytesRetained;  //!< Largest value of bytesRetained
+  };
+
+  /**
+   * \brief Get the statistics of the buffer data free lists of the
+   * calling thread.
+   *
+   * \returns The statistics.
+   */
+  static FreeListStats GetFreeListStats (void);
+  /**
+   * \brief Reset the counters of the free list statistics of the
+   * calling thread, but not the number of bytes retained.
+   */
+  static void ResetFreeListStats (void);
 private:
   /**
    * This data structure is variable-sized through its last member whose size
@@ -737,6 +763,19 @@ private:
    * \returns a pointer to the created buffer storage
    */
   static struct Buffer::Data *Create (uint32_t size);
+  /**
+   * \brief Get the size class of a buffer data storage
+   * \param size the storage size
+   * \returns the index of the smallest size class which can hold
+   * \p size bytes, or N_SIZE_CLASSES if \p size is too large
+   */
+  static uint32_t GetSizeClass (uint32_t size);
+  /**
+   * \brief Get the storage size of a size class
+   * \param sizeClass the size class
+   * \returns the storage size of the buffer data of \p sizeClass
+   */
+  static uint32_t GetSizeClassSize (uint32_t sizeClass);
   /**
    * \brief Allocate a buffer data storage
    * \param reqSize the storage size to create
@@ -767,7 +806,13 @@ private:
    * writing data. i.e., m_start should be initialized to this 
    * value.
    */
-  static uint32_t g_recommendedStart;
+  static thread_local uint32_t g_recommendedStart;
+  /**
+   * number of bytes which should be left after the zero area of a
+   * newly-allocated buffer. It is the largest number of bytes added
+   * after the zero area of a buffer.
+   */
+  static thread_local uint32_t g_recommendedEndSize;
 
   /**
    * offset to the start of the virtual zero area from the start
@@ -790,17 +835,33 @@ private:
    */
   uint32_t m_end;
 
+  /**
+   * Number of size classes. Their sizes grow from 64 bytes to 64 KiB
+   * in steps of alternately 3/2 and 4/3, so that a storage is at most
+   * half empty.
+   */
+  static const uint32_t N_SIZE_CLASSES = 21;
+  /// Largest number of bytes kept in the free list of a size class
+  static const uint32_t FREE_LIST_BYTES = 4 << 20;
+
+  static thread_local FreeListStats g_freeListStats; //!< Free list statistics of this thread
 #ifdef BUFFER_FREE_LIST
-  /// Container for buffer data
-  typedef std::vector<struct Buffer::Data*> FreeList;
+  /**
+   * Free buffer data of a thread, one list per size class. The data
+   * of a list are chained through their m_data field.
+   */
+  struct FreeList
+  {
+    struct Buffer::Data *m_head[N_SIZE_CLASSES];  //!< First free data of each size class
+    uint32_t m_count[N_SIZE_CLASSES];             //!< Number of free data of each size class
+  };
   /// Local static destructor structure
   struct LocalStaticDestructor 
   {
     ~LocalStaticDestructor ();
   };
-  static uint32_t g_maxSize; //!< Max observed data size
-  static FreeList *g_freeList; //!< Buffer data container
-  static struct LocalStaticDestructor g_localStaticDestructor; //!< Local static destructor
+  static thread_local FreeList *g_freeList; //!< Buffer data container of this thread
+  static thread_local struct LocalStaticDestructor g_localStaticDestructor; //!< Local static destructor
 #endif
 };
 
@@ -30,10 +30,53 @@
 #include "ns3/log.h"
 #include <cstring>
 
+/* Tags at most this large are allocated with room for this many bytes
+ * and recycled through a free list, since most tags are that small. */
+#define POOLED_TAG_DATA_SIZE 40
+#define FREE_LIST_SIZE 4096
+
 namespace ns3 {
 
 NS_LOG_COMPONENT_DEFINE ("PacketTagList");
 
+/**
+ * \ingroup packet
+ *
+ * \brief Free list of the pooled TagData of a thread
+ *
+ * Internal use only. The free TagData are chained through their
+ * next field.
+ */
+static class TagDataFreeList
+{
+public:
+  TagDataFreeList ();
+  ~TagDataFreeList ();
+  struct PacketTagList::TagData *m_head; //!< First free TagData
+  uint32_t m_size;                        //!< Number of free TagData
+} thread_local g_freeList; //!< Free list of pooled TagData, per thread
+/// Set when the free list of this thread has been destroyed
+static thread_local bool g_freeListDestroyed = false;
+
+TagDataFreeList::TagDataFreeList ()
+  : m_head (0),
+    m_size (0)
+{
+}
+
+TagDataFreeList::~TagDataFreeList ()
+{
+  NS_LOG_FUNCTION (this);
+  while (m_head != 0)
+    {
+      struct PacketTagList::TagData *tag = m_head;
+      m_head = tag->next;
+      std::free (tag);
+    }
+  m_size = 0;
+  g_freeListDestroyed = true;
+}
+
 PacketTagList::TagData *
 PacketTagList::CreateTagData (size_t dataSize)
 {
@@ -43,14 +86,48 @@ PacketTagList::CreateTagData (size_t dataSize)
                  << " exceeds maximum "
                  << std::numeric_limits<decltype(TagData::size)>::max () );
 
-  void * p = std::malloc (sizeof (TagData) + dataSize - 1);
-  // The matching frees are in RemoveAll and RemoveWriter
+  void * p;
+  if (dataSize > POOLED_TAG_DATA_SIZE)
+    {
+      p = std::malloc (sizeof (TagData) + dataSize - 1);
+    }
+  else if (!g_freeListDestroyed && g_freeList.m_head != 0)
+    {
+      p = g_freeList.m_head;
+      g_freeList.m_head = g_freeList.m_head->next;
+      g_freeList.m_size--;
+    }
+  else
+    {
+      p = std::malloc (sizeof (TagData) + POOLED_TAG_DATA_SIZE - 1);
+    }
+  // The matching release is in FreeTagData
 
   TagData * tag = new (p) TagData;
   tag->size = dataSize;
   return tag;
 }
 
+void
+PacketTagList::FreeTagData (TagData *tag)
+{
+  // the pooled TagData may have been created by another thread
+  uint32_t size = tag->size;
+  tag->~TagData ();
+  if (size > POOLED_TAG_DATA_SIZE
+      || g_freeListDestroyed
+      || g_freeList.m_size >= FREE_LIST_SIZE)
+    {
+      std::free (tag);
+    }
+  else
+    {
+      tag->next = g_freeList.m_head;
+      g_freeList.m_head = tag;
+      g_freeList.m_size++;
+    }
+}
+
 bool
 PacketTagList::COWTraverse (Tag & tag, PacketTagList::COWWriter Writer)
 {
@@ -194,8 +271,7 @@ PacketTagList::RemoveWriter (Tag & tag, bool preMerge,
   if (preMerge)
     {
       // found tid before first merge, so delete cur
-      cur->~TagData ();
-      std::free (cur);
+      FreeTagData (cur);
     }
   else
     {
@@ -294,6 +370,25 @@ PacketTagList::Peek (Tag &tag) const
   return false;
 }
 
+PacketTagList
+PacketTagList::DeepCopy (void) const
+{
+  NS_LOG_FUNCTION (this);
+  PacketTagList copy;
+  struct TagData **prevNext = &copy.m_next;
+  for (struct TagData *cur = m_next; cur != 0; cur = cur->next)
+    {
+      struct TagData *tag = CreateTagData (cur->size);
+      tag->tid = cur->tid;
+      tag->count = 1;
+      memcpy (tag->data, cur->data, cur->size);
+      tag->next = 0;
+      *prevNext = tag;
+      prevNext = &tag->next;
+    }
+  return copy;
+}
+
 const struct PacketTagList::TagData *
 PacketTagList::Head (void) const
 {
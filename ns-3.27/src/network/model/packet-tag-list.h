@@ -213,6 +213,12 @@ public:
    * Remove all tags from this list (up to the first merge).
    */
   inline void RemoveAll (void);
+  /**
+   * Create a copy which shares no tag storage with this list.
+   *
+   * \returns The copy.
+   */
+  PacketTagList DeepCopy (void) const;
   /**
    * \returns pointer to head of tag list
    */
@@ -228,6 +234,14 @@ private:
    */
   static
   TagData * CreateTagData (size_t dataSize);
+  /**
+   * Destroy a TagData struct created by CreateTagData, and release
+   * its memory or keep it for later reuse.
+   *
+   * \param [in] tag The TagData to release.
+   */
+  static
+  void FreeTagData (TagData *tag);
   
   /**
    * Typedef of method function pointer for copy-on-write operations
@@ -341,15 +355,13 @@ PacketTagList::RemoveAll (void)
         }
       if (prev != 0) 
         {
-          prev->~TagData ();
-          std::free (prev);
+          FreeTagData (prev);
         }
       prev = cur;
     }
   if (prev != 0) 
     {
-      prev->~TagData ();
-      std::free (prev);
+      FreeTagData (prev);
     }
   m_next = 0;
 }
@@ -28,7 +28,7 @@ namespace ns3 {
 
 NS_LOG_COMPONENT_DEFINE ("Packet");
 
-uint32_t Packet::m_globalUid = 0;
+thread_local uint32_t Packet::m_globalUid = 0;
 
 TypeId 
 ByteTagIterator::Item::GetTypeId (void) const
@@ -126,6 +126,25 @@ Packet::Copy (void) const
   return Ptr<Packet> (new Packet (*this), false);
 }
 
+Ptr<Packet>
+Packet::DeepCopy (void) const
+{
+  NS_LOG_FUNCTION (this);
+  Buffer buffer;
+  buffer.AddAtStart (m_buffer.GetSize ());
+  buffer.Begin ().Write (m_buffer.Begin (), m_buffer.End ());
+  ByteTagList byteTagList;
+  byteTagList.Add (m_byteTagList);
+  Ptr<Packet> ret = Ptr<Packet> (new Packet (buffer, byteTagList,
+                                             m_packetTagList.DeepCopy (),
+                                             m_metadata.DeepCopy ()), false);
+  if (m_nixVector)
+    {
+      ret->SetNixVector (m_nixVector->Copy ());
+    }
+  return ret;
+}
+
 Packet::Packet ()
   : m_buffer (),
     m_byteTagList (),
@@ -428,6 +428,17 @@ public:
    */
   Ptr<Packet> Copy (void) const;
 
+  /**
+   * \brief performs a deep copy of the packet.
+   *
+   * \returns a deep copy of the packet.
+   *
+   * Unlike Copy, the returned packet shares none of its internal
+   * datasets with the original packet, so that each of them can
+   * then be used from a different thread.
+   */
+  Ptr<Packet> DeepCopy (void) const;
+
   /**
    * \brief Returns the packet's Uid.
    *
@@ -731,7 +742,7 @@ private:
   /* Please see comments above about nix-vector */
   Ptr<NixVector> m_nixVector; //!< the packet's Nix vector
 
-  static uint32_t m_globalUid; //!< Global counter of packets Uid
+  static thread_local uint32_t m_globalUid; //!< Per-thread counter of packets Uid
 };
 
 /**
@@ -378,6 +378,177 @@ BufferTest::DoRun (void)
   NS_TEST_ASSERT_MSG_EQ (val1, val2, "Bad ReadNtohU16()");
 }
 
+/**
+ * \ingroup network-test
+ * \ingroup tests
+ *
+ * Buffer free list test: buffer data of different sizes are reused.
+ */
+class BufferFreeListTest : public TestCase
+{
+public:
+  BufferFreeListTest ();
+private:
+  virtual void DoRun (void);
+};
+
+BufferFreeListTest::BufferFreeListTest ()
+  : TestCase ("Buffer size class free lists")
+{
+}
+
+void
+BufferFreeListTest::DoRun (void)
+{
+  uint32_t sizes[] = { 40, 576, 1500, 9000, 1500, 100 };
+  uint32_t nSizes = sizeof (sizes) / sizeof (sizes[0]);
+  // warm up the free lists with one buffer of each size
+  for (uint32_t i = 0; i < nSizes; ++i)
+    {
+      Buffer buffer;
+      buffer.AddAtStart (sizes[i]);
+    }
+
+  Buffer::ResetFreeListStats ();
+  for (uint32_t i = 0; i < nSizes; ++i)
+    {
+      Buffer buffer;
+      buffer.AddAtStart (sizes[i]);
+      buffer.Begin ().WriteU8 (0xab, sizes[i]);
+      NS_TEST_EXPECT_MSG_EQ (buffer.GetSize (), sizes[i], "Bad buffer size");
+      NS_TEST_EXPECT_MSG_EQ (buffer.Begin ().ReadU8 (), 0xab, "Bad buffer content");
+    }
+  Buffer::FreeListStats stats = Buffer::GetFreeListStats ();
+  NS_TEST_ASSERT_MSG_GT (stats.requests, 0, "No buffer data requested");
+#ifdef BUFFER_FREE_LIST
+  NS_TEST_EXPECT_MSG_EQ (stats.hits, stats.requests, "Every buffer data should come from a free list");
+  NS_TEST_EXPECT_MSG_EQ (stats.released, 0, "No buffer data should be freed");
+  NS_TEST_EXPECT_MSG_GT (stats.bytesRetained, 9000, "The free lists should retain the buffer data");
+#endif
+}
+
+/**
+ * \ingroup network-test
+ * \ingroup tests
+ *
+ * Buffer reassembly test: fragments of a buffer are concatenated back
+ * with AddAtEnd, whether they share their storage or not.
+ */
+class BufferReassemblyTest : public TestCase
+{
+public:
+  BufferReassemblyTest ();
+private:
+  virtual void DoRun (void);
+  /**
+   * Split a buffer in fragments and concatenate them back.
+   * \param buffer The buffer to split
+   * \param fragmentSize The size of the fragments
+   * \param unshare Add and remove a header to each fragment, which
+   * moves it to a storage of its own
+   * \returns The concatenated fragments
+   */
+  Buffer Reassemble (Buffer buffer, uint32_t fragmentSize, bool unshare);
+  /**
+   * Check that two buffers have the same content
+   * \param got The buffer to check
+   * \param expected The expected buffer
+   * \param msg The test message
+   */
+  void CheckContent (Buffer got, Buffer expected, std::string msg);
+};
+
+BufferReassemblyTest::BufferReassemblyTest ()
+  : TestCase ("Buffer fragment reassembly")
+{
+}
+
+Buffer
+BufferReassemblyTest::Reassemble (Buffer buffer, uint32_t fragmentSize, bool unshare)
+{
+  Buffer result;
+  for (uint32_t offset = 0; offset < buffer.GetSize (); offset += fragmentSize)
+    {
+      uint32_t size = std::min (fragmentSize, buffer.GetSize () - offset);
+      Buffer fragment = buffer.CreateFragment (offset, size);
+      if (unshare)
+        {
+          fragment.AddAtStart (8);
+          fragment.Begin ().WriteU8 (0xff, 8);
+          fragment.RemoveAtStart (8);
+        }
+      result.AddAtEnd (fragment);
+    }
+  return result;
+}
+
+void
+BufferReassemblyTest::CheckContent (Buffer got, Buffer expected, std::string msg)
+{
+  NS_TEST_ASSERT_MSG_EQ (got.GetSize (), expected.GetSize (), msg << ": bad size");
+  std::vector<uint8_t> gotBytes (got.GetSize ());
+  std::vector<uint8_t> expectedBytes (expected.GetSize ());
+  got.CopyData (gotBytes.data (), got.GetSize ());
+  expected.CopyData (expectedBytes.data (), expected.GetSize ());
+  NS_TEST_EXPECT_MSG_EQ ((gotBytes == expectedBytes), true, msg << ": bad content");
+}
+
+void
+BufferReassemblyTest::DoRun (void)
+{
+  // real data only
+  Buffer data;
+  data.AddAtStart (1000);
+  Buffer::Iterator i = data.Begin ();
+  for (uint32_t j = 0; j < 1000; j++)
+    {
+      i.WriteU8 (j % 251);
+    }
+  // real data around a zero area
+  Buffer zero (600);
+  zero.AddAtStart (100);
+  zero.Begin ().WriteU8 (0x11, 100);
+  zero.AddAtEnd (100);
+  i = zero.End ();
+  i.Prev (100);
+  i.WriteU8 (0x22, 100);
+
+  uint32_t sizes[] = { 1, 7, 96, 128, 333, 1000 };
+  for (uint32_t j = 0; j < sizeof (sizes) / sizeof (sizes[0]); j++)
+    {
+      std::ostringstream oss;
+      oss << " fragments of " << sizes[j] << " bytes";
+      CheckContent (Reassemble (data, sizes[j], false), data, "Shared data" + oss.str ());
+      CheckContent (Reassemble (data, sizes[j], true), data, "Data" + oss.str ());
+      CheckContent (Reassemble (zero, sizes[j], false), zero, "Shared zero area" + oss.str ());
+      CheckContent (Reassemble (zero, sizes[j], true), zero, "Zero area" + oss.str ());
+    }
+
+  // fragments out of order
+  Buffer swapped = data.CreateFragment (500, 500);
+  swapped.AddAtEnd (data.CreateFragment (0, 500));
+  CheckContent (swapped.CreateFragment (0, 500), data.CreateFragment (500, 500), "Swapped fragments, first half");
+  CheckContent (swapped.CreateFragment (500, 500), data.CreateFragment (0, 500), "Swapped fragments, second half");
+
+  // a buffer appended to itself
+  Buffer twice = data;
+  twice.AddAtEnd (twice);
+  CheckContent (twice.CreateFragment (0, 1000), data, "Self append, first half");
+  CheckContent (twice.CreateFragment (1000, 1000), data, "Self append, second half");
+  CheckContent (data, Reassemble (data, 1000, true), "Original buffer modified");
+
+  // a zero area followed by data, appended to an empty buffer, which
+  // takes over the zero area and then copies the data after it
+  Buffer trailing (600);
+  trailing.AddAtEnd (100);
+  i = trailing.End ();
+  i.Prev (100);
+  i.WriteU8 (0x33, 100);
+  Buffer empty;
+  empty.AddAtEnd (trailing);
+  CheckContent (empty, trailing, "Zero area and data appended to an empty buffer");
+}
+
 /**
  * \ingroup network-test
  * \ingroup tests
@@ -394,6 +565,8 @@ BufferTestSuite::BufferTestSuite ()
   : TestSuite ("buffer", UNIT)
 {
   AddTestCase (new BufferTest, TestCase::QUICK);
+  AddTestCase (new BufferFreeListTest, TestCase::QUICK);
+  AddTestCase (new BufferReassemblyTest, TestCase::QUICK);
 }
 
 static BufferTestSuite g_bufferTestSuite; //!< Static variable for test initialization
@@ -19,6 +19,7 @@
 #include "point-to-point-channel.h"
 #include "point-to-point-net-device.h"
 #include "ns3/trace-source-accessor.h"
+#include "ns3/node.h"
 #include "ns3/packet.h"
 #include "ns3/simulator.h"
 #include "ns3/log.h"
@@ -80,9 +81,18 @@ PointToPointChannel::Attach (Ptr<PointToPointNetDevice> device)
       m_link[1].m_dst = m_link[0].m_src;
       m_link[0].m_state = IDLE;
       m_link[1].m_state = IDLE;
+      m_link[0].m_dstNode = PeekPointer (m_link[0].m_dst->GetNode ());
+      m_link[1].m_dstNode = PeekPointer (m_link[1].m_dst->GetNode ());
     }
 }
 
+bool
+PointToPointChannel::IsCrossSystem (void) const
+{
+  return m_link[0].m_dstNode != 0 && m_link[1].m_dstNode != 0
+         && m_link[0].m_dstNode->GetSystemId () != m_link[1].m_dstNode->GetSystemId ();
+}
+
 bool
 PointToPointChannel::TransmitStart (
   Ptr<const Packet> p,
@@ -97,6 +107,18 @@ PointToPointChannel::TransmitStart (
 
   uint32_t wire = src == m_link[0].m_src ? 0 : 1;
 
+  if (IsCrossSystem ())
+    {
+      // The receiving node may be simulated by another thread: hand
+      // it a packet which shares nothing with the one of the sender,
+      // and do not touch the reference count of the receiving device,
+      // which is also why the animation trace is not fired.
+      Simulator::ScheduleWithContext (m_link[wire].m_dstNode->GetId (),
+                                      txTime + m_delay, &PointToPointNetDevice::Receive,
+                                      PeekPointer (m_link[wire].m_dst), p->DeepCopy ());
+      return true;
+    }
+
   Simulator::ScheduleWithContext (m_link[wire].m_dst->GetNode ()->GetId (),
                                   txTime + m_delay, &PointToPointNetDevice::Receive,
                                   m_link[wire].m_dst, p->Copy ());
@@ -121,6 +143,19 @@ PointToPointChannel::GetPointToPointDevice (uint32_t i) const
   return m_link[i].m_src;
 }
 
+Address
+PointToPointChannel::GetRemoteAddress (const PointToPointNetDevice *device) const
+{
+  NS_LOG_FUNCTION (this << device);
+  NS_ASSERT (m_nDevices == N_DEVICES);
+  if (m_link[0].m_src == device)
+    {
+      return m_link[1].m_src->GetAddress ();
+    }
+  NS_ASSERT (m_link[1].m_src == device);
+  return m_link[0].m_src->GetAddress ();
+}
+
 Ptr<NetDevice>
 PointToPointChannel::GetDevice (uint32_t i) const
 {
@@ -21,6 +21,7 @@
 
 #include <list>
 #include "ns3/channel.h"
+#include "ns3/address.h"
 #include "ns3/ptr.h"
 #include "ns3/nstime.h"
 #include "ns3/data-rate.h"
@@ -29,6 +30,7 @@
 namespace ns3 {
 
 class PointToPointNetDevice;
+class Node;
 class Packet;
 
 /**
@@ -93,6 +95,17 @@ public:
    */
   Ptr<PointToPointNetDevice> GetPointToPointDevice (uint32_t i) const;
 
+  /**
+   * \brief Get the address of the device at the other end of this channel
+   *
+   * Unlike GetDevice, this does not take a reference to the remote
+   * device, which may belong to a node simulated by another thread.
+   *
+   * \param device One of the two devices attached to this channel
+   * \returns The address of the other device
+   */
+  Address GetRemoteAddress (const PointToPointNetDevice *device) const;
+
   /**
    * \brief Get NetDevice corresponding to index i on this channel
    * \param i Index number of the device requested
@@ -194,13 +207,27 @@ public:
     /** \brief Create the link, it will be in INITIALIZING state
      *
      */
-    Link() : m_state (INITIALIZING), m_src (0), m_dst (0) {}
+    Link() : m_state (INITIALIZING), m_src (0), m_dst (0), m_dstNode (0) {}
 
     WireState                  m_state; //!< State of the link
     Ptr<PointToPointNetDevice> m_src;   //!< First NetDevice
     Ptr<PointToPointNetDevice> m_dst;   //!< Second NetDevice
+    /**
+     * Node of the second NetDevice, not reference counted so that
+     * another thread may use it.
+     */
+    Node                      *m_dstNode;
   };
 
+  /**
+   * Check whether the two devices belong to nodes with different
+   * system ids, which a parallel simulator may run in different threads.
+   * The system ids may be assigned after the devices are attached.
+   *
+   * eturns True if the channel crosses a partition boundary.
+   */
+  bool IsCrossSystem (void) const;
+
   Link    m_link[N_DEVICES]; //!< Link model
 };
 
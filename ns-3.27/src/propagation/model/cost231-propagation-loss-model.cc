@@ -142,25 +142,37 @@ Cost231PropagationLossModel::GetSSAntennaHeight (void) const
 double
 Cost231PropagationLossModel::GetLoss (Ptr<MobilityModel> a, Ptr<MobilityModel> b) const
 {
+  return GetLoss (GetLossTerms (), a->GetDistanceFrom (b));
+}
 
-  double distance = a->GetDistanceFrom (b);
-  if (distance <= m_minDistance)
-    {
-      return 0.0;
-    }
-
+Cost231PropagationLossModel::LossTerms
+Cost231PropagationLossModel::GetLossTerms (void) const
+{
+  LossTerms terms;
   double frequency_MHz = m_frequency * 1e-6;
 
-  double distance_km = distance * 1e-3;
-
   double C_H = 0.8 + ((1.11 * std::log10(frequency_MHz)) - 0.7) * m_SSAntennaHeight - (1.56 * std::log10(frequency_MHz));
 
   // from the COST231 wiki entry
   // See also http://www.lx.it.pt/cost231/final_report.htm
   // Ch. 4, eq. 4.4.3, pg. 135
 
-  double loss_in_db = 46.3 + (33.9 * std::log10(frequency_MHz)) - (13.82 * std::log10 (m_BSAntennaHeight)) - C_H
-		  	  	  + ((44.9 - 6.55 * std::log10 (m_BSAntennaHeight)) * std::log10 (distance_km)) + m_shadowing;
+  terms.m_intercept = 46.3 + (33.9 * std::log10(frequency_MHz)) - (13.82 * std::log10 (m_BSAntennaHeight)) - C_H;
+  terms.m_slope = 44.9 - 6.55 * std::log10 (m_BSAntennaHeight);
+  return terms;
+}
+
+double
+Cost231PropagationLossModel::GetLoss (const LossTerms &terms, double distance) const
+{
+  if (distance <= m_minDistance)
+    {
+      return 0.0;
+    }
+
+  double distance_km = distance * 1e-3;
+
+  double loss_in_db = terms.m_intercept + (terms.m_slope * std::log10 (distance_km)) + m_shadowing;
 
   NS_LOG_DEBUG ("dist =" << distance << ", Path Loss = " << loss_in_db);
 
@@ -174,6 +186,16 @@ Cost231PropagationLossModel::DoCalcRxPower (double txPowerDbm, Ptr<MobilityModel
   return txPowerDbm + GetLoss (a, b);
 }
 
+void
+Cost231PropagationLossModel::DoCalcRxPowers (const Destinations &b, double *rxPowerDbm) const
+{
+  LossTerms terms = GetLossTerms ();
+  for (size_t i = 0; i < b.m_distances.size (); i++)
+    {
+      rxPowerDbm[i] += GetLoss (terms, b.m_distances[i]);
+    }
+}
+
 int64_t
 Cost231PropagationLossModel::DoAssignStreams (int64_t stream)
 {
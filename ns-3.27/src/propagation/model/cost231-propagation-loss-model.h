@@ -139,6 +139,24 @@ private:
   Cost231PropagationLossModel & operator = (const Cost231PropagationLossModel &);
 
   virtual double DoCalcRxPower (double txPowerDbm, Ptr<MobilityModel> a, Ptr<MobilityModel> b) const;
+  virtual void DoCalcRxPowers (const Destinations &b, double *rxPowerDbm) const;
+
+  /// The terms of the loss which do not depend on the distance
+  struct LossTerms
+  {
+    double m_intercept; //!< loss before the distance term [dB]
+    double m_slope; //!< loss per decade of distance [dB]
+  };
+  /**
+   * \returns the terms of the loss for the current attributes
+   */
+  LossTerms GetLossTerms (void) const;
+  /**
+   * \param terms the terms of the loss
+   * \param distance the distance between the nodes [m]
+   * \returns the propagation loss (in dBm)
+   */
+  double GetLoss (const LossTerms &terms, double distance) const;
   virtual int64_t DoAssignStreams (int64_t stream);
   double m_BSAntennaHeight; //!< BS Antenna Height [m]
   double m_SSAntennaHeight; //!< SS Antenna Height [m]
@@ -60,24 +60,40 @@ ItuR1411LosPropagationLossModel::~ItuR1411LosPropagationLossModel ()
 
 double
 ItuR1411LosPropagationLossModel::GetLoss (Ptr<MobilityModel> a, Ptr<MobilityModel> b) const
+{
+  return GetLoss (GetLossTerms (a->GetPosition ().z, b->GetPosition ().z), a->GetDistanceFrom (b));
+}
+
+ItuR1411LosPropagationLossModel::LossTerms
+ItuR1411LosPropagationLossModel::GetLossTerms (double heightA, double heightB) const
 {
   NS_LOG_FUNCTION (this);
-  double dist = a->GetDistanceFrom (b);
+  LossTerms terms;
+  NS_ASSERT_MSG (heightA > 0 && heightB > 0, "nodes' height must be greater than 0");
+  double Lbp = std::fabs (20 * std::log10 ((m_lambda * m_lambda) / (8 * M_PI * heightA * heightB)));
+  double Rbp = (4 * heightA * heightB) / m_lambda;
+  NS_LOG_LOGIC (this << " Lbp " << Lbp << " Rbp " << Rbp << " lambda " << m_lambda);
+  terms.m_breakpointLoss = Lbp;
+  terms.m_breakpointDistance = Rbp;
+  return terms;
+}
+
+double
+ItuR1411LosPropagationLossModel::GetLoss (const LossTerms &terms, double distance) const
+{
+  double Lbp = terms.m_breakpointLoss;
+  double Rbp = terms.m_breakpointDistance;
   double lossLow = 0.0;
   double lossUp = 0.0;
-  NS_ASSERT_MSG (a->GetPosition ().z > 0 && b->GetPosition ().z > 0, "nodes' height must be greater than 0");
-  double Lbp = std::fabs (20 * std::log10 ((m_lambda * m_lambda) / (8 * M_PI * a->GetPosition ().z * b->GetPosition ().z)));
-  double Rbp = (4 * a->GetPosition ().z * b->GetPosition ().z) / m_lambda;
-  NS_LOG_LOGIC (this << " Lbp " << Lbp << " Rbp " << Rbp << " lambda " << m_lambda);
-  if (dist <= Rbp)
+  if (distance <= Rbp)
     {
-      lossLow = Lbp + 20 * std::log10 (dist / Rbp);
-      lossUp = Lbp + 20 + 25 * std::log10 (dist / Rbp);
+      lossLow = Lbp + 20 * std::log10 (distance / Rbp);
+      lossUp = Lbp + 20 + 25 * std::log10 (distance / Rbp);
     }
   else
     {
-      lossLow = Lbp + 40 * std::log10 (dist / Rbp);
-      lossUp = Lbp + 20 + 40 * std::log10 (dist / Rbp);
+      lossLow = Lbp + 40 * std::log10 (distance / Rbp);
+      lossUp = Lbp + 20 + 40 * std::log10 (distance / Rbp);
     }
 
   double loss = (lossUp + lossLow) / 2;
@@ -102,6 +118,22 @@ ItuR1411LosPropagationLossModel::DoCalcRxPower (double txPowerDbm,
   return (txPowerDbm - GetLoss (a, b));
 }
 
+void
+ItuR1411LosPropagationLossModel::DoCalcRxPowers (const Destinations &b, double *rxPowerDbm) const
+{
+  // The terms not depending on the distance are only computed again
+  // when the height of the destination changes
+  LossTerms terms = GetLossTerms (b.m_sourceHeight, b.m_heights[0]);
+  for (size_t i = 0; i < b.m_distances.size (); i++)
+    {
+      if (i > 0 && b.m_heights[i] != b.m_heights[i - 1])
+        {
+          terms = GetLossTerms (b.m_sourceHeight, b.m_heights[i]);
+        }
+      rxPowerDbm[i] -= GetLoss (terms, b.m_distances[i]);
+    }
+}
+
 int64_t
 ItuR1411LosPropagationLossModel::DoAssignStreams (int64_t stream)
 {
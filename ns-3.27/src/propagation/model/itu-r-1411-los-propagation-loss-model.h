@@ -89,6 +89,26 @@ private:
   virtual double DoCalcRxPower (double txPowerDbm,
                                 Ptr<MobilityModel> a,
                                 Ptr<MobilityModel> b) const;
+  virtual void DoCalcRxPowers (const Destinations &b, double *rxPowerDbm) const;
+
+  /// The terms of the loss which do not depend on the distance
+  struct LossTerms
+  {
+    double m_breakpointLoss; //!< basic transmission loss at the breakpoint [dB]
+    double m_breakpointDistance; //!< breakpoint distance [m]
+  };
+  /**
+   * \param heightA the height of the first node [m]
+   * \param heightB the height of the second node [m]
+   * \return the terms of the loss between two nodes at these heights
+   */
+  LossTerms GetLossTerms (double heightA, double heightB) const;
+  /**
+   * \param terms the terms of the loss at the heights of the nodes
+   * \param distance the distance between the nodes [m]
+   * \return the loss in dB for the propagation between the two nodes
+   */
+  double GetLoss (const LossTerms &terms, double distance) const;
   virtual int64_t DoAssignStreams (int64_t stream);
   
   double m_lambda; //!< wavelength
@@ -101,7 +101,14 @@ ItuR1411NlosOverRooftopPropagationLossModel::~ItuR1411NlosOverRooftopPropagation
 double
 ItuR1411NlosOverRooftopPropagationLossModel::GetLoss (Ptr<MobilityModel> a, Ptr<MobilityModel> b) const
 {
-  NS_LOG_FUNCTION (this << a << b);
+  return GetLoss (GetLossTerms (a->GetPosition ().z, b->GetPosition ().z), a->GetDistanceFrom (b));
+}
+
+ItuR1411NlosOverRooftopPropagationLossModel::LossTerms
+ItuR1411NlosOverRooftopPropagationLossModel::GetLossTerms (double heightA, double heightB) const
+{
+  NS_LOG_FUNCTION (this << heightA << heightB);
+  LossTerms terms;
   double Lori = 0.0;
   double fmhz = m_frequency / 1e6;
 
@@ -120,30 +127,68 @@ ItuR1411NlosOverRooftopPropagationLossModel::GetLoss (Ptr<MobilityModel> a, Ptr<
       Lori = 2.5 + 0.075 * (m_streetsOrientation - 55);
     }
 
-  double distance = a->GetDistanceFrom (b);
-  double hb = (a->GetPosition ().z > b->GetPosition ().z ? a->GetPosition ().z : b->GetPosition ().z);
-  double hm = (a->GetPosition ().z < b->GetPosition ().z ? a->GetPosition ().z : b->GetPosition ().z);
+  double hb = (heightA > heightB ? heightA : heightB);
+  double hm = (heightA < heightB ? heightA : heightB);
   NS_ASSERT_MSG (hm > 0 && hb > 0, "nodes' height must be greater then 0");
   double Dhb = hb - m_rooftopHeight;
+  terms.m_hb = hb;
+  terms.m_dhb = Dhb;
+
+  // Terms of Lmsd for ds < m_buildingsExtend
+  double kf = 0.0;
+  terms.m_ka = 0.0;
+  if (hb > m_rooftopHeight)
+    {
+      terms.m_lbsh = -18 * std::log10 (1 + Dhb);
+      terms.m_ka = (fmhz > 2000 ? 71.4 : 54.0);
+      terms.m_kd = 18.0;
+    }
+  else 
+    {
+      terms.m_lbsh = 0;
+      terms.m_kd = 18.0 - 15 * Dhb / heightA;
+    }
+  if (fmhz > 2000)
+    {
+      kf = -8;
+    }
+  else if ((m_environment == UrbanEnvironment)&&(m_citySize == LargeCity))
+    {
+      kf = -4 + 0.7 * (fmhz / 925.0 - 1);
+    }
+  else
+    {
+      kf = -4 + 1.5 * (fmhz / 925.0 - 1);
+    }
+  terms.m_kfTerm = kf * std::log10 (fmhz);
+  terms.m_separationTerm = 9.0 * std::log10 (m_buildingSeparation);
+
+  // Terms of Lmsd for ds >= m_buildingsExtend
+  double theta = std::atan (Dhb / m_buildingSeparation);
+  double rho = std::sqrt (Dhb * Dhb + m_buildingSeparation * m_buildingSeparation);
+  terms.m_sqrtLambdaRho = std::sqrt (m_lambda / rho);
+  terms.m_thetaTerm = (1 / theta - (1 / (2 * M_PI + theta)));
+
+  terms.m_frequencyTerm = 20 * std::log10 (fmhz);
+  double Dhm = m_rooftopHeight - hm;
+  terms.m_lrts = -8.2 - 10 * std::log10 (m_streetsWidth) + 10 * std::log10 (fmhz) + 20 * std::log10 (Dhm) + Lori;
+  NS_LOG_LOGIC (this << " Lrts " << terms.m_lrts << " Dhm" << Dhm);
+  return terms;
+}
+
+double
+ItuR1411NlosOverRooftopPropagationLossModel::GetLoss (const LossTerms &terms, double distance) const
+{
+  double hb = terms.m_hb;
+  double Dhb = terms.m_dhb;
   double ds = (m_lambda * distance * distance) / (Dhb * Dhb);
   double Lmsd = 0.0;
   NS_LOG_LOGIC (this << " build " << m_buildingsExtend << " ds " << ds << " roof " << m_rooftopHeight << " hb " << hb << " lambda " << m_lambda);
   if (ds < m_buildingsExtend)
     {
-      double Lbsh = 0.0;
-      double ka = 0.0;
-      double kd = 0.0;
-      double kf = 0.0;
-      if (hb > m_rooftopHeight)
-        {
-          Lbsh = -18 * std::log10 (1 + Dhb);
-          ka = (fmhz > 2000 ? 71.4 : 54.0);
-          kd = 18.0;
-        }
-      else 
+      double ka = terms.m_ka;
+      if (hb <= m_rooftopHeight)
         {
-          Lbsh = 0;
-          kd = 18.0 - 15 * Dhb / a->GetPosition ().z;
           if (distance < 500)
             {
               ka = 54.0 - 1.6 * Dhb * distance / 1000;
@@ -153,25 +198,10 @@ ItuR1411NlosOverRooftopPropagationLossModel::GetLoss (Ptr<MobilityModel> a, Ptr<
               ka = 54.0 - 0.8 * Dhb;
             }
         }
-      if (fmhz > 2000)
-        {
-          kf = -8;
-        }
-      else if ((m_environment == UrbanEnvironment)&&(m_citySize == LargeCity))
-        {
-          kf = -4 + 0.7 * (fmhz / 925.0 - 1);
-        }
-      else
-        {
-          kf = -4 + 1.5 * (fmhz / 925.0 - 1);
-        }
-
-      Lmsd = Lbsh + ka + kd * std::log10 (distance / 1000.0) + kf * std::log10 (fmhz) - 9.0 * std::log10 (m_buildingSeparation);
+      Lmsd = terms.m_lbsh + ka + terms.m_kd * std::log10 (distance / 1000.0) + terms.m_kfTerm - terms.m_separationTerm;
     }
   else
     {
-      double theta = std::atan (Dhb / m_buildingSeparation);
-      double rho = std::sqrt (Dhb * Dhb + m_buildingSeparation * m_buildingSeparation);
       double Qm = 0.0;
       if ((hb > m_rooftopHeight - 1.0) && (hb < m_rooftopHeight + 1.0))
         {
@@ -183,14 +213,13 @@ ItuR1411NlosOverRooftopPropagationLossModel::GetLoss (Ptr<MobilityModel> a, Ptr<
         }
       else
         {
-          Qm = m_buildingSeparation / (2 * M_PI * distance) * std::sqrt (m_lambda / rho) * (1 / theta - (1 / (2 * M_PI + theta)));
+          Qm = m_buildingSeparation / (2 * M_PI * distance) * terms.m_sqrtLambdaRho * terms.m_thetaTerm;
         }
       Lmsd = -10 * std::log10 (Qm * Qm);
     }
-  double Lbf = 32.4 + 20 * std::log10 (distance / 1000) + 20 * std::log10 (fmhz);
-  double Dhm = m_rooftopHeight - hm;
-  double Lrts = -8.2 - 10 * std::log10 (m_streetsWidth) + 10 * std::log10 (fmhz) + 20 * std::log10 (Dhm) + Lori;
-  NS_LOG_LOGIC (this << " Lbf " << Lbf << " Lrts " << Lrts << " Dhm" << Dhm << " Lmsd "  << Lmsd);
+  double Lbf = 32.4 + 20 * std::log10 (distance / 1000) + terms.m_frequencyTerm;
+  double Lrts = terms.m_lrts;
+  NS_LOG_LOGIC (this << " Lbf " << Lbf << " Lrts " << Lrts << " Lmsd "  << Lmsd);
   double loss = 0.0;
   if (Lrts + Lmsd > 0)
     {
@@ -220,6 +249,22 @@ ItuR1411NlosOverRooftopPropagationLossModel::DoCalcRxPower (double txPowerDbm,
   return (txPowerDbm - GetLoss (a, b));
 }
 
+void
+ItuR1411NlosOverRooftopPropagationLossModel::DoCalcRxPowers (const Destinations &b, double *rxPowerDbm) const
+{
+  // The terms not depending on the distance are only computed again
+  // when the height of the destination changes
+  LossTerms terms = GetLossTerms (b.m_sourceHeight, b.m_heights[0]);
+  for (size_t i = 0; i < b.m_distances.size (); i++)
+    {
+      if (i > 0 && b.m_heights[i] != b.m_heights[i - 1])
+        {
+          terms = GetLossTerms (b.m_sourceHeight, b.m_heights[i]);
+        }
+      rxPowerDbm[i] -= GetLoss (terms, b.m_distances[i]);
+    }
+}
+
 int64_t
 ItuR1411NlosOverRooftopPropagationLossModel::DoAssignStreams (int64_t stream)
 {
@@ -89,6 +89,35 @@ private:
   virtual double DoCalcRxPower (double txPowerDbm,
                                 Ptr<MobilityModel> a,
                                 Ptr<MobilityModel> b) const;
+  virtual void DoCalcRxPowers (const Destinations &b, double *rxPowerDbm) const;
+
+  /// The terms of the loss which do not depend on the distance
+  struct LossTerms
+  {
+    double m_hb; //!< height of the base station [m]
+    double m_dhb; //!< height of the base station above the rooftops [m]
+    double m_lbsh; //!< Lbsh, for ds < buildings extend [dB]
+    double m_ka; //!< ka, when the base station is above the rooftops [dB]
+    double m_kd; //!< kd, for ds < buildings extend
+    double m_kfTerm; //!< kf log10 (f) [dB]
+    double m_separationTerm; //!< 9 log10 (b) [dB]
+    double m_sqrtLambdaRho; //!< sqrt (lambda / rho), for ds >= buildings extend
+    double m_thetaTerm; //!< 1 / theta - 1 / (2 pi + theta), for ds >= buildings extend
+    double m_frequencyTerm; //!< 20 log10 (f) in the free space loss [dB]
+    double m_lrts; //!< Lrts, the rooftop-to-street diffraction loss [dB]
+  };
+  /**
+   * \param heightA the height of the first node [m]
+   * \param heightB the height of the second node [m]
+   * \return the terms of the loss between two nodes at these heights
+   */
+  LossTerms GetLossTerms (double heightA, double heightB) const;
+  /**
+   * \param terms the terms of the loss at the heights of the nodes
+   * \param distance the distance between the nodes [m]
+   * \return the loss in dB for the propagation between the two nodes
+   */
+  double GetLoss (const LossTerms &terms, double distance) const;
   virtual int64_t DoAssignStreams (int64_t stream);
   
   double m_frequency; //!< frequency in MHz
@@ -75,19 +75,26 @@ OkumuraHataPropagationLossModel::~OkumuraHataPropagationLossModel ()
 double
 OkumuraHataPropagationLossModel::GetLoss (Ptr<MobilityModel> a, Ptr<MobilityModel> b) const
 {
-  double loss = 0.0;
+  return GetLoss (GetLossTerms (a->GetPosition ().z, b->GetPosition ().z), a->GetDistanceFrom (b));
+}
+
+OkumuraHataPropagationLossModel::LossTerms
+OkumuraHataPropagationLossModel::GetLossTerms (double heightA, double heightB) const
+{
+  LossTerms terms;
   double fmhz = m_frequency / 1e6;
-  double dist = a->GetDistanceFrom (b) / 1000.0; 
+  double log_f = std::log10 (fmhz);
+  double hb = (heightA > heightB ? heightA : heightB);
+  double hm = (heightA < heightB ? heightA : heightB);
+  NS_ASSERT_MSG (hb > 0 && hm > 0, "nodes' height must be greater then 0");
+  double log_aHeight = 13.82 * std::log10 (hb);
+  double log_bHeight = 0.0;
+  terms.m_slope = 44.9 - (6.55 * std::log10 (hb));
+  terms.m_correction = 0.0;
   if (m_frequency <= 1.500e9)
     {
       // standard Okumura Hata 
       // see eq. (4.4.1) in the COST 231 final report
-      double log_f = std::log10 (fmhz);
-      double hb = (a->GetPosition ().z > b->GetPosition ().z ? a->GetPosition ().z : b->GetPosition ().z);
-      double hm = (a->GetPosition ().z < b->GetPosition ().z ? a->GetPosition ().z : b->GetPosition ().z);
-      NS_ASSERT_MSG (hb > 0 && hm > 0, "nodes' height must be greater then 0");
-      double log_aHeight = 13.82 * std::log10 (hb);
-      double log_bHeight = 0.0;
       if (m_citySize == LargeCity)
         {
           if (fmhz < 200)
@@ -104,44 +111,43 @@ OkumuraHataPropagationLossModel::GetLoss (Ptr<MobilityModel> a, Ptr<MobilityMode
           log_bHeight = 0.8 + (1.1 * log_f - 0.7) * hm - 1.56 * log_f;
         }
 
-      NS_LOG_INFO (this << " logf " << 26.16 * log_f << " loga " << log_aHeight << " X " << (((44.9 - (6.55 * std::log10 (hb)) )) * std::log10 (a->GetDistanceFrom (b))) << " logb " << log_bHeight);
-      loss = 69.55 + (26.16 * log_f) - log_aHeight + (((44.9 - (6.55 * std::log10 (hb)) )) * std::log10 (dist)) - log_bHeight;
+      NS_LOG_INFO (this << " logf " << 26.16 * log_f << " loga " << log_aHeight << " slope " << terms.m_slope << " logb " << log_bHeight);
+      terms.m_intercept = 69.55 + (26.16 * log_f) - log_aHeight;
       if (m_environment == SubUrbanEnvironment)
         {
-          loss += -2 * (std::pow (std::log10 (fmhz / 28), 2)) - 5.4;
+          terms.m_correction = -2 * (std::pow (std::log10 (fmhz / 28), 2)) - 5.4;
         }
       else if (m_environment == OpenAreasEnvironment)
         {
-          loss += -4.70 * std::pow (std::log10 (fmhz),2) + 18.33 * std::log10 (fmhz) - 40.94;
+          terms.m_correction = -4.70 * std::pow (std::log10 (fmhz),2) + 18.33 * std::log10 (fmhz) - 40.94;
         }
-
     }
   else
     {
       // COST 231 Okumura model
       // see eq. (4.4.3) in the COST 231 final report
 
-      double log_f = std::log10 (fmhz);
-      double hb = (a->GetPosition ().z > b->GetPosition ().z ? a->GetPosition ().z : b->GetPosition ().z);
-      double hm = (a->GetPosition ().z < b->GetPosition ().z ? a->GetPosition ().z : b->GetPosition ().z);
-      NS_ASSERT_MSG (hb > 0 && hm > 0, "nodes' height must be greater then 0");
-      double log_aHeight = 13.82 * std::log10 (hb);
-      double log_bHeight = 0.0;
-      double C = 0.0;
-
       if (m_citySize == LargeCity)
         {
           log_bHeight = 3.2 * std::pow ((std::log10 (11.75 * hm)), 2);
-          C = 3;
+          terms.m_correction = 3;
         }
       else
         {
           log_bHeight = 1.1 * log_f - 0.7 * hm - (1.56 * log_f - 0.8);
         }
 
-      loss = 46.3 + (33.9 * log_f) - log_aHeight + (((44.9 - (6.55 * std::log10 (hb)) )) * std::log10 (dist)) - log_bHeight + C;
+      terms.m_intercept = 46.3 + (33.9 * log_f) - log_aHeight;
     }
-  return loss;
+  terms.m_mobileHeightGain = log_bHeight;
+  return terms;
+}
+
+double
+OkumuraHataPropagationLossModel::GetLoss (const LossTerms &terms, double distance) const
+{
+  double dist = distance / 1000.0;
+  return terms.m_intercept + (terms.m_slope * std::log10 (dist)) - terms.m_mobileHeightGain + terms.m_correction;
 }
 
 double 
@@ -152,6 +158,22 @@ OkumuraHataPropagationLossModel::DoCalcRxPower (double txPowerDbm,
   return (txPowerDbm - GetLoss (a, b));
 }
 
+void
+OkumuraHataPropagationLossModel::DoCalcRxPowers (const Destinations &b, double *rxPowerDbm) const
+{
+  // The terms not depending on the distance are only computed again
+  // when the height of the destination changes
+  LossTerms terms = GetLossTerms (b.m_sourceHeight, b.m_heights[0]);
+  for (size_t i = 0; i < b.m_distances.size (); i++)
+    {
+      if (i > 0 && b.m_heights[i] != b.m_heights[i - 1])
+        {
+          terms = GetLossTerms (b.m_sourceHeight, b.m_heights[i]);
+        }
+      rxPowerDbm[i] -= GetLoss (terms, b.m_distances[i]);
+    }
+}
+
 int64_t
 OkumuraHataPropagationLossModel::DoAssignStreams (int64_t stream)
 {
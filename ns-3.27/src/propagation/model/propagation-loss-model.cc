@@ -24,16 +24,54 @@
 #include "propagation-loss-model.h"
 #include "ns3/log.h"
 #include "ns3/mobility-model.h"
+#include "ns3/constant-position-mobility-model.h"
 #include "ns3/boolean.h"
 #include "ns3/double.h"
 #include "ns3/string.h"
 #include "ns3/pointer.h"
+#include "ns3/uinteger.h"
 #include <cmath>
 
 namespace ns3 {
 
 NS_LOG_COMPONENT_DEFINE ("PropagationLossModel");
 
+/*
+ * The geometry of a batch of links is computed by the kernel below on
+ * plain arrays, in a loop which the compiler vectorizes.  Where the
+ * toolchain supports function multi-versioning, the kernel is also
+ * built for AVX2 and the loader picks the version matching the
+ * processor.
+ */
+#if defined (__GNUC__) && !defined (__clang__) && (__GNUC__ >= 6) && defined (__x86_64__) && defined (__linux__)
+#define PROPAGATION_LOSS_KERNEL __attribute__ ((target_clones ("avx2", "default")))
+#else
+#define PROPAGATION_LOSS_KERNEL
+#endif
+
+namespace {
+
+/*
+ * Compute the squared distances from (x, y, z) to n points.  The
+ * square roots are left to the caller: std::sqrt may set errno, which
+ * keeps the compiler from vectorizing it.
+ */
+PROPAGATION_LOSS_KERNEL void
+SquaredDistances (double x, double y, double z,
+                  const double *bx, const double *by, const double *bz,
+                  double *distance, size_t n)
+{
+  for (size_t i = 0; i < n; ++i)
+    {
+      double dx = bx[i] - x;
+      double dy = by[i] - y;
+      double dz = bz[i] - z;
+      distance[i] = dx * dx + dy * dy + dz * dz;
+    }
+}
+
+} // anonymous namespace
+
 // ------------------------------------------------------------------------- //
 
 NS_OBJECT_ENSURE_REGISTERED (PropagationLossModel);
@@ -82,6 +120,92 @@ PropagationLossModel::CalcRxPower (double txPowerDbm,
   return self;
 }
 
+void
+PropagationLossModel::CalcRxPower (double txPowerDbm,
+                                   Ptr<MobilityModel> a,
+                                   const std::vector<Ptr<MobilityModel> > &b,
+                                   std::vector<double> &rxPowerDbm) const
+{
+  NS_LOG_FUNCTION (this << txPowerDbm << a << b.size ());
+  rxPowerDbm.assign (b.size (), txPowerDbm);
+  if (b.empty ())
+    {
+      return;
+    }
+  Destinations destinations (a, b);
+  for (const PropagationLossModel *model = this; model != 0; model = PeekPointer (model->m_next))
+    {
+      model->DoCalcRxPowers (destinations, &rxPowerDbm[0]);
+    }
+}
+
+void
+PropagationLossModel::DoCalcRxPowers (const Destinations &b, double *rxPowerDbm) const
+{
+  for (size_t i = 0; i < b.m_destinations.size (); i++)
+    {
+      rxPowerDbm[i] = DoCalcRxPower (rxPowerDbm[i], b.m_source, b.m_destinations[i]);
+    }
+}
+
+PropagationLossModel::Destinations::Destinations (Ptr<MobilityModel> a, const std::vector<Ptr<MobilityModel> > &b)
+  : m_source (a),
+    m_destinations (b),
+    m_heights (b.size ()),
+    m_distances (b.size ())
+{
+  Vector source = a->GetPosition ();
+  m_sourceHeight = source.z;
+  std::vector<double> x (b.size ());
+  std::vector<double> y (b.size ());
+  for (size_t i = 0; i < b.size (); i++)
+    {
+      Vector position = b[i]->GetPosition ();
+      x[i] = position.x;
+      y[i] = position.y;
+      m_heights[i] = position.z;
+    }
+  SquaredDistances (source.x, source.y, source.z, &x[0], &y[0], &m_heights[0], &m_distances[0], b.size ());
+  for (size_t i = 0; i < b.size (); i++)
+    {
+      m_distances[i] = std::sqrt (m_distances[i]);
+    }
+}
+
+double
+PropagationLossModel::CalcRange (double maxLossDb, double maxRange,
+                                 double heightA, double heightB) const
+{
+  NS_LOG_FUNCTION (this << maxLossDb << maxRange << heightA << heightB);
+  Ptr<ConstantPositionMobilityModel> a = CreateObject<ConstantPositionMobilityModel> ();
+  Ptr<ConstantPositionMobilityModel> b = CreateObject<ConstantPositionMobilityModel> ();
+  a->SetPosition (Vector (0, 0, heightA));
+  b->SetPosition (Vector (maxRange, 0, heightB));
+  // A loss which cannot be compared, such as NaN, keeps the node in range
+  if (!(-CalcRxPower (0, a, b) > maxLossDb))
+    {
+      return b->GetDistanceFrom (a);
+    }
+  // The loss does not exceed maxLossDb at low and exceeds it at high
+  double low = 0;
+  double high = maxRange;
+  while (high - low > 1e-3 * high && high - low > 1e-3)
+    {
+      double middle = (low + high) / 2;
+      b->SetPosition (Vector (middle, 0, heightB));
+      if (-CalcRxPower (0, a, b) > maxLossDb)
+        {
+          high = middle;
+        }
+      else
+        {
+          low = middle;
+        }
+    }
+  b->SetPosition (Vector (high, 0, heightB));
+  return b->GetDistanceFrom (a);
+}
+
 int64_t
 PropagationLossModel::AssignStreams (int64_t stream)
 {
@@ -255,20 +379,34 @@ FriisPropagationLossModel::DoCalcRxPower (double txPowerDbm,
    * L: system loss (unit-less)
    * lambda: wavelength (m)
    */
-  double distance = a->GetDistanceFrom (b);
+  return txPowerDbm - GetLoss (a->GetDistanceFrom (b));
+}
+
+void
+FriisPropagationLossModel::DoCalcRxPowers (const Destinations &b, double *rxPowerDbm) const
+{
+  for (size_t i = 0; i < b.m_distances.size (); i++)
+    {
+      rxPowerDbm[i] -= GetLoss (b.m_distances[i]);
+    }
+}
+
+double
+FriisPropagationLossModel::GetLoss (double distance) const
+{
   if (distance < 3*m_lambda)
     {
       NS_LOG_WARN ("distance not within the far field region => inaccurate propagation loss value");
     }
   if (distance <= 0)
     {
-      return txPowerDbm - m_minLoss;
+      return m_minLoss;
     }
   double numerator = m_lambda * m_lambda;
   double denominator = 16 * M_PI * M_PI * distance * distance * m_systemLoss;
   double lossDb = -10 * log10 (numerator / denominator);
   NS_LOG_DEBUG ("distance=" << distance<< "m, loss=" << lossDb <<"dB");
-  return txPowerDbm - std::max (lossDb, m_minLoss);
+  return std::max (lossDb, m_minLoss);
 }
 
 int64_t
@@ -508,10 +646,24 @@ LogDistancePropagationLossModel::DoCalcRxPower (double txPowerDbm,
                                                 Ptr<MobilityModel> a,
                                                 Ptr<MobilityModel> b) const
 {
-  double distance = a->GetDistanceFrom (b);
+  return txPowerDbm - GetLoss (a->GetDistanceFrom (b));
+}
+
+void
+LogDistancePropagationLossModel::DoCalcRxPowers (const Destinations &b, double *rxPowerDbm) const
+{
+  for (size_t i = 0; i < b.m_distances.size (); i++)
+    {
+      rxPowerDbm[i] -= GetLoss (b.m_distances[i]);
+    }
+}
+
+double
+LogDistancePropagationLossModel::GetLoss (double distance) const
+{
   if (distance <= m_referenceDistance)
     {
-      return txPowerDbm - m_referenceLoss;
+      return m_referenceLoss;
     }
   /**
    * The formula is:
@@ -531,7 +683,7 @@ LogDistancePropagationLossModel::DoCalcRxPower (double txPowerDbm,
   double rxc = -m_referenceLoss - pathLossDb;
   NS_LOG_DEBUG ("distance="<<distance<<"m, reference-attenuation="<< -m_referenceLoss<<"dB, "<<
                 "attenuation coefficient="<<rxc<<"db");
-  return txPowerDbm + rxc;
+  return -rxc;
 }
 
 int64_t
@@ -600,7 +752,21 @@ ThreeLogDistancePropagationLossModel::DoCalcRxPower (double txPowerDbm,
                                                      Ptr<MobilityModel> a,
                                                      Ptr<MobilityModel> b) const
 {
-  double distance = a->GetDistanceFrom (b);
+  return txPowerDbm - GetLoss (a->GetDistanceFrom (b));
+}
+
+void
+ThreeLogDistancePropagationLossModel::DoCalcRxPowers (const Destinations &b, double *rxPowerDbm) const
+{
+  for (size_t i = 0; i < b.m_distances.size (); i++)
+    {
+      rxPowerDbm[i] -= GetLoss (b.m_distances[i]);
+    }
+}
+
+double
+ThreeLogDistancePropagationLossModel::GetLoss (double distance) const
+{
   NS_ASSERT (distance >= 0);
 
   // See doxygen comments for the formula and explanation
@@ -633,7 +799,7 @@ ThreeLogDistancePropagationLossModel::DoCalcRxPower (double txPowerDbm,
   NS_LOG_DEBUG ("ThreeLogDistance distance=" << distance << "m, " <<
                 "attenuation=" << pathLossDb << "dB");
 
-  return txPowerDbm - pathLossDb;
+  return pathLossDb;
 }
 
 int64_t
@@ -932,4 +1098,137 @@ RangePropagationLossModel::DoAssignStreams (int64_t stream)
 
 // ------------------------------------------------------------------------- //
 
+NS_OBJECT_ENSURE_REGISTERED (CachedPropagationLossModel);
+
+TypeId
+CachedPropagationLossModel::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::CachedPropagationLossModel")
+    .SetParent<PropagationLossModel> ()
+    .SetGroupName ("Propagation")
+    .AddConstructor<CachedPropagationLossModel> ()
+    .AddAttribute ("Model",
+                   "The model whose loss is cached.",
+                   PointerValue (),
+                   MakePointerAccessor (&CachedPropagationLossModel::SetModel,
+                                        &CachedPropagationLossModel::GetModel),
+                   MakePointerChecker<PropagationLossModel> ())
+    .AddAttribute ("MaxSize",
+                   "The largest number of pairs of nodes whose loss is cached, 0 for no limit.",
+                   UintegerValue (100000),
+                   MakeUintegerAccessor (&CachedPropagationLossModel::SetMaxSize,
+                                         &CachedPropagationLossModel::GetMaxSize),
+                   MakeUintegerChecker<uint32_t> ())
+    .AddAttribute ("PositionThreshold",
+                   "The distance (m) either node of a pair may move before their loss is computed again.",
+                   DoubleValue (0),
+                   MakeDoubleAccessor (&CachedPropagationLossModel::SetPositionThreshold,
+                                       &CachedPropagationLossModel::GetPositionThreshold),
+                   MakeDoubleChecker<double> (0))
+  ;
+  return tid;
+}
+
+CachedPropagationLossModel::CachedPropagationLossModel ()
+  : m_cache (false)
+{
+  NS_LOG_FUNCTION (this);
+}
+
+CachedPropagationLossModel::~CachedPropagationLossModel ()
+{
+  NS_LOG_FUNCTION (this);
+}
+
+void
+CachedPropagationLossModel::DoDispose (void)
+{
+  NS_LOG_FUNCTION (this);
+  m_cache.Clear ();
+  m_model = 0;
+  PropagationLossModel::DoDispose ();
+}
+
+void
+CachedPropagationLossModel::SetModel (Ptr<PropagationLossModel> model)
+{
+  NS_LOG_FUNCTION (this << model);
+  m_model = model;
+  m_cache.Clear ();
+}
+
+Ptr<PropagationLossModel>
+CachedPropagationLossModel::GetModel (void) const
+{
+  return m_model;
+}
+
+void
+CachedPropagationLossModel::SetMaxSize (uint32_t maxSize)
+{
+  NS_LOG_FUNCTION (this << maxSize);
+  m_cache.SetMaxSize (maxSize);
+}
+
+uint32_t
+CachedPropagationLossModel::GetMaxSize (void) const
+{
+  return m_cache.GetMaxSize ();
+}
+
+void
+CachedPropagationLossModel::SetPositionThreshold (double threshold)
+{
+  NS_LOG_FUNCTION (this << threshold);
+  m_cache.SetPositionThreshold (threshold);
+}
+
+double
+CachedPropagationLossModel::GetPositionThreshold (void) const
+{
+  return m_cache.GetPositionThreshold ();
+}
+
+uint64_t
+CachedPropagationLossModel::GetCacheHits (void) const
+{
+  return m_cache.GetHits ();
+}
+
+uint64_t
+CachedPropagationLossModel::GetCacheMisses (void) const
+{
+  return m_cache.GetMisses ();
+}
+
+double
+CachedPropagationLossModel::DoCalcRxPower (double txPowerDbm,
+                                           Ptr<MobilityModel> a,
+                                           Ptr<MobilityModel> b) const
+{
+  NS_ASSERT_MSG (m_model != 0, "CachedPropagationLossModel needs a Model");
+  Ptr<PathGain> gain = m_cache.GetPathData (a, b, 0);
+  if (gain != 0)
+    {
+      return txPowerDbm + gain->m_gainDb;
+    }
+  double rxPowerDbm = m_model->CalcRxPower (txPowerDbm, a, b);
+  gain = Create<PathGain> ();
+  gain->m_gainDb = rxPowerDbm - txPowerDbm;
+  m_cache.AddPathData (gain, a, b, 0);
+  return rxPowerDbm;
+}
+
+int64_t
+CachedPropagationLossModel::DoAssignStreams (int64_t stream)
+{
+  if (m_model == 0)
+    {
+      return 0;
+    }
+  return m_model->AssignStreams (stream);
+}
+
+// ------------------------------------------------------------------------- //
+
 } // namespace ns3
@@ -27,7 +27,10 @@
 
 #include "ns3/object.h"
 #include "ns3/random-variable-stream.h"
+#include "ns3/simple-ref-count.h"
+#include "propagation-cache.h"
 #include <map>
+#include <vector>
 
 namespace ns3 {
 
@@ -93,6 +96,50 @@ public:
                       Ptr<MobilityModel> a,
                       Ptr<MobilityModel> b) const;
 
+  /**
+   * Returns the Rx Power at several destinations of the same source,
+   * taking into account all the PropagationLossModel(s) chained to the
+   * current one.
+   *
+   * The positions of the nodes are read, and the distances from the
+   * source computed, once for the whole chain, and each model of the
+   * chain is evaluated for all the destinations in one pass.  The
+   * results are the same as calling CalcRxPower for each destination
+   * in turn, and models drawing random variables draw them for the
+   * destinations in the same order.
+   *
+   * \param txPowerDbm current transmission power (in dBm)
+   * \param a the mobility model of the source
+   * \param b the mobility models of the destinations
+   * \param rxPowerDbm the reception power at each destination (in dBm),
+   *        resized to the number of destinations
+   */
+  void CalcRxPower (double txPowerDbm,
+                    Ptr<MobilityModel> a,
+                    const std::vector<Ptr<MobilityModel> > &b,
+                    std::vector<double> &rxPowerDbm) const;
+
+  /**
+   * Find the distance beyond which the loss of the chain of models
+   * exceeds a value, by bisection over CalcRxPower between two nodes
+   * at fixed heights.
+   *
+   * The loss of the chain must be deterministic and must not decrease
+   * with the distance: models drawing random variables would have
+   * their streams advanced, and models needing objects aggregated to
+   * the MobilityModel, such as the building models, cannot be used.
+   *
+   * \param maxLossDb the loss [dB]
+   * \param maxRange the largest distance considered [m]
+   * \param heightA the height of the source [m]
+   * \param heightB the height of the destination [m]
+   * \return the distance [m] between the nodes, never less than the
+   *          distance at which the loss reaches maxLossDb, and maxRange
+   *          if the loss at maxRange does not exceed maxLossDb
+   */
+  double CalcRange (double maxLossDb, double maxRange,
+                    double heightA = 0, double heightB = 0) const;
+
   /**
    * If this loss model uses objects of type RandomVariableStream,
    * set the stream numbers to the integers starting with the offset
@@ -106,6 +153,29 @@ public:
    */
   int64_t AssignStreams (int64_t stream);
 
+protected:
+  /**
+   * The destinations of a batch of links from the same source, with
+   * the geometry shared by the models of a chain.
+   */
+  struct Destinations
+  {
+    /**
+     * Read the positions of the nodes, and compute the distances from
+     * the source.
+     *
+     * \param a the mobility model of the source
+     * \param b the mobility models of the destinations
+     */
+    Destinations (Ptr<MobilityModel> a, const std::vector<Ptr<MobilityModel> > &b);
+
+    Ptr<MobilityModel> m_source; //!< the mobility model of the source
+    const std::vector<Ptr<MobilityModel> > &m_destinations; //!< the mobility models of the destinations
+    double m_sourceHeight; //!< the height of the source [m]
+    std::vector<double> m_heights; //!< the height of each destination [m]
+    std::vector<double> m_distances; //!< the distance from the source to each destination [m]
+  };
+
 private:
   /**
    * \brief Copy constructor
@@ -134,6 +204,19 @@ private:
                                 Ptr<MobilityModel> a,
                                 Ptr<MobilityModel> b) const = 0;
 
+  /**
+   * Updates the Rx Power at several destinations taking into account
+   * only the particular PropagationLossModel.
+   *
+   * The default implementation calls DoCalcRxPower for each
+   * destination.  Models overriding it must give the same results.
+   *
+   * \param b the source and the destinations, at least one
+   * \param rxPowerDbm the power at each destination (in dBm), before
+   *        and after adding/multiplying propagation loss
+   */
+  virtual void DoCalcRxPowers (const Destinations &b, double *rxPowerDbm) const;
+
   /**
    * Subclasses must implement this; those not using random variables
    * can return zero
@@ -321,6 +404,12 @@ private:
   virtual double DoCalcRxPower (double txPowerDbm,
                                 Ptr<MobilityModel> a,
                                 Ptr<MobilityModel> b) const;
+  virtual void DoCalcRxPowers (const Destinations &b, double *rxPowerDbm) const;
+  /**
+   * \param distance the distance between the nodes [m]
+   * \return the loss [dB]
+   */
+  double GetLoss (double distance) const;
   virtual int64_t DoAssignStreams (int64_t stream);
 
   /**
@@ -529,6 +618,12 @@ private:
   virtual double DoCalcRxPower (double txPowerDbm,
                                 Ptr<MobilityModel> a,
                                 Ptr<MobilityModel> b) const;
+  virtual void DoCalcRxPowers (const Destinations &b, double *rxPowerDbm) const;
+  /**
+   * \param distance the distance between the nodes [m]
+   * \return the loss [dB]
+   */
+  double GetLoss (double distance) const;
   virtual int64_t DoAssignStreams (int64_t stream);
 
   /**
@@ -612,6 +707,12 @@ private:
   virtual double DoCalcRxPower (double txPowerDbm,
                                 Ptr<MobilityModel> a,
                                 Ptr<MobilityModel> b) const;
+  virtual void DoCalcRxPowers (const Destinations &b, double *rxPowerDbm) const;
+  /**
+   * \param distance the distance between the nodes [m]
+   * \return the loss [dB]
+   */
+  double GetLoss (double distance) const;
   virtual int64_t DoAssignStreams (int64_t stream);
 
   double m_distance0; //!< Beginning of the first (near) distance field
@@ -856,6 +957,103 @@ private:
   double m_range; //!< Maximum Transmission Range (meters)
 };
 
+/**
+ * \ingroup propagation
+ *
+ * \brief Memoize the loss of another model for each pair of nodes.
+ *
+ * The loss computed by the Model attribute, which may be a chain of
+ * models, is kept for each pair of nodes, and reused until either node
+ * moves further than the PositionThreshold attribute.  The cache holds
+ * at most MaxSize pairs, evicting the least recently used ones.
+ *
+ * This is only correct for models which are deterministic for a given
+ * pair of positions, and whose loss does not depend on the transmit
+ * power, such as the distance based and the buildings models, or
+ * models keeping a random value per pair of nodes, like the shadowing
+ * of BuildingsPropagationLossModel.  Models drawing a new value for
+ * each packet, such as NakagamiPropagationLossModel, or varying in
+ * time, such as JakesPropagationLossModel, should be chained after
+ * this model rather than cached.  Pairs are directional, a->b and
+ * b->a being cached separately.
+ */
+class CachedPropagationLossModel : public PropagationLossModel
+{
+public:
+  /**
+   * \brief Get the type ID.
+   * \return the object TypeId
+   */
+  static TypeId GetTypeId (void);
+
+  CachedPropagationLossModel ();
+  virtual ~CachedPropagationLossModel ();
+
+  /**
+   * \param model the model whose loss is cached
+   */
+  void SetModel (Ptr<PropagationLossModel> model);
+  /**
+   * \return the model whose loss is cached
+   */
+  Ptr<PropagationLossModel> GetModel (void) const;
+  /**
+   * \return the number of losses found in the cache
+   */
+  uint64_t GetCacheHits (void) const;
+  /**
+   * \return the number of losses computed by the model
+   */
+  uint64_t GetCacheMisses (void) const;
+
+private:
+  /**
+   * \brief Copy constructor
+   *
+   * Defined and unimplemented to avoid misuse
+   */
+  CachedPropagationLossModel (const CachedPropagationLossModel &);
+  /**
+   * \brief Copy constructor
+   *
+   * Defined and unimplemented to avoid misuse
+   * \returns
+   */
+  CachedPropagationLossModel &operator = (const CachedPropagationLossModel &);
+
+  virtual void DoDispose (void);
+  virtual double DoCalcRxPower (double txPowerDbm,
+                                Ptr<MobilityModel> a,
+                                Ptr<MobilityModel> b) const;
+  virtual int64_t DoAssignStreams (int64_t stream);
+
+  /**
+   * \param maxSize the largest number of pairs of nodes in the cache
+   */
+  void SetMaxSize (uint32_t maxSize);
+  /**
+   * \return the largest number of pairs of nodes in the cache
+   */
+  uint32_t GetMaxSize (void) const;
+  /**
+   * \param threshold the distance the nodes may move before their loss is computed again [m]
+   */
+  void SetPositionThreshold (double threshold);
+  /**
+   * \return the distance the nodes may move before their loss is computed again [m]
+   */
+  double GetPositionThreshold (void) const;
+
+  /// The gain of a pair of nodes
+  struct PathGain : public SimpleRefCount<PathGain>
+  {
+    double m_gainDb; //!< received minus transmitted power [dB]
+  };
+
+  Ptr<PropagationLossModel> m_model; //!< the model whose loss is cached
+  mutable PropagationCache<PathGain> m_cache; //!< the gain of each pair of nodes
+};
+
 } // namespace ns3
 
 #endif /* PROPAGATION_LOSS_MODEL_H */
@@ -21,9 +21,15 @@
 #include "ns3/test.h"
 #include "ns3/config.h"
 #include "ns3/double.h"
+#include "ns3/uinteger.h"
 #include "ns3/propagation-loss-model.h"
+#include "ns3/okumura-hata-propagation-loss-model.h"
+#include "ns3/cost231-propagation-loss-model.h"
+#include "ns3/itu-r-1411-los-propagation-loss-model.h"
+#include "ns3/itu-r-1411-nlos-over-rooftop-propagation-loss-model.h"
 #include "ns3/constant-position-mobility-model.h"
 #include "ns3/simulator.h"
+#include <cmath>
 
 using namespace ns3;
 
@@ -436,6 +442,236 @@ RangePropagationLossModelTestCase::DoRun (void)
   Simulator::Destroy ();
 }
 
+class CalcRangeTestCase : public TestCase
+{
+public:
+  CalcRangeTestCase ();
+  virtual ~CalcRangeTestCase ();
+
+private:
+  virtual void DoRun (void);
+};
+
+CalcRangeTestCase::CalcRangeTestCase ()
+  : TestCase ("Test PropagationLossModel::CalcRange")
+{
+}
+
+CalcRangeTestCase::~CalcRangeTestCase ()
+{
+}
+
+void
+CalcRangeTestCase::DoRun (void)
+{
+  Ptr<LogDistancePropagationLossModel> logDistance = CreateObject<LogDistancePropagationLossModel> ();
+  logDistance->SetReference (1, 46.6777);
+  logDistance->SetPathLossExponent (3);
+  // 110 dB are reached at 10^((110 - 46.6777) / 30) m
+  double distance = std::pow (10, (110 - 46.6777) / 30);
+  double range = logDistance->CalcRange (110, 10000);
+  NS_TEST_EXPECT_MSG_GT_OR_EQ (range, distance, "Range shorter than the distance of the loss");
+  NS_TEST_EXPECT_MSG_EQ_TOL (range, distance, 2e-3 * distance, "Range too long");
+  // The loss depends on the distance, whatever the heights of the nodes
+  range = logDistance->CalcRange (110, 10000, 30, 1.5);
+  NS_TEST_EXPECT_MSG_GT_OR_EQ (range, distance, "Range shorter than the distance of the loss between heights");
+  NS_TEST_EXPECT_MSG_EQ_TOL (range, distance, 2e-3 * distance, "Range too long between heights");
+  // The loss at maxRange does not exceed maxLossDb
+  range = logDistance->CalcRange (110, 50);
+  NS_TEST_EXPECT_MSG_EQ (range, 50, "Range not bounded by maxRange");
+
+  // A chain of models
+  Ptr<RangePropagationLossModel> rangeModel = CreateObject<RangePropagationLossModel> ();
+  rangeModel->SetAttribute ("MaxRange", DoubleValue (127.2));
+  logDistance->SetNext (rangeModel);
+  range = logDistance->CalcRange (200, 10000);
+  NS_TEST_EXPECT_MSG_GT_OR_EQ (range, 127.2, "Range shorter than the chained range");
+  NS_TEST_EXPECT_MSG_EQ_TOL (range, 127.2, 0.2, "Range too long for the chained range");
+  Simulator::Destroy ();
+}
+
+class CachedPropagationLossModelTestCase : public TestCase
+{
+public:
+  CachedPropagationLossModelTestCase ();
+  virtual ~CachedPropagationLossModelTestCase ();
+
+private:
+  virtual void DoRun (void);
+};
+
+CachedPropagationLossModelTestCase::CachedPropagationLossModelTestCase ()
+  : TestCase ("Test the cache of CachedPropagationLossModel")
+{
+}
+
+CachedPropagationLossModelTestCase::~CachedPropagationLossModelTestCase ()
+{
+}
+
+void
+CachedPropagationLossModelTestCase::DoRun (void)
+{
+  Ptr<MobilityModel> a = CreateObject<ConstantPositionMobilityModel> ();
+  a->SetPosition (Vector (0, 0, 0));
+  Ptr<MobilityModel> b = CreateObject<ConstantPositionMobilityModel> ();
+  b->SetPosition (Vector (100, 0, 0));
+  Ptr<MobilityModel> c = CreateObject<ConstantPositionMobilityModel> ();
+  c->SetPosition (Vector (0, 200, 0));
+
+  Ptr<LogDistancePropagationLossModel> logDistance = CreateObject<LogDistancePropagationLossModel> ();
+  Ptr<CachedPropagationLossModel> cached = CreateObject<CachedPropagationLossModel> ();
+  cached->SetModel (logDistance);
+  cached->SetAttribute ("PositionThreshold", DoubleValue (1));
+  cached->SetAttribute ("MaxSize", UintegerValue (2));
+
+  // The test macros evaluate their arguments more than once
+  double expected = logDistance->CalcRxPower (10, a, b);
+  double rxPower = cached->CalcRxPower (10, a, b);
+  NS_TEST_EXPECT_MSG_EQ (rxPower, expected, "Wrong power when computed");
+  rxPower = cached->CalcRxPower (10, a, b);
+  NS_TEST_EXPECT_MSG_EQ_TOL (rxPower, expected, 1e-9, "Wrong power when cached");
+  rxPower = cached->CalcRxPower (20, a, b);
+  NS_TEST_EXPECT_MSG_EQ_TOL (rxPower, expected + 10, 1e-9, "Wrong power for another transmit power");
+  NS_TEST_EXPECT_MSG_EQ (cached->GetCacheMisses (), 1, "Wrong number of misses");
+  NS_TEST_EXPECT_MSG_EQ (cached->GetCacheHits (), 2, "Wrong number of hits");
+
+  // Paths are directional
+  cached->CalcRxPower (10, b, a);
+  NS_TEST_EXPECT_MSG_EQ (cached->GetCacheMisses (), 2, "Reverse path not computed");
+
+  // Moves within the threshold are ignored, but not beyond it
+  b->SetPosition (Vector (100.5, 0, 0));
+  rxPower = cached->CalcRxPower (10, a, b);
+  NS_TEST_EXPECT_MSG_EQ_TOL (rxPower, expected, 1e-9, "Power of a small move not cached");
+  b->SetPosition (Vector (102, 0, 0));
+  expected = logDistance->CalcRxPower (10, a, b);
+  rxPower = cached->CalcRxPower (10, a, b);
+  NS_TEST_EXPECT_MSG_EQ (rxPower, expected, "Power of a large move cached");
+  NS_TEST_EXPECT_MSG_EQ (cached->GetCacheMisses (), 3, "Large move not computed");
+  NS_TEST_EXPECT_MSG_EQ (cached->GetCacheHits (), 3, "Small move not cached");
+
+  // The least recently used path, b->a, is evicted
+  cached->CalcRxPower (10, a, c);
+  cached->CalcRxPower (10, a, b);
+  NS_TEST_EXPECT_MSG_EQ (cached->GetCacheHits (), 4, "Recently used path evicted");
+  cached->CalcRxPower (10, b, a);
+  NS_TEST_EXPECT_MSG_EQ (cached->GetCacheMisses (), 5, "Least recently used path not evicted");
+
+  // Models chained after the cache are applied to every path
+  Ptr<RangePropagationLossModel> rangeModel = CreateObject<RangePropagationLossModel> ();
+  rangeModel->SetAttribute ("MaxRange", DoubleValue (150));
+  cached->SetNext (rangeModel);
+  rxPower = cached->CalcRxPower (10, a, c);
+  NS_TEST_EXPECT_MSG_EQ (rxPower, -1000, "Chained model not applied");
+  Simulator::Destroy ();
+}
+
+class BatchCalcRxPowerTestCase : public TestCase
+{
+public:
+  BatchCalcRxPowerTestCase ();
+  virtual ~BatchCalcRxPowerTestCase ();
+
+private:
+  virtual void DoRun (void);
+
+  /**
+   * Check the powers computed for all the destinations at once against
+   * the powers computed for each destination.
+   *
+   * \param batch the model computing the powers at once
+   * \param single the model computing the powers of each destination,
+   *        which may be batch itself if it is deterministic
+   * \param name the name of the model
+   */
+  void CheckModel (Ptr<PropagationLossModel> batch, Ptr<PropagationLossModel> single, std::string name);
+
+  Ptr<MobilityModel> m_source; //!< the source
+  std::vector<Ptr<MobilityModel> > m_destinations; //!< the destinations
+};
+
+BatchCalcRxPowerTestCase::BatchCalcRxPowerTestCase ()
+  : TestCase ("Check the power of a batch of destinations against single destinations")
+{
+}
+
+BatchCalcRxPowerTestCase::~BatchCalcRxPowerTestCase ()
+{
+}
+
+void
+BatchCalcRxPowerTestCase::CheckModel (Ptr<PropagationLossModel> batch, Ptr<PropagationLossModel> single, std::string name)
+{
+  std::vector<double> rxPowers;
+  batch->CalcRxPower (20, m_source, m_destinations, rxPowers);
+  NS_TEST_ASSERT_MSG_EQ (rxPowers.size (), m_destinations.size (), name << ": wrong number of powers");
+  for (uint32_t i = 0; i < m_destinations.size (); i++)
+    {
+      double expected = single->CalcRxPower (20, m_source, m_destinations[i]);
+      NS_TEST_EXPECT_MSG_EQ_TOL (rxPowers[i], expected, 1e-9, name << ": wrong power at destination " << i);
+    }
+}
+
+void
+BatchCalcRxPowerTestCase::DoRun (void)
+{
+  m_source = CreateObject<ConstantPositionMobilityModel> ();
+  m_source->SetPosition (Vector (10, 20, 30));
+  for (uint32_t i = 0; i < 37; i++)
+    {
+      // Destinations from a few meters to a few kilometers, in all directions
+      double distance = 2 * std::pow (1.25, i);
+      double angle = i * 2.4;
+      Ptr<MobilityModel> destination = CreateObject<ConstantPositionMobilityModel> ();
+      destination->SetPosition (Vector (10 + distance * std::cos (angle), 20 + distance * std::sin (angle), 1 + (i % 3)));
+      m_destinations.push_back (destination);
+    }
+
+  Ptr<FriisPropagationLossModel> friis = CreateObject<FriisPropagationLossModel> ();
+  CheckModel (friis, friis, "Friis");
+  Ptr<LogDistancePropagationLossModel> logDistance = CreateObject<LogDistancePropagationLossModel> ();
+  CheckModel (logDistance, logDistance, "LogDistance");
+  Ptr<ThreeLogDistancePropagationLossModel> threeLogDistance = CreateObject<ThreeLogDistancePropagationLossModel> ();
+  CheckModel (threeLogDistance, threeLogDistance, "ThreeLogDistance");
+  Ptr<OkumuraHataPropagationLossModel> okumuraHata = CreateObject<OkumuraHataPropagationLossModel> ();
+  CheckModel (okumuraHata, okumuraHata, "OkumuraHata");
+  okumuraHata->SetAttribute ("Frequency", DoubleValue (900e6));
+  CheckModel (okumuraHata, okumuraHata, "OkumuraHata at 900 MHz");
+  Ptr<Cost231PropagationLossModel> cost231 = CreateObject<Cost231PropagationLossModel> ();
+  CheckModel (cost231, cost231, "Cost231");
+  Ptr<ItuR1411LosPropagationLossModel> ituR1411Los = CreateObject<ItuR1411LosPropagationLossModel> ();
+  CheckModel (ituR1411Los, ituR1411Los, "ItuR1411Los");
+  Ptr<ItuR1411NlosOverRooftopPropagationLossModel> ituR1411Nlos = CreateObject<ItuR1411NlosOverRooftopPropagationLossModel> ();
+  CheckModel (ituR1411Nlos, ituR1411Nlos, "ItuR1411NlosOverRooftop");
+  m_source->SetPosition (Vector (10, 20, 15));
+  CheckModel (ituR1411Nlos, ituR1411Nlos, "ItuR1411NlosOverRooftop below the rooftops");
+
+  // Models without a batch implementation, chained to models with one,
+  // draw their random variables in the order of the destinations
+  Ptr<PropagationLossModel> chains[2];
+  for (uint32_t i = 0; i < 2; i++)
+    {
+      Ptr<ThreeLogDistancePropagationLossModel> first = CreateObject<ThreeLogDistancePropagationLossModel> ();
+      Ptr<NakagamiPropagationLossModel> second = CreateObject<NakagamiPropagationLossModel> ();
+      Ptr<FriisPropagationLossModel> third = CreateObject<FriisPropagationLossModel> ();
+      first->SetNext (second);
+      second->SetNext (third);
+      first->AssignStreams (1);
+      chains[i] = first;
+    }
+  CheckModel (chains[0], chains[1], "Chain");
+
+  // An empty batch
+  std::vector<double> rxPowers (3, 0);
+  friis->CalcRxPower (20, m_source, std::vector<Ptr<MobilityModel> > (), rxPowers);
+  NS_TEST_EXPECT_MSG_EQ (rxPowers.size (), 0, "Powers of an empty batch");
+
+  m_source = 0;
+  m_destinations.clear ();
+  Simulator::Destroy ();
+}
+
 class PropagationLossModelsTestSuite : public TestSuite
 {
 public:
@@ -450,6 +686,9 @@ PropagationLossModelsTestSuite::PropagationLossModelsTestSuite ()
   AddTestCase (new LogDistancePropagationLossModelTestCase, TestCase::QUICK);
   AddTestCase (new MatrixPropagationLossModelTestCase, TestCase::QUICK);
   AddTestCase (new RangePropagationLossModelTestCase, TestCase::QUICK);
+  AddTestCase (new CalcRangeTestCase, TestCase::QUICK);
+  AddTestCase (new CachedPropagationLossModelTestCase, TestCase::QUICK);
+  AddTestCase (new BatchCalcRxPowerTestCase, TestCase::QUICK);
 }
 
 static PropagationLossModelsTestSuite propagationLossModelsTestSuite;
@@ -0,0 +1,156 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/log.h"
+
+#include "ns3/cached-spectrum-propagation-loss.h"
+#include "ns3/double.h"
+#include "ns3/uinteger.h"
+#include "ns3/pointer.h"
+
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("CachedSpectrumPropagationLossModel");
+
+NS_OBJECT_ENSURE_REGISTERED (CachedSpectrumPropagationLossModel);
+
+CachedSpectrumPropagationLossModel::CachedSpectrumPropagationLossModel ()
+  : m_cache (false)
+{
+  NS_LOG_FUNCTION (this);
+}
+
+CachedSpectrumPropagationLossModel::~CachedSpectrumPropagationLossModel ()
+{
+  NS_LOG_FUNCTION (this);
+}
+
+TypeId
+CachedSpectrumPropagationLossModel::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::CachedSpectrumPropagationLossModel")
+    .SetParent<SpectrumPropagationLossModel> ()
+    .SetGroupName ("Spectrum")
+    .AddConstructor<CachedSpectrumPropagationLossModel> ()
+    .AddAttribute ("Model",
+                   "The model whose gain is cached.",
+                   PointerValue (),
+                   MakePointerAccessor (&CachedSpectrumPropagationLossModel::SetModel,
+                                        &CachedSpectrumPropagationLossModel::GetModel),
+                   MakePointerChecker<SpectrumPropagationLossModel> ())
+    .AddAttribute ("MaxSize",
+                   "The largest number of pairs of nodes whose gain is cached, 0 for no limit.",
+                   UintegerValue (100000),
+                   MakeUintegerAccessor (&CachedSpectrumPropagationLossModel::SetMaxSize,
+                                         &CachedSpectrumPropagationLossModel::GetMaxSize),
+                   MakeUintegerChecker<uint32_t> ())
+    .AddAttribute ("PositionThreshold",
+                   "The distance (m) either node of a pair may move before their gain is computed again.",
+                   DoubleValue (0),
+                   MakeDoubleAccessor (&CachedSpectrumPropagationLossModel::SetPositionThreshold,
+                                       &CachedSpectrumPropagationLossModel::GetPositionThreshold),
+                   MakeDoubleChecker<double> (0))
+    ;
+  return tid;
+}
+
+void
+CachedSpectrumPropagationLossModel::DoDispose ()
+{
+  NS_LOG_FUNCTION (this);
+  m_cache.Clear ();
+  m_model = 0;
+  SpectrumPropagationLossModel::DoDispose ();
+}
+
+void
+CachedSpectrumPropagationLossModel::SetModel (Ptr<SpectrumPropagationLossModel> model)
+{
+  NS_LOG_FUNCTION (this << model);
+  m_model = model;
+  m_cache.Clear ();
+}
+
+Ptr<SpectrumPropagationLossModel>
+CachedSpectrumPropagationLossModel::GetModel () const
+{
+  return m_model;
+}
+
+void
+CachedSpectrumPropagationLossModel::SetMaxSize (uint32_t maxSize)
+{
+  NS_LOG_FUNCTION (this << maxSize);
+  m_cache.SetMaxSize (maxSize);
+}
+
+uint32_t
+CachedSpectrumPropagationLossModel::GetMaxSize () const
+{
+  return m_cache.GetMaxSize ();
+}
+
+void
+CachedSpectrumPropagationLossModel::SetPositionThreshold (double threshold)
+{
+  NS_LOG_FUNCTION (this << threshold);
+  m_cache.SetPositionThreshold (threshold);
+}
+
+double
+CachedSpectrumPropagationLossModel::GetPositionThreshold () const
+{
+  return m_cache.GetPositionThreshold ();
+}
+
+uint64_t
+CachedSpectrumPropagationLossModel::GetCacheHits () const
+{
+  return m_cache.GetHits ();
+}
+
+uint64_t
+CachedSpectrumPropagationLossModel::GetCacheMisses () const
+{
+  return m_cache.GetMisses ();
+}
+
+
+Ptr<SpectrumValue>
+CachedSpectrumPropagationLossModel::DoCalcRxPowerSpectralDensity (Ptr<const SpectrumValue> txPsd,
+                                                                  Ptr<const MobilityModel> a,
+                                                                  Ptr<const MobilityModel> b) const
+{
+  NS_LOG_FUNCTION (this);
+  NS_ASSERT_MSG (m_model != 0, "CachedSpectrumPropagationLossModel needs a Model");
+
+  Ptr<SpectrumValue> gain = m_cache.GetPathData (a, b, txPsd->GetSpectrumModelUid ());
+  if (gain == 0)
+    {
+      // The PSD may be null in some bands, so the gain is that of a unit PSD
+      Ptr<SpectrumValue> unit = Create<SpectrumValue> (txPsd->GetSpectrumModel ());
+      *unit = 1.0;
+      gain = m_model->CalcRxPowerSpectralDensity (unit, a, b);
+      m_cache.AddPathData (gain, a, b, txPsd->GetSpectrumModelUid ());
+    }
+  Ptr<SpectrumValue> rxPsd = Copy<SpectrumValue> (txPsd);
+  *rxPsd *= *gain;
+  return rxPsd;
+}
+
+
+}  // namespace ns3
@@ -82,6 +82,8 @@ RxSpectrumModelInfo::RxSpectrumModelInfo (Ptr<const SpectrumModel> rxSpectrumMod
 
 
 MultiModelSpectrumChannel::MultiModelSpectrumChannel ()
+  : m_grid (1),
+    m_gridOutdated (true)
 {
   NS_LOG_FUNCTION (this);
 }
@@ -95,6 +97,8 @@ MultiModelSpectrumChannel::DoDispose ()
   m_spectrumPropagationLoss = 0;
   m_txSpectrumModelInfoMap.clear ();
   m_rxSpectrumModelInfoMap.clear ();
+  m_grid.Clear ();
+  m_gridPhys.clear ();
   SpectrumChannel::DoDispose ();
 }
 
@@ -119,6 +123,21 @@ MultiModelSpectrumChannel::GetTypeId (void)
                    DoubleValue (1.0e9),
                    MakeDoubleAccessor (&MultiModelSpectrumChannel::m_maxLossDb),
                    MakeDoubleChecker<double> ())
+    .AddAttribute ("MaxRange",
+                   "If positive, the maximum distance in meters between "
+                   "the transmitter and a receiver for which transmissions "
+                   "will be passed to the receiving PHY.  The receivers are "
+                   "then indexed by position, so that those farther away "
+                   "are skipped without evaluating their loss, and the "
+                   "PathLoss trace is not fired for them.  A receiver or "
+                   "transmitter without a MobilityModel is always in range. "
+                   "PropagationLossModel::CalcRange can derive this distance "
+                   "from MaxLossDb and the maximum antenna gains, for a "
+                   "deterministic PropagationLossModel.  The default value "
+                   "disables the index.",
+                   DoubleValue (0),
+                   MakeDoubleAccessor (&MultiModelSpectrumChannel::m_maxRange),
+                   MakeDoubleChecker<double> (0))
     .AddTraceSource ("PathLoss",
                      "This trace is fired whenever a new path loss value "
                      "is calculated. The first and second parameters "
@@ -169,6 +188,7 @@ MultiModelSpectrumChannel::AddRx (Ptr<SpectrumPhy> phy)
     }
 
   ++m_numDevices;
+  m_gridOutdated = true;
 
   RxSpectrumModelInfoMap_t::iterator rxInfoIterator = m_rxSpectrumModelInfoMap.find (rxSpectrumModelUid);
 
@@ -254,6 +274,32 @@ MultiModelSpectrumChannel::FindAndEventuallyAddTxSpectrumModel (Ptr<const Spectr
 
     
 
+void
+MultiModelSpectrumChannel::UpdateGrid (void)
+{
+  NS_LOG_FUNCTION (this);
+  if (!m_gridOutdated && m_grid.GetCellSize () == m_maxRange)
+    {
+      return;
+    }
+  m_grid.Clear ();
+  m_grid.SetCellSize (m_maxRange);
+  m_gridPhys.clear ();
+  for (RxSpectrumModelInfoMap_t::const_iterator rxInfoIterator = m_rxSpectrumModelInfoMap.begin ();
+       rxInfoIterator != m_rxSpectrumModelInfoMap.end ();
+       ++rxInfoIterator)
+    {
+      for (std::set<Ptr<SpectrumPhy> >::const_iterator rxPhyIterator = rxInfoIterator->second.m_rxPhySet.begin ();
+           rxPhyIterator != rxInfoIterator->second.m_rxPhySet.end ();
+           ++rxPhyIterator)
+        {
+          m_grid.Add (m_gridPhys.size (), (*rxPhyIterator)->GetMobility ());
+          m_gridPhys.push_back (*rxPhyIterator);
+        }
+    }
+  m_gridOutdated = false;
+}
+
 void
 MultiModelSpectrumChannel::StartTx (Ptr<SpectrumSignalParameters> txParams)
 {
@@ -275,112 +321,198 @@ MultiModelSpectrumChannel::StartTx (Ptr<SpectrumSignalParameters> txParams)
   NS_LOG_LOGIC ("converter map size: " << txInfoIteratorerator->second.m_spectrumConverterMap.size ());
   NS_LOG_LOGIC ("converter map first element: " << txInfoIteratorerator->second.m_spectrumConverterMap.begin ()->first);
 
-  for (RxSpectrumModelInfoMap_t::const_iterator rxInfoIterator = m_rxSpectrumModelInfoMap.begin ();
-       rxInfoIterator != m_rxSpectrumModelInfoMap.end ();
-       ++rxInfoIterator)
+  // The receivers, and the transmitted PSD converted to their SpectrumModel
+  std::vector<Ptr<SpectrumPhy> > rxPhys;
+  std::vector<Ptr<SpectrumValue> > convertedTxPowerSpectra;
+  if (m_maxRange > 0 && txMobility)
     {
-      SpectrumModelUid_t rxSpectrumModelUid = rxInfoIterator->second.m_rxSpectrumModel->GetUid ();
-      NS_LOG_LOGIC (" rxSpectrumModelUids " << rxSpectrumModelUid);
-
+      UpdateGrid ();
+      std::vector<uint32_t> ids;
+      m_grid.Find (txMobility->GetPosition (), m_maxRange, ids);
+      NS_LOG_LOGIC (ids.size () << " of " << m_gridPhys.size () << " receivers within " << m_maxRange << " m");
+
+      // The receivers are grouped by RX SpectrumModel in m_gridPhys,
+      // so that each conversion is done once, as below
+      SpectrumModelUid_t rxSpectrumModelUid = 0;
       Ptr <SpectrumValue> convertedTxPowerSpectrum;
-      if (txSpectrumModelUid == rxSpectrumModelUid)
+      for (std::vector<uint32_t>::const_iterator id = ids.begin (); id != ids.end (); ++id)
         {
-          NS_LOG_LOGIC ("no spectrum conversion needed");
-          convertedTxPowerSpectrum = txParams->psd;
+          Ptr<SpectrumPhy> rxPhy = m_gridPhys[*id];
+          if (convertedTxPowerSpectrum == 0 || rxPhy->GetRxSpectrumModel ()->GetUid () != rxSpectrumModelUid)
+            {
+              rxSpectrumModelUid = rxPhy->GetRxSpectrumModel ()->GetUid ();
+              if (txSpectrumModelUid == rxSpectrumModelUid)
+                {
+                  convertedTxPowerSpectrum = txParams->psd;
+                }
+              else
+                {
+                  SpectrumConverterMap_t::const_iterator rxConverterIterator = txInfoIteratorerator->second.m_spectrumConverterMap.find (rxSpectrumModelUid);
+                  if (rxConverterIterator == txInfoIteratorerator->second.m_spectrumConverterMap.end ())
+                    {
+                      // No converter means TX SpectrumModel is orthogonal to RX SpectrumModel
+                      convertedTxPowerSpectrum = 0;
+                      continue;
+                    }
+                  convertedTxPowerSpectrum = rxConverterIterator->second.Convert (txParams->psd);
+                }
+            }
+          if (rxPhy != txParams->txPhy)
+            {
+              rxPhys.push_back (rxPhy);
+              convertedTxPowerSpectra.push_back (convertedTxPowerSpectrum);
+            }
         }
-      else
+    }
+  else
+    {
+      for (RxSpectrumModelInfoMap_t::const_iterator rxInfoIterator = m_rxSpectrumModelInfoMap.begin ();
+           rxInfoIterator != m_rxSpectrumModelInfoMap.end ();
+           ++rxInfoIterator)
         {
-          NS_LOG_LOGIC (" converting txPowerSpectrum SpectrumModelUids" << txSpectrumModelUid << " --> " << rxSpectrumModelUid);
-          SpectrumConverterMap_t::const_iterator rxConverterIterator = txInfoIteratorerator->second.m_spectrumConverterMap.find (rxSpectrumModelUid);
-          if (rxConverterIterator == txInfoIteratorerator->second.m_spectrumConverterMap.end ())
+          SpectrumModelUid_t rxSpectrumModelUid = rxInfoIterator->second.m_rxSpectrumModel->GetUid ();
+          NS_LOG_LOGIC (" rxSpectrumModelUids " << rxSpectrumModelUid);
+
+          Ptr <SpectrumValue> convertedTxPowerSpectrum;
+          if (txSpectrumModelUid == rxSpectrumModelUid)
             {
-              // No converter means TX SpectrumModel is orthogonal to RX SpectrumModel
-              continue;
+              NS_LOG_LOGIC ("no spectrum conversion needed");
+              convertedTxPowerSpectrum = txParams->psd;
             }
-          convertedTxPowerSpectrum = rxConverterIterator->second.Convert (txParams->psd);
+          else
+            {
+              NS_LOG_LOGIC (" converting txPowerSpectrum SpectrumModelUids" << txSpectrumModelUid << " --> " << rxSpectrumModelUid);
+              SpectrumConverterMap_t::const_iterator rxConverterIterator = txInfoIteratorerator->second.m_spectrumConverterMap.find (rxSpectrumModelUid);
+              if (rxConverterIterator == txInfoIteratorerator->second.m_spectrumConverterMap.end ())
+                {
+                  // No converter means TX SpectrumModel is orthogonal to RX SpectrumModel
+                  continue;
+                }
+              convertedTxPowerSpectrum = rxConverterIterator->second.Convert (txParams->psd);
+            }
+
+
+          for (std::set<Ptr<SpectrumPhy> >::const_iterator rxPhyIterator = rxInfoIterator->second.m_rxPhySet.begin ();
+               rxPhyIterator != rxInfoIterator->second.m_rxPhySet.end ();
+               ++rxPhyIterator)
+            {
+              if (*rxPhyIterator != txParams->txPhy)
+                {
+                  rxPhys.push_back (*rxPhyIterator);
+                  convertedTxPowerSpectra.push_back (convertedTxPowerSpectrum);
+                }
+            }
+
         }
+    }
 
+  // The propagation loss of all the receivers having a position is
+  // computed in one pass
+  std::vector<Ptr<MobilityModel> > rxMobilities (rxPhys.size ());
+  std::vector<Ptr<MobilityModel> > lossMobilities;
+  for (size_t i = 0; i < rxPhys.size (); i++)
+    {
+      rxMobilities[i] = rxPhys[i]->GetMobility ();
+      if (txMobility && rxMobilities[i])
+        {
+          lossMobilities.push_back (rxMobilities[i]);
+        }
+    }
+  std::vector<double> propagationGainsDb (lossMobilities.size (), 0);
+  if (m_propagationLoss && !lossMobilities.empty ())
+    {
+      m_propagationLoss->CalcRxPower (0, txMobility, lossMobilities, propagationGainsDb);
+    }
 
-      for (std::set<Ptr<SpectrumPhy> >::const_iterator rxPhyIterator = rxInfoIterator->second.m_rxPhySet.begin ();
-           rxPhyIterator != rxInfoIterator->second.m_rxPhySet.end ();
-           ++rxPhyIterator)
+  size_t j = 0;
+  for (size_t i = 0; i < rxPhys.size (); i++)
+    {
+      double propagationGainDb = 0;
+      if (txMobility && rxMobilities[i])
         {
-          NS_ASSERT_MSG ((*rxPhyIterator)->GetRxSpectrumModel ()->GetUid () == rxSpectrumModelUid,
-                         "SpectrumModel change was not notified to MultiModelSpectrumChannel (i.e., AddRx should be called again after model is changed)");
+          propagationGainDb = propagationGainsDb[j++];
+        }
+      StartTxToRx (txParams, txMobility, convertedTxPowerSpectra[i], rxPhys[i], rxMobilities[i], propagationGainDb);
+    }
+}
 
-          if ((*rxPhyIterator) != txParams->txPhy)
-            {
-              NS_LOG_LOGIC (" copying signal parameters " << txParams);
-              Ptr<SpectrumSignalParameters> rxParams = txParams->Copy ();
-              rxParams->psd = Copy<SpectrumValue> (convertedTxPowerSpectrum);
-              Time delay = MicroSeconds (0);
+void
+MultiModelSpectrumChannel::StartTxToRx (Ptr<SpectrumSignalParameters> txParams, Ptr<MobilityModel> txMobility,
+                                        Ptr<SpectrumValue> convertedTxPowerSpectrum, Ptr<SpectrumPhy> rxPhy,
+                                        Ptr<MobilityModel> receiverMobility, double propagationGainDb)
+{
+  NS_ASSERT_MSG (rxPhy->GetRxSpectrumModel ()->GetUid () == convertedTxPowerSpectrum->GetSpectrumModelUid (),
+                 "SpectrumModel change was not notified to MultiModelSpectrumChannel (i.e., AddRx should be called again after model is changed)");
 
-              Ptr<MobilityModel> receiverMobility = (*rxPhyIterator)->GetMobility ();
+  Time delay = MicroSeconds (0);
+  double pathGainLinear = 1;
 
-              if (txMobility && receiverMobility)
-                {
-                  double pathLossDb = 0;
-                  if (rxParams->txAntenna != 0)
-                    {
-                      Angles txAngles (receiverMobility->GetPosition (), txMobility->GetPosition ());
-                      double txAntennaGain = rxParams->txAntenna->GetGainDb (txAngles);
-                      NS_LOG_LOGIC ("txAntennaGain = " << txAntennaGain << " dB");
-                      pathLossDb -= txAntennaGain;
-                    }
-                  Ptr<AntennaModel> rxAntenna = (*rxPhyIterator)->GetRxAntenna ();
-                  if (rxAntenna != 0)
-                    {
-                      Angles rxAngles (txMobility->GetPosition (), receiverMobility->GetPosition ());
-                      double rxAntennaGain = rxAntenna->GetGainDb (rxAngles);
-                      NS_LOG_LOGIC ("rxAntennaGain = " << rxAntennaGain << " dB");
-                      pathLossDb -= rxAntennaGain;
-                    }
-                  if (m_propagationLoss)
-                    {
-                      double propagationGainDb = m_propagationLoss->CalcRxPower (0, txMobility, receiverMobility);
-                      NS_LOG_LOGIC ("propagationGainDb = " << propagationGainDb << " dB");
-                      pathLossDb -= propagationGainDb;
-                    }                    
-                  NS_LOG_LOGIC ("total pathLoss = " << pathLossDb << " dB");    
-                  m_pathLossTrace (txParams->txPhy, *rxPhyIterator, pathLossDb);
-                  if ( pathLossDb > m_maxLossDb)
-                    {
-                      // beyond range
-                      continue;
-                    }
-                  double pathGainLinear = std::pow (10.0, (-pathLossDb) / 10.0);
-                  *(rxParams->psd) *= pathGainLinear;              
+  if (txMobility && receiverMobility)
+    {
+      double pathLossDb = 0;
+      if (txParams->txAntenna != 0)
+        {
+          Angles txAngles (receiverMobility->GetPosition (), txMobility->GetPosition ());
+          double txAntennaGain = txParams->txAntenna->GetGainDb (txAngles);
+          NS_LOG_LOGIC ("txAntennaGain = " << txAntennaGain << " dB");
+          pathLossDb -= txAntennaGain;
+        }
+      Ptr<AntennaModel> rxAntenna = rxPhy->GetRxAntenna ();
+      if (rxAntenna != 0)
+        {
+          Angles rxAngles (txMobility->GetPosition (), receiverMobility->GetPosition ());
+          double rxAntennaGain = rxAntenna->GetGainDb (rxAngles);
+          NS_LOG_LOGIC ("rxAntennaGain = " << rxAntennaGain << " dB");
+          pathLossDb -= rxAntennaGain;
+        }
+      if (m_propagationLoss)
+        {
+          NS_LOG_LOGIC ("propagationGainDb = " << propagationGainDb << " dB");
+          pathLossDb -= propagationGainDb;
+        }
+      NS_LOG_LOGIC ("total pathLoss = " << pathLossDb << " dB");
+      m_pathLossTrace (txParams->txPhy, rxPhy, pathLossDb);
+      if ( pathLossDb > m_maxLossDb)
+        {
+          // beyond range
+          return;
+        }
+      pathGainLinear = std::pow (10.0, (-pathLossDb) / 10.0);
+    }
 
-                  if (m_spectrumPropagationLoss)
-                    {
-                      rxParams->psd = m_spectrumPropagationLoss->CalcRxPowerSpectralDensity (rxParams->psd, txMobility, receiverMobility);
-                    }
+  NS_LOG_LOGIC (" copying signal parameters " << txParams);
+  Ptr<SpectrumSignalParameters> rxParams = txParams->Copy ();
+  rxParams->psd = Copy<SpectrumValue> (convertedTxPowerSpectrum);
 
-                  if (m_propagationDelay)
-                    {
-                      delay = m_propagationDelay->GetDelay (txMobility, receiverMobility);
-                    }
-                }
+  if (txMobility && receiverMobility)
+    {
+      *(rxParams->psd) *= pathGainLinear;
 
-              Ptr<NetDevice> netDev = (*rxPhyIterator)->GetDevice ();
-              if (netDev)
-                {
-                  // the receiver has a NetDevice, so we expect that it is attached to a Node
-                  uint32_t dstNode =  netDev->GetNode ()->GetId ();
-                  Simulator::ScheduleWithContext (dstNode, delay, &MultiModelSpectrumChannel::StartRx, this,
-                                                  rxParams, *rxPhyIterator);
-                }
-              else
-                {
-                  // the receiver is not attached to a NetDevice, so we cannot assume that it is attached to a node
-                  Simulator::Schedule (delay, &MultiModelSpectrumChannel::StartRx, this,
-                                       rxParams, *rxPhyIterator);
-                }
-            }
+      if (m_spectrumPropagationLoss)
+        {
+          rxParams->psd = m_spectrumPropagationLoss->CalcRxPowerSpectralDensity (rxParams->psd, txMobility, receiverMobility);
         }
 
+      if (m_propagationDelay)
+        {
+          delay = m_propagationDelay->GetDelay (txMobility, receiverMobility);
+        }
     }
 
+  Ptr<NetDevice> netDev = rxPhy->GetDevice ();
+  if (netDev)
+    {
+      // the receiver has a NetDevice, so we expect that it is attached to a Node
+      uint32_t dstNode =  netDev->GetNode ()->GetId ();
+      Simulator::ScheduleWithContext (dstNode, delay, &MultiModelSpectrumChannel::StartRx, this,
+                                      rxParams, rxPhy);
+    }
+  else
+    {
+      // the receiver is not attached to a NetDevice, so we cannot assume that it is attached to a node
+      Simulator::Schedule (delay, &MultiModelSpectrumChannel::StartRx, this,
+                           rxParams, rxPhy);
+    }
 }
 
 void
@@ -27,8 +27,10 @@
 #include <ns3/spectrum-channel.h>
 #include <ns3/spectrum-propagation-loss-model.h>
 #include <ns3/propagation-delay-model.h>
+#include <ns3/spatial-grid.h>
 #include <map>
 #include <set>
+#include <vector>
 
 namespace ns3 {
 
@@ -102,6 +104,12 @@ typedef std::map<SpectrumModelUid_t, RxSpectrumModelInfo> RxSpectrumModelInfoMap
  * for this to work is that, after the SpectrumPhy switched its
  * SpectrumModel,  MultiModelSpectrumChannel::AddRx () is
  * called again passing the pointer to that SpectrumPhy.
+ *
+ * When the MaxRange attribute is set, the receivers are indexed by
+ * position in a SpatialGrid, and a transmission only visits the
+ * receivers within that distance of the transmitter.  The same
+ * requirement applies to a SpectrumPhy whose MobilityModel is
+ * replaced.
  */
 class MultiModelSpectrumChannel : public SpectrumChannel
 {
@@ -150,6 +158,28 @@ private:
    */
   TxSpectrumModelInfoMap_t::const_iterator FindAndEventuallyAddTxSpectrumModel (Ptr<const SpectrumModel> txSpectrumModel);
 
+  /**
+   * Index the receivers in m_grid, in the order of
+   * m_rxSpectrumModelInfoMap and of their sets, if needed.
+   */
+  void UpdateGrid (void);
+
+  /**
+   * Compute the signal received by a SpectrumPhy and schedule its
+   * reception, unless the loss exceeds m_maxLossDb.
+   *
+   * @param txParams The signal parameters of the transmitter.
+   * @param txMobility The mobility of the transmitter, if any.
+   * @param convertedTxPowerSpectrum The transmitted PSD in the RX SpectrumModel.
+   * @param rxPhy The receiver.
+   * @param receiverMobility The mobility of the receiver, if any.
+   * @param propagationGainDb The gain of m_propagationLoss from the
+   *        transmitter to the receiver [dB], if both have a mobility.
+   */
+  void StartTxToRx (Ptr<SpectrumSignalParameters> txParams, Ptr<MobilityModel> txMobility,
+                    Ptr<SpectrumValue> convertedTxPowerSpectrum, Ptr<SpectrumPhy> rxPhy,
+                    Ptr<MobilityModel> receiverMobility, double propagationGainDb);
+
   /**
    * Used internally to reschedule transmission after the propagation delay.
    *
@@ -201,6 +231,28 @@ private:
    */
   double m_maxLossDb;
 
+  /**
+   * Maximum distance [m] between the transmitter and a receiver, or 0
+   * to consider all the receivers.
+   */
+  double m_maxRange;
+
+  /**
+   * The receivers, indexed by position when m_maxRange is set.  The
+   * identifier of a receiver is its index in m_gridPhys.
+   */
+  SpatialGrid m_grid;
+
+  /**
+   * The receivers indexed in m_grid, grouped by RX SpectrumModel.
+   */
+  std::vector<Ptr<SpectrumPhy> > m_gridPhys;
+
+  /**
+   * Whether m_grid must be rebuilt before its next use.
+   */
+  bool m_gridOutdated;
+
   /**
    * \deprecated The non-const \c Ptr<SpectrumPhy> argument
    * is deprecated and will be changed to \c Ptr<const SpectrumPhy>
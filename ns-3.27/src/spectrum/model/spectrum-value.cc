@@ -22,11 +22,180 @@
 #include <ns3/spectrum-value.h>
 #include <ns3/math.h>
 #include <ns3/log.h>
+#include <algorithm>
 
 namespace ns3 {
 
 NS_LOG_COMPONENT_DEFINE ("SpectrumValue");
 
+/*
+ * The kernels below do the arithmetic of SpectrumValue on plain
+ * arrays, in loops which the compiler vectorizes.  Where the
+ * toolchain supports function multi-versioning, each kernel is also
+ * built for AVX2 and the loader picks the version matching the
+ * processor, so that builds which are not tuned with -march=native
+ * still get the wider registers.
+ */
+#if defined (__GNUC__) && !defined (__clang__) && (__GNUC__ >= 6) && defined (__x86_64__) && defined (__linux__)
+#define SPECTRUM_VALUE_KERNEL __attribute__ ((target_clones ("avx2", "default")))
+#else
+#define SPECTRUM_VALUE_KERNEL
+#endif
+
+namespace {
+
+SPECTRUM_VALUE_KERNEL void
+AddValues (double *a, const double *b, size_t n)
+{
+  for (size_t i = 0; i < n; ++i)
+    {
+      a[i] += b[i];
+    }
+}
+
+SPECTRUM_VALUE_KERNEL void
+SubtractValues (double *a, const double *b, size_t n)
+{
+  for (size_t i = 0; i < n; ++i)
+    {
+      a[i] -= b[i];
+    }
+}
+
+SPECTRUM_VALUE_KERNEL void
+MultiplyValues (double *a, const double *b, size_t n)
+{
+  for (size_t i = 0; i < n; ++i)
+    {
+      a[i] *= b[i];
+    }
+}
+
+SPECTRUM_VALUE_KERNEL void
+DivideValues (double *a, const double *b, size_t n)
+{
+  for (size_t i = 0; i < n; ++i)
+    {
+      a[i] /= b[i];
+    }
+}
+
+SPECTRUM_VALUE_KERNEL void
+AddScalar (double *a, double s, size_t n)
+{
+  for (size_t i = 0; i < n; ++i)
+    {
+      a[i] += s;
+    }
+}
+
+SPECTRUM_VALUE_KERNEL void
+MultiplyScalar (double *a, double s, size_t n)
+{
+  for (size_t i = 0; i < n; ++i)
+    {
+      a[i] *= s;
+    }
+}
+
+SPECTRUM_VALUE_KERNEL void
+DivideScalar (double *a, double s, size_t n)
+{
+  for (size_t i = 0; i < n; ++i)
+    {
+      a[i] /= s;
+    }
+}
+
+SPECTRUM_VALUE_KERNEL void
+NegateValues (double *a, size_t n)
+{
+  for (size_t i = 0; i < n; ++i)
+    {
+      a[i] = -a[i];
+    }
+}
+
+SPECTRUM_VALUE_KERNEL void
+AddScaledValues (double *a, const double *b, double s, size_t n)
+{
+  for (size_t i = 0; i < n; ++i)
+    {
+      a[i] += b[i] * s;
+    }
+}
+
+SPECTRUM_VALUE_KERNEL void
+AddProductValues (double *a, const double *b, const double *c, size_t n)
+{
+  for (size_t i = 0; i < n; ++i)
+    {
+      a[i] += b[i] * c[i];
+    }
+}
+
+// The compiler may not reorder floating point additions by itself, so
+// the reductions keep four partial sums which fill a vector register.
+
+SPECTRUM_VALUE_KERNEL double
+SumValues (const double *a, size_t n)
+{
+  double s[4] = { 0, 0, 0, 0 };
+  size_t i = 0;
+  for (; i + 4 <= n; i += 4)
+    {
+      s[0] += a[i];
+      s[1] += a[i + 1];
+      s[2] += a[i + 2];
+      s[3] += a[i + 3];
+    }
+  for (; i < n; ++i)
+    {
+      s[0] += a[i];
+    }
+  return (s[0] + s[1]) + (s[2] + s[3]);
+}
+
+SPECTRUM_VALUE_KERNEL double
+SumSquaredValues (const double *a, size_t n)
+{
+  double s[4] = { 0, 0, 0, 0 };
+  size_t i = 0;
+  for (; i + 4 <= n; i += 4)
+    {
+      s[0] += a[i] * a[i];
+      s[1] += a[i + 1] * a[i + 1];
+      s[2] += a[i + 2] * a[i + 2];
+      s[3] += a[i + 3] * a[i + 3];
+    }
+  for (; i < n; ++i)
+    {
+      s[0] += a[i] * a[i];
+    }
+  return (s[0] + s[1]) + (s[2] + s[3]);
+}
+
+SPECTRUM_VALUE_KERNEL double
+IntegrateValues (const double *a, const BandInfo *bands, size_t n)
+{
+  double s[4] = { 0, 0, 0, 0 };
+  size_t i = 0;
+  for (; i + 4 <= n; i += 4)
+    {
+      s[0] += a[i] * (bands[i].fh - bands[i].fl);
+      s[1] += a[i + 1] * (bands[i + 1].fh - bands[i + 1].fl);
+      s[2] += a[i + 2] * (bands[i + 2].fh - bands[i + 2].fl);
+      s[3] += a[i + 3] * (bands[i + 3].fh - bands[i + 3].fl);
+    }
+  for (; i < n; ++i)
+    {
+      s[0] += a[i] * (bands[i].fh - bands[i].fl);
+    }
+  return (s[0] + s[1]) + (s[2] + s[3]);
+}
+
+} // anonymous namespace
+
 SpectrumValue::SpectrumValue ()
 {
 }
@@ -106,31 +275,16 @@ SpectrumValue::ConstBandsEnd () const
 void
 SpectrumValue::Add (const SpectrumValue& x)
 {
-  Values::iterator it1 = m_values.begin ();
-  Values::const_iterator it2 = x.m_values.begin ();
-
   NS_ASSERT (m_spectrumModel == x.m_spectrumModel);
-
-  while (it1 != m_values.end ())
-    {
-      NS_ASSERT ( it2 != x.m_values.end ());
-      *it1 += *it2;
-      ++it1;
-      ++it2;
-    }
+  NS_ASSERT (m_values.size () == x.m_values.size ());
+  AddValues (m_values.data (), x.m_values.data (), m_values.size ());
 }
 
 
 void
 SpectrumValue::Add (double s)
 {
-  Values::iterator it1 = m_values.begin ();
-
-  while (it1 != m_values.end ())
-    {
-      *it1 += s;
-      ++it1;
-    }
+  AddScalar (m_values.data (), s, m_values.size ());
 }
 
 
@@ -138,18 +292,9 @@ SpectrumValue::Add (double s)
 void
 SpectrumValue::Subtract (const SpectrumValue& x)
 {
-  Values::iterator it1 = m_values.begin ();
-  Values::const_iterator it2 = x.m_values.begin ();
-
   NS_ASSERT (m_spectrumModel == x.m_spectrumModel);
-
-  while (it1 != m_values.end ())
-    {
-      NS_ASSERT ( it2 != x.m_values.end ());
-      *it1 -= *it2;
-      ++it1;
-      ++it2;
-    }
+  NS_ASSERT (m_values.size () == x.m_values.size ());
+  SubtractValues (m_values.data (), x.m_values.data (), m_values.size ());
 }
 
 
@@ -164,31 +309,16 @@ SpectrumValue::Subtract (double s)
 void
 SpectrumValue::Multiply (const SpectrumValue& x)
 {
-  Values::iterator it1 = m_values.begin ();
-  Values::const_iterator it2 = x.m_values.begin ();
-
   NS_ASSERT (m_spectrumModel == x.m_spectrumModel);
-
-  while (it1 != m_values.end ())
-    {
-      NS_ASSERT ( it2 != x.m_values.end ());
-      *it1 *= *it2;
-      ++it1;
-      ++it2;
-    }
+  NS_ASSERT (m_values.size () == x.m_values.size ());
+  MultiplyValues (m_values.data (), x.m_values.data (), m_values.size ());
 }
 
 
 void
 SpectrumValue::Multiply (double s)
 {
-  Values::iterator it1 = m_values.begin ();
-
-  while (it1 != m_values.end ())
-    {
-      *it1 *= s;
-      ++it1;
-    }
+  MultiplyScalar (m_values.data (), s, m_values.size ());
 }
 
 
@@ -197,18 +327,9 @@ SpectrumValue::Multiply (double s)
 void
 SpectrumValue::Divide (const SpectrumValue& x)
 {
-  Values::iterator it1 = m_values.begin ();
-  Values::const_iterator it2 = x.m_values.begin ();
-
   NS_ASSERT (m_spectrumModel == x.m_spectrumModel);
-
-  while (it1 != m_values.end ())
-    {
-      NS_ASSERT ( it2 != x.m_values.end ());
-      *it1 /= *it2;
-      ++it1;
-      ++it2;
-    }
+  NS_ASSERT (m_values.size () == x.m_values.size ());
+  DivideValues (m_values.data (), x.m_values.data (), m_values.size ());
 }
 
 
@@ -216,13 +337,7 @@ void
 SpectrumValue::Divide (double s)
 {
   NS_LOG_FUNCTION (this << s);
-  Values::iterator it1 = m_values.begin ();
-
-  while (it1 != m_values.end ())
-    {
-      *it1 /= s;
-      ++it1;
-    }
+  DivideScalar (m_values.data (), s, m_values.size ());
 }
 
 
@@ -231,13 +346,7 @@ SpectrumValue::Divide (double s)
 void
 SpectrumValue::ChangeSign ()
 {
-  Values::iterator it1 = m_values.begin ();
-
-  while (it1 != m_values.end ())
-    {
-      *it1 = -(*it1);
-      ++it1;
-    }
+  NegateValues (m_values.data (), m_values.size ());
 }
 
 
@@ -347,28 +456,14 @@ SpectrumValue::Log ()
 double
 Norm (const SpectrumValue& x)
 {
-  double s = 0;
-  Values::const_iterator it1 = x.ConstValuesBegin ();
-  while (it1 != x.ConstValuesEnd ())
-    {
-      s += (*it1) * (*it1);
-      ++it1;
-    }
-  return std::sqrt (s);
+  return std::sqrt (SumSquaredValues (x.m_values.data (), x.m_values.size ()));
 }
 
 
 double
 Sum (const SpectrumValue& x)
 {
-  double s = 0;
-  Values::const_iterator it1 = x.ConstValuesBegin ();
-  while (it1 != x.ConstValuesEnd ())
-    {
-      s += (*it1);
-      ++it1;
-    }
-  return s;
+  return SumValues (x.m_values.data (), x.m_values.size ());
 }
 
 
@@ -389,18 +484,12 @@ Prod (const SpectrumValue& x)
 double
 Integral (const SpectrumValue& arg)
 {
-  double i = 0;
-  Values::const_iterator vit = arg.ConstValuesBegin ();
-  Bands::const_iterator bit = arg.ConstBandsBegin ();
-  while (vit != arg.ConstValuesEnd ())
+  NS_ASSERT (arg.m_values.size () == arg.m_spectrumModel->GetNumBands ());
+  if (arg.m_values.empty ())
     {
-      NS_ASSERT (bit != arg.ConstBandsEnd ());
-      i += (*vit) * (bit->fh - bit->fl);
-      ++vit;
-      ++bit;
+      return 0;
     }
-  NS_ASSERT (bit == arg.ConstBandsEnd ());
-  return i;
+  return IntegrateValues (arg.m_values.data (), &(*arg.ConstBandsBegin ()), arg.m_values.size ());
 }
 
 
@@ -467,9 +556,8 @@ operator+ (double lhs, const SpectrumValue& rhs)
 SpectrumValue
 operator- (const SpectrumValue& lhs, const SpectrumValue& rhs)
 {
-  SpectrumValue res = rhs;
-  res.ChangeSign ();
-  res.Add (lhs);
+  SpectrumValue res = lhs;
+  res.Subtract (rhs);
   return res;
 }
 
@@ -660,17 +748,31 @@ SpectrumValue::operator/= (double rhs)
   return *this;
 }
 
+SpectrumValue&
+SpectrumValue::AddScaled (const SpectrumValue& x, double s)
+{
+  NS_ASSERT (m_spectrumModel == x.m_spectrumModel);
+  NS_ASSERT (m_values.size () == x.m_values.size ());
+  AddScaledValues (m_values.data (), x.m_values.data (), s, m_values.size ());
+  return *this;
+}
 
 SpectrumValue&
-SpectrumValue::operator= (double rhs)
+SpectrumValue::AddProduct (const SpectrumValue& x, const SpectrumValue& y)
 {
-  Values::iterator it1 = m_values.begin ();
+  NS_ASSERT (m_spectrumModel == x.m_spectrumModel);
+  NS_ASSERT (m_spectrumModel == y.m_spectrumModel);
+  NS_ASSERT (m_values.size () == x.m_values.size ());
+  NS_ASSERT (m_values.size () == y.m_values.size ());
+  AddProductValues (m_values.data (), x.m_values.data (), y.m_values.data (), m_values.size ());
+  return *this;
+}
 
-  while (it1 != m_values.end ())
-    {
-      *it1 = rhs;
-      ++it1;
-    }
+
+SpectrumValue&
+SpectrumValue::operator= (double rhs)
+{
+  std::fill (m_values.begin (), m_values.end (), rhs);
   return *this;
 }
 
@@ -409,6 +409,30 @@ public:
    */
   SpectrumValue& operator= (double rhs);
 
+  /**
+   * Add x scaled by s to *this, component by component.  This is
+   * *this += x * s in a single pass, without the temporary
+   * SpectrumValue the operators need.
+   *
+   * @param x the SpectrumValue to scale and add
+   * @param s the scale factor
+   *
+   * @return a reference to *this
+   */
+  SpectrumValue& AddScaled (const SpectrumValue& x, double s);
+
+  /**
+   * Add the product of x and y to *this, component by component
+   * (multiply-accumulate).  This is *this += x * y in a single pass,
+   * without the temporary SpectrumValue the operators need.
+   *
+   * @param x the first factor
+   * @param y the second factor
+   *
+   * @return a reference to *this
+   */
+  SpectrumValue& AddProduct (const SpectrumValue& x, const SpectrumValue& y);
+
 
 
   /**
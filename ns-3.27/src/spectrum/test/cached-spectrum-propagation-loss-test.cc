@@ -0,0 +1,133 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <ns3/test.h>
+#include <ns3/double.h>
+#include <ns3/constant-position-mobility-model.h>
+#include <ns3/friis-spectrum-propagation-loss.h>
+#include <ns3/cached-spectrum-propagation-loss.h>
+#include <ns3/spectrum-value.h>
+#include <vector>
+
+using namespace ns3;
+
+/**
+ * \ingroup spectrum-tests
+ *
+ * \brief Check that CachedSpectrumPropagationLossModel gives the PSD of
+ * the cached model, including in the bands where the transmitted PSD is
+ * null, and computes it again only for new paths, SpectrumModels or
+ * positions.
+ */
+class CachedSpectrumPropagationLossTestCase : public TestCase
+{
+public:
+  CachedSpectrumPropagationLossTestCase ();
+  virtual ~CachedSpectrumPropagationLossTestCase ();
+
+private:
+  virtual void DoRun (void);
+  /**
+   * Check a received PSD against the PSD received through the Friis model.
+   * \param rxPsd the received PSD
+   * \param expected the PSD received through the Friis model
+   * \param msg the description of the check
+   */
+  void CheckPsd (Ptr<const SpectrumValue> rxPsd, Ptr<const SpectrumValue> expected, std::string msg);
+};
+
+CachedSpectrumPropagationLossTestCase::CachedSpectrumPropagationLossTestCase ()
+  : TestCase ("Cache the gain of a SpectrumPropagationLossModel")
+{
+}
+
+CachedSpectrumPropagationLossTestCase::~CachedSpectrumPropagationLossTestCase ()
+{
+}
+
+void
+CachedSpectrumPropagationLossTestCase::CheckPsd (Ptr<const SpectrumValue> rxPsd, Ptr<const SpectrumValue> expected, std::string msg)
+{
+  NS_TEST_ASSERT_MSG_EQ (rxPsd->GetSpectrumModelUid (), expected->GetSpectrumModelUid (), msg << ": wrong SpectrumModel");
+  for (uint32_t i = 0; i < expected->GetSpectrumModel ()->GetNumBands (); i++)
+    {
+      NS_TEST_ASSERT_MSG_EQ_TOL ((*rxPsd)[i], (*expected)[i], 1e-12 * (*expected)[i], msg << ": wrong PSD in band " << i);
+    }
+}
+
+void
+CachedSpectrumPropagationLossTestCase::DoRun (void)
+{
+  Ptr<MobilityModel> a = CreateObject<ConstantPositionMobilityModel> ();
+  a->SetPosition (Vector (0, 0, 0));
+  Ptr<MobilityModel> b = CreateObject<ConstantPositionMobilityModel> ();
+  b->SetPosition (Vector (100, 0, 0));
+
+  std::vector<double> frequencies;
+  for (uint32_t i = 0; i <= 10; i++)
+    {
+      frequencies.push_back (2400e6 + i * 1e6);
+    }
+  Ptr<SpectrumModel> model = Create<SpectrumModel> (frequencies);
+  Ptr<SpectrumModel> otherModel = Create<SpectrumModel> (frequencies);
+  Ptr<SpectrumValue> txPsd = Create<SpectrumValue> (model);
+  for (uint32_t i = 0; i < 10; i++)
+    {
+      (*txPsd)[i] = (i % 3) * 1e-9;
+    }
+  Ptr<SpectrumValue> otherTxPsd = Create<SpectrumValue> (otherModel);
+  *otherTxPsd = 1e-9;
+
+  Ptr<FriisSpectrumPropagationLossModel> friis = CreateObject<FriisSpectrumPropagationLossModel> ();
+  Ptr<CachedSpectrumPropagationLossModel> cached = CreateObject<CachedSpectrumPropagationLossModel> ();
+  cached->SetModel (friis);
+  cached->SetAttribute ("PositionThreshold", DoubleValue (1));
+
+  CheckPsd (cached->CalcRxPowerSpectralDensity (txPsd, a, b), friis->CalcRxPowerSpectralDensity (txPsd, a, b), "Computed");
+  CheckPsd (cached->CalcRxPowerSpectralDensity (txPsd, a, b), friis->CalcRxPowerSpectralDensity (txPsd, a, b), "Cached");
+  *txPsd = 2e-9;
+  CheckPsd (cached->CalcRxPowerSpectralDensity (txPsd, a, b), friis->CalcRxPowerSpectralDensity (txPsd, a, b), "Cached for another PSD");
+  NS_TEST_ASSERT_MSG_EQ (cached->GetCacheMisses (), 1, "Wrong number of misses");
+  NS_TEST_ASSERT_MSG_EQ (cached->GetCacheHits (), 2, "Wrong number of hits");
+
+  // Another SpectrumModel, the reverse path and a large move are new paths
+  CheckPsd (cached->CalcRxPowerSpectralDensity (otherTxPsd, a, b), friis->CalcRxPowerSpectralDensity (otherTxPsd, a, b), "Other SpectrumModel");
+  CheckPsd (cached->CalcRxPowerSpectralDensity (txPsd, b, a), friis->CalcRxPowerSpectralDensity (txPsd, b, a), "Reverse path");
+  b->SetPosition (Vector (200, 0, 0));
+  CheckPsd (cached->CalcRxPowerSpectralDensity (txPsd, a, b), friis->CalcRxPowerSpectralDensity (txPsd, a, b), "Large move");
+  NS_TEST_ASSERT_MSG_EQ (cached->GetCacheMisses (), 4, "New paths not computed");
+  NS_TEST_ASSERT_MSG_EQ (cached->GetCacheHits (), 2, "New paths cached");
+}
+
+
+/**
+ * \ingroup spectrum-tests
+ *
+ * \brief CachedSpectrumPropagationLossModel Test Suite
+ */
+class CachedSpectrumPropagationLossTestSuite : public TestSuite
+{
+public:
+  CachedSpectrumPropagationLossTestSuite ();
+};
+
+CachedSpectrumPropagationLossTestSuite::CachedSpectrumPropagationLossTestSuite ()
+  : TestSuite ("cached-spectrum-propagation-loss", UNIT)
+{
+  AddTestCase (new CachedSpectrumPropagationLossTestCase, TestCase::QUICK);
+}
+
+static CachedSpectrumPropagationLossTestSuite g_cachedSpectrumPropagationLossTestSuite; ///< the test suite
@@ -0,0 +1,313 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <ns3/test.h>
+#include <ns3/simulator.h>
+#include <ns3/double.h>
+#include <ns3/random-variable-stream.h>
+#include <ns3/constant-position-mobility-model.h>
+#include <ns3/propagation-loss-model.h>
+#include <ns3/propagation-delay-model.h>
+#include <ns3/multi-model-spectrum-channel.h>
+#include <ns3/spectrum-phy.h>
+#include <ns3/net-device.h>
+#include <ns3/antenna-model.h>
+#include <ns3/spectrum-signal-parameters.h>
+#include <ns3/spectrum-value.h>
+#include <vector>
+#include <algorithm>
+
+using namespace ns3;
+
+/// A reception by a RecordingPhy
+struct Reception
+{
+  uint32_t rx;    //!< The index of the receiver
+  Time time;      //!< The time of the reception
+  double power;   //!< The power received in the first band
+};
+
+/**
+ * \param a a reception
+ * \param b another reception
+ * \return whether a is earlier than b, or at the same time at a receiver of lower index
+ */
+static bool
+ReceptionLess (const Reception &a, const Reception &b)
+{
+  return a.time < b.time || (a.time == b.time && a.rx < b.rx);
+}
+
+/// A SpectrumPhy recording the signals it receives
+class RecordingPhy : public SpectrumPhy
+{
+public:
+  /**
+   * \param index The index of the receiver.
+   * \param model The SpectrumModel of the receiver.
+   * \param mobility The position of the receiver, if any.
+   * \param receptions The list of the receptions to extend.
+   */
+  RecordingPhy (uint32_t index, Ptr<const SpectrumModel> model, Ptr<MobilityModel> mobility,
+                std::vector<Reception> *receptions);
+
+  // inherited from SpectrumPhy
+  virtual void SetDevice (Ptr<NetDevice> d);
+  virtual Ptr<NetDevice> GetDevice () const;
+  virtual void SetMobility (Ptr<MobilityModel> m);
+  virtual Ptr<MobilityModel> GetMobility ();
+  virtual void SetChannel (Ptr<SpectrumChannel> c);
+  virtual Ptr<const SpectrumModel> GetRxSpectrumModel () const;
+  virtual Ptr<AntennaModel> GetRxAntenna ();
+  virtual void StartRx (Ptr<SpectrumSignalParameters> params);
+
+private:
+  virtual void DoDispose (void);
+
+  uint32_t m_index;                      //!< The index of the receiver
+  Ptr<const SpectrumModel> m_model;      //!< The SpectrumModel of the receiver
+  Ptr<MobilityModel> m_mobility;         //!< The position of the receiver
+  std::vector<Reception> *m_receptions;  //!< The list of the receptions
+};
+
+RecordingPhy::RecordingPhy (uint32_t index, Ptr<const SpectrumModel> model, Ptr<MobilityModel> mobility,
+                            std::vector<Reception> *receptions)
+  : m_index (index),
+    m_model (model),
+    m_mobility (mobility),
+    m_receptions (receptions)
+{
+}
+
+void
+RecordingPhy::DoDispose (void)
+{
+  m_model = 0;
+  m_mobility = 0;
+  SpectrumPhy::DoDispose ();
+}
+
+void
+RecordingPhy::SetDevice (Ptr<NetDevice> d)
+{
+}
+
+Ptr<NetDevice>
+RecordingPhy::GetDevice () const
+{
+  return 0;
+}
+
+void
+RecordingPhy::SetMobility (Ptr<MobilityModel> m)
+{
+  m_mobility = m;
+}
+
+Ptr<MobilityModel>
+RecordingPhy::GetMobility ()
+{
+  return m_mobility;
+}
+
+void
+RecordingPhy::SetChannel (Ptr<SpectrumChannel> c)
+{
+}
+
+Ptr<const SpectrumModel>
+RecordingPhy::GetRxSpectrumModel () const
+{
+  return m_model;
+}
+
+Ptr<AntennaModel>
+RecordingPhy::GetRxAntenna ()
+{
+  return 0;
+}
+
+void
+RecordingPhy::StartRx (Ptr<SpectrumSignalParameters> params)
+{
+  Reception reception;
+  reception.rx = m_index;
+  reception.time = Simulator::Now ();
+  reception.power = (*params->psd)[0];
+  m_receptions->push_back (reception);
+}
+
+/**
+ * \ingroup spectrum-tests
+ *
+ * \brief Check that the receptions of a MultiModelSpectrumChannel are
+ * the same when receivers beyond MaxLossDb are
+ * culled by MaxRange, with several RX SpectrumModels and some nodes
+ * without a MobilityModel.
+ */
+class MultiModelSpectrumChannelMaxRangeTestCase : public TestCase
+{
+public:
+  MultiModelSpectrumChannelMaxRangeTestCase ();
+  virtual ~MultiModelSpectrumChannelMaxRangeTestCase ();
+
+private:
+  virtual void DoRun (void);
+  /**
+   * Let every node transmit once, then move a node and let it
+   * transmit again.
+   * \param maxRange the MaxRange attribute of the channel
+   * \return the receptions
+   */
+  std::vector<Reception> Run (double maxRange);
+  /**
+   * \param fl the lowest frequency of the first band
+   * \return a SpectrumModel of 10 bands of 1 MHz
+   */
+  static Ptr<SpectrumModel> CreateModel (double fl);
+
+  std::vector<Vector> m_positions; ///< the positions of the nodes
+};
+
+MultiModelSpectrumChannelMaxRangeTestCase::MultiModelSpectrumChannelMaxRangeTestCase ()
+  : TestCase ("Receivers beyond MaxRange are culled without changing the receptions")
+{
+}
+
+MultiModelSpectrumChannelMaxRangeTestCase::~MultiModelSpectrumChannelMaxRangeTestCase ()
+{
+}
+
+Ptr<SpectrumModel>
+MultiModelSpectrumChannelMaxRangeTestCase::CreateModel (double fl)
+{
+  std::vector<double> frequencies;
+  for (uint32_t i = 0; i <= 10; i++)
+    {
+      frequencies.push_back (fl + i * 1e6);
+    }
+  return Create<SpectrumModel> (frequencies);
+}
+
+std::vector<Reception>
+MultiModelSpectrumChannelMaxRangeTestCase::Run (double maxRange)
+{
+  std::vector<Reception> receptions;
+  Ptr<MultiModelSpectrumChannel> channel = CreateObject<MultiModelSpectrumChannel> ();
+  channel->SetAttribute ("MaxLossDb", DoubleValue (110));
+  channel->SetAttribute ("MaxRange", DoubleValue (maxRange));
+  channel->AddPropagationLossModel (CreateObject<LogDistancePropagationLossModel> ());
+  channel->SetPropagationDelayModel (CreateObject<ConstantSpeedPropagationDelayModel> ());
+
+  // Overlapping models, and one orthogonal to the others
+  Ptr<SpectrumModel> models[] = { CreateModel (2400e6), CreateModel (2400.5e6), CreateModel (5000e6) };
+  std::vector<Ptr<RecordingPhy> > phys;
+  for (uint32_t i = 0; i < m_positions.size (); i++)
+    {
+      Ptr<MobilityModel> mobility;
+      if (i % 25 != 0)
+        {
+          mobility = CreateObject<ConstantPositionMobilityModel> ();
+          mobility->SetPosition (m_positions[i]);
+        }
+      Ptr<RecordingPhy> phy = CreateObject<RecordingPhy> (i, models[i % 3], mobility, &receptions);
+      channel->AddRx (phy);
+      phys.push_back (phy);
+    }
+  for (uint32_t i = 0; i < phys.size (); i++)
+    {
+      Ptr<SpectrumSignalParameters> params = Create<SpectrumSignalParameters> ();
+      params->duration = MicroSeconds (1);
+      params->txPhy = phys[i];
+      params->psd = Create<SpectrumValue> (models[i % 3]);
+      *params->psd = 1e-12;
+      Simulator::Schedule (MicroSeconds (10 * i), &SpectrumChannel::StartTx, channel, params);
+    }
+  Simulator::Run ();
+
+  // The grid follows the nodes which are moved
+  phys[1]->GetMobility ()->SetPosition (Vector (0, 0, 0));
+  phys[2]->GetMobility ()->SetPosition (Vector (50, 0, 0));
+  Ptr<SpectrumSignalParameters> params = Create<SpectrumSignalParameters> ();
+  params->duration = MicroSeconds (1);
+  params->txPhy = phys[2];
+  params->psd = Create<SpectrumValue> (models[2]);
+  *params->psd = 1e-12;
+  Simulator::Schedule (MicroSeconds (10), &SpectrumChannel::StartTx, channel, params);
+  params = Create<SpectrumSignalParameters> ();
+  params->duration = MicroSeconds (1);
+  params->txPhy = phys[4];
+  params->psd = Create<SpectrumValue> (models[1]);
+  *params->psd = 1e-12;
+  Simulator::Schedule (MicroSeconds (20), &SpectrumChannel::StartTx, channel, params);
+  Simulator::Run ();
+  Simulator::Destroy ();
+
+  channel->Dispose ();
+  for (uint32_t i = 0; i < phys.size (); i++)
+    {
+      phys[i]->Dispose ();
+    }
+  return receptions;
+}
+
+void
+MultiModelSpectrumChannelMaxRangeTestCase::DoRun (void)
+{
+  Ptr<UniformRandomVariable> random = CreateObject<UniformRandomVariable> ();
+  random->SetStream (1);
+  for (uint32_t i = 0; i < 300; i++)
+    {
+      m_positions.push_back (Vector (random->GetValue (0, 1000), random->GetValue (0, 1000), 0));
+    }
+
+  std::vector<Reception> expected = Run (0);
+  double maxRange = CreateObject<LogDistancePropagationLossModel> ()->CalcRange (110, 10000);
+  std::vector<Reception> receptions = Run (maxRange);
+  NS_TEST_ASSERT_MSG_GT (expected.size (), 0, "No reception");
+  NS_TEST_ASSERT_MSG_LT (expected.size (), 300 * 300 / 2, "Too many receptions for the test to be useful");
+  NS_TEST_ASSERT_MSG_EQ (receptions.size (), expected.size (), "Wrong number of receptions");
+  // The receivers of a SpectrumModel are ordered by address in the
+  // channel, so simultaneous receptions may be ordered differently
+  std::sort (expected.begin (), expected.end (), &ReceptionLess);
+  std::sort (receptions.begin (), receptions.end (), &ReceptionLess);
+  for (uint32_t i = 0; i < receptions.size (); i++)
+    {
+      NS_TEST_ASSERT_MSG_EQ (receptions[i].rx, expected[i].rx, "Wrong receiver of reception " << i);
+      NS_TEST_ASSERT_MSG_EQ (receptions[i].time, expected[i].time, "Wrong time of reception " << i);
+      NS_TEST_ASSERT_MSG_EQ (receptions[i].power, expected[i].power, "Wrong power of reception " << i);
+    }
+}
+
+
+/**
+ * \ingroup spectrum-tests
+ *
+ * \brief MultiModelSpectrumChannel Test Suite
+ */
+class MultiModelSpectrumChannelTestSuite : public TestSuite
+{
+public:
+  MultiModelSpectrumChannelTestSuite ();
+};
+
+MultiModelSpectrumChannelTestSuite::MultiModelSpectrumChannelTestSuite ()
+  : TestSuite ("multi-model-spectrum-channel", UNIT)
+{
+  AddTestCase (new MultiModelSpectrumChannelMaxRangeTestCase, TestCase::QUICK);
+}
+
+static MultiModelSpectrumChannelTestSuite g_multiModelSpectrumChannelTestSuite; ///< the test suite
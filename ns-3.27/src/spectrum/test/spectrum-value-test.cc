@@ -82,6 +82,52 @@ SpectrumValueTestCase::DoRun (void)
 
 
 
+/**
+ * Test the sums of the values of a SpectrumValue whose number of
+ * bands is not a multiple of the number summed at a time.
+ */
+class SpectrumValueSumTestCase : public TestCase
+{
+public:
+  SpectrumValueSumTestCase ();
+  virtual ~SpectrumValueSumTestCase ();
+  virtual void DoRun (void);
+};
+
+SpectrumValueSumTestCase::SpectrumValueSumTestCase ()
+  : TestCase ("Sum and Norm of a SpectrumValue")
+{
+}
+
+SpectrumValueSumTestCase::~SpectrumValueSumTestCase ()
+{
+}
+
+void
+SpectrumValueSumTestCase::DoRun (void)
+{
+  std::vector<double> freqs;
+  for (int i = 1; i <= 13; i++)
+    {
+      freqs.push_back (i);
+    }
+  Ptr<SpectrumModel> f = Create<SpectrumModel> (freqs);
+  SpectrumValue v (f);
+
+  double sum = 0;
+  double squares = 0;
+  for (int i = 0; i < 13; i++)
+    {
+      v[i] = 0.5 * i - 2;
+      sum += v[i];
+      squares += v[i] * v[i];
+    }
+  NS_TEST_ASSERT_MSG_EQ_TOL (Sum (v), sum, TOLERANCE, "Sum of 13 values");
+  NS_TEST_ASSERT_MSG_EQ_TOL (Norm (v), std::sqrt (squares), TOLERANCE, "Norm of 13 values");
+}
+
+
+
 class SpectrumValueTestSuite : public TestSuite
 {
 public:
@@ -241,6 +287,16 @@ SpectrumValueTestSuite::SpectrumValueTestSuite ()
   tv1rs3 = v1 >> 3;
   AddTestCase (new SpectrumValueTestCase (tv1rs3, v1rs3, "tv1rs3 = v1 >> 3"), TestCase::QUICK);
 
+  SpectrumValue tv11 (f), tv12 (f);
+  tv11 = v1;
+  tv11.AddScaled (v2, doubleValue);
+  AddTestCase (new SpectrumValueTestCase (tv11, v1 + v2 * doubleValue, "tv11 = v1, tv11.AddScaled (v2, doubleValue)"), TestCase::QUICK);
+  tv12 = v1;
+  tv12.AddProduct (v1, v2);
+  AddTestCase (new SpectrumValueTestCase (tv12, v1 + v5, "tv12 = v1, tv12.AddProduct (v1, v2)"), TestCase::QUICK);
+
+  AddTestCase (new SpectrumValueSumTestCase (), TestCase::QUICK);
+
 
 }
 
@@ -134,6 +134,8 @@ InterferenceHelper::InterferenceHelper ()
   : m_errorRateModel (0),
     m_numRxAntennas (1),
     m_firstPower (0.0),
+    m_nowPosition (0),
+    m_nowPower (0.0),
     m_rxing (false)
 {
 }
@@ -199,8 +201,8 @@ InterferenceHelper::GetEnergyDuration (double energyW) const
   Time now = Simulator::Now ();
   double noiseInterferenceW = 0.0;
   Time end = now;
-  noiseInterferenceW = m_firstPower;
-  for (NiChanges::const_iterator i = m_niChanges.begin (); i != m_niChanges.end (); i++)
+  noiseInterferenceW = m_nowPower;
+  for (NiChanges::const_iterator i = m_niChanges.begin () + m_nowPosition; i != m_niChanges.end (); i++)
     {
       noiseInterferenceW += i->GetDelta ();
       end = i->GetTime ();
@@ -220,22 +222,42 @@ void
 InterferenceHelper::AppendEvent (Ptr<InterferenceHelper::Event> event)
 {
   Time now = Simulator::Now ();
-  if (!m_rxing)
+  // Sum the NI changes which happened since the last event, so that the
+  // power at now is not summed from the first NI change every time
+  while (m_nowPosition < m_niChanges.size () && m_niChanges[m_nowPosition].GetTime () < now)
     {
-      NiChanges::const_iterator nowIterator = GetPosition (now);
-      for (NiChanges::const_iterator i = m_niChanges.begin (); i != nowIterator; i++)
-        {
-          m_firstPower += i->GetDelta ();
-        }
-      m_niChanges.erase (m_niChanges.begin (), nowIterator);
-      m_niChanges.insert (m_niChanges.begin (), NiChange (event->GetStartTime (), event->GetRxPowerW (), event));
+      m_nowPower += m_niChanges[m_nowPosition].GetDelta ();
+      m_nowPosition++;
+    }
+  // The NI changes before the signal being received, or up to now when no
+  // signal is being received, are no longer needed: fold them into
+  // m_firstPower, so that the list only spans the signals in the air.
+  NiChanges::const_iterator first;
+  if (m_rxing)
+    {
+      first = std::lower_bound (m_niChanges.begin (), m_niChanges.end (), NiChange (m_rxStart, 0, NULL));
+    }
+  else
+    {
+      first = GetPosition (now);
+    }
+  for (NiChanges::const_iterator i = m_niChanges.begin (); i != first; i++)
+    {
+      m_firstPower += i->GetDelta ();
+    }
+  NiChanges::size_type erased = first - m_niChanges.begin ();
+  m_niChanges.erase (m_niChanges.begin (), first);
+  if (m_rxing)
+    {
+      m_nowPosition -= erased;
     }
   else
     {
-      AddNiChangeEvent (NiChange (event->GetStartTime (), event->GetRxPowerW (), event));
+      m_nowPosition = 0;
+      m_nowPower = m_firstPower;
     }
+  AddNiChangeEvent (NiChange (event->GetStartTime (), event->GetRxPowerW (), event));
   AddNiChangeEvent (NiChange (event->GetEndTime (), -event->GetRxPowerW (), event));
-
 }
 
 
@@ -255,7 +277,7 @@ InterferenceHelper::CalculateSnr (double signal, double noiseInterference, uint8
 }
 
 double
-InterferenceHelper::CalculateNoiseInterferenceW (Ptr<InterferenceHelper::Event> event, NiChanges *ni) const
+InterferenceHelper::CalculateNoiseInterferenceW (Ptr<const InterferenceHelper::Event> event, NiChanges::const_iterator *start) const
 {
   double noiseInterference = m_firstPower;
   NiChanges::const_iterator eventIterator = m_niChanges.begin ();
@@ -282,17 +304,8 @@ InterferenceHelper::CalculateNoiseInterferenceW (Ptr<InterferenceHelper::Event>
         }
       ++eventIterator;
     }
-
-  for (NiChanges::const_iterator i = eventIterator + 1; i != m_niChanges.end (); ++i)
-    {
-      if (event->GetEndTime () == i->GetTime () && event == i->GetEvent ())
-        {
-          break;
-        }
-      ni->push_back (*i);
-    }
-  ni->insert (ni->begin (), NiChange (event->GetStartTime (), noiseInterference, event));
-  ni->push_back (NiChange (event->GetEndTime (), 0, event));
+  NS_ASSERT (eventIterator != m_niChanges.end ());
+  *start = eventIterator;
   return noiseInterference;
 }
 
@@ -317,12 +330,12 @@ InterferenceHelper::CalculateChunkSuccessRate (double snir, Time duration, WifiM
 }
 
 double
-InterferenceHelper::CalculatePlcpPayloadPer (Ptr<const InterferenceHelper::Event> event, NiChanges *ni) const
+InterferenceHelper::CalculatePlcpPayloadPer (Ptr<const InterferenceHelper::Event> event, NiChanges::const_iterator start, double noiseInterferenceW) const
 {
   NS_LOG_FUNCTION (this);
   const WifiTxVector txVector = event->GetTxVector ();
   double psr = 1.0; /* Packet Success Rate */
-  NiChanges::const_iterator j = ni->begin ();
+  NiChanges::const_iterator j = start;
   Time previous = (*j).GetTime ();
   WifiMode payloadMode = event->GetPayloadMode ();
   WifiPreamble preamble = txVector.GetPreambleType ();
@@ -330,11 +343,10 @@ InterferenceHelper::CalculatePlcpPayloadPer (Ptr<const InterferenceHelper::Event
   Time plcpHsigHeaderStart = plcpHeaderStart + WifiPhy::GetPlcpHeaderDuration (txVector); //packet start time + preamble + L-SIG
   Time plcpTrainingSymbolsStart = plcpHsigHeaderStart + WifiPhy::GetPlcpHtSigHeaderDuration (preamble) + WifiPhy::GetPlcpSigA1Duration (preamble) + WifiPhy::GetPlcpSigA2Duration (preamble); //packet start time + preamble + L-SIG + HT-SIG or SIG-A
   Time plcpPayloadStart = plcpTrainingSymbolsStart + WifiPhy::GetPlcpTrainingSymbolDuration (txVector) + WifiPhy::GetPlcpSigBDuration (preamble); //packet start time + preamble + L-SIG + HT-SIG or SIG-A + Training + SIG-B
-  double noiseInterferenceW = (*j).GetDelta ();
   double powerW = event->GetRxPowerW ();
-  j++;
-  while (ni->end () != j)
+  do
     {
+      j++;
       Time current = (*j).GetTime ();
       NS_LOG_DEBUG ("previous= " << previous << ", current=" << current);
       NS_ASSERT (current >= previous);
@@ -362,20 +374,20 @@ InterferenceHelper::CalculatePlcpPayloadPer (Ptr<const InterferenceHelper::Event
 
       noiseInterferenceW += (*j).GetDelta ();
       previous = (*j).GetTime ();
-      j++;
     }
+  while ((*j).GetEvent () != event);
 
   double per = 1 - psr;
   return per;
 }
 
 double
-InterferenceHelper::CalculatePlcpHeaderPer (Ptr<const InterferenceHelper::Event> event, NiChanges *ni) const
+InterferenceHelper::CalculatePlcpHeaderPer (Ptr<const InterferenceHelper::Event> event, NiChanges::const_iterator start, double noiseInterferenceW) const
 {
   NS_LOG_FUNCTION (this);
   const WifiTxVector txVector = event->GetTxVector ();
   double psr = 1.0; /* Packet Success Rate */
-  NiChanges::const_iterator j = ni->begin ();
+  NiChanges::const_iterator j = start;
   Time previous = (*j).GetTime ();
   WifiPreamble preamble = txVector.GetPreambleType ();
   WifiMode mcsHeaderMode;
@@ -399,11 +411,10 @@ InterferenceHelper::CalculatePlcpHeaderPer (Ptr<const InterferenceHelper::Event>
   Time plcpHsigHeaderStart = plcpHeaderStart + WifiPhy::GetPlcpHeaderDuration (txVector); //packet start time + preamble + L-SIG
   Time plcpTrainingSymbolsStart = plcpHsigHeaderStart + WifiPhy::GetPlcpHtSigHeaderDuration (preamble) + WifiPhy::GetPlcpSigA1Duration (preamble) + WifiPhy::GetPlcpSigA2Duration (preamble); //packet start time + preamble + L-SIG + HT-SIG or SIG-A
   Time plcpPayloadStart = plcpTrainingSymbolsStart + WifiPhy::GetPlcpTrainingSymbolDuration (txVector) + WifiPhy::GetPlcpSigBDuration (preamble); //packet start time + preamble + L-SIG + HT-SIG or SIG-A + Training + SIG-B
-  double noiseInterferenceW = (*j).GetDelta ();
   double powerW = event->GetRxPowerW ();
-  j++;
-  while (ni->end () != j)
+  do
     {
+      j++;
       Time current = (*j).GetTime ();
       NS_LOG_DEBUG ("previous= " << previous << ", current=" << current);
       NS_ASSERT (current >= previous);
@@ -820,8 +831,8 @@ InterferenceHelper::CalculatePlcpHeaderPer (Ptr<const InterferenceHelper::Event>
 
       noiseInterferenceW += (*j).GetDelta ();
       previous = (*j).GetTime ();
-      j++;
     }
+  while ((*j).GetEvent () != event);
 
   double per = 1 - psr;
   return per;
@@ -830,8 +841,8 @@ InterferenceHelper::CalculatePlcpHeaderPer (Ptr<const InterferenceHelper::Event>
 struct InterferenceHelper::SnrPer
 InterferenceHelper::CalculatePlcpPayloadSnrPer (Ptr<InterferenceHelper::Event> event)
 {
-  NiChanges ni;
-  double noiseInterferenceW = CalculateNoiseInterferenceW (event, &ni);
+  NiChanges::const_iterator start;
+  double noiseInterferenceW = CalculateNoiseInterferenceW (event, &start);
   double snr = CalculateSnr (event->GetRxPowerW (),
                              noiseInterferenceW,
                              event->GetTxVector ().GetChannelWidth ());
@@ -839,7 +850,7 @@ InterferenceHelper::CalculatePlcpPayloadSnrPer (Ptr<InterferenceHelper::Event> e
   /* calculate the SNIR at the start of the packet and accumulate
    * all SNIR changes in the snir vector.
    */
-  double per = CalculatePlcpPayloadPer (event, &ni);
+  double per = CalculatePlcpPayloadPer (event, start, noiseInterferenceW);
 
   struct SnrPer snrPer;
   snrPer.snr = snr;
@@ -850,8 +861,8 @@ InterferenceHelper::CalculatePlcpPayloadSnrPer (Ptr<InterferenceHelper::Event> e
 struct InterferenceHelper::SnrPer
 InterferenceHelper::CalculatePlcpHeaderSnrPer (Ptr<InterferenceHelper::Event> event)
 {
-  NiChanges ni;
-  double noiseInterferenceW = CalculateNoiseInterferenceW (event, &ni);
+  NiChanges::const_iterator start;
+  double noiseInterferenceW = CalculateNoiseInterferenceW (event, &start);
   double snr = CalculateSnr (event->GetRxPowerW (),
                              noiseInterferenceW,
                              event->GetTxVector ().GetChannelWidth ());
@@ -859,7 +870,7 @@ InterferenceHelper::CalculatePlcpHeaderSnrPer (Ptr<InterferenceHelper::Event> ev
   /* calculate the SNIR at the start of the plcp header and accumulate
    * all SNIR changes in the snir vector.
    */
-  double per = CalculatePlcpHeaderPer (event, &ni);
+  double per = CalculatePlcpHeaderPer (event, start, noiseInterferenceW);
 
   struct SnrPer snrPer;
   snrPer.snr = snr;
@@ -873,6 +884,8 @@ InterferenceHelper::EraseEvents (void)
   m_niChanges.clear ();
   m_rxing = false;
   m_firstPower = 0.0;
+  m_nowPosition = 0;
+  m_nowPower = 0.0;
 }
 
 InterferenceHelper::NiChanges::const_iterator
@@ -892,6 +905,7 @@ InterferenceHelper::NotifyRxStart ()
 {
   NS_LOG_FUNCTION (this);
   m_rxing = true;
+  m_rxStart = Simulator::Now ();
 }
 
 void
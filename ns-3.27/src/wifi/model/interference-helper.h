@@ -195,7 +195,8 @@ private:
   struct InterferenceHelper::SnrPer CalculatePlcpHeaderSnrPer (Ptr<InterferenceHelper::Event> event);
 
   /**
-   * Notify that RX has started.
+   * Notify that the reception of the signal starting now has started.
+   * The NI changes before it are no longer needed.
    */
   void NotifyRxStart ();
   /**
@@ -270,11 +271,11 @@ private:
    * Calculate noise and interference power in W.
    *
    * \param event
-   * \param ni
+   * \param start the NI change starting the event
    *
-   * \return noise and interference power
+   * \return noise and interference power when the event starts
    */
-  double CalculateNoiseInterferenceW (Ptr<Event> event, NiChanges *ni) const;
+  double CalculateNoiseInterferenceW (Ptr<const Event> event, NiChanges::const_iterator *start) const;
   /**
    * Calculate SNR (linear ratio) from the given signal power and noise+interference power.
    * (Mode is not currently used)
@@ -303,29 +304,34 @@ private:
    * multiple chunks (e.g. due to interference from other transmissions).
    *
    * \param event
-   * \param ni
+   * \param start the NI change starting the event
+   * \param noiseInterferenceW the noise and interference power when the event starts
    *
    * \return the error rate of the packet
    */
-  double CalculatePlcpPayloadPer (Ptr<const Event> event, NiChanges *ni) const;
+  double CalculatePlcpPayloadPer (Ptr<const Event> event, NiChanges::const_iterator start, double noiseInterferenceW) const;
   /**
    * Calculate the error rate of the plcp header. The plcp header can be divided into
    * multiple chunks (e.g. due to interference from other transmissions).
    *
    * \param event
-   * \param ni
+   * \param start the NI change starting the event
+   * \param noiseInterferenceW the noise and interference power when the event starts
    *
    * \return the error rate of the packet
    */
-  double CalculatePlcpHeaderPer (Ptr<const Event> event, NiChanges *ni) const;
+  double CalculatePlcpHeaderPer (Ptr<const Event> event, NiChanges::const_iterator start, double noiseInterferenceW) const;
 
   double m_noiseFigure; /**< noise figure (linear) */
   Ptr<ErrorRateModel> m_errorRateModel; ///< error rate model
   uint8_t m_numRxAntennas; /**< the number of RX antennas in the corresponding receiver */
   /// Experimental: needed for energy duration calculation
   NiChanges m_niChanges;
-  double m_firstPower; ///< first power
+  double m_firstPower; ///< power before the first NI change
+  NiChanges::size_type m_nowPosition; ///< index of the first NI change not earlier than the last event appended
+  double m_nowPower; ///< power before the NI change at m_nowPosition
   bool m_rxing; ///< flag whether it is in receiving state
+  Time m_rxStart; ///< start time of the ongoing reception
 
   /**
    * Returns a const iterator to the first nichange, which is later than moment
@@ -2267,49 +2267,49 @@ WifiPhy::CalculateTxDuration (uint32_t size, WifiTxVector txVector, uint16_t fre
 void
 WifiPhy::NotifyTxBegin (Ptr<const Packet> packet)
 {
-  m_phyTxBeginTrace (packet);
+  NS_TRACE_HOT (m_phyTxBeginTrace (packet));
 }
 
 void
 WifiPhy::NotifyTxEnd (Ptr<const Packet> packet)
 {
-  m_phyTxEndTrace (packet);
+  NS_TRACE_HOT (m_phyTxEndTrace (packet));
 }
 
 void
 WifiPhy::NotifyTxDrop (Ptr<const Packet> packet)
 {
-  m_phyTxDropTrace (packet);
+  NS_TRACE_HOT (m_phyTxDropTrace (packet));
 }
 
 void
 WifiPhy::NotifyRxBegin (Ptr<const Packet> packet)
 {
-  m_phyRxBeginTrace (packet);
+  NS_TRACE_HOT (m_phyRxBeginTrace (packet));
 }
 
 void
 WifiPhy::NotifyRxEnd (Ptr<const Packet> packet)
 {
-  m_phyRxEndTrace (packet);
+  NS_TRACE_HOT (m_phyRxEndTrace (packet));
 }
 
 void
 WifiPhy::NotifyRxDrop (Ptr<const Packet> packet)
 {
-  m_phyRxDropTrace (packet);
+  NS_TRACE_HOT (m_phyRxDropTrace (packet));
 }
 
 void
 WifiPhy::NotifyMonitorSniffRx (Ptr<const Packet> packet, uint16_t channelFreqMhz, WifiTxVector txVector, MpduInfo aMpdu, SignalNoiseDbm signalNoise)
 {
-  m_phyMonitorSniffRxTrace (packet, channelFreqMhz, txVector, aMpdu, signalNoise);
+  NS_TRACE_HOT (m_phyMonitorSniffRxTrace (packet, channelFreqMhz, txVector, aMpdu, signalNoise));
 }
 
 void
 WifiPhy::NotifyMonitorSniffTx (Ptr<const Packet> packet, uint16_t channelFreqMhz, WifiTxVector txVector, MpduInfo aMpdu)
 {
-  m_phyMonitorSniffTxTrace (packet, channelFreqMhz, txVector, aMpdu);
+  NS_TRACE_HOT (m_phyMonitorSniffTxTrace (packet, channelFreqMhz, txVector, aMpdu));
 }
 
 void
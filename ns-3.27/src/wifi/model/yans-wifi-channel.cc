@@ -21,6 +21,7 @@
 #include "ns3/simulator.h"
 #include "ns3/log.h"
 #include "ns3/pointer.h"
+#include "ns3/double.h"
 #include "yans-wifi-channel.h"
 #include "ns3/propagation-loss-model.h"
 #include "ns3/propagation-delay-model.h"
@@ -47,11 +48,26 @@ YansWifiChannel::GetTypeId (void)
                    PointerValue (),
                    MakePointerAccessor (&YansWifiChannel::m_delay),
                    MakePointerChecker<PropagationDelayModel> ())
+    .AddAttribute ("MaxRange",
+                   "If positive, the maximum distance in meters between the sender "
+                   "and a receiver for which packets are delivered.  The receivers "
+                   "are then indexed by position, so that those farther away are "
+                   "skipped without evaluating their propagation loss and delay.  "
+                   "PropagationLossModel::CalcRange can derive this distance from "
+                   "the lowest power worth delivering, for a deterministic "
+                   "PropagationLossModel.  The default value delivers packets to "
+                   "all the receivers.",
+                   DoubleValue (0),
+                   MakeDoubleAccessor (&YansWifiChannel::m_maxRange),
+                   MakeDoubleChecker<double> (0))
   ;
   return tid;
 }
 
 YansWifiChannel::YansWifiChannel ()
+  : m_maxRange (0),
+    m_grid (1),
+    m_gridOutdated (true)
 {
   NS_LOG_FUNCTION (this);
 }
@@ -59,6 +75,7 @@ YansWifiChannel::YansWifiChannel ()
 YansWifiChannel::~YansWifiChannel ()
 {
   NS_LOG_FUNCTION (this);
+  m_grid.Clear ();
   m_phyList.clear ();
 }
 
@@ -80,38 +97,85 @@ YansWifiChannel::Send (Ptr<YansWifiPhy> sender, Ptr<const Packet> packet, double
   NS_LOG_FUNCTION (this << sender << packet << txPowerDbm << duration.GetSeconds ());
   Ptr<MobilityModel> senderMobility = sender->GetMobility ();
   NS_ASSERT (senderMobility != 0);
-  for (PhyList::const_iterator i = m_phyList.begin (); i != m_phyList.end (); i++)
+  std::vector<uint32_t> candidates;
+  if (m_maxRange > 0)
     {
-      if (sender != (*i))
+      UpdateGrid ();
+      m_grid.Find (senderMobility->GetPosition (), m_maxRange, candidates);
+      NS_LOG_LOGIC (candidates.size () << " of " << m_phyList.size () << " PHYs within " << m_maxRange << " m");
+    }
+  else
+    {
+      candidates.resize (m_phyList.size ());
+      for (uint32_t i = 0; i < m_phyList.size (); i++)
+        {
+          candidates[i] = i;
+        }
+    }
+
+  PhyList receivers;
+  std::vector<Ptr<MobilityModel> > receiverMobilities;
+  receivers.reserve (candidates.size ());
+  receiverMobilities.reserve (candidates.size ());
+  for (std::vector<uint32_t>::const_iterator i = candidates.begin (); i != candidates.end (); i++)
+    {
+      Ptr<YansWifiPhy> receiver = m_phyList[*i];
+      //For now don't account for inter channel interference nor channel bonding
+      if (receiver != sender && receiver->GetChannelNumber () == sender->GetChannelNumber ())
         {
-          //For now don't account for inter channel interference nor channel bonding
-          if ((*i)->GetChannelNumber () != sender->GetChannelNumber ())
-            {
-              continue;
-            }
-
-          Ptr<MobilityModel> receiverMobility = (*i)->GetMobility ()->GetObject<MobilityModel> ();
-          Time delay = m_delay->GetDelay (senderMobility, receiverMobility);
-          double rxPowerDbm = m_loss->CalcRxPower (txPowerDbm, senderMobility, receiverMobility);
-          NS_LOG_DEBUG ("propagation: txPower=" << txPowerDbm << "dbm, rxPower=" << rxPowerDbm << "dbm, " <<
-                        "distance=" << senderMobility->GetDistanceFrom (receiverMobility) << "m, delay=" << delay);
-          Ptr<Packet> copy = packet->Copy ();
-          Ptr<NetDevice> dstNetDevice = (*i)->GetDevice ();
-          uint32_t dstNode;
-          if (dstNetDevice == 0)
-            {
-              dstNode = 0xffffffff;
-            }
-          else
-            {
-              dstNode = dstNetDevice->GetNode ()->GetId ();
-            }
-
-          Simulator::ScheduleWithContext (dstNode,
-                                          delay, &YansWifiChannel::Receive,
-                                          (*i), copy, rxPowerDbm, duration);
+          receivers.push_back (receiver);
+          receiverMobilities.push_back (receiver->GetMobility ()->GetObject<MobilityModel> ());
         }
     }
+
+  // The loss of all the receivers is computed in one pass
+  std::vector<double> rxPowersDbm;
+  m_loss->CalcRxPower (txPowerDbm, senderMobility, receiverMobilities, rxPowersDbm);
+  for (uint32_t i = 0; i < receivers.size (); i++)
+    {
+      SendTo (senderMobility, receivers[i], receiverMobilities[i], packet, rxPowersDbm[i], duration);
+    }
+}
+
+void
+YansWifiChannel::SendTo (Ptr<MobilityModel> senderMobility, Ptr<YansWifiPhy> receiver, Ptr<MobilityModel> receiverMobility,
+                         Ptr<const Packet> packet, double rxPowerDbm, Time duration) const
+{
+  Time delay = m_delay->GetDelay (senderMobility, receiverMobility);
+  NS_LOG_DEBUG ("propagation: rxPower=" << rxPowerDbm << "dbm, " <<
+                "distance=" << senderMobility->GetDistanceFrom (receiverMobility) << "m, delay=" << delay);
+  Ptr<Packet> copy = packet->Copy ();
+  Ptr<NetDevice> dstNetDevice = receiver->GetDevice ();
+  uint32_t dstNode;
+  if (dstNetDevice == 0)
+    {
+      dstNode = 0xffffffff;
+    }
+  else
+    {
+      dstNode = dstNetDevice->GetNode ()->GetId ();
+    }
+
+  Simulator::ScheduleWithContext (dstNode,
+                                  delay, &YansWifiChannel::Receive,
+                                  receiver, copy, rxPowerDbm, duration);
+}
+
+void
+YansWifiChannel::UpdateGrid (void) const
+{
+  if (!m_gridOutdated && m_grid.GetCellSize () == m_maxRange)
+    {
+      return;
+    }
+  NS_LOG_FUNCTION (this);
+  m_grid.Clear ();
+  m_grid.SetCellSize (m_maxRange);
+  for (uint32_t i = 0; i < m_phyList.size (); i++)
+    {
+      m_grid.Add (i, m_phyList[i]->GetMobility ());
+    }
+  m_gridOutdated = false;
 }
 
 void
@@ -137,6 +201,7 @@ void
 YansWifiChannel::Add (Ptr<YansWifiPhy> phy)
 {
   m_phyList.push_back (phy);
+  m_gridOutdated = true;
 }
 
 int64_t
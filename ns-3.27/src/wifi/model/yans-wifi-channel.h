@@ -22,6 +22,7 @@
 #define YANS_WIFI_CHANNEL_H
 
 #include "ns3/channel.h"
+#include "ns3/spatial-grid.h"
 #include "yans-wifi-phy.h"
 
 namespace ns3 {
@@ -38,6 +39,12 @@ class PropagationDelayModel;
  * class and supports an ns3::PropagationLossModel and an 
  * ns3::PropagationDelayModel.  By default, no propagation models are set; 
  * it is the caller's responsibility to set them before using the channel.
+ *
+ * When the MaxRange attribute is set, the PHYs are indexed by position
+ * in a SpatialGrid, and a packet is only delivered to the PHYs within
+ * that distance of the sender.  The MobilityModel of each PHY is read
+ * when the index is built, on the first packet sent after a PHY is
+ * added.
  */
 class YansWifiChannel : public Channel
 {
@@ -114,9 +121,31 @@ private:
    */
   static void Receive (Ptr<YansWifiPhy> receiver, Ptr<Packet> packet, double txPowerDbm, Time duration);
 
+  /**
+   * Compute the delay of a packet at a YansWifiPhy and schedule its
+   * reception.
+   *
+   * \param senderMobility the position of the sender
+   * \param receiver the phy object receiving the packet
+   * \param receiverMobility the position of the receiver
+   * \param packet the packet to send
+   * \param rxPowerDbm the rx power of the packet at the receiver, in dBm
+   * \param duration the transmission duration associated with the packet
+   */
+  void SendTo (Ptr<MobilityModel> senderMobility, Ptr<YansWifiPhy> receiver, Ptr<MobilityModel> receiverMobility,
+               Ptr<const Packet> packet, double rxPowerDbm, Time duration) const;
+
+  /**
+   * Index the PHYs of m_phyList in m_grid, if needed.
+   */
+  void UpdateGrid (void) const;
+
   PhyList m_phyList;                   //!< List of YansWifiPhys connected to this YansWifiChannel
   Ptr<PropagationLossModel> m_loss;    //!< Propagation loss model
   Ptr<PropagationDelayModel> m_delay;  //!< Propagation delay model
+  double m_maxRange;                   //!< Maximum distance of a receiver [m], or 0 for no limit
+  mutable SpatialGrid m_grid;          //!< Index of m_phyList by position, when m_maxRange is set
+  mutable bool m_gridOutdated;         //!< Whether m_grid must be rebuilt before its next use
 };
 
 } //namespace ns3
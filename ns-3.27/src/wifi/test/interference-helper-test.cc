@@ -0,0 +1,219 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/test.h"
+#include "ns3/simulator.h"
+#include "ns3/nist-error-rate-model.h"
+#include "ns3/interference-helper.h"
+#include "ns3/wifi-phy.h"
+
+using namespace ns3;
+
+/**
+ * \ingroup wifi-test
+ * \ingroup tests
+ *
+ * \brief Test the noise and interference tracked by the InterferenceHelper
+ *
+ * A signal is received while an older signal, many short interferers and
+ * a later signal overlap it.  The SNR, the PER of the payload and the
+ * energy durations are compared with the values computed from the
+ * powers of the overlapping signals.
+ */
+class InterferenceHelperTestCase : public TestCase
+{
+public:
+  InterferenceHelperTestCase ();
+  virtual ~InterferenceHelperTestCase ();
+
+private:
+  virtual void DoRun (void);
+
+  /**
+   * Add a signal
+   * \param powerW the power of the signal (w)
+   * \param duration the duration of the signal
+   * \param receive whether the reception of the signal starts
+   */
+  void AddSignal (double powerW, Time duration, bool receive);
+  /**
+   * Check the SNR of the PLCP header of the last signal added
+   * \param noiseInterferenceW the expected noise and interference, without the noise floor (w)
+   */
+  void CheckHeaderSnr (double noiseInterferenceW);
+  /**
+   * Check the energy duration from now
+   * \param energyW the energy threshold (w)
+   * \param expected the expected duration
+   */
+  void CheckEnergyDuration (double energyW, Time expected);
+  /// Check the SNR and the PER of the payload of the signal being received
+  void CheckPayloadSnrPer (void);
+  /**
+   * \param noiseInterferenceW the noise and interference, without the noise floor (w)
+   * \return the SNR of the signal being received
+   */
+  double GetSnr (double noiseInterferenceW) const;
+  /**
+   * \param noiseInterferenceW the noise and interference, without the noise floor (w)
+   * \param duration the duration of the chunk of payload
+   * \return the success rate of the chunk of payload of the signal being received
+   */
+  double GetChunkSuccessRate (double noiseInterferenceW, Time duration) const;
+
+  InterferenceHelper m_interference; ///< the interference helper
+  Ptr<ErrorRateModel> m_errorRateModel; ///< the error rate model
+  WifiTxVector m_txVector; ///< the TXVECTOR of the signals
+  Ptr<InterferenceHelper::Event> m_event; ///< the last signal added
+  Ptr<InterferenceHelper::Event> m_rxEvent; ///< the signal being received
+  double m_noiseFloorW; ///< the noise floor (w)
+};
+
+InterferenceHelperTestCase::InterferenceHelperTestCase ()
+  : TestCase ("Check the noise and interference of overlapping signals")
+{
+}
+
+InterferenceHelperTestCase::~InterferenceHelperTestCase ()
+{
+}
+
+void
+InterferenceHelperTestCase::AddSignal (double powerW, Time duration, bool receive)
+{
+  m_event = m_interference.Add (Create<Packet> (1000), m_txVector, duration, powerW);
+  if (receive)
+    {
+      m_rxEvent = m_event;
+      m_interference.NotifyRxStart ();
+    }
+}
+
+double
+InterferenceHelperTestCase::GetSnr (double noiseInterferenceW) const
+{
+  return m_rxEvent->GetRxPowerW () / (m_noiseFloorW + noiseInterferenceW);
+}
+
+double
+InterferenceHelperTestCase::GetChunkSuccessRate (double noiseInterferenceW, Time duration) const
+{
+  WifiMode mode = m_txVector.GetMode ();
+  uint64_t nbits = (uint64_t)(mode.GetPhyRate (m_txVector) * duration.GetSeconds ());
+  return m_errorRateModel->GetChunkSuccessRate (mode, m_txVector, GetSnr (noiseInterferenceW), (uint32_t)nbits);
+}
+
+void
+InterferenceHelperTestCase::CheckHeaderSnr (double noiseInterferenceW)
+{
+  double snr = m_interference.CalculatePlcpHeaderSnrPer (m_event).snr;
+  double expected = m_event->GetRxPowerW () / (m_noiseFloorW + noiseInterferenceW);
+  NS_TEST_EXPECT_MSG_EQ_TOL (snr, expected, expected * 1e-9, "Wrong SNR at " << Simulator::Now ().As (Time::US));
+}
+
+void
+InterferenceHelperTestCase::CheckEnergyDuration (double energyW, Time expected)
+{
+  Time duration = m_interference.GetEnergyDuration (energyW);
+  NS_TEST_EXPECT_MSG_EQ (duration, expected, "Wrong energy duration above " << energyW << " W at " << Simulator::Now ().As (Time::US));
+}
+
+void
+InterferenceHelperTestCase::CheckPayloadSnrPer (void)
+{
+  InterferenceHelper::SnrPer snrPer = m_interference.CalculatePlcpPayloadSnrPer (m_rxEvent);
+  m_interference.NotifyRxEnd ();
+
+  // The chunks of payload between the changes of interference, see DoRun
+  double psr = GetChunkSuccessRate (1e-10, MicroSeconds (80));
+  for (uint32_t i = 0; i < 500; i++)
+    {
+      psr *= GetChunkSuccessRate (1e-10 + 1e-11, MicroSeconds (1));
+    }
+  psr *= GetChunkSuccessRate (1e-10, MicroSeconds (100));
+  psr *= GetChunkSuccessRate (1e-10 + 3e-11, MicroSeconds (100));
+  psr *= GetChunkSuccessRate (1e-10, MicroSeconds (100));
+  psr *= GetChunkSuccessRate (0, MicroSeconds (100));
+  double expectedSnr = GetSnr (1e-10);
+  NS_TEST_EXPECT_MSG_EQ_TOL (snrPer.snr, expectedSnr, expectedSnr * 1e-9, "Wrong SNR of the payload");
+  NS_TEST_EXPECT_MSG_EQ_TOL (snrPer.per, 1 - psr, 1e-9, "Wrong PER of the payload");
+  NS_TEST_EXPECT_MSG_GT (snrPer.per, 0.01, "The interference should corrupt the payload");
+  NS_TEST_EXPECT_MSG_LT (snrPer.per, 0.99, "The interference should not always corrupt the payload");
+}
+
+void
+InterferenceHelperTestCase::DoRun (void)
+{
+  m_errorRateModel = CreateObject<NistErrorRateModel> ();
+  m_interference.SetErrorRateModel (m_errorRateModel);
+  m_interference.SetNoiseFigure (1.0);
+  m_noiseFloorW = 1.3803e-23 * 290.0 * 20 * 1000000;
+  m_txVector.SetMode (WifiPhy::GetOfdmRate54Mbps ());
+  m_txVector.SetPreambleType (WIFI_PREAMBLE_LONG);
+  m_txVector.SetChannelWidth (20);
+  m_txVector.SetNss (1);
+  m_txVector.SetNTx (1);
+  NS_TEST_ASSERT_MSG_EQ (WifiPhy::CalculatePlcpPreambleAndHeaderDuration (m_txVector), MicroSeconds (20), "Unexpected PLCP duration");
+
+  // A signal from 0 to 1000 us, and a signal received from 100 to 1100 us
+  Simulator::Schedule (MicroSeconds (0), &InterferenceHelperTestCase::AddSignal, this, 1e-10, MicroSeconds (1000), false);
+  Simulator::Schedule (MicroSeconds (100), &InterferenceHelperTestCase::AddSignal, this, 2e-8, MicroSeconds (1000), true);
+  Simulator::Schedule (MicroSeconds (100), &InterferenceHelperTestCase::CheckHeaderSnr, this, 1e-10);
+  Simulator::Schedule (MicroSeconds (150), &InterferenceHelperTestCase::CheckEnergyDuration, this, 1.5e-8, MicroSeconds (950));
+  Simulator::Schedule (MicroSeconds (150), &InterferenceHelperTestCase::CheckEnergyDuration, this, 2.005e-8, MicroSeconds (850));
+  // Back to back interferers from 200 to 700 us, each one ending at the
+  // same time as the next one starts
+  for (uint32_t i = 0; i < 500; i++)
+    {
+      Simulator::Schedule (MicroSeconds (200 + i), &InterferenceHelperTestCase::AddSignal, this, 1e-11, MicroSeconds (1), false);
+    }
+  Simulator::Schedule (MicroSeconds (450), &InterferenceHelperTestCase::CheckHeaderSnr, this, 1e-10 + 2e-8);
+  // A later signal from 800 to 900 us
+  Simulator::Schedule (MicroSeconds (800), &InterferenceHelperTestCase::AddSignal, this, 3e-11, MicroSeconds (100), false);
+  Simulator::Schedule (MicroSeconds (800), &InterferenceHelperTestCase::CheckHeaderSnr, this, 1e-10 + 2e-8);
+  Simulator::Schedule (MicroSeconds (1050), &InterferenceHelperTestCase::CheckEnergyDuration, this, 1.5e-8, MicroSeconds (50));
+  Simulator::Schedule (MicroSeconds (1100), &InterferenceHelperTestCase::CheckPayloadSnrPer, this);
+  // Once all the signals ended, a new signal only has the noise floor
+  Simulator::Schedule (MicroSeconds (2000), &InterferenceHelperTestCase::AddSignal, this, 1e-9, MicroSeconds (100), false);
+  Simulator::Schedule (MicroSeconds (2000), &InterferenceHelperTestCase::CheckHeaderSnr, this, 0);
+  Simulator::Schedule (MicroSeconds (2000), &InterferenceHelperTestCase::CheckEnergyDuration, this, 5e-10, MicroSeconds (100));
+  Simulator::Run ();
+  Simulator::Destroy ();
+
+  m_interference.EraseEvents ();
+  m_event = 0;
+  m_rxEvent = 0;
+}
+
+/**
+ * \ingroup wifi-test
+ * \ingroup tests
+ *
+ * \brief Interference Helper Test Suite
+ */
+class InterferenceHelperTestSuite : public TestSuite
+{
+public:
+  InterferenceHelperTestSuite ();
+};
+
+InterferenceHelperTestSuite::InterferenceHelperTestSuite ()
+  : TestSuite ("wifi-interference-helper", UNIT)
+{
+  AddTestCase (new InterferenceHelperTestCase, TestCase::QUICK);
+}
+
+static InterferenceHelperTestSuite interferenceHelperTestSuite; ///< the test suite
@@ -29,6 +29,8 @@
 #include "ns3/propagation-loss-model.h"
 #include "ns3/yans-error-rate-model.h"
 #include "ns3/constant-position-mobility-model.h"
+#include "ns3/constant-velocity-mobility-model.h"
+#include "ns3/double.h"
 #include "ns3/test.h"
 #include "ns3/pointer.h"
 #include "ns3/rng-seed-manager.h"
@@ -37,6 +39,8 @@
 #include "ns3/packet-socket-server.h"
 #include "ns3/packet-socket-client.h"
 #include "ns3/packet-socket-helper.h"
+#include <sstream>
+#include <cstdlib>
 
 using namespace ns3;
 
@@ -1154,6 +1158,142 @@ Bug2222TestCase::DoRun (void)
   NS_TEST_ASSERT_MSG_EQ (m_countInternalCollisions, 1, "unexpected number of internal collisions!");
 }
 
+//-----------------------------------------------------------------------------
+/**
+ * \ingroup wifi-test
+ * \ingroup tests
+ *
+ * \brief Make sure that the PHYs receiving broadcast frames do not change
+ * when the YansWifiChannel skips the receivers beyond MaxRange, with
+ * stationary nodes, nodes set a new position and a moving node.
+ */
+class YansWifiChannelMaxRangeTest : public TestCase
+{
+public:
+  YansWifiChannelMaxRangeTest ();
+
+  virtual void DoRun (void);
+
+
+private:
+  /**
+   * Broadcast frames from some of the nodes
+   * \param maxRange the MaxRange attribute of the channel
+   * \returns the number of frames received by each node
+   */
+  std::vector<uint32_t> Run (double maxRange);
+  /**
+   * Send one packet function
+   * \param dev the device
+   */
+  void SendOnePacket (Ptr<NetDevice> dev);
+  /**
+   * Notify the reception of a frame
+   * \param context the node index
+   * \param p the packet
+   */
+  void RxEnd (std::string context, Ptr<const Packet> p);
+
+  std::vector<uint32_t> m_received; ///< number of frames received by each node
+};
+
+YansWifiChannelMaxRangeTest::YansWifiChannelMaxRangeTest ()
+  : TestCase ("Skip the receivers beyond MaxRange")
+{
+}
+
+void
+YansWifiChannelMaxRangeTest::SendOnePacket (Ptr<NetDevice> dev)
+{
+  Ptr<Packet> p = Create<Packet> (100);
+  dev->Send (p, dev->GetBroadcast (), 1);
+}
+
+void
+YansWifiChannelMaxRangeTest::RxEnd (std::string context, Ptr<const Packet> p)
+{
+  m_received[std::atoi (context.c_str ())]++;
+}
+
+std::vector<uint32_t>
+YansWifiChannelMaxRangeTest::Run (double maxRange)
+{
+  NodeContainer nodes;
+  nodes.Create (30);
+  YansWifiChannelHelper channel = YansWifiChannelHelper::Default ();
+  YansWifiPhyHelper phy = YansWifiPhyHelper::Default ();
+  Ptr<YansWifiChannel> wifiChannel = channel.Create ();
+  wifiChannel->SetAttribute ("MaxRange", DoubleValue (maxRange));
+  phy.SetChannel (wifiChannel);
+  WifiHelper wifi;
+  wifi.SetStandard (WIFI_PHY_STANDARD_80211a);
+  wifi.SetRemoteStationManager ("ns3::ConstantRateWifiManager",
+                                "DataMode", StringValue ("OfdmRate6Mbps"),
+                                "ControlMode", StringValue ("OfdmRate6Mbps"));
+  WifiMacHelper mac;
+  mac.SetType ("ns3::AdhocWifiMac");
+  NetDeviceContainer devices = wifi.Install (phy, mac, nodes);
+  // The same reception errors in both runs
+  wifi.AssignStreams (devices, 100);
+
+  // A line of nodes 40 m apart, and a node moving along it
+  for (uint32_t i = 0; i < nodes.GetN () - 1; i++)
+    {
+      Ptr<ConstantPositionMobilityModel> mobility = CreateObject<ConstantPositionMobilityModel> ();
+      mobility->SetPosition (Vector (40.0 * i, 0, 0));
+      nodes.Get (i)->AggregateObject (mobility);
+    }
+  Ptr<ConstantVelocityMobilityModel> moving = CreateObject<ConstantVelocityMobilityModel> ();
+  moving->SetPosition (Vector (0, 10, 0));
+  moving->SetVelocity (Vector (100, 0, 0));
+  nodes.Get (nodes.GetN () - 1)->AggregateObject (moving);
+
+  m_received.assign (nodes.GetN (), 0);
+  for (uint32_t i = 0; i < nodes.GetN (); i++)
+    {
+      std::ostringstream context;
+      context << i;
+      Ptr<WifiPhy> wifiPhy = DynamicCast<WifiNetDevice> (devices.Get (i))->GetPhy ();
+      wifiPhy->TraceConnect ("PhyRxEnd", context.str (), MakeCallback (&YansWifiChannelMaxRangeTest::RxEnd, this));
+    }
+
+  // Node 29 moves along the line, from next to node 0 to past node 24
+  uint32_t senders[] = { 0, 10, 29, 17, 29 };
+  for (uint32_t i = 0; i < sizeof (senders) / sizeof (senders[0]); i++)
+    {
+      Simulator::Schedule (Seconds (1.0 + 2 * i), &YansWifiChannelMaxRangeTest::SendOnePacket, this, devices.Get (senders[i]));
+    }
+  // Move the node next to node 17 far from the others, and another one next to node 17
+  Simulator::Schedule (Seconds (6.0), &MobilityModel::SetPosition, nodes.Get (18)->GetObject<MobilityModel> (), Vector (1e4, 0, 0));
+  Simulator::Schedule (Seconds (6.0), &MobilityModel::SetPosition, nodes.Get (25)->GetObject<MobilityModel> (), Vector (690, 5, 0));
+
+  Simulator::Stop (Seconds (12.0));
+  Simulator::Run ();
+  Simulator::Destroy ();
+  return m_received;
+}
+
+void
+YansWifiChannelMaxRangeTest::DoRun (void)
+{
+  std::vector<uint32_t> expected = Run (0);
+  // 16.0206 dBm are received at -110 dBm, well below the energy
+  // detection threshold, at the range of the default loss model
+  double maxRange = CreateObject<LogDistancePropagationLossModel> ()->CalcRange (126.0206, 1e4);
+  NS_TEST_ASSERT_MSG_LT (maxRange, 1000, "Range too long for the test to be useful");
+  std::vector<uint32_t> received = Run (maxRange);
+
+  uint32_t nReceived = 0;
+  for (uint32_t i = 0; i < expected.size (); i++)
+    {
+      NS_TEST_ASSERT_MSG_EQ (received[i], expected[i], "Wrong number of frames received by node " << i);
+      nReceived += expected[i];
+    }
+  NS_TEST_ASSERT_MSG_GT (nReceived, 10, "Too few frames received for the test to be useful");
+  NS_TEST_ASSERT_MSG_EQ (expected[18], 0, "Frame received by node 18 once out of range");
+  NS_TEST_ASSERT_MSG_GT (expected[25], 0, "Frame not received by node 25 next to node 17");
+}
+
 /**
  * \ingroup wifi-test
  * \ingroup tests
@@ -1176,6 +1316,7 @@ WifiTestSuite::WifiTestSuite ()
   AddTestCase (new Bug730TestCase, TestCase::QUICK); //Bug 730
   AddTestCase (new SetChannelFrequencyTest, TestCase::QUICK);
   AddTestCase (new Bug2222TestCase, TestCase::QUICK); //Bug 2222
+  AddTestCase (new YansWifiChannelMaxRangeTest, TestCase::QUICK);
 }
 
 static WifiTestSuite g_wifiTestSuite; ///< the test suite
@@ -0,0 +1,186 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+// This program can be used to benchmark the time taken to hook up
+// traces through the Config paths, for growing numbers of nodes.
+// Sample usage:  ./waf --run 'bench-config --max-nodes=20000'
+
+#include "ns3/command-line.h"
+#include "ns3/system-wall-clock-ms.h"
+#include "ns3/config.h"
+#include "ns3/callback.h"
+#include "ns3/node.h"
+#include "ns3/node-list.h"
+#include "ns3/simple-net-device.h"
+#include "ns3/packet.h"
+#include <iostream>
+#include <iomanip>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+using namespace ns3;
+
+/// Number of trace sink invocations, to keep the sinks from being trivial
+static uint32_t g_events = 0;
+
+/**
+ * Trace sink for the queue trace sources.
+ *
+ * \param context The context of the trace source.
+ * \param p The packet.
+ */
+static void
+QueueSink (std::string context, Ptr<const Packet> p)
+{
+  g_events++;
+}
+
+/**
+ * Create nodes, each with two devices.
+ *
+ * \param n The number of nodes wanted in the NodeList.
+ */
+static void
+CreateNodes (uint32_t n)
+{
+  while (NodeList::GetNNodes () < n)
+    {
+      Ptr<Node> node = CreateObject<Node> ();
+      node->AddDevice (CreateObject<SimpleNetDevice> ());
+      node->AddDevice (CreateObject<SimpleNetDevice> ());
+    }
+}
+
+/**
+ * Connect a trace source of every device with one wildcard path.
+ */
+static void
+WildcardConnect (void)
+{
+  Config::Connect ("/NodeList/*/DeviceList/*/$ns3::SimpleNetDevice/TxQueue/Enqueue",
+                   MakeCallback (&QueueSink));
+}
+
+/**
+ * Connect a trace source of every device with one path per node,
+ * the way many helpers do.
+ */
+static void
+PerNodeConnect (void)
+{
+  for (uint32_t i = 0; i < NodeList::GetNNodes (); ++i)
+    {
+      std::ostringstream oss;
+      oss << "/NodeList/" << i << "/DeviceList/*/$ns3::SimpleNetDevice/TxQueue/Enqueue";
+      Config::Connect (oss.str (), MakeCallback (&QueueSink));
+    }
+}
+
+/**
+ * Connect three trace sources of every device, one path at a time.
+ */
+static void
+SeparateConnect (void)
+{
+  std::string root = "/NodeList/*/DeviceList/*/$ns3::SimpleNetDevice/TxQueue/";
+  Config::Connect (root + "Enqueue", MakeCallback (&QueueSink));
+  Config::Connect (root + "Dequeue", MakeCallback (&QueueSink));
+  Config::Connect (root + "Drop", MakeCallback (&QueueSink));
+}
+
+/**
+ * Connect three trace sources of every device at once.
+ */
+static void
+BulkConnect (void)
+{
+  std::string root = "/NodeList/*/DeviceList/*/$ns3::SimpleNetDevice/TxQueue/";
+  std::vector<std::pair<std::string, CallbackBase> > connections;
+  connections.push_back (std::make_pair (root + "Enqueue", MakeCallback (&QueueSink)));
+  connections.push_back (std::make_pair (root + "Dequeue", MakeCallback (&QueueSink)));
+  connections.push_back (std::make_pair (root + "Drop", MakeCallback (&QueueSink)));
+  Config::ConnectMany (connections);
+}
+
+/**
+ * Connect a trace source of every device with a compiled path.
+ */
+static void
+CompiledConnect (void)
+{
+  Config::CompiledPath path ("/NodeList/*/DeviceList/*/$ns3::SimpleNetDevice/TxQueue/Enqueue");
+  path.Connect (MakeCallback (&QueueSink));
+}
+
+/**
+ * Time one way of connecting the traces.
+ *
+ * \param f The function doing the connections.
+ * \returns The time taken, in milliseconds.
+ */
+static int64_t
+TimeConnections (void (*f)(void))
+{
+  SystemWallClockMs time;
+  time.Start ();
+  f ();
+  return time.End ();
+}
+
+int main (int argc, char *argv[])
+{
+  uint32_t minNodes = 1000;
+  uint32_t maxNodes = 8000;
+  bool perNode = true;
+
+  CommandLine cmd;
+  cmd.Usage ("Benchmark the Config trace connections");
+  cmd.AddValue ("min-nodes", "smallest number of nodes", minNodes);
+  cmd.AddValue ("max-nodes", "largest number of nodes, doubling from min-nodes", maxNodes);
+  cmd.AddValue ("per-node", "also time one Config::Connect per node", perNode);
+  cmd.Parse (argc, argv);
+
+  std::cout << "times in ms" << std::endl;
+  std::cout << std::setw (8) << "nodes"
+            << std::setw (12) << "wildcard"
+            << std::setw (12) << "per-node"
+            << std::setw (12) << "compiled"
+            << std::setw (12) << "3 separate"
+            << std::setw (12) << "3 bulk"
+            << std::endl;
+  for (uint32_t n = minNodes; n <= maxNodes; n *= 2)
+    {
+      CreateNodes (n);
+      std::cout << std::setw (8) << n
+                << std::setw (12) << TimeConnections (&WildcardConnect);
+      if (perNode)
+        {
+          std::cout << std::setw (12) << TimeConnections (&PerNodeConnect);
+        }
+      else
+        {
+          std::cout << std::setw (12) << "-";
+        }
+      std::cout << std::setw (12) << TimeConnections (&CompiledConnect)
+                << std::setw (12) << TimeConnections (&SeparateConnect)
+                << std::setw (12) << TimeConnections (&BulkConnect)
+                << std::endl;
+    }
+
+  return 0;
+}
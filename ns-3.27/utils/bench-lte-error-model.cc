@@ -0,0 +1,115 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+// This program can be used to benchmark the LTE MI error model: the
+// decoding statistics of transport blocks are evaluated for random
+// SINRs, MCSs and sizes, on a given number of RBs, with and without HARQ
+// history.
+// Sample usage:  ./waf --run 'bench-lte-error-model --tbs=1000000'
+
+#include "ns3/command-line.h"
+#include "ns3/system-wall-clock-ms.h"
+#include "ns3/random-variable-stream.h"
+#include "ns3/lte-mi-error-model.h"
+#include <iostream>
+#include <cmath>
+
+using namespace ns3;
+
+/**
+ * Evaluate transport blocks and print the time.
+ *
+ * \param nRbs The number of RBs of the bandwidth.
+ * \param nTbs The number of transport blocks.
+ * \param harq Whether the transport blocks are retransmissions.
+ */
+static void
+RunTbs (uint32_t nRbs, uint32_t nTbs, bool harq)
+{
+  std::vector<double> frequencies;
+  for (uint32_t i = 0; i < nRbs; i++)
+    {
+      frequencies.push_back (2.1e9 + i * 180000);
+    }
+  Ptr<SpectrumModel> model = Create<SpectrumModel> (frequencies);
+  Ptr<UniformRandomVariable> random = CreateObject<UniformRandomVariable> ();
+  random->SetStream (0);
+
+  // A few SINR profiles, each with a TB on every other RB
+  const uint32_t nProfiles = 64;
+  std::vector<SpectrumValue> sinrs;
+  std::vector<uint8_t> mcss;
+  std::vector<uint16_t> sizes;
+  for (uint32_t p = 0; p < nProfiles; p++)
+    {
+      SpectrumValue sinr (model);
+      double meanDb = random->GetValue (-5, 25);
+      for (uint32_t i = 0; i < nRbs; i++)
+        {
+          sinr[i] = std::pow (10, (meanDb + random->GetValue (-3, 3)) / 10);
+        }
+      sinrs.push_back (sinr);
+      mcss.push_back (random->GetInteger (0, 28));
+      sizes.push_back (random->GetInteger (20, 1500));
+    }
+  std::vector<int> map;
+  for (uint32_t i = 0; i < nRbs; i += 2)
+    {
+      map.push_back (i);
+    }
+
+  SystemWallClockMs time;
+  time.Start ();
+  double tbler = 0;
+  for (uint32_t i = 0; i < nTbs; i++)
+    {
+      uint32_t p = i % nProfiles;
+      HarqProcessInfoList_t history;
+      if (harq)
+        {
+          HarqProcessInfoElement_t element;
+          element.m_mi = 0.3;
+          element.m_rv = 1;
+          element.m_infoBits = sizes[p] * 8;
+          element.m_codeBits = sizes[p] * 8 * 2;
+          history.push_back (element);
+        }
+      tbler += LteMiErrorModel::GetTbDecodificationStats (sinrs[p], map, sizes[p], mcss[p], history).tbler;
+    }
+  int64_t ms = time.End ();
+
+  std::cout << nRbs << " RBs" << (harq ? " with HARQ" : "") << ": " << nTbs << " TBs in " << ms << " ms, "
+            << (ms * 1e6 / nTbs) << " ns per TB (mean TBLER " << tbler / nTbs << ")" << std::endl;
+}
+
+int main (int argc, char *argv[])
+{
+  uint32_t nTbs = 5000000;
+
+  CommandLine cmd;
+  cmd.Usage ("Benchmark the LTE MI error model");
+  cmd.AddValue ("tbs", "number of transport blocks per run", nTbs);
+  cmd.Parse (argc, argv);
+
+  std::cout << "Running bench-lte-error-model with " << nTbs << " TBs" << std::endl;
+  uint32_t rbs[] = { 6, 25, 50, 100 };
+  for (uint32_t i = 0; i < 4; i++)
+    {
+      RunTbs (rbs[i], nTbs, false);
+      RunTbs (rbs[i], nTbs, true);
+    }
+  return 0;
+}
@@ -0,0 +1,526 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+// This program can be used to benchmark the LTE FF MAC schedulers: each
+// scheduler is driven directly through its SAPs, without PHY, channel
+// or RLC, by a cell of UEs sending random DL buffer status, subband
+// CQIs, BSRs, PUSCH CQIs and HARQ feedback, with the timing of
+// LteEnbMac.  The time spent per TTI is printed along with a digest of
+// the allocation decisions, which does not change as long as the
+// scheduler takes the same decisions.
+// Sample usage:  ./waf --run 'bench-lte-scheduler --schedulers=Pf,Pss --ues=100,500'
+
+#include "ns3/command-line.h"
+#include "ns3/object-factory.h"
+#include "ns3/simulator.h"
+#include "ns3/system-wall-clock-ms.h"
+#include "ns3/random-variable-stream.h"
+#include "ns3/ff-mac-scheduler.h"
+#include "ns3/ff-mac-csched-sap.h"
+#include "ns3/ff-mac-sched-sap.h"
+#include "ns3/lte-fr-no-op-algorithm.h"
+#include "ns3/lte-common.h"
+#include <iostream>
+#include <iomanip>
+#include <sstream>
+#include <deque>
+
+using namespace ns3;
+
+/// The delay in TTIs between the scheduling of a subframe and its transmission
+static const uint32_t g_macChTtiDelay = 2;
+/// The delay in TTIs between a DL transmission and its HARQ feedback
+static const uint32_t g_dlHarqDelay = 4;
+
+/**
+ * The MAC side of the scheduler SAPs, generating the requests of a
+ * cell and keeping a digest of the decisions of the scheduler.
+ */
+class BenchMac : public FfMacSchedSapUser, public FfMacCschedSapUser
+{
+public:
+  /**
+   * \param scheduler The scheduler to drive.
+   * \param nUes The number of UEs of the cell.
+   * \param bandwidth The DL and UL bandwidth in RBs.
+   * \param nTtis The number of TTIs to run.
+   */
+  BenchMac (Ptr<FfMacScheduler> scheduler, uint32_t nUes, uint8_t bandwidth, uint32_t nTtis);
+
+  /// Configure the cell and the UEs, and start the TTIs
+  void Start (void);
+
+  /// \return the digest of the decisions of the scheduler
+  uint64_t GetDigest (void) const;
+  /// \return the number of RBGs allocated in DL
+  uint64_t GetDlRbgs (void) const;
+  /// \return the number of RBs allocated in UL
+  uint64_t GetUlRbs (void) const;
+
+  // inherited from FfMacSchedSapUser
+  virtual void SchedDlConfigInd (const struct SchedDlConfigIndParameters& params);
+  virtual void SchedUlConfigInd (const struct SchedUlConfigIndParameters& params);
+
+  // inherited from FfMacCschedSapUser
+  virtual void CschedCellConfigCnf (const struct CschedCellConfigCnfParameters& params);
+  virtual void CschedUeConfigCnf (const struct CschedUeConfigCnfParameters& params);
+  virtual void CschedLcConfigCnf (const struct CschedLcConfigCnfParameters& params);
+  virtual void CschedLcReleaseCnf (const struct CschedLcReleaseCnfParameters& params);
+  virtual void CschedUeReleaseCnf (const struct CschedUeReleaseCnfParameters& params);
+  virtual void CschedUeConfigUpdateInd (const struct CschedUeConfigUpdateIndParameters& params);
+  virtual void CschedCellConfigUpdateInd (const struct CschedCellConfigUpdateIndParameters& params);
+
+private:
+  /// Run a TTI and schedule the next one
+  void Tti (void);
+  /**
+   * \param tti The TTI.
+   * \return the SFN/SF of the TTI
+   */
+  static uint16_t GetSfnSf (uint32_t tti);
+  /**
+   * Add a value to the digest.
+   * \param value The value.
+   */
+  void Digest (uint64_t value);
+
+  Ptr<FfMacScheduler> m_scheduler; ///< the scheduler
+  Ptr<LteFfrAlgorithm> m_ffrAlgorithm; ///< the FFR algorithm of the scheduler
+  FfMacSchedSapProvider *m_schedSapProvider; ///< the scheduler SAP
+  FfMacCschedSapProvider *m_cschedSapProvider; ///< the scheduler configuration SAP
+  Ptr<UniformRandomVariable> m_random; ///< the random variable of the requests
+  uint32_t m_nUes; ///< the number of UEs
+  uint8_t m_bandwidth; ///< the bandwidth in RBs
+  uint32_t m_rbgNum; ///< the number of RBGs
+  uint32_t m_nTtis; ///< the number of TTIs to run
+  uint32_t m_tti; ///< the current TTI
+  std::vector<uint8_t> m_meanCqi; ///< the mean CQI of each UE
+  /// the HARQ feedback to report, per TTI
+  std::deque<std::vector<DlInfoListElement_s> > m_dlInfo;
+  /// the UL receptions to report, per TTI
+  std::deque<std::vector<UlInfoListElement_s> > m_ulInfo;
+  /// the SFN/SF of the PUSCH CQIs to report, per TTI
+  std::deque<int32_t> m_ulCqiSfnSf;
+  uint64_t m_digest; ///< the digest of the decisions
+  uint64_t m_dlRbgs; ///< the number of RBGs allocated in DL
+  uint64_t m_ulRbs; ///< the number of RBs allocated in UL
+};
+
+BenchMac::BenchMac (Ptr<FfMacScheduler> scheduler, uint32_t nUes, uint8_t bandwidth, uint32_t nTtis)
+  : m_scheduler (scheduler),
+    m_nUes (nUes),
+    m_bandwidth (bandwidth),
+    m_nTtis (nTtis),
+    m_tti (0),
+    m_digest (14695981039346656037ULL),
+    m_dlRbgs (0),
+    m_ulRbs (0)
+{
+  m_ffrAlgorithm = CreateObject<LteFrNoOpAlgorithm> ();
+  m_ffrAlgorithm->SetDlBandwidth (bandwidth);
+  m_ffrAlgorithm->SetUlBandwidth (bandwidth);
+  m_scheduler->SetFfMacSchedSapUser (this);
+  m_scheduler->SetFfMacCschedSapUser (this);
+  m_scheduler->SetLteFfrSapProvider (m_ffrAlgorithm->GetLteFfrSapProvider ());
+  m_ffrAlgorithm->SetLteFfrSapUser (m_scheduler->GetLteFfrSapUser ());
+  m_schedSapProvider = m_scheduler->GetFfMacSchedSapProvider ();
+  m_cschedSapProvider = m_scheduler->GetFfMacCschedSapProvider ();
+  m_random = CreateObject<UniformRandomVariable> ();
+  m_random->SetStream (1);
+  uint32_t rbgSize = bandwidth < 11 ? 1 : (bandwidth < 27 ? 2 : (bandwidth < 64 ? 3 : 4));
+  m_rbgNum = bandwidth / rbgSize;
+  for (uint32_t i = 0; i < g_dlHarqDelay + 1; i++)
+    {
+      m_dlInfo.push_back (std::vector<DlInfoListElement_s> ());
+    }
+  for (uint32_t i = 0; i < g_macChTtiDelay + UL_PUSCH_TTIS_DELAY + 2; i++)
+    {
+      m_ulInfo.push_back (std::vector<UlInfoListElement_s> ());
+      m_ulCqiSfnSf.push_back (-1);
+    }
+}
+
+uint16_t
+BenchMac::GetSfnSf (uint32_t tti)
+{
+  return ((0x3FF & (1 + tti / 10)) << 4) | (0xF & (1 + tti % 10));
+}
+
+void
+BenchMac::Digest (uint64_t value)
+{
+  // FNV-1a
+  for (uint32_t i = 0; i < 8; i++)
+    {
+      m_digest ^= (value >> (8 * i)) & 0xFF;
+      m_digest *= 1099511628211ULL;
+    }
+}
+
+uint64_t
+BenchMac::GetDigest (void) const
+{
+  return m_digest;
+}
+
+uint64_t
+BenchMac::GetDlRbgs (void) const
+{
+  return m_dlRbgs;
+}
+
+uint64_t
+BenchMac::GetUlRbs (void) const
+{
+  return m_ulRbs;
+}
+
+void
+BenchMac::Start (void)
+{
+  m_scheduler->Initialize ();
+  m_ffrAlgorithm->Initialize ();
+
+  FfMacCschedSapProvider::CschedCellConfigReqParameters cellConfig;
+  cellConfig.m_ulBandwidth = m_bandwidth;
+  cellConfig.m_dlBandwidth = m_bandwidth;
+  m_cschedSapProvider->CschedCellConfigReq (cellConfig);
+
+  for (uint32_t i = 0; i < m_nUes; i++)
+    {
+      uint16_t rnti = i + 1;
+      m_meanCqi.push_back (m_random->GetInteger (2, 14));
+
+      FfMacCschedSapProvider::CschedUeConfigReqParameters ueConfig;
+      ueConfig.m_rnti = rnti;
+      ueConfig.m_transmissionMode = 0;
+      m_cschedSapProvider->CschedUeConfigReq (ueConfig);
+
+      // a default bearer for every UE, and a GBR bearer for every fourth UE
+      FfMacCschedSapProvider::CschedLcConfigReqParameters lcConfig;
+      lcConfig.m_rnti = rnti;
+      lcConfig.m_reconfigureFlag = false;
+      LogicalChannelConfigListElement_s lc;
+      lc.m_logicalChannelIdentity = 3;
+      lc.m_logicalChannelGroup = 3;
+      lc.m_direction = LogicalChannelConfigListElement_s::DIR_BOTH;
+      lc.m_qosBearerType = LogicalChannelConfigListElement_s::QBT_NON_GBR;
+      lc.m_qci = 9;
+      lc.m_eRabMaximulBitrateUl = 0;
+      lc.m_eRabMaximulBitrateDl = 0;
+      lc.m_eRabGuaranteedBitrateUl = 0;
+      lc.m_eRabGuaranteedBitrateDl = 0;
+      lcConfig.m_logicalChannelConfigList.push_back (lc);
+      if (i % 4 == 0)
+        {
+          lc.m_logicalChannelIdentity = 4;
+          lc.m_logicalChannelGroup = 1;
+          lc.m_qosBearerType = LogicalChannelConfigListElement_s::QBT_GBR;
+          lc.m_qci = 1;
+          lc.m_eRabMaximulBitrateUl = 64000;
+          lc.m_eRabMaximulBitrateDl = 64000;
+          lc.m_eRabGuaranteedBitrateUl = 64000;
+          lc.m_eRabGuaranteedBitrateDl = 64000;
+          lcConfig.m_logicalChannelConfigList.push_back (lc);
+        }
+      m_cschedSapProvider->CschedLcConfigReq (lcConfig);
+    }
+
+  Simulator::ScheduleNow (&BenchMac::Tti, this);
+}
+
+void
+BenchMac::Tti (void)
+{
+  // DL buffer status of a tenth of the UEs, some of them idle
+  uint32_t nReports = std::max (1u, m_nUes / 10);
+  for (uint32_t j = 0; j < nReports; j++)
+    {
+      uint16_t rnti = 1 + (m_tti * nReports + j) % m_nUes;
+      FfMacSchedSapProvider::SchedDlRlcBufferReqParameters req;
+      req.m_rnti = rnti;
+      req.m_logicalChannelIdentity = 3;
+      req.m_rlcTransmissionQueueSize = m_random->GetValue () < 0.3 ? 0 : m_random->GetInteger (100, 20000);
+      req.m_rlcTransmissionQueueHolDelay = m_random->GetInteger (0, 100);
+      req.m_rlcRetransmissionQueueSize = 0;
+      req.m_rlcRetransmissionHolDelay = 0;
+      req.m_rlcStatusPduSize = 0;
+      m_schedSapProvider->SchedDlRlcBufferReq (req);
+      if ((rnti - 1) % 4 == 0)
+        {
+          req.m_logicalChannelIdentity = 4;
+          req.m_rlcTransmissionQueueSize = m_random->GetInteger (0, 400);
+          req.m_rlcTransmissionQueueHolDelay = m_random->GetInteger (0, 40);
+          m_schedSapProvider->SchedDlRlcBufferReq (req);
+        }
+    }
+
+  // subband CQIs of a fifth of the UEs
+  FfMacSchedSapProvider::SchedDlCqiInfoReqParameters cqiInfo;
+  cqiInfo.m_sfnSf = GetSfnSf (m_tti);
+  for (uint16_t rnti = 1 + m_tti % 5; rnti <= m_nUes; rnti += 5)
+    {
+      CqiListElement_s cqi;
+      cqi.m_rnti = rnti;
+      cqi.m_ri = 1;
+      cqi.m_cqiType = CqiListElement_s::A30;
+      cqi.m_wbPmi = 0;
+      for (uint32_t k = 0; k < m_rbgNum; k++)
+        {
+          HigherLayerSelected_s sb;
+          sb.m_sbPmi = 0;
+          int value = m_meanCqi[rnti - 1] + m_random->GetInteger (0, 4) - 2;
+          sb.m_sbCqi.push_back (std::min (15, std::max (0, value)));
+          cqi.m_sbMeasResult.m_higherLayerSelected.push_back (sb);
+        }
+      cqiInfo.m_cqiList.push_back (cqi);
+    }
+  m_schedSapProvider->SchedDlCqiInfoReq (cqiInfo);
+
+  // DL trigger, with the HARQ feedback of the TBs of g_dlHarqDelay TTIs ago
+  FfMacSchedSapProvider::SchedDlTriggerReqParameters dlTrigger;
+  dlTrigger.m_sfnSf = GetSfnSf (m_tti + g_macChTtiDelay);
+  dlTrigger.m_dlInfoList.swap (m_dlInfo.front ());
+  m_dlInfo.pop_front ();
+  m_dlInfo.push_back (std::vector<DlInfoListElement_s> ());
+  m_schedSapProvider->SchedDlTriggerReq (dlTrigger);
+
+  // PUSCH CQIs of the subframe received in the previous TTI
+  int32_t ulCqiSfnSf = m_ulCqiSfnSf.front ();
+  m_ulCqiSfnSf.pop_front ();
+  m_ulCqiSfnSf.push_back (-1);
+  if (ulCqiSfnSf >= 0)
+    {
+      FfMacSchedSapProvider::SchedUlCqiInfoReqParameters ulCqi;
+      ulCqi.m_sfnSf = ulCqiSfnSf;
+      ulCqi.m_ulCqi.m_type = UlCqi_s::PUSCH;
+      for (uint32_t i = 0; i < m_bandwidth; i++)
+        {
+          ulCqi.m_ulCqi.m_sinr.push_back (LteFfConverter::double2fpS11dot3 (m_random->GetValue (-5, 25)));
+        }
+      m_schedSapProvider->SchedUlCqiInfoReq (ulCqi);
+    }
+
+  // BSRs of a tenth of the UEs
+  FfMacSchedSapProvider::SchedUlMacCtrlInfoReqParameters ulMacCtrl;
+  ulMacCtrl.m_sfnSf = GetSfnSf (m_tti);
+  for (uint32_t j = 0; j < nReports; j++)
+    {
+      MacCeListElement_s bsr;
+      bsr.m_rnti = 1 + (m_tti * nReports + j + m_nUes / 2) % m_nUes;
+      bsr.m_macCeType = MacCeListElement_s::BSR;
+      for (uint8_t lcg = 0; lcg < 4; lcg++)
+        {
+          bsr.m_macCeValue.m_bufferStatus.push_back (lcg == 3 ? m_random->GetInteger (0, 40) : 0);
+        }
+      ulMacCtrl.m_macCeList.push_back (bsr);
+    }
+  m_schedSapProvider->SchedUlMacCtrlInfoReq (ulMacCtrl);
+
+  // UL trigger, with the receptions of the subframe received in the previous TTI
+  FfMacSchedSapProvider::SchedUlTriggerReqParameters ulTrigger;
+  ulTrigger.m_sfnSf = GetSfnSf (m_tti + g_macChTtiDelay + UL_PUSCH_TTIS_DELAY);
+  ulTrigger.m_ulInfoList.swap (m_ulInfo.front ());
+  m_ulInfo.pop_front ();
+  m_ulInfo.push_back (std::vector<UlInfoListElement_s> ());
+  m_schedSapProvider->SchedUlTriggerReq (ulTrigger);
+  m_ulCqiSfnSf.back () = ulTrigger.m_sfnSf;
+
+  if (++m_tti < m_nTtis)
+    {
+      Simulator::Schedule (MilliSeconds (1), &BenchMac::Tti, this);
+    }
+}
+
+void
+BenchMac::SchedDlConfigInd (const struct SchedDlConfigIndParameters& params)
+{
+  Digest (m_tti);
+  for (std::vector<BuildDataListElement_s>::const_iterator it = params.m_buildDataList.begin ();
+       it != params.m_buildDataList.end (); ++it)
+    {
+      const DlDciListElement_s &dci = it->m_dci;
+      Digest (dci.m_rnti);
+      Digest (dci.m_rbBitmap);
+      Digest (dci.m_harqProcess);
+      for (uint32_t j = 0; j < dci.m_tbsSize.size (); j++)
+        {
+          Digest (dci.m_mcs[j]);
+          Digest (dci.m_tbsSize[j]);
+          Digest (dci.m_ndi[j]);
+          Digest (dci.m_rv[j]);
+        }
+      for (uint32_t k = 0; k < it->m_rlcPduList.size (); k++)
+        {
+          for (uint32_t j = 0; j < it->m_rlcPduList[k].size (); j++)
+            {
+              Digest (it->m_rlcPduList[k][j].m_logicalChannelIdentity);
+              Digest (it->m_rlcPduList[k][j].m_size);
+            }
+        }
+      for (uint32_t mask = dci.m_rbBitmap; mask != 0; mask &= mask - 1)
+        {
+          m_dlRbgs++;
+        }
+
+      DlInfoListElement_s info;
+      info.m_rnti = dci.m_rnti;
+      info.m_harqProcessId = dci.m_harqProcess;
+      for (uint32_t j = 0; j < dci.m_ndi.size (); j++)
+        {
+          info.m_harqStatus.push_back (m_random->GetValue () < 0.1 ? DlInfoListElement_s::NACK : DlInfoListElement_s::ACK);
+        }
+      m_dlInfo.back ().push_back (info);
+    }
+  for (std::vector<BuildRarListElement_s>::const_iterator it = params.m_buildRarList.begin ();
+       it != params.m_buildRarList.end (); ++it)
+    {
+      Digest (it->m_rnti);
+    }
+}
+
+void
+BenchMac::SchedUlConfigInd (const struct SchedUlConfigIndParameters& params)
+{
+  Digest (m_tti);
+  for (std::vector<UlDciListElement_s>::const_iterator it = params.m_dciList.begin ();
+       it != params.m_dciList.end (); ++it)
+    {
+      Digest (it->m_rnti);
+      Digest (it->m_rbStart);
+      Digest (it->m_rbLen);
+      Digest (it->m_mcs);
+      Digest (it->m_tbSize);
+      Digest (it->m_ndi);
+      m_ulRbs += it->m_rbLen;
+
+      UlInfoListElement_s info;
+      info.m_rnti = it->m_rnti;
+      info.m_receptionStatus = m_random->GetValue () < 0.1 ? UlInfoListElement_s::NotOk : UlInfoListElement_s::Ok;
+      info.m_tpc = 0;
+      m_ulInfo.back ().push_back (info);
+    }
+}
+
+void
+BenchMac::CschedCellConfigCnf (const struct CschedCellConfigCnfParameters& params)
+{
+}
+
+void
+BenchMac::CschedUeConfigCnf (const struct CschedUeConfigCnfParameters& params)
+{
+}
+
+void
+BenchMac::CschedLcConfigCnf (const struct CschedLcConfigCnfParameters& params)
+{
+}
+
+void
+BenchMac::CschedLcReleaseCnf (const struct CschedLcReleaseCnfParameters& params)
+{
+}
+
+void
+BenchMac::CschedUeReleaseCnf (const struct CschedUeReleaseCnfParameters& params)
+{
+}
+
+void
+BenchMac::CschedUeConfigUpdateInd (const struct CschedUeConfigUpdateIndParameters& params)
+{
+}
+
+void
+BenchMac::CschedCellConfigUpdateInd (const struct CschedCellConfigUpdateIndParameters& params)
+{
+}
+
+/**
+ * Run a scheduler on a cell and print the time.
+ *
+ * \param name The name of the scheduler, without the FfMacScheduler suffix.
+ * \param nUes The number of UEs.
+ * \param bandwidth The bandwidth in RBs.
+ * \param nTtis The number of TTIs.
+ */
+static void
+RunScheduler (std::string name, uint32_t nUes, uint8_t bandwidth, uint32_t nTtis)
+{
+  ObjectFactory factory;
+  factory.SetTypeId ("ns3::" + name + "FfMacScheduler");
+  Ptr<FfMacScheduler> scheduler = factory.Create<FfMacScheduler> ();
+  BenchMac mac (scheduler, nUes, bandwidth, nTtis);
+
+  SystemWallClockMs time;
+  time.Start ();
+  mac.Start ();
+  Simulator::Run ();
+  int64_t ms = time.End ();
+  Simulator::Destroy ();
+  scheduler->Dispose ();
+
+  std::cout << std::setw (8) << name << " " << std::setw (5) << nUes << " UEs: "
+            << ms << " ms, " << (ms * 1e3 / nTtis) << " us per TTI, "
+            << mac.GetDlRbgs () << " DL RBGs, " << mac.GetUlRbs () << " UL RBs"
+            << " (digest " << std::hex << mac.GetDigest () << std::dec << ")" << std::endl;
+}
+
+/**
+ * \param list A comma separated list.
+ * \return the items of the list
+ */
+static std::vector<std::string>
+Split (std::string list)
+{
+  std::vector<std::string> items;
+  std::istringstream is (list);
+  std::string item;
+  while (std::getline (is, item, ','))
+    {
+      items.push_back (item);
+    }
+  return items;
+}
+
+int main (int argc, char *argv[])
+{
+  std::string schedulers = "Pf,Pss,Cqa,Rr,FdMt,TdMt,Tta,FdBet,TdBet,FdTbfq,TdTbfq";
+  std::string ues = "10,100,500";
+  uint32_t bandwidth = 25;
+  uint32_t nTtis = 1000;
+
+  CommandLine cmd;
+  cmd.Usage ("Benchmark the LTE FF MAC schedulers");
+  cmd.AddValue ("schedulers", "comma separated list of schedulers, e.g. Pf for PfFfMacScheduler", schedulers);
+  cmd.AddValue ("ues", "comma separated list of numbers of UEs", ues);
+  cmd.AddValue ("bandwidth", "DL and UL bandwidth in RBs", bandwidth);
+  cmd.AddValue ("ttis", "number of TTIs per run", nTtis);
+  cmd.Parse (argc, argv);
+
+  std::cout << "Running bench-lte-scheduler with " << nTtis << " TTIs on " << bandwidth << " RBs" << std::endl;
+  std::vector<std::string> names = Split (schedulers);
+  std::vector<std::string> counts = Split (ues);
+  for (uint32_t i = 0; i < names.size (); i++)
+    {
+      for (uint32_t j = 0; j < counts.size (); j++)
+        {
+          RunScheduler (names[i], std::atoi (counts[j].c_str ()), bandwidth, nTtis);
+        }
+    }
+  return 0;
+}
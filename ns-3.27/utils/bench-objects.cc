@@ -0,0 +1,140 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+// This program can be used to benchmark the construction of objects
+// through their attributes, by installing a Wi-Fi stack on many nodes,
+// and then the lookups of their aggregates, alone and while broadcasting
+// over the Wi-Fi channel.
+// Sample usage:  ./waf --run 'bench-objects --nodes=10000'
+
+#include "ns3/command-line.h"
+#include "ns3/system-wall-clock-ms.h"
+#include "ns3/config.h"
+#include "ns3/double.h"
+#include "ns3/string.h"
+#include "ns3/uinteger.h"
+#include "ns3/node-container.h"
+#include "ns3/net-device-container.h"
+#include "ns3/wifi-helper.h"
+#include "ns3/yans-wifi-helper.h"
+#include "ns3/wifi-mac-helper.h"
+#include "ns3/ssid.h"
+#include "ns3/mobility-helper.h"
+#include "ns3/mobility-model.h"
+#include "ns3/propagation-loss-model.h"
+#include "ns3/packet.h"
+#include "ns3/simulator.h"
+#include <iostream>
+
+using namespace ns3;
+
+/**
+ * Broadcast a packet from a device.
+ *
+ * \param device The sending device.
+ */
+static void
+Broadcast (Ptr<NetDevice> device)
+{
+  device->Send (Create<Packet> (1000), device->GetBroadcast (), 0x0800);
+}
+
+int main (int argc, char *argv[])
+{
+  uint32_t nNodes = 10000;
+  uint32_t nLookups = 100;
+  uint32_t nPackets = 20;
+
+  CommandLine cmd;
+  cmd.Usage ("Benchmark the construction of objects by the Wi-Fi helpers");
+  cmd.AddValue ("nodes", "number of nodes", nNodes);
+  cmd.AddValue ("lookups", "number of GetObject rounds over all the nodes", nLookups);
+  cmd.AddValue ("packets", "number of packets broadcast to all the nodes", nPackets);
+  cmd.Parse (argc, argv);
+
+  SystemWallClockMs time;
+
+  time.Start ();
+  NodeContainer nodes;
+  nodes.Create (nNodes);
+  int64_t nodesMs = time.End ();
+
+  YansWifiChannelHelper channel = YansWifiChannelHelper::Default ();
+  YansWifiPhyHelper phy = YansWifiPhyHelper::Default ();
+  phy.SetChannel (channel.Create ());
+  WifiHelper wifi;
+  wifi.SetStandard (WIFI_PHY_STANDARD_80211a);
+  wifi.SetRemoteStationManager ("ns3::ConstantRateWifiManager",
+                                "DataMode", StringValue ("OfdmRate6Mbps"),
+                                "ControlMode", StringValue ("OfdmRate6Mbps"));
+  WifiMacHelper mac;
+  mac.SetType ("ns3::AdhocWifiMac", "Ssid", SsidValue (Ssid ("bench")));
+
+  time.Start ();
+  NetDeviceContainer devices = wifi.Install (phy, mac, nodes);
+  int64_t installMs = time.End ();
+
+  time.Start ();
+  Config::Set ("/NodeList/*/DeviceList/*/$ns3::WifiNetDevice/Phy/$ns3::YansWifiPhy/TxPowerStart",
+               DoubleValue (10.0));
+  Config::Set ("/NodeList/*/DeviceList/*/$ns3::WifiNetDevice/Phy/$ns3::YansWifiPhy/TxPowerEnd",
+               DoubleValue (10.0));
+  int64_t setMs = time.End ();
+
+  MobilityHelper mobility;
+  mobility.SetPositionAllocator ("ns3::GridPositionAllocator",
+                                 "DeltaX", DoubleValue (10.0),
+                                 "DeltaY", DoubleValue (10.0),
+                                 "GridWidth", UintegerValue (100));
+  mobility.Install (nodes);
+
+  // Look up an aggregate which is present and one which is not
+  uint32_t found = 0;
+  time.Start ();
+  for (uint32_t j = 0; j < nLookups; j++)
+    {
+      for (NodeContainer::Iterator i = nodes.Begin (); i != nodes.End (); ++i)
+        {
+          found += ((*i)->GetObject<MobilityModel> () != 0);
+          found += ((*i)->GetObject<PropagationLossModel> () != 0);
+        }
+    }
+  int64_t lookupMs = time.End ();
+
+  for (uint32_t j = 0; j < nPackets; j++)
+    {
+      Simulator::Schedule (MilliSeconds (10 * j), &Broadcast, devices.Get (0));
+    }
+  time.Start ();
+  Simulator::Run ();
+  int64_t runMs = time.End ();
+  Simulator::Destroy ();
+
+  std::cout << nNodes << " nodes created in " << nodesMs << " ms" << std::endl
+            << devices.GetN () << " Wi-Fi devices installed in " << installMs << " ms";
+  if (installMs > 0)
+    {
+      std::cout << " (" << devices.GetN () * 1000.0 / installMs << " devices/s)";
+    }
+  std::cout << std::endl
+            << "2 Config::Set on all devices in " << setMs << " ms" << std::endl
+            << 2 * nLookups * nNodes << " GetObject lookups (" << found << " found) in "
+            << lookupMs << " ms" << std::endl
+            << nPackets << " packets broadcast to " << nNodes << " nodes in "
+            << runMs << " ms" << std::endl;
+
+  return 0;
+}
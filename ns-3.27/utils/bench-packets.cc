@@ -26,12 +26,14 @@
 #include "ns3/system-wall-clock-ms.h"
 #include "ns3/packet.h"
 #include "ns3/packet-metadata.h"
+#include "ns3/traced-callback.h"
 #include <iostream>
 #include <sstream>
 #include <string>
 #include <stdlib.h> // for exit ()
 #include <limits>
 #include <algorithm>
+#include <vector>
 
 using namespace ns3;
 
@@ -328,6 +330,159 @@ benchByteTags (uint32_t n)
     }
 }
 
+static void
+fragmentAndReassemble (Ptr<Packet> p, uint32_t fragmentSize)
+{
+  BenchHeader<8> fragmentHeader;
+  std::vector<Ptr<Packet> > fragments;
+  for (uint32_t offset = 0; offset < p->GetSize (); offset += fragmentSize) {
+    uint32_t size = std::min (fragmentSize, p->GetSize () - offset);
+    Ptr<Packet> fragment = p->CreateFragment (offset, size);
+    fragment->AddHeader (fragmentHeader);
+    fragments.push_back (fragment);
+  }
+  Ptr<Packet> reassembled = 0;
+  for (std::vector<Ptr<Packet> >::iterator i = fragments.begin (); i != fragments.end (); i++) {
+    (*i)->RemoveHeader (fragmentHeader);
+    if (reassembled == 0) {
+      reassembled = (*i)->Copy ();
+    } else {
+      reassembled->AddAtEnd (*i);
+    }
+  }
+  NS_ASSERT (reassembled->GetSize () == p->GetSize ());
+}
+
+static void
+benchJumboFragments (uint32_t n)
+{
+  BenchHeader<20> ipv4;
+  static uint8_t payload[8980];
+  for (uint32_t i = 0; i < n; i++) {
+    Ptr<Packet> p = Create<Packet> (payload, sizeof (payload));
+    p->AddHeader (ipv4);
+    // a jumbo frame fragmented for an Ethernet link
+    fragmentAndReassemble (p, 1480);
+  }
+}
+
+static void
+benchLowpanFragments (uint32_t n)
+{
+  BenchHeader<40> ipv6;
+  static uint8_t payload[1240];
+  for (uint32_t i = 0; i < n; i++) {
+    Ptr<Packet> p = Create<Packet> (payload, sizeof (payload));
+    p->AddHeader (ipv6);
+    // a minimum MTU IPv6 packet fragmented in 802.15.4 frames
+    fragmentAndReassemble (p, 96);
+  }
+}
+
+static void
+benchMixedMtu (uint32_t n)
+{
+  BenchHeader<25> ipv4;
+  BenchHeader<8> udp;
+  // payload sizes of a mix of links: minimum IPv4 MTU, IPv6 minimum
+  // MTU, Ethernet, jumbo frames, and small control packets
+  static const uint32_t sizes[] = { 576, 1280, 1500, 9000, 64, 1500, 40 };
+  static const uint32_t nSizes = sizeof (sizes) / sizeof (sizes[0]);
+  static uint8_t payload[9000];
+  // packets stay queued for a while, so that sizes are mixed in memory
+  std::vector<Ptr<Packet> > queue (64);
+
+  for (uint32_t i = 0; i < n; i++) {
+    Ptr<Packet> p = Create<Packet> (payload, sizes[i % nSizes]);
+    p->AddHeader (udp);
+    p->AddHeader (ipv4);
+    Ptr<Packet> o = p->Copy ();
+    o->RemoveHeader (ipv4);
+    o->RemoveHeader (udp);
+    queue[i % queue.size ()] = p;
+  }
+}
+
+template <uint32_t N>
+static void
+benchPacketTags (uint32_t n)
+{
+  BenchHeader<25> ipv4;
+  // typical sizes of a flow id, a socket address, a SNR and a tx vector
+  BenchTag<4> tag1;
+  BenchTag<20> tag2;
+  BenchTag<8> tag3;
+  BenchTag<12> tag4;
+
+  for (uint32_t i = 0; i < n; i++) {
+    Ptr<Packet> p = Create<Packet> (1500);
+    p->AddHeader (ipv4);
+    // each of three hops tags the packet it forwards, and the receiver
+    // strips these tags from its own copy
+    for (uint32_t hop = 0; hop < 3; hop++) {
+      if (N >= 1) {
+        p->AddPacketTag (tag1);
+      }
+      if (N >= 4) {
+        p->AddPacketTag (tag2);
+        p->AddPacketTag (tag3);
+        p->AddPacketTag (tag4);
+      }
+      Ptr<Packet> o = p->Copy ();
+      if (N >= 4) {
+        o->RemovePacketTag (tag4);
+        o->RemovePacketTag (tag3);
+        o->RemovePacketTag (tag2);
+      }
+      if (N >= 1) {
+        o->RemovePacketTag (tag1);
+      }
+      p = o;
+    }
+  }
+}
+
+/// Number of trace sink invocations, to keep the sinks from being trivial
+static uint32_t g_traceEvents = 0;
+
+/**
+ * Trace sink for the traced stack benchmark.
+ *
+ * \param p The packet.
+ */
+static void
+traceSink (Ptr<const Packet> p)
+{
+  g_traceEvents++;
+}
+
+template <uint32_t S>
+static void
+benchTracedStack (uint32_t n)
+{
+  BenchHeader<25> ipv4;
+  BenchHeader<8> udp;
+  // the per-packet trace sources of a Wi-Fi device, in the order a
+  // packet fires them: queue Enqueue and Dequeue, MacTx, PhyTxBegin,
+  // PhyTxEnd, MonitorSnifferTx, then on the receiver PhyRxBegin,
+  // PhyRxEnd, MonitorSnifferRx, MacPromiscRx and MacRx
+  std::vector<TracedCallback<Ptr<const Packet> > > traces (11);
+  for (uint32_t t = 0; t < traces.size (); t++) {
+    for (uint32_t s = 0; s < S; s++) {
+      traces[t].ConnectWithoutContext (MakeCallback (&traceSink));
+    }
+  }
+
+  for (uint32_t i = 0; i < n; i++) {
+    Ptr<Packet> p = Create<Packet> (1500);
+    p->AddHeader (udp);
+    p->AddHeader (ipv4);
+    for (uint32_t t = 0; t < traces.size (); t++) {
+      NS_TRACE_HOT (traces[t] (p));
+    }
+  }
+}
+
 static uint64_t
 runBenchOneIteration (void (*bench) (uint32_t), uint32_t n)
 {
@@ -343,6 +498,7 @@ static void
 runBench (void (*bench) (uint32_t), uint32_t n, uint32_t minIterations, char const *name)
 {
   uint64_t minDelay = std::numeric_limits<uint64_t>::max();
+  Buffer::ResetFreeListStats ();
   for (uint32_t i = 0; i < minIterations; i++)
     {
       uint64_t delay = runBenchOneIteration(bench, n);
@@ -351,9 +507,14 @@ runBench (void (*bench) (uint32_t), uint32_t n, uint32_t minIterations, char con
   double ps = n;
   ps *= 1000;
   ps /= minDelay;
+  Buffer::FreeListStats stats = Buffer::GetFreeListStats ();
   std::cout << ps << " packets/s"
             << " (" << minDelay << " ms elapsed)\t"
             << name
+            << std::endl
+            << "  buffer free lists: "
+            << (stats.requests ? 100.0 * stats.hits / stats.requests : 0.0) << "% hits, "
+            << stats.maxBytesRetained << " bytes retained at most"
             << std::endl;
 }
 
@@ -384,7 +545,16 @@ int main (int argc, char *argv[])
   runBench (&benchC, n, minIterations, "Remove by func call");
   runBench (&benchD, n, minIterations, "Intermixed add/remove headers and tags");
   runBench (&benchFragment, n, minIterations, "Fragmentation and concatenation");
+  runBench (&benchJumboFragments, n, minIterations, "Fragmentation and reassembly of jumbo frames");
+  runBench (&benchLowpanFragments, n, minIterations, "Fragmentation and reassembly over 6LoWPAN");
   runBench (&benchByteTags, n, minIterations, "Benchmark byte tags");
+  runBench (&benchMixedMtu, n, minIterations, "Mixed MTU payloads");
+  runBench (&benchPacketTags<0>, n, minIterations, "Forward over 3 hops without packet tags");
+  runBench (&benchPacketTags<1>, n, minIterations, "Forward over 3 hops with 1 packet tag per hop");
+  runBench (&benchPacketTags<4>, n, minIterations, "Forward over 3 hops with 4 packet tags per hop");
+  runBench (&benchTracedStack<0>, n, minIterations, "Fire the Wi-Fi trace sources with no sink");
+  runBench (&benchTracedStack<1>, n, minIterations, "Fire the Wi-Fi trace sources with 1 sink each");
+  runBench (&benchTracedStack<2>, n, minIterations, "Fire the Wi-Fi trace sources with 2 sinks each");
 
   return 0;
 }
@@ -0,0 +1,119 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+// This program can be used to benchmark the evaluation of the
+// propagation loss models from one source to many destinations, one
+// destination at a time and all the destinations at once.
+// Sample usage:  ./waf --run 'bench-propagation-batch --destinations=1000'
+
+#include "ns3/command-line.h"
+#include "ns3/system-wall-clock-ms.h"
+#include "ns3/object-factory.h"
+#include "ns3/random-variable-stream.h"
+#include "ns3/constant-position-mobility-model.h"
+#include "ns3/propagation-loss-model.h"
+#include <iostream>
+#include <cmath>
+#include <algorithm>
+
+using namespace ns3;
+
+/**
+ * Evaluate a model from a source to destinations, one at a time and
+ * all at once, and print the times.
+ *
+ * \param typeId The TypeId of the model.
+ * \param a The source.
+ * \param b The destinations.
+ * \param rounds The number of times all the destinations are evaluated.
+ */
+static void
+RunModel (std::string typeId, Ptr<MobilityModel> a, const std::vector<Ptr<MobilityModel> > &b, uint32_t rounds)
+{
+  ObjectFactory factory;
+  factory.SetTypeId (typeId);
+  Ptr<PropagationLossModel> model = factory.Create<PropagationLossModel> ();
+
+  SystemWallClockMs time;
+  time.Start ();
+  double single = 0;
+  for (uint32_t round = 0; round < rounds; round++)
+    {
+      for (uint32_t i = 0; i < b.size (); i++)
+        {
+          single += model->CalcRxPower (20, a, b[i]);
+        }
+    }
+  int64_t singleMs = time.End ();
+
+  time.Start ();
+  double batch = 0;
+  std::vector<double> rxPowers;
+  for (uint32_t round = 0; round < rounds; round++)
+    {
+      model->CalcRxPower (20, a, b, rxPowers);
+      for (uint32_t i = 0; i < rxPowers.size (); i++)
+        {
+          batch += rxPowers[i];
+        }
+    }
+  int64_t batchMs = time.End ();
+
+  std::cout << typeId << ": " << singleMs << " ms one at a time, "
+            << batchMs << " ms at once (mean power "
+            << single / rounds / b.size () << " / " << batch / rounds / b.size () << " dBm)" << std::endl;
+}
+
+int main (int argc, char *argv[])
+{
+  uint32_t nDestinations = 1000;
+  uint32_t rounds = 1000;
+  double radius = 1000;
+
+  CommandLine cmd;
+  cmd.Usage ("Benchmark the propagation loss models from one source to many destinations");
+  cmd.AddValue ("destinations", "number of destinations", nDestinations);
+  cmd.AddValue ("rounds", "number of times all the destinations are evaluated", rounds);
+  cmd.AddValue ("radius", "largest distance of a destination from the source [m]", radius);
+  cmd.Parse (argc, argv);
+
+  // A base station above a disc of user terminals
+  Ptr<MobilityModel> a = CreateObject<ConstantPositionMobilityModel> ();
+  a->SetPosition (Vector (0, 0, 30));
+  Ptr<UniformRandomVariable> random = CreateObject<UniformRandomVariable> ();
+  random->SetStream (0);
+  std::vector<Ptr<MobilityModel> > b;
+  for (uint32_t i = 0; i < nDestinations; i++)
+    {
+      double distance = random->GetValue (20, radius);
+      double angle = random->GetValue (0, 2 * M_PI);
+      Ptr<MobilityModel> destination = CreateObject<ConstantPositionMobilityModel> ();
+      destination->SetPosition (Vector (distance * std::cos (angle), distance * std::sin (angle), 1.5));
+      b.push_back (destination);
+    }
+
+  std::cout << "Running bench-propagation-batch with " << nDestinations << " destinations, "
+            << rounds << " rounds" << std::endl;
+  RunModel ("ns3::FriisPropagationLossModel", a, b, rounds);
+  RunModel ("ns3::LogDistancePropagationLossModel", a, b, rounds);
+  RunModel ("ns3::ThreeLogDistancePropagationLossModel", a, b, rounds);
+  RunModel ("ns3::OkumuraHataPropagationLossModel", a, b, rounds);
+  RunModel ("ns3::Cost231PropagationLossModel", a, b, rounds);
+  RunModel ("ns3::ItuR1411LosPropagationLossModel", a, b, rounds);
+  RunModel ("ns3::ItuR1411NlosOverRooftopPropagationLossModel", a, b, rounds);
+  RunModel ("ns3::TwoRayGroundPropagationLossModel", a, b, rounds);
+  return 0;
+}
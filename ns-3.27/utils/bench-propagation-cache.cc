@@ -0,0 +1,322 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+// This program can be used to benchmark the CachedPropagationLossModel
+// on a static LTE scenario, eNBs and UEs placed among buildings,
+// with the HybridBuildingsPropagationLossModel and with the same model
+// behind the cache, first evaluating the links alone, then running
+// the LTE model.
+// Sample usage:  ./waf --run 'bench-propagation-cache --ues=200'
+
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/mobility-module.h"
+#include "ns3/lte-module.h"
+#include "ns3/buildings-module.h"
+#include "ns3/spectrum-channel.h"
+#include "ns3/spectrum-phy.h"
+#include "ns3/system-wall-clock-ms.h"
+#include <iostream>
+
+using namespace ns3;
+
+/// The number of path losses evaluated by the channels
+static uint64_t g_nLookups = 0;
+
+/// A PropagationLossModel counting the links it is evaluated for
+class CountingPropagationLossModel : public PropagationLossModel
+{
+public:
+  CountingPropagationLossModel ();
+
+  uint64_t m_count; //!< The number of evaluations
+
+private:
+  virtual double DoCalcRxPower (double txPowerDbm,
+                                Ptr<MobilityModel> a,
+                                Ptr<MobilityModel> b) const;
+  virtual int64_t DoAssignStreams (int64_t stream);
+};
+
+CountingPropagationLossModel::CountingPropagationLossModel ()
+  : m_count (0)
+{
+}
+
+double
+CountingPropagationLossModel::DoCalcRxPower (double txPowerDbm,
+                                             Ptr<MobilityModel> a,
+                                             Ptr<MobilityModel> b) const
+{
+  const_cast<CountingPropagationLossModel *> (this)->m_count++;
+  return txPowerDbm;
+}
+
+int64_t
+CountingPropagationLossModel::DoAssignStreams (int64_t stream)
+{
+  return 0;
+}
+
+/// A PropagationLossModel forwarding to another, like the cache would
+class ForwardingPropagationLossModel : public PropagationLossModel
+{
+public:
+  /**
+   * \brief Get the type ID.
+   * \return the object TypeId
+   */
+  static TypeId GetTypeId (void);
+
+private:
+  virtual double DoCalcRxPower (double txPowerDbm,
+                                Ptr<MobilityModel> a,
+                                Ptr<MobilityModel> b) const;
+  virtual int64_t DoAssignStreams (int64_t stream);
+
+  Ptr<PropagationLossModel> m_model; //!< The model forwarded to
+};
+
+NS_OBJECT_ENSURE_REGISTERED (ForwardingPropagationLossModel);
+
+TypeId
+ForwardingPropagationLossModel::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::ForwardingPropagationLossModel")
+    .SetParent<PropagationLossModel> ()
+    .AddConstructor<ForwardingPropagationLossModel> ()
+    .AddAttribute ("Model",
+                   "The model forwarded to.",
+                   PointerValue (),
+                   MakePointerAccessor (&ForwardingPropagationLossModel::m_model),
+                   MakePointerChecker<PropagationLossModel> ())
+  ;
+  return tid;
+}
+
+double
+ForwardingPropagationLossModel::DoCalcRxPower (double txPowerDbm,
+                                               Ptr<MobilityModel> a,
+                                               Ptr<MobilityModel> b) const
+{
+  return m_model->CalcRxPower (txPowerDbm, a, b);
+}
+
+int64_t
+ForwardingPropagationLossModel::DoAssignStreams (int64_t stream)
+{
+  return 0;
+}
+
+/**
+ * Count a path loss evaluated by a channel.
+ *
+ * \param txPhy The transmitter.
+ * \param rxPhy The receiver.
+ * \param lossDb The loss [dB].
+ */
+static void
+PathLoss (Ptr<SpectrumPhy> txPhy, Ptr<SpectrumPhy> rxPhy, double lossDb)
+{
+  g_nLookups++;
+}
+
+/**
+ * Create the buildings and the nodes, with their positions.
+ *
+ * \param nEnbs The number of eNBs on a side of the grid of sites.
+ * \param nUes The number of UEs.
+ * \param enbNodes The container to hold the eNBs.
+ * \param ueNodes The container to hold the UEs.
+ */
+static void
+CreateTopology (uint32_t nEnbs, uint32_t nUes, NodeContainer &enbNodes, NodeContainer &ueNodes)
+{
+  // Blocks of 60 x 40 m buildings, 20 m apart, one eNB per block
+  double blockX = 80;
+  double blockY = 60;
+  Ptr<GridBuildingAllocator> buildings = CreateObject<GridBuildingAllocator> ();
+  buildings->SetAttribute ("GridWidth", UintegerValue (nEnbs));
+  buildings->SetAttribute ("LengthX", DoubleValue (blockX - 20));
+  buildings->SetAttribute ("LengthY", DoubleValue (blockY - 20));
+  buildings->SetAttribute ("DeltaX", DoubleValue (20));
+  buildings->SetAttribute ("DeltaY", DoubleValue (20));
+  buildings->SetAttribute ("Height", DoubleValue (12));
+  buildings->SetBuildingAttribute ("NRoomsX", UintegerValue (2));
+  buildings->SetBuildingAttribute ("NRoomsY", UintegerValue (2));
+  buildings->SetBuildingAttribute ("NFloors", UintegerValue (4));
+  buildings->SetAttribute ("MinX", DoubleValue (0));
+  buildings->SetAttribute ("MinY", DoubleValue (0));
+  buildings->Create (nEnbs * nEnbs);
+
+  enbNodes.Create (nEnbs * nEnbs);
+  ueNodes.Create (nUes);
+
+  // The eNBs stand on the corner of their block, above the roofs
+  Ptr<ListPositionAllocator> enbPositions = CreateObject<ListPositionAllocator> ();
+  for (uint32_t i = 0; i < enbNodes.GetN (); i++)
+    {
+      enbPositions->Add (Vector ((i % nEnbs + 1) * blockX - 10, (i / nEnbs + 1) * blockY - 10, 30));
+    }
+  MobilityHelper mobility;
+  mobility.SetPositionAllocator (enbPositions);
+  mobility.Install (enbNodes);
+  Ptr<RandomBoxPositionAllocator> uePositions = CreateObject<RandomBoxPositionAllocator> ();
+  Ptr<UniformRandomVariable> x = CreateObject<UniformRandomVariable> ();
+  x->SetAttribute ("Max", DoubleValue (nEnbs * blockX));
+  x->SetStream (1);
+  Ptr<UniformRandomVariable> y = CreateObject<UniformRandomVariable> ();
+  y->SetAttribute ("Max", DoubleValue (nEnbs * blockY));
+  y->SetStream (2);
+  uePositions->SetX (x);
+  uePositions->SetY (y);
+  uePositions->SetZ (CreateObjectWithAttributes<ConstantRandomVariable> ("Constant", DoubleValue (1.5)));
+  mobility.SetPositionAllocator (uePositions);
+  mobility.Install (ueNodes);
+  BuildingsHelper::Install (enbNodes);
+  BuildingsHelper::Install (ueNodes);
+  BuildingsHelper::MakeMobilityModelConsistent ();
+
+}
+
+/**
+ * Evaluate the loss of every link between eNBs and UEs, in both
+ * directions, without the rest of the LTE model.
+ *
+ * \param nEnbs The number of eNBs on a side of the grid of sites.
+ * \param nUes The number of UEs.
+ * \param rounds The number of evaluations of each link.
+ * \param cached Whether the path loss is cached.
+ */
+static void
+RunLinks (uint32_t nEnbs, uint32_t nUes, uint32_t rounds, bool cached)
+{
+  NodeContainer enbNodes;
+  NodeContainer ueNodes;
+  CreateTopology (nEnbs, nUes, enbNodes, ueNodes);
+  Ptr<HybridBuildingsPropagationLossModel> hybrid = CreateObject<HybridBuildingsPropagationLossModel> ();
+  hybrid->AssignStreams (1);
+  Ptr<PropagationLossModel> model = hybrid;
+  Ptr<CachedPropagationLossModel> cache;
+  if (cached)
+    {
+      cache = CreateObject<CachedPropagationLossModel> ();
+      cache->SetModel (hybrid);
+      model = cache;
+    }
+
+  double sum = 0;
+  SystemWallClockMs time;
+  time.Start ();
+  for (uint32_t round = 0; round < rounds; round++)
+    {
+      for (uint32_t i = 0; i < enbNodes.GetN (); i++)
+        {
+          Ptr<MobilityModel> enb = enbNodes.Get (i)->GetObject<MobilityModel> ();
+          for (uint32_t j = 0; j < ueNodes.GetN (); j++)
+            {
+              Ptr<MobilityModel> ue = ueNodes.Get (j)->GetObject<MobilityModel> ();
+              sum += model->CalcRxPower (0, enb, ue);
+              sum += model->CalcRxPower (0, ue, enb);
+            }
+        }
+    }
+  int64_t runMs = time.End ();
+  Simulator::Destroy ();
+
+  std::cout << enbNodes.GetN () << " eNBs, " << ueNodes.GetN () << " UEs, "
+            << (cached ? "cached" : "not cached") << ": "
+            << 2 * rounds * enbNodes.GetN () * ueNodes.GetN () << " link losses";
+  if (cached)
+    {
+      std::cout << ", " << cache->GetCacheHits () << " hits, " << cache->GetCacheMisses () << " misses";
+    }
+  std::cout << " in " << runMs << " ms (mean " << sum / (2.0 * rounds * enbNodes.GetN () * ueNodes.GetN ()) << " dBm)" << std::endl;
+}
+
+/**
+ * Run the LTE scenario.
+ *
+ * \param nEnbs The number of eNBs on a side of the grid of sites.
+ * \param nUes The number of UEs.
+ * \param simTime The simulated time [s].
+ * \param cached Whether the path loss is cached.
+ */
+static void
+RunScenario (uint32_t nEnbs, uint32_t nUes, double simTime, bool cached)
+{
+  NodeContainer enbNodes;
+  NodeContainer ueNodes;
+  CreateTopology (nEnbs, nUes, enbNodes, ueNodes);
+
+  Ptr<LteHelper> lteHelper = CreateObject<LteHelper> ();
+  // The helper cannot set the frequency of a model behind another, so
+  // both directions use the model at the downlink frequency
+  Ptr<HybridBuildingsPropagationLossModel> hybrid = CreateObject<HybridBuildingsPropagationLossModel> ();
+  hybrid->SetAttribute ("Frequency", DoubleValue (2120e6));
+  hybrid->AssignStreams (1);
+  Ptr<CountingPropagationLossModel> counter = CreateObject<CountingPropagationLossModel> ();
+  counter->SetNext (hybrid);
+  lteHelper->SetAttribute ("PathlossModel", StringValue (cached ? "ns3::CachedPropagationLossModel" : "ns3::ForwardingPropagationLossModel"));
+  lteHelper->SetPathlossModelAttribute ("Model", PointerValue (counter));
+  NetDeviceContainer enbDevs = lteHelper->InstallEnbDevice (enbNodes);
+  NetDeviceContainer ueDevs = lteHelper->InstallUeDevice (ueNodes);
+  lteHelper->AttachToClosestEnb (ueDevs, enbDevs);
+  lteHelper->ActivateDataRadioBearer (ueDevs, EpsBearer (EpsBearer::GBR_CONV_VOICE));
+  lteHelper->AssignStreams (enbDevs, 10);
+  lteHelper->AssignStreams (ueDevs, 1000);
+
+  g_nLookups = 0;
+  lteHelper->GetDownlinkSpectrumChannel ()->TraceConnectWithoutContext ("PathLoss", MakeCallback (&PathLoss));
+  lteHelper->GetUplinkSpectrumChannel ()->TraceConnectWithoutContext ("PathLoss", MakeCallback (&PathLoss));
+
+  Simulator::Stop (Seconds (simTime));
+  SystemWallClockMs time;
+  time.Start ();
+  Simulator::Run ();
+  int64_t runMs = time.End ();
+  Simulator::Destroy ();
+
+  std::cout << enbNodes.GetN () << " eNBs, " << ueNodes.GetN () << " UEs, ";
+  std::cout << (cached ? "cached" : "not cached") << ": " << g_nLookups << " path losses, "
+            << counter->m_count << " computed";
+  std::cout << " in " << runMs << " ms" << std::endl;
+}
+
+int main (int argc, char *argv[])
+{
+  uint32_t nEnbs = 3;
+  uint32_t nUes = 100;
+  double simTime = 1;
+  uint32_t rounds = 1000;
+
+  CommandLine cmd;
+  cmd.Usage ("Benchmark the CachedPropagationLossModel on a static LTE scenario with buildings");
+  cmd.AddValue ("enbs", "number of eNBs on a side of the grid of sites", nEnbs);
+  cmd.AddValue ("ues", "number of UEs", nUes);
+  cmd.AddValue ("time", "simulated time [s]", simTime);
+  cmd.AddValue ("rounds", "number of evaluations of each link without LTE", rounds);
+  cmd.Parse (argc, argv);
+
+  // Allow up to 320 UEs per eNB
+  Config::SetDefault ("ns3::LteEnbRrc::SrsPeriodicity", UintegerValue (320));
+
+  RunLinks (nEnbs, nUes, rounds, false);
+  RunLinks (nEnbs, nUes, rounds, true);
+  RunScenario (nEnbs, nUes, simTime, false);
+  RunScenario (nEnbs, nUes, simTime, true);
+  return 0;
+}
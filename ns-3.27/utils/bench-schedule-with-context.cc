@@ -0,0 +1,151 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2017
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+// Measure the rate at which events can be injected into a running
+// simulation from other threads with Simulator::ScheduleWithContext.
+//
+// A number of producer threads each schedule a number of events while
+// the main thread runs the simulation, polling for new events with a
+// periodic event, until all the injected events have been executed.
+
+#include <algorithm>
+#include <iomanip>
+#include <iostream>
+#include <list>
+
+#include "ns3/core-module.h"
+
+using namespace ns3;
+
+/// Injection benchmark state
+class Bench
+{
+public:
+  /**
+   * Constructor
+   * \param threads The number of producer threads.
+   * \param events The number of events injected by each thread.
+   */
+  Bench (uint32_t threads, uint32_t events)
+    : m_nThreads (threads),
+      m_nEvents (events),
+      m_received (0),
+      m_injectMs (0)
+  {
+  }
+
+  /** Run the benchmark and print the results. */
+  void Run (void)
+  {
+    Simulator::ScheduleNow (&Bench::Start, this);
+    Simulator::Run ();
+    for (std::list<Ptr<SystemThread> >::iterator it = m_threads.begin (); it != m_threads.end (); ++it)
+      {
+        (*it)->Join ();
+      }
+    int64_t totalMs = m_clock.End ();
+    uint64_t total = static_cast<uint64_t> (m_nThreads) * m_nEvents;
+    std::cout << "ScheduleWithContext: " << m_nThreads << " threads, "
+              << total << " events" << std::endl
+              << "  slowest thread injection: " << m_injectMs << " ms ("
+              << std::setprecision (3)
+              << (m_injectMs > 0 ? m_nEvents * 1000.0 / m_injectMs : 0.0)
+              << " ev/s per thread)" << std::endl
+              << "  until all executed: " << totalMs << " ms ("
+              << (totalMs > 0 ? total * 1000.0 / totalMs : 0.0)
+              << " ev/s)" << std::endl;
+    Simulator::Destroy ();
+  }
+
+private:
+  /** Start the producer threads from within the simulation. */
+  void Start (void)
+  {
+    m_clock.Start ();
+    for (uint32_t i = 0; i < m_nThreads; ++i)
+      {
+        Ptr<SystemThread> thread =
+          Create<SystemThread> (MakeBoundCallback (&Bench::Produce, this, i));
+        m_threads.push_back (thread);
+      }
+    for (std::list<Ptr<SystemThread> >::iterator it = m_threads.begin (); it != m_threads.end (); ++it)
+      {
+        (*it)->Start ();
+      }
+    Poll ();
+  }
+
+  /**
+   * Producer thread body.
+   * \param bench The benchmark.
+   * \param context The context of the injected events.
+   */
+  static void Produce (Bench *bench, uint32_t context)
+  {
+    SystemWallClockMs clock;
+    clock.Start ();
+    for (uint32_t i = 0; i < bench->m_nEvents; ++i)
+      {
+        Simulator::ScheduleWithContext (context, Time (0), &Bench::Receive, bench);
+      }
+    int64_t ms = clock.End ();
+    CriticalSection cs (bench->m_mutex);
+    bench->m_injectMs = std::max (bench->m_injectMs, ms);
+  }
+
+  /** Injected event. */
+  void Receive (void)
+  {
+    m_received++;
+    if (m_received == static_cast<uint64_t> (m_nThreads) * m_nEvents)
+      {
+        Simulator::Stop ();
+      }
+  }
+
+  /** Keep the simulation running until all events are received. */
+  void Poll (void)
+  {
+    Simulator::Schedule (MicroSeconds (1), &Bench::Poll, this);
+  }
+
+  uint32_t m_nThreads;     ///< Number of producer threads.
+  uint32_t m_nEvents;      ///< Number of events per thread.
+  uint64_t m_received;     ///< Number of events executed so far.
+  int64_t m_injectMs;      ///< Injection time of the slowest thread.
+  SystemMutex m_mutex;     ///< Protects m_injectMs.
+  SystemWallClockMs m_clock;                ///< Total time.
+  std::list<Ptr<SystemThread> > m_threads;  ///< The producer threads.
+};
+
+
+int main (int argc, char *argv[])
+{
+  uint32_t threads = 4;
+  uint32_t events = 1000000;
+
+  CommandLine cmd;
+  cmd.Usage ("Benchmark Simulator::ScheduleWithContext from multiple threads.");
+  cmd.AddValue ("threads", "number of producer threads", threads);
+  cmd.AddValue ("events", "number of events injected by each thread", events);
+  cmd.Parse (argc, argv);
+
+  Bench bench (threads, events);
+  bench.Run ();
+  return 0;
+}
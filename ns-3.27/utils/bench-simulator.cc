@@ -51,7 +51,8 @@ public:
   Bench (const uint32_t population, const uint32_t total)
     : m_population (population),
       m_total (total),
-      m_count (0)
+      m_count (0),
+      m_timers (false)
   {
   }
 
@@ -82,16 +83,30 @@ public:
     m_total = total;
   }
 
+  /**
+   * Enable the timer workload: every event also restarts a timer,
+   * removing the pending one, as protocol retransmission timers do.
+   * \param timers whether to restart a timer at each event
+   */
+  void SetTimers (const bool timers)
+  {
+    m_timers = timers;
+  }
+
   /// Run function
   void RunBench (void);
 private:
   /// callback function
   void Cb (void);
+  /// timer expiration function
+  void Timeout (void);
 
   Ptr<RandomVariableStream> m_rand; ///< random variable
   uint32_t m_population; ///< population
   uint32_t m_total; ///< total
   uint32_t m_count; ///< count 
+  bool m_timers; ///< restart a timer at each event
+  EventId m_timer; ///< the pending timer
 };
 
 void
@@ -141,22 +156,64 @@ Bench::Cb (void)
 
   Time after = NanoSeconds (m_rand->GetValue ());
   Simulator::Schedule (after, &Bench::Cb, this);
+  if (m_timers)
+    {
+      Simulator::Remove (m_timer);
+      m_timer = Simulator::Schedule (MilliSeconds (1), &Bench::Timeout, this);
+    }
   ++m_count;
 }
 
+void
+Bench::Timeout (void)
+{
+  DEB ("timeout at " << Simulator::Now ().GetSeconds () << "s");
+}
+
 
 Ptr<RandomVariableStream>
-GetRandomStream (std::string filename)
+GetRandomStream (std::string filename, std::string dist)
 {
   Ptr<RandomVariableStream> stream = 0;
 
-  if (filename == "")
+  if (filename == "" && dist == "exp")
     {
       LOGME ("using default exponential distribution");
       Ptr<ExponentialRandomVariable> erv = CreateObject<ExponentialRandomVariable> ();
       erv->SetAttribute ("Mean", DoubleValue (100));
       stream = erv;
     }
+  else if (filename == "" && dist == "uniform")
+    {
+      LOGME ("using uniform distribution in [0, 200] ns");
+      Ptr<UniformRandomVariable> urv = CreateObject<UniformRandomVariable> ();
+      urv->SetAttribute ("Min", DoubleValue (0));
+      urv->SetAttribute ("Max", DoubleValue (200));
+      stream = urv;
+    }
+  else if (filename == "" && dist == "pareto")
+    {
+      LOGME ("using Pareto distribution, scale 50 ns, shape 1.5, bound 1 s");
+      Ptr<ParetoRandomVariable> prv = CreateObject<ParetoRandomVariable> ();
+      prv->SetAttribute ("Scale", DoubleValue (50));
+      prv->SetAttribute ("Shape", DoubleValue (1.5));
+      prv->SetAttribute ("Bound", DoubleValue (1e9));
+      stream = prv;
+    }
+  else if (filename == "" && dist == "bimodal")
+    {
+      // 90% of the events are 1 ms TTIs, which pile up on identical
+      // timestamps, and the rest are long timers uniform up to 1 s.
+      LOGME ("using bimodal distribution, 90% at 1 ms, 10% in [1 ms, 1 s]");
+      Ptr<EmpiricalRandomVariable> erv = CreateObject<EmpiricalRandomVariable> ();
+      erv->CDF (1e6, 0.9);
+      erv->CDF (1e9, 1.0);
+      stream = erv;
+    }
+  else if (filename == "")
+    {
+      NS_FATAL_ERROR ("unknown distribution " << dist);
+    }
   else
     {
       std::istream *input;
@@ -200,106 +257,183 @@ GetRandomStream (std::string filename)
 
 
 
+/**
+ * Run the benchmark with one scheduler.
+ *
+ * \param factory the scheduler factory
+ * \param bench the benchmark
+ * \param pop the event population size
+ * \param total the total number of events to run
+ * \param runs the number of runs
+ */
+void
+BenchScheduler (ObjectFactory factory, Bench *bench,
+                uint32_t pop, uint32_t total, uint32_t runs)
+{
+  Simulator::SetScheduler (factory);
+
+  LOGME ("scheduler: " << factory.GetTypeId ().GetName ());
+  LOGME ("population: " << pop);
+  LOGME ("total events: " << total);
+  LOGME ("runs: " << runs);
+
+  // table header
+  LOG ("");
+  LOG (std::left << std::setw (g_fwidth) << "Run #" <<
+       std::left << std::setw (3 * g_fwidth) << "Inititialization:" <<
+       std::left << std::setw (3 * g_fwidth) << "Simulation:");
+  LOG (std::left << std::setw (g_fwidth) << "" <<
+       std::left << std::setw (g_fwidth) << "Time (s)" <<
+       std::left << std::setw (g_fwidth) << "Rate (ev/s)" <<
+       std::left << std::setw (g_fwidth) << "Per (s/ev)" <<
+       std::left << std::setw (g_fwidth) << "Time (s)" <<
+       std::left << std::setw (g_fwidth) << "Rate (ev/s)" <<
+       std::left << std::setw (g_fwidth) << "Per (s/ev)" );
+  LOG (std::setfill ('-') <<
+       std::right << std::setw (g_fwidth) << " " <<
+       std::right << std::setw (g_fwidth) << " " <<
+       std::right << std::setw (g_fwidth) << " " <<
+       std::right << std::setw (g_fwidth) << " " <<
+       std::right << std::setw (g_fwidth) << " " <<
+       std::right << std::setw (g_fwidth) << " " <<
+       std::right << std::setw (g_fwidth) << " " <<
+       std::setfill (' ')
+       );
+
+  // prime
+  DEB ("priming");
+  std::cout << std::left << std::setw (g_fwidth) << "(prime)";
+  bench->SetPopulation (pop);
+  bench->SetTotal (total);
+  bench->RunBench ();
+
+  for (uint32_t i = 0; i < runs; i++)
+    {
+      std::cout << std::setw (g_fwidth) << i;
+
+      bench->RunBench ();
+    }
+
+  Ptr<DefaultSimulatorImpl> impl = DynamicCast<DefaultSimulatorImpl> (Simulator::GetImplementation ());
+  if (impl != 0)
+    {
+      LOGME ("tombstones left: " << impl->GetTombstoneCount () <<
+             ", compactions: " << impl->GetCompactionCount () <<
+             ", compacted events: " << impl->GetCompactedEventCount ());
+    }
+
+  LOG ("");
+}
+
+
 int main (int argc, char *argv[])
 {
 
   bool schedCal  = false;
+  bool schedDary = false;
   bool schedHeap = false;
+  bool schedLadder = false;
   bool schedList = false;
   bool schedMap  = true;
+  bool schedAll  = false;
+  bool timers    = false;
+  bool lazy      = false;
 
   uint32_t pop   =  100000;
   uint32_t total = 1000000;
   uint32_t runs  =       1;
   std::string filename = "";
+  std::string dist = "exp";
 
   CommandLine cmd;
   cmd.Usage ("Benchmark the simulator scheduler.\n"
              "\n"
              "Event intervals are taken from one of:\n"
              "  an exponential distribution, with mean 100 ns,\n"
+             "  one of the distributions selected by --dist,\n"
              "  an ascii file, given by the --file=\"<filename>\" argument,\n"
              "  or standard input, by the argument --file=\"-\"\n"
              "In the case of either --file form, the input is expected\n"
-             "to be ascii, giving the relative event times in ns.");
+             "to be ascii, giving the relative event times in ns.\n"
+             "\n"
+             "With --all, every scheduler is benchmarked in turn\n"
+             "on the same event distribution.");
   cmd.AddValue ("cal",   "use CalendarSheduler",          schedCal);
+  cmd.AddValue ("dary",  "use DaryHeapScheduler",         schedDary);
   cmd.AddValue ("heap",  "use HeapScheduler",             schedHeap);
+  cmd.AddValue ("ladder", "use LadderQueueScheduler",     schedLadder);
   cmd.AddValue ("list",  "use ListSheduler",              schedList);
   cmd.AddValue ("map",   "use MapScheduler (default)",    schedMap);
+  cmd.AddValue ("all",   "benchmark all schedulers, except ListScheduler", schedAll);
+  cmd.AddValue ("timers", "restart a timer at each event", timers);
+  cmd.AddValue ("lazy",  "remove events lazily, with bulk compaction", lazy);
   cmd.AddValue ("debug", "enable debugging output",       g_debug);
   cmd.AddValue ("pop",   "event population size (default 1E5)",         pop);
   cmd.AddValue ("total", "total number of events to run (default 1E6)", total);
   cmd.AddValue ("runs",  "number of runs (default 1)",    runs);
   cmd.AddValue ("file",  "file of relative event times",  filename);
+  cmd.AddValue ("dist",  "event time distribution: exp (default), uniform, "
+                "pareto or bimodal", dist);
   cmd.AddValue ("prec",  "printed output precision",      g_fwidth);
   cmd.Parse (argc, argv);
   g_me = cmd.GetName () + ": ";
   g_fwidth += 6;  // 5 extra chars in '2.000002e+07 ': . e+0 _
 
-  ObjectFactory factory ("ns3::MapScheduler");
-  if (schedCal)
+  std::vector<std::string> schedulers;
+  if (schedAll)
     {
-      factory.SetTypeId ("ns3::CalendarScheduler");
+      // ListScheduler is left out: it is O(n) per insert and would
+      // dominate the total run time at the default population.
+      schedulers.push_back ("ns3::MapScheduler");
+      schedulers.push_back ("ns3::HeapScheduler");
+      schedulers.push_back ("ns3::CalendarScheduler");
+      schedulers.push_back ("ns3::DaryHeapScheduler");
+      schedulers.push_back ("ns3::LadderQueueScheduler");
     }
-  if (schedHeap)
+  else if (schedCal)
     {
-      factory.SetTypeId ("ns3::HeapScheduler");
+      schedulers.push_back ("ns3::CalendarScheduler");
     }
-  if (schedList)
+  else if (schedDary)
     {
-      factory.SetTypeId ("ns3::ListScheduler");
+      schedulers.push_back ("ns3::DaryHeapScheduler");
+    }
+  else if (schedLadder)
+    {
+      schedulers.push_back ("ns3::LadderQueueScheduler");
+    }
+  else if (schedHeap)
+    {
+      schedulers.push_back ("ns3::HeapScheduler");
+    }
+  else if (schedList)
+    {
+      schedulers.push_back ("ns3::ListScheduler");
+    }
+  else
+    {
+      schedulers.push_back ("ns3::MapScheduler");
+    }
+
+  if (lazy)
+    {
+      Config::SetDefault ("ns3::DefaultSimulatorImpl::LazyRemove", BooleanValue (true));
     }
-  Simulator::SetScheduler (factory);
 
   LOGME (std::setprecision (g_fwidth - 6));
   DEB ("debugging is ON");
 
-  LOGME ("scheduler: " << factory.GetTypeId ().GetName ());
-  LOGME ("population: " << pop);
-  LOGME ("total events: " << total);
-  LOGME ("runs: " << runs);
-
   Bench *bench = new Bench (pop, total);
-  bench->SetRandomStream (GetRandomStream (filename));
-
-  // table header
-  LOG ("");
-  LOG (std::left << std::setw (g_fwidth) << "Run #" <<
-       std::left << std::setw (3 * g_fwidth) << "Inititialization:" <<
-       std::left << std::setw (3 * g_fwidth) << "Simulation:");
-  LOG (std::left << std::setw (g_fwidth) << "" <<
-       std::left << std::setw (g_fwidth) << "Time (s)" <<
-       std::left << std::setw (g_fwidth) << "Rate (ev/s)" <<
-       std::left << std::setw (g_fwidth) << "Per (s/ev)" <<
-       std::left << std::setw (g_fwidth) << "Time (s)" <<
-       std::left << std::setw (g_fwidth) << "Rate (ev/s)" <<
-       std::left << std::setw (g_fwidth) << "Per (s/ev)" );
-  LOG (std::setfill ('-') <<
-       std::right << std::setw (g_fwidth) << " " <<
-       std::right << std::setw (g_fwidth) << " " <<
-       std::right << std::setw (g_fwidth) << " " <<
-       std::right << std::setw (g_fwidth) << " " <<
-       std::right << std::setw (g_fwidth) << " " <<
-       std::right << std::setw (g_fwidth) << " " <<
-       std::right << std::setw (g_fwidth) << " " <<
-       std::setfill (' ')
-       );
-
-  // prime
-  DEB ("priming");
-  std::cout << std::left << std::setw (g_fwidth) << "(prime)";
-  bench->RunBench ();
+  bench->SetTimers (timers);
+  bench->SetRandomStream (GetRandomStream (filename, dist));
 
-  bench->SetPopulation (pop);
-  bench->SetTotal (total);
-  for (uint32_t i = 0; i < runs; i++)
+  for (std::vector<std::string>::const_iterator i = schedulers.begin ();
+       i != schedulers.end (); ++i)
     {
-      std::cout << std::setw (g_fwidth) << i;
-
-      bench->RunBench ();
+      ObjectFactory factory (*i);
+      BenchScheduler (factory, bench, pop, total, runs);
     }
 
-  LOG ("");
   Simulator::Destroy ();
   delete bench;
   return 0;
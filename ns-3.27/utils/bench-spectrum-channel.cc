@@ -0,0 +1,240 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+// This program can be used to benchmark the MultiModelSpectrumChannel
+// for increasing numbers of nodes placed at random in a square, each
+// of them transmitting once to all the others, without cutoff, with
+// the MaxLossDb cutoff alone, and with the MaxRange derived from it.
+// Sample usage:  ./waf --run 'bench-spectrum-channel --max-nodes=4000'
+
+#include "ns3/command-line.h"
+#include "ns3/system-wall-clock-ms.h"
+#include "ns3/double.h"
+#include "ns3/simulator.h"
+#include "ns3/random-variable-stream.h"
+#include "ns3/constant-position-mobility-model.h"
+#include "ns3/propagation-loss-model.h"
+#include "ns3/propagation-delay-model.h"
+#include "ns3/multi-model-spectrum-channel.h"
+#include "ns3/spectrum-phy.h"
+#include "ns3/net-device.h"
+#include "ns3/antenna-model.h"
+#include "ns3/spectrum-signal-parameters.h"
+#include "ns3/spectrum-value.h"
+#include <iostream>
+#include <vector>
+
+using namespace ns3;
+
+/// The number of signals received by all the BenchPhy instances
+static uint64_t g_nRx = 0;
+
+/// A SpectrumPhy counting the signals it receives
+class BenchPhy : public SpectrumPhy
+{
+public:
+  /**
+   * \param model The SpectrumModel of the receiver.
+   * \param mobility The position of the receiver.
+   */
+  BenchPhy (Ptr<const SpectrumModel> model, Ptr<MobilityModel> mobility);
+
+  // inherited from SpectrumPhy
+  virtual void SetDevice (Ptr<NetDevice> d);
+  virtual Ptr<NetDevice> GetDevice () const;
+  virtual void SetMobility (Ptr<MobilityModel> m);
+  virtual Ptr<MobilityModel> GetMobility ();
+  virtual void SetChannel (Ptr<SpectrumChannel> c);
+  virtual Ptr<const SpectrumModel> GetRxSpectrumModel () const;
+  virtual Ptr<AntennaModel> GetRxAntenna ();
+  virtual void StartRx (Ptr<SpectrumSignalParameters> params);
+
+private:
+  virtual void DoDispose (void);
+
+  Ptr<const SpectrumModel> m_model; //!< The SpectrumModel of the receiver
+  Ptr<MobilityModel> m_mobility;    //!< The position of the receiver
+};
+
+BenchPhy::BenchPhy (Ptr<const SpectrumModel> model, Ptr<MobilityModel> mobility)
+  : m_model (model),
+    m_mobility (mobility)
+{
+}
+
+void
+BenchPhy::DoDispose (void)
+{
+  m_model = 0;
+  m_mobility = 0;
+  SpectrumPhy::DoDispose ();
+}
+
+void
+BenchPhy::SetDevice (Ptr<NetDevice> d)
+{
+}
+
+Ptr<NetDevice>
+BenchPhy::GetDevice () const
+{
+  return 0;
+}
+
+void
+BenchPhy::SetMobility (Ptr<MobilityModel> m)
+{
+  m_mobility = m;
+}
+
+Ptr<MobilityModel>
+BenchPhy::GetMobility ()
+{
+  return m_mobility;
+}
+
+void
+BenchPhy::SetChannel (Ptr<SpectrumChannel> c)
+{
+}
+
+Ptr<const SpectrumModel>
+BenchPhy::GetRxSpectrumModel () const
+{
+  return m_model;
+}
+
+Ptr<AntennaModel>
+BenchPhy::GetRxAntenna ()
+{
+  return 0;
+}
+
+void
+BenchPhy::StartRx (Ptr<SpectrumSignalParameters> params)
+{
+  g_nRx++;
+}
+
+/**
+ * Create the SpectrumModel of a 25 resource block LTE carrier.
+ *
+ * \return The SpectrumModel.
+ */
+static Ptr<SpectrumModel>
+CreateSpectrumModel (void)
+{
+  Bands bands;
+  double f = 2120e6 - 25 * 90e3;
+  for (uint32_t i = 0; i < 25; i++)
+    {
+      BandInfo info;
+      info.fl = f;
+      info.fc = f + 90e3;
+      info.fh = f + 180e3;
+      bands.push_back (info);
+      f += 180e3;
+    }
+  return Create<SpectrumModel> (bands);
+}
+
+/**
+ * Let every node transmit once to the others.
+ *
+ * \param positions The positions of the nodes.
+ * \param maxLossDb The MaxLossDb attribute of the channel.
+ * \param maxRange The MaxRange attribute of the channel.
+ * \param name The description of the run.
+ */
+static void
+RunChannel (const std::vector<Vector> &positions, double maxLossDb, double maxRange, std::string name)
+{
+  Ptr<SpectrumModel> model = CreateSpectrumModel ();
+  Ptr<MultiModelSpectrumChannel> channel = CreateObject<MultiModelSpectrumChannel> ();
+  channel->SetAttribute ("MaxLossDb", DoubleValue (maxLossDb));
+  channel->SetAttribute ("MaxRange", DoubleValue (maxRange));
+  channel->AddPropagationLossModel (CreateObject<LogDistancePropagationLossModel> ());
+  channel->SetPropagationDelayModel (CreateObject<ConstantSpeedPropagationDelayModel> ());
+
+  std::vector<Ptr<BenchPhy> > phys;
+  for (uint32_t i = 0; i < positions.size (); i++)
+    {
+      Ptr<MobilityModel> mobility = CreateObject<ConstantPositionMobilityModel> ();
+      mobility->SetPosition (positions[i]);
+      Ptr<BenchPhy> phy = CreateObject<BenchPhy> (model, mobility);
+      channel->AddRx (phy);
+      phys.push_back (phy);
+    }
+  for (uint32_t i = 0; i < phys.size (); i++)
+    {
+      Ptr<SpectrumSignalParameters> params = Create<SpectrumSignalParameters> ();
+      params->duration = MicroSeconds (1);
+      params->txPhy = phys[i];
+      params->psd = Create<SpectrumValue> (model);
+      *params->psd = 1e-12;
+      Simulator::Schedule (MicroSeconds (10 * i), &SpectrumChannel::StartTx, channel, params);
+    }
+
+  g_nRx = 0;
+  SystemWallClockMs time;
+  time.Start ();
+  Simulator::Run ();
+  int64_t runMs = time.End ();
+  Simulator::Destroy ();
+  channel->Dispose ();
+  for (uint32_t i = 0; i < phys.size (); i++)
+    {
+      phys[i]->Dispose ();
+    }
+
+  std::cout << positions.size () << " nodes, " << name << ": "
+            << g_nRx << " StartRx events in " << runMs << " ms" << std::endl;
+}
+
+int main (int argc, char *argv[])
+{
+  uint32_t minNodes = 250;
+  uint32_t maxNodes = 2000;
+  double side = 1000;
+  double maxLossDb = 110;
+
+  CommandLine cmd;
+  cmd.Usage ("Benchmark the MultiModelSpectrumChannel for increasing node densities");
+  cmd.AddValue ("min-nodes", "smallest number of nodes", minNodes);
+  cmd.AddValue ("max-nodes", "largest number of nodes, doubling from min-nodes", maxNodes);
+  cmd.AddValue ("side", "side of the square holding the nodes [m]", side);
+  cmd.AddValue ("max-loss", "loss [dB] beyond which signals are dropped", maxLossDb);
+  cmd.Parse (argc, argv);
+
+  double maxRange = CreateObject<LogDistancePropagationLossModel> ()->CalcRange (maxLossDb, 10 * side);
+  std::cout << "Running bench-spectrum-channel over " << side << " x " << side << " m, "
+            << "log-distance loss of " << maxLossDb << " dB at " << maxRange << " m" << std::endl;
+
+  Ptr<UniformRandomVariable> random = CreateObject<UniformRandomVariable> ();
+  random->SetStream (1);
+  for (uint32_t nNodes = minNodes; nNodes <= maxNodes; nNodes *= 2)
+    {
+      std::vector<Vector> positions;
+      for (uint32_t i = 0; i < nNodes; i++)
+        {
+          positions.push_back (Vector (random->GetValue (0, side), random->GetValue (0, side), 1.5));
+        }
+      RunChannel (positions, 1e9, 0, "no cutoff");
+      RunChannel (positions, maxLossDb, 0, "MaxLossDb");
+      RunChannel (positions, maxLossDb, maxRange, "MaxLossDb and MaxRange");
+    }
+  return 0;
+}
@@ -0,0 +1,251 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+// This program can be used to benchmark the SpectrumValue arithmetic
+// over the spectrum models of LTE (25 and 100 resource blocks) and of
+// OFDM Wi-Fi (20 to 160 MHz channels), for 'n' operations of each kind.
+// Sample usage:  ./waf --run 'bench-spectrum --n=100000'
+
+#include "ns3/command-line.h"
+#include "ns3/system-wall-clock-ms.h"
+#include "ns3/spectrum-value.h"
+#include "ns3/wifi-spectrum-value-helper.h"
+#include <iostream>
+#include <string>
+#include <sstream>
+#include <limits>
+#include <algorithm>
+
+using namespace ns3;
+
+/// The operands of the benchmarks, all over the same SpectrumModel
+struct Operands
+{
+  /**
+   * Create operands holding distinct positive values.
+   *
+   * \param model The SpectrumModel of the operands.
+   */
+  Operands (Ptr<const SpectrumModel> model);
+
+  SpectrumValue a;     //!< The value updated in place
+  SpectrumValue b;     //!< The first argument
+  SpectrumValue c;     //!< The second argument
+  SpectrumValue noise; //!< A noise power spectral density
+};
+
+Operands::Operands (Ptr<const SpectrumModel> model)
+  : a (model),
+    b (model),
+    c (model),
+    noise (model)
+{
+  for (size_t i = 0; i < model->GetNumBands (); i++)
+    {
+      a[i] = 1e-12 * (i + 1);
+      b[i] = 2e-12 * (i + 1);
+      c[i] = 0.5 + 1e-3 * i;
+      noise[i] = 4e-21;
+    }
+}
+
+/// Accumulates the results of reductions, so that they are not optimized out
+static double g_sink = 0;
+
+static void
+benchAdd (Operands &op, uint32_t n)
+{
+  for (uint32_t i = 0; i < n; i++)
+    {
+      op.a += op.b;
+    }
+}
+
+static void
+benchMultiply (Operands &op, uint32_t n)
+{
+  for (uint32_t i = 0; i < n; i++)
+    {
+      op.a = op.b * op.c;
+    }
+}
+
+static void
+benchScaledAddOperators (Operands &op, uint32_t n)
+{
+  for (uint32_t i = 0; i < n; i++)
+    {
+      op.a += op.b * 1e-3;
+    }
+}
+
+static void
+benchAddScaled (Operands &op, uint32_t n)
+{
+  for (uint32_t i = 0; i < n; i++)
+    {
+      op.a.AddScaled (op.b, 1e-3);
+    }
+}
+
+static void
+benchMultiplyAccumulateOperators (Operands &op, uint32_t n)
+{
+  for (uint32_t i = 0; i < n; i++)
+    {
+      op.a += op.b * op.c;
+    }
+}
+
+static void
+benchAddProduct (Operands &op, uint32_t n)
+{
+  for (uint32_t i = 0; i < n; i++)
+    {
+      op.a.AddProduct (op.b, op.c);
+    }
+}
+
+static void
+benchSinr (Operands &op, uint32_t n)
+{
+  for (uint32_t i = 0; i < n; i++)
+    {
+      SpectrumValue sinr = op.b / (op.a - op.b + op.noise);
+      g_sink += sinr[0];
+    }
+}
+
+static void
+benchSum (Operands &op, uint32_t n)
+{
+  for (uint32_t i = 0; i < n; i++)
+    {
+      g_sink += Sum (op.a);
+    }
+}
+
+static void
+benchIntegral (Operands &op, uint32_t n)
+{
+  for (uint32_t i = 0; i < n; i++)
+    {
+      g_sink += Integral (op.a);
+    }
+}
+
+static void
+benchLog10 (Operands &op, uint32_t n)
+{
+  for (uint32_t i = 0; i < n; i++)
+    {
+      SpectrumValue db = 10 * Log10 (op.b);
+      g_sink += db[0];
+    }
+}
+
+static void
+runBench (void (*bench) (Operands &, uint32_t), Ptr<const SpectrumModel> model,
+          uint32_t n, uint32_t minIterations, std::string name)
+{
+  uint64_t minDelay = std::numeric_limits<uint64_t>::max ();
+  for (uint32_t i = 0; i < minIterations; i++)
+    {
+      Operands op (model);
+      SystemWallClockMs time;
+      time.Start ();
+      (*bench) (op, n);
+      uint64_t delay = time.End ();
+      minDelay = std::min (minDelay, delay);
+    }
+  double ps = n;
+  ps *= 1000;
+  ps /= std::max<uint64_t> (minDelay, 1);
+  std::cout << ps << " ops/s"
+            << " (" << minDelay << " ms elapsed)\t"
+            << name
+            << std::endl;
+}
+
+static void
+runModel (Ptr<const SpectrumModel> model, std::string modelName, uint32_t n, uint32_t minIterations)
+{
+  std::cout << modelName << ", " << model->GetNumBands () << " bands:" << std::endl;
+  runBench (&benchAdd, model, n, minIterations, "a += b");
+  runBench (&benchMultiply, model, n, minIterations, "a = b * c");
+  runBench (&benchScaledAddOperators, model, n, minIterations, "a += b * s");
+  runBench (&benchAddScaled, model, n, minIterations, "a.AddScaled (b, s)");
+  runBench (&benchMultiplyAccumulateOperators, model, n, minIterations, "a += b * c");
+  runBench (&benchAddProduct, model, n, minIterations, "a.AddProduct (b, c)");
+  runBench (&benchSinr, model, n, minIterations, "b / (a - b + noise)");
+  runBench (&benchSum, model, n, minIterations, "Sum (a)");
+  runBench (&benchIntegral, model, n, minIterations, "Integral (a)");
+  runBench (&benchLog10, model, n, minIterations, "10 * Log10 (b)");
+}
+
+/**
+ * Create the SpectrumModel of an LTE carrier, with one band per
+ * resource block.
+ *
+ * \param nRb The number of resource blocks.
+ * \return The SpectrumModel.
+ */
+static Ptr<SpectrumModel>
+CreateLteSpectrumModel (uint32_t nRb)
+{
+  Bands bands;
+  double f = 2120e6 - nRb * 90e3;
+  for (uint32_t i = 0; i < nRb; i++)
+    {
+      BandInfo info;
+      info.fl = f;
+      info.fc = f + 90e3;
+      info.fh = f + 180e3;
+      bands.push_back (info);
+      f += 180e3;
+    }
+  return Create<SpectrumModel> (bands);
+}
+
+int main (int argc, char *argv[])
+{
+  uint32_t n = 100000;
+  uint32_t minIterations = 1;
+
+  CommandLine cmd;
+  cmd.Usage ("Benchmark the SpectrumValue arithmetic");
+  cmd.AddValue ("n", "number of operations of each kind", n);
+  cmd.AddValue ("min-iterations", "number of subiterations to minimize iteration time over", minIterations);
+  cmd.Parse (argc, argv);
+
+  std::cout << "Running bench-spectrum with n=" << n << std::endl;
+
+  runModel (CreateLteSpectrumModel (25), "LTE 25 RB", n, minIterations);
+  runModel (CreateLteSpectrumModel (100), "LTE 100 RB", n, minIterations);
+  // The band and guard widths used by SpectrumWifiPhy for 802.11a/n/ac
+  for (uint32_t width = 20; width <= 160; width *= 2)
+    {
+      std::ostringstream name;
+      name << "Wi-Fi " << width << " MHz";
+      runModel (WifiSpectrumValueHelper::GetSpectrumModel (5250, static_cast<uint8_t> (width), 312500, 10), name.str (), n, minIterations);
+    }
+
+  if (g_sink == 0)
+    {
+      std::cout << std::endl;
+    }
+  return 0;
+}
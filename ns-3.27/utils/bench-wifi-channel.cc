@@ -0,0 +1,183 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+// This program can be used to benchmark the YansWifiChannel for
+// increasing numbers of ad-hoc Wi-Fi nodes on a grid of constant
+// density, broadcasting packets from random nodes, with and without
+// the MaxRange cutoff.
+// Sample usage:  ./waf --run 'bench-wifi-channel --max-nodes=10000'
+
+#include "ns3/command-line.h"
+#include "ns3/system-wall-clock-ms.h"
+#include "ns3/double.h"
+#include "ns3/string.h"
+#include "ns3/uinteger.h"
+#include "ns3/simulator.h"
+#include "ns3/random-variable-stream.h"
+#include "ns3/node-container.h"
+#include "ns3/net-device-container.h"
+#include "ns3/wifi-helper.h"
+#include "ns3/yans-wifi-helper.h"
+#include "ns3/wifi-mac-helper.h"
+#include "ns3/mobility-helper.h"
+#include "ns3/propagation-loss-model.h"
+#include "ns3/packet.h"
+#include <iostream>
+#include <cmath>
+
+using namespace ns3;
+
+/// A PropagationLossModel counting the links it is evaluated for
+class CountingPropagationLossModel : public PropagationLossModel
+{
+public:
+  CountingPropagationLossModel ();
+
+  uint64_t m_count; //!< The number of evaluations
+
+private:
+  virtual double DoCalcRxPower (double txPowerDbm,
+                                Ptr<MobilityModel> a,
+                                Ptr<MobilityModel> b) const;
+  virtual int64_t DoAssignStreams (int64_t stream);
+};
+
+CountingPropagationLossModel::CountingPropagationLossModel ()
+  : m_count (0)
+{
+}
+
+double
+CountingPropagationLossModel::DoCalcRxPower (double txPowerDbm,
+                                             Ptr<MobilityModel> a,
+                                             Ptr<MobilityModel> b) const
+{
+  const_cast<CountingPropagationLossModel *> (this)->m_count++;
+  return txPowerDbm;
+}
+
+int64_t
+CountingPropagationLossModel::DoAssignStreams (int64_t stream)
+{
+  return 0;
+}
+
+/**
+ * Broadcast a packet from a device.
+ *
+ * \param device The sending device.
+ */
+static void
+Broadcast (Ptr<NetDevice> device)
+{
+  device->Send (Create<Packet> (500), device->GetBroadcast (), 0x0800);
+}
+
+/**
+ * Broadcast packets from random nodes.
+ *
+ * \param nNodes The number of nodes.
+ * \param spacing The distance between neighbor nodes [m].
+ * \param nPackets The number of packets broadcast.
+ * \param maxRange The MaxRange attribute of the channel.
+ */
+static void
+RunChannel (uint32_t nNodes, double spacing, uint32_t nPackets, double maxRange)
+{
+  NodeContainer nodes;
+  nodes.Create (nNodes);
+
+  Ptr<LogDistancePropagationLossModel> loss = CreateObject<LogDistancePropagationLossModel> ();
+  Ptr<CountingPropagationLossModel> counter = CreateObject<CountingPropagationLossModel> ();
+  loss->SetNext (counter);
+  Ptr<YansWifiChannel> channel = YansWifiChannelHelper::Default ().Create ();
+  channel->SetPropagationLossModel (loss);
+  channel->SetAttribute ("MaxRange", DoubleValue (maxRange));
+  YansWifiPhyHelper phy = YansWifiPhyHelper::Default ();
+  phy.SetChannel (channel);
+  WifiHelper wifi;
+  wifi.SetStandard (WIFI_PHY_STANDARD_80211a);
+  wifi.SetRemoteStationManager ("ns3::ConstantRateWifiManager",
+                                "DataMode", StringValue ("OfdmRate6Mbps"),
+                                "ControlMode", StringValue ("OfdmRate6Mbps"));
+  WifiMacHelper mac;
+  mac.SetType ("ns3::AdhocWifiMac");
+  NetDeviceContainer devices = wifi.Install (phy, mac, nodes);
+  wifi.AssignStreams (devices, 1);
+
+  MobilityHelper mobility;
+  mobility.SetPositionAllocator ("ns3::GridPositionAllocator",
+                                 "DeltaX", DoubleValue (spacing),
+                                 "DeltaY", DoubleValue (spacing),
+                                 "GridWidth", UintegerValue (std::ceil (std::sqrt (nNodes))));
+  mobility.Install (nodes);
+
+  Ptr<UniformRandomVariable> random = CreateObject<UniformRandomVariable> ();
+  random->SetStream (0);
+  for (uint32_t i = 0; i < nPackets; i++)
+    {
+      Simulator::Schedule (MilliSeconds (10 * i), &Broadcast, devices.Get (random->GetInteger (0, nNodes - 1)));
+    }
+
+  SystemWallClockMs time;
+  time.Start ();
+  Simulator::Run ();
+  int64_t runMs = time.End ();
+  Simulator::Destroy ();
+
+  std::cout << nNodes << " nodes, ";
+  if (maxRange > 0)
+    {
+      std::cout << "MaxRange " << maxRange << " m: ";
+    }
+  else
+    {
+      std::cout << "no cutoff: ";
+    }
+  std::cout << counter->m_count << " receptions scheduled in " << runMs << " ms" << std::endl;
+}
+
+int main (int argc, char *argv[])
+{
+  uint32_t minNodes = 100;
+  uint32_t maxNodes = 10000;
+  uint32_t nPackets = 200;
+  double spacing = 50;
+  double minRxPowerDbm = -110;
+
+  CommandLine cmd;
+  cmd.Usage ("Benchmark the YansWifiChannel for increasing numbers of nodes");
+  cmd.AddValue ("min-nodes", "smallest number of nodes", minNodes);
+  cmd.AddValue ("max-nodes", "largest number of nodes, scaling by sqrt(10) from min-nodes", maxNodes);
+  cmd.AddValue ("packets", "number of packets broadcast", nPackets);
+  cmd.AddValue ("spacing", "distance between neighbor nodes [m]", spacing);
+  cmd.AddValue ("min-rx-power", "lowest power [dBm] worth delivering to a receiver", minRxPowerDbm);
+  cmd.Parse (argc, argv);
+
+  // The default transmission power of YansWifiPhy
+  double txPowerDbm = 16.0206;
+  double maxRange = CreateObject<LogDistancePropagationLossModel> ()->CalcRange (txPowerDbm - minRxPowerDbm, 1e6);
+  std::cout << "Running bench-wifi-channel with " << nPackets << " broadcasts, "
+            << spacing << " m between nodes" << std::endl;
+
+  for (double n = minNodes; n <= maxNodes * 1.01; n *= std::sqrt (10.0))
+    {
+      uint32_t nNodes = static_cast<uint32_t> (n + 0.5);
+      RunChannel (nNodes, spacing, nPackets, 0);
+      RunChannel (nNodes, spacing, nPackets, maxRange);
+    }
+  return 0;
+}
@@ -0,0 +1,265 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+// This program can be used to benchmark the interference tracking of
+// the Wi-Fi PHY in dense networks: increasing numbers of saturated
+// ad-hoc 802.11b nodes are placed at random in a square, so that every
+// node hears many long overlapping signals, most of them too weak to
+// defer to but all of them adding to the interference.  The
+// InterferenceHelper is also benchmarked alone, tracking a given number
+// of overlapping signals the way a PHY does.
+// Sample usage:  ./waf --run 'bench-wifi-interference --max-nodes=1600'
+
+#include "ns3/command-line.h"
+#include "ns3/system-wall-clock-ms.h"
+#include "ns3/double.h"
+#include "ns3/string.h"
+#include "ns3/simulator.h"
+#include "ns3/node-container.h"
+#include "ns3/net-device-container.h"
+#include "ns3/wifi-helper.h"
+#include "ns3/yans-wifi-helper.h"
+#include "ns3/wifi-mac-helper.h"
+#include "ns3/mobility-helper.h"
+#include "ns3/packet.h"
+#include "ns3/random-variable-stream.h"
+#include "ns3/interference-helper.h"
+#include "ns3/nist-error-rate-model.h"
+#include "ns3/wifi-phy.h"
+#include <iostream>
+#include <sstream>
+#include <cmath>
+
+using namespace ns3;
+
+/// The number of packets received by all the nodes
+static uint64_t g_received = 0;
+
+/**
+ * Count a received packet.
+ *
+ * \param device The receiving device.
+ * \param packet The packet.
+ * \param protocol The protocol number.
+ * \param sender The sender address.
+ * \returns true
+ */
+static bool
+Receive (Ptr<NetDevice> device, Ptr<const Packet> packet, uint16_t protocol, const Address &sender)
+{
+  g_received++;
+  return true;
+}
+
+/**
+ * Broadcast packets from a device until the end of the simulation.
+ *
+ * \param device The sending device.
+ * \param interval The time between two packets.
+ */
+static void
+Broadcast (Ptr<NetDevice> device, Time interval)
+{
+  device->Send (Create<Packet> (2000), device->GetBroadcast (), 0x0800);
+  Simulator::Schedule (interval, &Broadcast, device, interval);
+}
+
+/// A receiver tracking the signals with an InterferenceHelper, like a PHY
+class Receiver
+{
+public:
+  /**
+   * \param concurrency The mean number of overlapping signals.
+   * \param duration The duration of the signals.
+   */
+  Receiver (double concurrency, Time duration);
+  /// Add a signal, and schedule the next one.
+  void AddSignal (void);
+  /// Calculate the PER of the PLCP header of the signal being received.
+  void ReceiveHeader (void);
+  /// Calculate the PER of the payload of the signal being received.
+  void EndReceive (void);
+
+  InterferenceHelper m_interference; //!< The interference helper
+  WifiTxVector m_txVector; //!< The TXVECTOR of the signals
+  Time m_duration; //!< The duration of the signals
+  Ptr<ExponentialRandomVariable> m_interval; //!< The time between two signals
+  Ptr<UniformRandomVariable> m_powerDbm; //!< The power of the signals
+  Ptr<InterferenceHelper::Event> m_rxEvent; //!< The signal being received
+  uint64_t m_received; //!< The number of signals received
+  double m_per; //!< The sum of the PER of the signals received
+};
+
+Receiver::Receiver (double concurrency, Time duration)
+  : m_duration (duration),
+    m_received (0),
+    m_per (0)
+{
+  m_interference.SetErrorRateModel (CreateObject<NistErrorRateModel> ());
+  m_interference.SetNoiseFigure (5);
+  m_txVector.SetMode (WifiPhy::GetDsssRate1Mbps ());
+  m_txVector.SetPreambleType (WIFI_PREAMBLE_LONG);
+  m_txVector.SetChannelWidth (22);
+  m_interval = CreateObject<ExponentialRandomVariable> ();
+  m_interval->SetAttribute ("Mean", DoubleValue (duration.GetSeconds () / concurrency));
+  m_interval->SetStream (0);
+  m_powerDbm = CreateObject<UniformRandomVariable> ();
+  m_powerDbm->SetAttribute ("Min", DoubleValue (-120));
+  m_powerDbm->SetAttribute ("Max", DoubleValue (-50));
+  m_powerDbm->SetStream (1);
+}
+
+void
+Receiver::AddSignal (void)
+{
+  double powerW = std::pow (10.0, m_powerDbm->GetValue () / 10.0) / 1000.0;
+  Ptr<InterferenceHelper::Event> event = m_interference.Add (0, m_txVector, m_duration, powerW);
+  if (m_rxEvent == 0 && powerW > 2.5e-13)
+    {
+      // The strongest signals are received when the receiver is idle
+      m_rxEvent = event;
+      m_interference.NotifyRxStart ();
+      Simulator::Schedule (WifiPhy::CalculatePlcpPreambleAndHeaderDuration (m_txVector), &Receiver::ReceiveHeader, this);
+      Simulator::Schedule (m_duration, &Receiver::EndReceive, this);
+    }
+  else
+    {
+      m_interference.GetEnergyDuration (1e-10);
+    }
+  Simulator::Schedule (Seconds (m_interval->GetValue ()), &Receiver::AddSignal, this);
+}
+
+void
+Receiver::ReceiveHeader (void)
+{
+  m_interference.CalculatePlcpHeaderSnrPer (m_rxEvent);
+}
+
+void
+Receiver::EndReceive (void)
+{
+  m_per += m_interference.CalculatePlcpPayloadSnrPer (m_rxEvent).per;
+  m_received++;
+  m_interference.NotifyRxEnd ();
+  m_rxEvent = 0;
+  m_interference.GetEnergyDuration (1e-10);
+}
+
+/**
+ * Track overlapping signals with an InterferenceHelper.
+ *
+ * \param concurrency The mean number of overlapping signals.
+ * \param duration The simulated time.
+ */
+static void
+RunHelper (double concurrency, Time duration)
+{
+  Receiver receiver (concurrency, MilliSeconds (16));
+  Simulator::ScheduleNow (&Receiver::AddSignal, &receiver);
+  Simulator::Stop (duration);
+
+  SystemWallClockMs time;
+  time.Start ();
+  Simulator::Run ();
+  int64_t runMs = time.End ();
+  Simulator::Destroy ();
+
+  std::cout << concurrency << " overlapping signals: " << receiver.m_received << " signals received (mean PER "
+            << receiver.m_per / receiver.m_received << ") in " << runMs << " ms" << std::endl;
+}
+
+/**
+ * Run a network of saturated nodes.
+ *
+ * \param nNodes The number of nodes.
+ * \param side The side of the square the nodes are placed in [m].
+ * \param duration The simulated time.
+ */
+static void
+RunNetwork (uint32_t nNodes, double side, Time duration)
+{
+  NodeContainer nodes;
+  nodes.Create (nNodes);
+
+  YansWifiChannelHelper channel = YansWifiChannelHelper::Default ();
+  YansWifiPhyHelper phy = YansWifiPhyHelper::Default ();
+  phy.SetChannel (channel.Create ());
+  WifiHelper wifi;
+  wifi.SetStandard (WIFI_PHY_STANDARD_80211b);
+  wifi.SetRemoteStationManager ("ns3::ConstantRateWifiManager",
+                                "DataMode", StringValue ("DsssRate1Mbps"),
+                                "ControlMode", StringValue ("DsssRate1Mbps"));
+  WifiMacHelper mac;
+  mac.SetType ("ns3::AdhocWifiMac");
+  NetDeviceContainer devices = wifi.Install (phy, mac, nodes);
+  wifi.AssignStreams (devices, 1);
+
+  MobilityHelper mobility;
+  std::ostringstream position;
+  position << "ns3::UniformRandomVariable[Min=0.0|Max=" << side << "]";
+  mobility.SetPositionAllocator ("ns3::RandomRectanglePositionAllocator",
+                                 "X", StringValue (position.str ()),
+                                 "Y", StringValue (position.str ()));
+  mobility.Install (nodes);
+
+  // A 2000 bytes packet lasts about 16.2 ms at 1 Mbit/s, so that one
+  // packet every 16 ms keeps every node backlogged
+  g_received = 0;
+  for (uint32_t i = 0; i < nNodes; i++)
+    {
+      devices.Get (i)->SetReceiveCallback (MakeCallback (&Receive));
+      Simulator::Schedule (MicroSeconds (i), &Broadcast, devices.Get (i), MilliSeconds (16));
+    }
+  Simulator::Stop (duration);
+
+  SystemWallClockMs time;
+  time.Start ();
+  Simulator::Run ();
+  int64_t runMs = time.End ();
+  Simulator::Destroy ();
+
+  std::cout << nNodes << " nodes: " << g_received << " packets received in "
+            << runMs << " ms" << std::endl;
+}
+
+int main (int argc, char *argv[])
+{
+  uint32_t minNodes = 100;
+  uint32_t maxNodes = 800;
+  double side = 3000;
+  double duration = 0.5;
+
+  CommandLine cmd;
+  cmd.Usage ("Benchmark the Wi-Fi interference tracking for increasing numbers of saturated nodes");
+  cmd.AddValue ("min-nodes", "smallest number of nodes", minNodes);
+  cmd.AddValue ("max-nodes", "largest number of nodes, doubling from min-nodes", maxNodes);
+  cmd.AddValue ("side", "side of the square the nodes are placed in [m]", side);
+  cmd.AddValue ("duration", "simulated time [s]", duration);
+  cmd.Parse (argc, argv);
+
+  std::cout << "Running bench-wifi-interference with " << side << " m square, "
+            << duration << " s" << std::endl;
+
+  for (double concurrency = 10; concurrency <= 1000; concurrency *= 10)
+    {
+      RunHelper (concurrency, Seconds (20 * duration * 100 / concurrency));
+    }
+  for (uint32_t nNodes = minNodes; nNodes <= maxNodes; nNodes *= 2)
+    {
+      RunNetwork (nNodes, side, Seconds (duration));
+    }
+  return 0;
+}
@@ -0,0 +1,51 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+// This program converts an LTE fading trace from the text format written
+// by fading_trace_generator.m to the binary format, which the
+// TraceFadingLossModel maps in memory instead of parsing it.
+// Sample usage:
+//   ./waf --run 'convert-fading-trace --input=fading_trace_EPA_3kmph.fad --output=fading_trace_EPA_3kmph.fadb'
+
+#include "ns3/command-line.h"
+#include "ns3/abort.h"
+#include "ns3/trace-fading-loss-model.h"
+#include <iostream>
+
+using namespace ns3;
+
+int main (int argc, char *argv[])
+{
+  std::string input;
+  std::string output;
+  uint32_t rbNum = 100;
+  uint32_t samplesNum = 10000;
+
+  CommandLine cmd;
+  cmd.Usage ("Convert an LTE fading trace from the text format to the binary format");
+  cmd.AddValue ("input", "text trace to read", input);
+  cmd.AddValue ("output", "binary trace to write", output);
+  cmd.AddValue ("rb", "number of RB the trace is made of", rbNum);
+  cmd.AddValue ("samples", "number of samples per RB", samplesNum);
+  cmd.Parse (argc, argv);
+
+  NS_ABORT_MSG_IF (input.empty () || output.empty (), "Both --input and --output are needed");
+  NS_ABORT_MSG_IF (rbNum == 0 || rbNum > 255, "The number of RB must be between 1 and 255");
+  TraceFadingLossModel::ConvertTrace (input, output, rbNum, samplesNum);
+  std::cout << "Converted " << rbNum << " RB of " << samplesNum << " samples from "
+            << input << " to " << output << std::endl;
+  return 0;
+}